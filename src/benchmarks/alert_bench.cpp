@@ -0,0 +1,43 @@
+/**
+ * @file alert_bench.cpp
+ * @brief AlertManager::evaluate() cost against the number of rules.
+ *
+ * Rules cycle through every AlertMetric with thresholds spread so that
+ * some breach and some do not; sustainSeconds is high enough that none
+ * fire during the run, so event recording stays out of the figure.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/alerts/alert_manager.h"
+
+#include <string>
+
+namespace {
+
+constexpr AlertMetric kMetrics[] = {
+    AlertMetric::CpuUsage, AlertMetric::MemoryUsage, AlertMetric::SwapUsage,
+    AlertMetric::DiskUsage, AlertMetric::GpuUsage, AlertMetric::CpuTemp,
+    AlertMetric::GpuTemp, AlertMetric::NetUpload, AlertMetric::NetDownload};
+
+void BM_EvaluateRules(benchmark::State& state) {
+    AlertManager alerts;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        AlertRule r;
+        r.name           = "rule " + std::to_string(i);
+        r.metric         = kMetrics[i % 9];
+        r.threshold      = static_cast<float>(i % 100);
+        r.above          = (i % 2) == 0;
+        r.sustainSeconds = 1 << 30;
+        alerts.addRule(r);
+    }
+
+    MetricData md;
+    md.cpu.totalUsage      = 55.0f;
+    md.memory.usagePercent = 70.0f;
+    md.memory.swapPercent  = 5.0f;
+    for (auto _ : state) alerts.evaluate(md);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EvaluateRules)->RangeMultiplier(10)->Range(10, 10000);
+
+} // namespace
@@ -0,0 +1,132 @@
+/**
+ * @file batch_reader_bench.cpp
+ * @brief Syscall count and latency of a process tick, sync vs io_uring.
+ *
+ * Run with --benchmark_counters_tabular=true. The "syscalls" counter is
+ * per iteration (one tick); compare it between the two backends.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/io/batch_reader.h"
+
+#ifdef __linux__
+#include "core/process/process_linux.h"
+
+#include <dirent.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// PIDs currently in /proc.
+std::vector<int> livePids() {
+    std::vector<int> pids;
+    if (DIR* d = opendir("/proc")) {
+        while (dirent* e = readdir(d))
+            if (std::isdigit(static_cast<unsigned char>(e->d_name[0])))
+                pids.push_back(std::atoi(e->d_name));
+        closedir(d);
+    }
+    return pids;
+}
+
+/**
+ * The stat/status/cmdline reads of a tick over @p pidCount PIDs. Live
+ * PIDs are repeated when fewer exist, so the file mix stays realistic
+ * without needing that many processes.
+ */
+std::vector<FileRead> tickRequests(std::size_t pidCount) {
+    static const char* kFiles[]   = {"/stat", "/status", "/cmdline"};
+    static const std::size_t kMax[] = {1024, 4096, 4096};
+    auto pids = livePids();
+    std::vector<FileRead> reqs;
+    reqs.reserve(pidCount * 3);
+    for (std::size_t i = 0; i < pidCount && !pids.empty(); ++i) {
+        std::string dir = "/proc/" + std::to_string(pids[i % pids.size()]);
+        for (int f = 0; f < 3; ++f) {
+            FileRead r;
+            r.path     = dir + kFiles[f];
+            r.maxBytes = kMax[f];
+            reqs.push_back(std::move(r));
+        }
+    }
+    return reqs;
+}
+
+void BM_BatchRead(benchmark::State& state, BatchBackend backend) {
+    auto reader = createBatchReader(backend);
+    auto reqs = tickRequests(static_cast<std::size_t>(state.range(0)));
+    state.SetLabel(reader->name());
+
+    uint64_t before = reader->syscalls();
+    for (auto _ : state) {
+        reader->readAll(reqs);
+        benchmark::DoNotOptimize(reqs.data());
+    }
+    state.counters["files"]    = static_cast<double>(reqs.size());
+    state.counters["syscalls"] = benchmark::Counter(
+        static_cast<double>(reader->syscalls() - before),
+        benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_BatchRead, sync,     BatchBackend::Sync)
+    ->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BatchRead, io_uring, BatchBackend::IoUring)
+    ->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/// Idle children that exist only to populate /proc; killed on destruction.
+class IdleChildren {
+public:
+    explicit IdleChildren(std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            pid_t pid = fork();
+            if (pid < 0) break;
+            if (pid == 0) { pause(); _exit(0); }
+            pids_.push_back(pid);
+        }
+    }
+    ~IdleChildren() {
+        for (pid_t pid : pids_) kill(pid, SIGKILL);
+        for (pid_t pid : pids_) waitpid(pid, nullptr, 0);
+    }
+    std::size_t size() const { return pids_.size(); }
+
+private:
+    std::vector<pid_t> pids_;
+};
+
+/// A full LinuxProcessManager::update() with @p range(0) extra processes.
+void BM_ProcessTick(benchmark::State& state, BatchBackend backend) {
+    IdleChildren children(static_cast<std::size_t>(state.range(0)));
+    if (children.size() < static_cast<std::size_t>(state.range(0))) {
+        state.SkipWithError("could not fork enough children (RLIMIT_NPROC?)");
+        return;
+    }
+
+    LinuxProcessManager pm(backend);
+    pm.setDetailedInfo(false);  // the stat/status path every tick takes
+    pm.update();                // prime the CPU deltas
+    state.SetLabel(pm.ioBackend());
+
+    uint64_t before = pm.ioSyscalls();
+    for (auto _ : state) pm.update();
+    state.counters["processes"] = pm.snapshot().totalProcesses;
+    state.counters["syscalls"]  = benchmark::Counter(
+        static_cast<double>(pm.ioSyscalls() - before),
+        benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_ProcessTick, sync,     BatchBackend::Sync)
+    ->Arg(0)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ProcessTick, io_uring, BatchBackend::IoUring)
+    ->Arg(0)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // __linux__
@@ -0,0 +1,69 @@
+/**
+ * @file load_bench.cpp
+ * @brief One tick of every module while the LoadGenerator loads the machine.
+ *
+ * The arguments are idle processes (4 threads each) and loopback TCP
+ * connections, so the rows trace the tick cost as each kind of load
+ * grows. Every module runs with full detail on the benchmark thread;
+ * "processes" and "sockets" are what the modules actually saw. For
+ * steady-state figures under a real Collector, run ResourceMonitorLoadGen.
+ */
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include "core/collector/collector.h"
+#include "load_generator.h"
+
+#include <string>
+
+namespace {
+
+void BM_TickUnderLoad(benchmark::State& state) {
+    LoadSpec spec;
+    spec.processes         = static_cast<int>(state.range(0));
+    spec.threadsPerProcess = 4;
+    spec.tcpConnections    = static_cast<int>(state.range(1));
+    LoadGenerator load(spec);
+    load.start();
+    // Only a shortfall in what the row is named for voids it; anything else
+    // (fewer threads, say) is reported in the label.
+    const LoadReport& got = load.achieved();
+    const int tcpWanted = spec.tcpConnections > 0 ? 1 + 2 * spec.tcpConnections : 0;
+    if (got.processes < spec.processes || got.tcpSockets < tcpWanted) {
+        state.SkipWithError(got.warnings.empty() ? "load fell short" : got.warnings.front().c_str());
+        return;
+    }
+    std::string warnings;
+    for (const auto& w : got.warnings) warnings += (warnings.empty() ? "" : "; ") + w;
+    if (!warnings.empty()) state.SetLabel(warnings);
+
+    auto mods = Collector::platformModules();
+    mods.cpu->setSensorDetail(true);
+    mods.memory->setTopProcessScan(true);
+    mods.network->setConnectionTracking(true);
+    mods.process->setDetailedInfo(true);
+    auto tick = [&] {
+        mods.cpu->update();
+        mods.memory->update();
+        mods.network->update();
+        mods.disk->update();
+        mods.gpu->update();
+        mods.process->update();
+    };
+    tick();  // prime the rate deltas and caches
+
+    for (auto _ : state) tick();
+    state.counters["processes"] = mods.process->snapshot().totalProcesses;
+    state.counters["sockets"]   = static_cast<double>(mods.network->snapshot().connections.size());
+}
+
+BENCHMARK(BM_TickUnderLoad)
+    ->ArgNames({"processes", "tcp"})
+    ->Args({0, 0})->Args({1000, 0})->Args({5000, 0})
+    ->Args({0, 1000})->Args({0, 5000})->Args({5000, 5000})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // __linux__
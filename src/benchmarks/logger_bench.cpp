@@ -0,0 +1,69 @@
+/**
+ * @file logger_bench.cpp
+ * @brief What a log call costs the calling thread.
+ *
+ * BM_LogCall measures Logger::log() on the caller only: the message is
+ * queued in the thread's ring and the background writer does the
+ * formatting and the file I/O. Run with ->Threads() to see that callers
+ * do not contend. BM_LogFlushed includes the writer's work by flushing
+ * every 64 messages, so it approximates throughput to the file.
+ *
+ * BM_EmitEvent is the same for a binary EventLog record with four
+ * arguments, with the event log closed (one branch) and open.
+ */
+
+#include <benchmark/benchmark.h>
+#include "utils/event_log.h"
+#include "utils/logger.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const std::string kBenchLog = "/tmp/rm_bench_logger.log";
+
+void BM_LogCall(benchmark::State& state) {
+    if (state.thread_index() == 0) Logger::initialize(kBenchLog);
+    for (auto _ : state) Logger::log("collector tick took longer than the interval");
+    if (state.thread_index() == 0) {
+        Logger::flush();
+        state.counters["dropped"] = static_cast<double>(Logger::dropped());
+        std::remove(kBenchLog.c_str());
+    }
+}
+BENCHMARK(BM_LogCall)->Threads(1)->Threads(4);
+
+void BM_LogFlushed(benchmark::State& state) {
+    Logger::initialize(kBenchLog);
+    int n = 0;
+    for (auto _ : state) {
+        Logger::log("collector tick took longer than the interval");
+        if (++n % 64 == 0) Logger::flush();
+    }
+    Logger::flush();
+    state.SetItemsProcessed(state.iterations());
+    std::remove(kBenchLog.c_str());
+}
+BENCHMARK(BM_LogFlushed);
+
+void BM_EmitEvent(benchmark::State& state) {
+    static const EventType kEvent("{} update took {} us, {} syscalls, {} bytes read");
+    const Label module("rm-Process");
+    const bool  open = state.range(0) != 0;
+    if (open && state.thread_index() == 0) EventLog::open("/tmp/rm_bench_events.rmev");
+    uint64_t i = 0;
+    for (auto _ : state) {
+        ++i;
+        EventLog::emit(kEvent, module, i, i & 63, i * 4096);
+    }
+    if (open && state.thread_index() == 0) {
+        EventLog::close();
+        state.counters["dropped"] = static_cast<double>(Logger::dropped());
+        std::remove("/tmp/rm_bench_events.rmev");
+        std::remove("/tmp/rm_bench_events.rmev.1");
+    }
+}
+BENCHMARK(BM_EmitEvent)->ArgName("open")->Arg(0)->Arg(1)->Threads(1)->Threads(4);
+
+} // namespace
@@ -0,0 +1,70 @@
+/**
+ * @file module_bench.cpp
+ * @brief One update() of each collector module, as the Collector runs it.
+ *
+ * Modules come from the same createX() factories the Collector uses and
+ * are updated once before timing so the delta state is primed. Network
+ * and Process are measured with and without their expensive detail
+ * (connection tracking, per-process detail), the two switches the
+ * collection profiles flip.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/cpu/cpu_common.h"
+#include "core/disk/disk_common.h"
+#include "core/gpu/gpu_common.h"
+#include "core/memory/memory_common.h"
+#include "core/network/network_common.h"
+#include "core/process/process_common.h"
+
+#include <memory>
+
+namespace {
+
+template <typename Module>
+void runUpdates(benchmark::State& state, Module& module) {
+    module.update();
+    for (auto _ : state) module.update();
+}
+
+void BM_UpdateCPU(benchmark::State& state) {
+    auto cpu = createCPU();
+    cpu->setSensorDetail(state.range(0) != 0);
+    runUpdates(state, *cpu);
+}
+BENCHMARK(BM_UpdateCPU)->ArgName("sensors")->Arg(0)->Arg(1);
+
+void BM_UpdateMemory(benchmark::State& state) {
+    auto memory = createMemory();
+    runUpdates(state, *memory);
+}
+BENCHMARK(BM_UpdateMemory);
+
+void BM_UpdateDisk(benchmark::State& state) {
+    auto disk = createDisk();
+    runUpdates(state, *disk);
+}
+BENCHMARK(BM_UpdateDisk);
+
+void BM_UpdateGPU(benchmark::State& state) {
+    auto gpu = createGPU();
+    runUpdates(state, *gpu);
+}
+BENCHMARK(BM_UpdateGPU);
+
+void BM_UpdateNetwork(benchmark::State& state) {
+    auto net = createNetwork();
+    net->setConnectionTracking(state.range(0) != 0);
+    runUpdates(state, *net);
+}
+BENCHMARK(BM_UpdateNetwork)->ArgName("connections")->Arg(0)->Arg(1);
+
+void BM_UpdateProcess(benchmark::State& state) {
+    auto pm = createProcessManager();
+    pm->setDetailedInfo(state.range(0) != 0);
+    runUpdates(state, *pm);
+    state.counters["processes"] = pm->snapshot().totalProcesses;
+}
+BENCHMARK(BM_UpdateProcess)->ArgName("detail")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
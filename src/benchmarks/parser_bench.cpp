@@ -0,0 +1,125 @@
+/**
+ * @file parser_bench.cpp
+ * @brief Text parsers of the Linux modules, without the file reads.
+ *
+ * Each benchmark reads its input once and then parses it repeatedly, so
+ * the figures are parser cost alone; bytes_per_second is parse
+ * throughput. The socket table is synthetic so its size can be swept.
+ */
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include "core/cpu/cpu_linux.h"
+#include "core/disk/disk_linux.h"
+#include "core/io/batch_reader.h"
+#include "core/memory/memory_linux.h"
+#include "core/network/network_linux.h"
+#include "core/process/process_linux.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string slurp(const char* path) {
+    std::string text;
+    readFileInto(path, text);
+    return text;
+}
+
+void BM_ParseProcStat(benchmark::State& state) {
+    std::string text = slurp("/proc/stat");
+    LinuxCPU::ProcStat out;
+    out.cores.resize(static_cast<std::size_t>(sysconf(_SC_NPROCESSORS_ONLN)));
+    for (auto _ : state) {
+        LinuxCPU::parseProcStat(text, out);
+        benchmark::DoNotOptimize(out.agg);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseProcStat);
+
+void BM_ParseMeminfo(benchmark::State& state) {
+    std::string text = slurp("/proc/meminfo");
+    for (auto _ : state) {
+        LinuxMemory::MemInfo out;
+        LinuxMemory::parseMeminfo(text, out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseMeminfo);
+
+void BM_ParseDiskStats(benchmark::State& state) {
+    std::string text = slurp("/proc/diskstats");
+    LinuxDisk::DiskStatsList out;
+    for (auto _ : state) {
+        LinuxDisk::parseDiskStats(text, out);
+        benchmark::DoNotOptimize(out.size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseDiskStats);
+
+void BM_ParsePidStat(benchmark::State& state) {
+    std::string text = slurp("/proc/self/stat");
+    const int pid = static_cast<int>(getpid());
+    ProcessInfo info;
+    LinuxProcessManager::CpuTicks ticks;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LinuxProcessManager::parseStat(text, pid, info, ticks));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParsePidStat);
+
+void BM_ParsePidStatus(benchmark::State& state) {
+    std::string text = slurp("/proc/self/status");
+    LinuxProcessManager pm;
+    ProcessInfo info;
+    for (auto _ : state) {
+        pm.parseStatus(text, info);
+        benchmark::DoNotOptimize(info.memoryBytes);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParsePidStatus);
+
+/// A /proc/net/tcp with @p rows sockets in mixed states.
+std::string socketTable(std::size_t rows) {
+    std::string text = "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when"
+                       " retrnsmt   uid  timeout inode\n";
+    char line[192];
+    for (std::size_t i = 0; i < rows; ++i) {
+        std::snprintf(line, sizeof(line),
+                      "%4zu: 0100007F:%04X 0A00020F:%04X %02X 00000000:00000000 00:00000000"
+                      " 00000000  1000        0 %zu 1 0000000000000000 20 4 30 10 -1\n",
+                      i, static_cast<unsigned>(1024 + i % 60000),
+                      static_cast<unsigned>(443 + i % 7), static_cast<unsigned>(1 + i % 11),
+                      100000 + i);
+        text += line;
+    }
+    return text;
+}
+
+void BM_ParseNetTcp(benchmark::State& state) {
+    std::string text = socketTable(static_cast<std::size_t>(state.range(0)));
+    LinuxNetwork net;
+    std::vector<TcpConnection> conns;
+    for (auto _ : state) {
+        std::size_t n = 0;
+        net.parseSocketText(text, false, false, conns, n);
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseNetTcp)->Arg(100)->Arg(1000)->Arg(10000);
+
+} // namespace
+
+#endif // __linux__
@@ -0,0 +1,81 @@
+/**
+ * @file replay_bench.cpp
+ * @brief Every collector module over a recorded capture, with no I/O.
+ *
+ * Set RM_BENCH_CAPTURE to a capture taken with "ResourceMonitorCLI
+ * --record" on the host worth profiling. Without it, 20 ticks of this
+ * machine are recorded to /tmp first. Each iteration replays the whole
+ * capture through one set of modules, so the figures are parser and
+ * pipeline cost on that host's data; items_per_second is ticks.
+ */
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include "core/collector/collector.h"
+#include "core/io/capture.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+/// Record @p ticks ticks of the live host to @p path, updating every module.
+void recordHost(const std::string& path, int ticks) {
+    auto rec = createRecordingFileReader(hostFileReader(), path);
+    if (!rec) return;
+    auto mods = Collector::platformModules(rec);
+    for (int i = 0; i < ticks; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        rec->markTick();
+        if (mods.cpu)     mods.cpu->update();
+        if (mods.memory)  mods.memory->update();
+        if (mods.network) mods.network->update();
+        if (mods.disk)    mods.disk->update();
+        if (mods.gpu)     mods.gpu->update();
+        if (mods.process) mods.process->update();
+    }
+}
+
+std::shared_ptr<ReplayFileReader> benchCapture() {
+    if (const char* path = std::getenv("RM_BENCH_CAPTURE")) return loadCapture(path);
+    static const std::string path = "/tmp/rm_bench_host.rmcap";
+    static bool recorded = (recordHost(path, 20), true);
+    (void)recorded;
+    return loadCapture(path);
+}
+
+void BM_ReplayCapture(benchmark::State& state) {
+    auto replay = benchCapture();
+    if (!replay || replay->tickCount() == 0) {
+        state.SkipWithError("no capture");
+        return;
+    }
+    auto mods = Collector::platformModules(replay);
+    mods.network->setConnectionTracking(true);
+
+    uint64_t bytes = 0;
+    for (auto _ : state) {
+        // The counters jump back at the rewind; only the first tick's rates are off.
+        replay->rewind();
+        while (replay->nextTick()) {
+            bytes += replay->tickBytes();
+            mods.cpu->update();
+            mods.memory->update();
+            mods.network->update();
+            mods.disk->update();
+            mods.gpu->update();
+            mods.process->update();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(replay->tickCount()));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_ReplayCapture)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // __linux__
@@ -0,0 +1,110 @@
+/**
+ * @file scrolling_buffer_bench.cpp
+ * @brief ScrollingBuffer and HistoryRing operations the GUI performs every frame.
+ *
+ * Buffers are filled past capacity first so the ring has wrapped, as it
+ * has after the first hour of a session at the default size.
+ */
+
+#include <benchmark/benchmark.h>
+#include "utils/decimate.h"
+#include "utils/history_ring.h"
+#include "utils/scrolling_buffer.h"
+
+#include <vector>
+
+namespace {
+
+ScrollingBuffer wrappedBuffer(int size) {
+    ScrollingBuffer buf(size);
+    for (int i = 0; i < size + size / 2; ++i)
+        buf.AddPoint(static_cast<float>(i), static_cast<float>(i % 97));
+    return buf;
+}
+
+void BM_AddPoint(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(static_cast<int>(state.range(0)));
+    float t = static_cast<float>(buf.MaxSize * 2);
+    for (auto _ : state) {
+        buf.AddPoint(t, t);
+        t += 1.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddPoint)->Arg(3600)->Arg(86400);
+
+/// The y-axis fit: max over the visible window (the last 60 s).
+void BM_MaxYInWindow(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(static_cast<int>(state.range(0)));
+    float xMin = static_cast<float>(buf.MaxSize + buf.MaxSize / 2 - 60);
+    for (auto _ : state) benchmark::DoNotOptimize(buf.MaxYInWindow(xMin));
+    state.SetItemsProcessed(state.iterations() * buf.Size());
+}
+BENCHMARK(BM_MaxYInWindow)->Arg(3600)->Arg(86400);
+
+/// Max over the whole ring, which the segment tree answers in O(log n) like a narrow window.
+void BM_MaxYFullRing(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(static_cast<int>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(buf.MaxY(0, buf.Size()));
+    state.SetItemsProcessed(state.iterations() * buf.Size());
+}
+BENCHMARK(BM_MaxYFullRing)->Arg(3600)->Arg(86400);
+
+/// Finding the start of the visible window.
+void BM_LowerBound(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(static_cast<int>(state.range(0)));
+    float xMin = static_cast<float>(buf.MaxSize + buf.MaxSize / 2 - 60);
+    for (auto _ : state) benchmark::DoNotOptimize(buf.LowerBound(xMin));
+}
+BENCHMARK(BM_LowerBound)->Arg(3600)->Arg(86400);
+
+void BM_Back(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(3600);
+    for (auto _ : state) benchmark::DoNotOptimize(buf.Back());
+}
+BENCHMARK(BM_Back);
+
+/// A day of 1 Hz samples in a HistoryRing with the default tiers.
+HistoryRing filledHistory() {
+    HistoryRing ring;
+    for (int i = 0; i < 86400; ++i)
+        ring.AddPoint(static_cast<float>(i), static_cast<float>(i % 97));
+    return ring;
+}
+
+void BM_HistoryAddPoint(benchmark::State& state) {
+    HistoryRing ring = filledHistory();
+    float t = 86400.0f;
+    for (auto _ : state) {
+        ring.AddPoint(t, t);
+        t += 1.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistoryAddPoint);
+
+/// Tier choice for a 6 hour window, made once per plot per frame.
+void BM_PickTier(benchmark::State& state) {
+    HistoryRing ring = filledHistory();
+    float xMin = 86400.0f - 6 * 3600.0f;
+    for (auto _ : state) benchmark::DoNotOptimize(ring.PickTier(xMin));
+}
+BENCHMARK(BM_PickTier);
+
+/// A full window decimated to a 1,600 pixel wide plot; vertices are the points drawn.
+void BM_DecimateMinMax(benchmark::State& state) {
+    ScrollingBuffer buf = wrappedBuffer(static_cast<int>(state.range(0)));
+    float xMax = static_cast<float>(buf.MaxSize + buf.MaxSize / 2);
+    float xMin = xMax - static_cast<float>(buf.MaxSize);
+    std::vector<float> x, y;
+    for (auto _ : state) {
+        decimateMinMax(buf.DataX.data(), buf.DataY.data(), buf.Size(), buf.Offset,
+                       xMin, xMax, 1600, x, y);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations() * buf.Size());
+    state.counters["vertices"] = static_cast<double>(x.size());
+}
+BENCHMARK(BM_DecimateMinMax)->Arg(3600)->Arg(86400);
+
+} // namespace
@@ -0,0 +1,59 @@
+/**
+ * @file startup_bench.cpp
+ * @brief Time from launch to the first sample and to the first complete sample.
+ *
+ * "construct" is what delays the first frame: how long the Collector
+ * constructor blocks its caller. "first_complete_ms" is how long until
+ * every enabled module has produced data. The Sync variant constructs
+ * every module up front, as the Collector used to; compare it with the
+ * default asynchronous start.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/collector/collector.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+void BM_Startup(benchmark::State& state, bool async) {
+    double constructMs = 0.0, firstSampleMs = 0.0, completeMs = 0.0;
+    for (auto _ : state) {
+        auto t0 = Clock::now();
+        auto c = async ? std::make_unique<Collector>(ProfileKind::Full)
+                       : std::make_unique<Collector>(ProfileKind::Full,
+                                                     Collector::platformModules());
+        constructMs += msSince(t0);
+
+        auto md = c->collect();
+        firstSampleMs += msSince(t0);
+        while (md.collector.firstCompleteMs == 0.0f && msSince(t0) < 30000.0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            md = c->collect();
+        }
+        completeMs += msSince(t0);
+
+        state.PauseTiming();
+        c.reset();
+        state.ResumeTiming();
+    }
+    auto n = static_cast<double>(state.iterations());
+    state.counters["construct_ms"]      = constructMs / n;
+    state.counters["first_sample_ms"]   = firstSampleMs / n;
+    state.counters["first_complete_ms"] = completeMs / n;
+}
+
+BENCHMARK_CAPTURE(BM_Startup, async, true)
+    ->Iterations(5)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Startup, sync, false)
+    ->Iterations(5)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,104 @@
+/**
+ * @file storage_bench.cpp
+ * @brief Database::insertSnapshot() batches and CSV export throughput.
+ *
+ * Samples carry a realistic payload (four mounted disks, two GPUs and a
+ * few interfaces) so the per-row statements are exercised as well as the
+ * transaction. Each run starts from an empty database file.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/database/database.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+const char* kDbPath    = "bench_resource_monitor.db";
+const char* kExportDir  = "bench_export";
+
+MetricData sampleMetrics() {
+    MetricData md;
+    md.timestamp = std::chrono::system_clock::now();
+    md.cpu.totalUsage = 37.5f;
+    md.cpu.frequency  = 3400.0f;
+    md.memory.usagePercent   = 61.0f;
+    md.memory.topProcessName = "firefox";
+
+    const char* mounts[][3] = {{"/dev/nvme0n1p2", "/", "ext4"},
+                               {"/dev/nvme0n1p1", "/boot/efi", "vfat"},
+                               {"/dev/sda1", "/home", "ext4"},
+                               {"/dev/sdb1", "/mnt/backup", "xfs"}};
+    for (const auto& m : mounts) {
+        DiskInfo d;
+        d.device = m[0]; d.mountPoint = m[1]; d.fsType = m[2];
+        d.totalBytes = 512ULL << 30; d.usedBytes = 200ULL << 30;
+        d.usagePercent = 39.0f; d.readBytesPerSec = 1.5e6f;
+        md.disk.disks.push_back(d);
+    }
+    for (int i = 0; i < 2; ++i) {
+        GpuInfo g;
+        g.name = i ? "Radeon RX 7600" : "Intel UHD 770";
+        g.vendor = i ? "AMD" : "Intel";
+        g.utilization = 12.0f; g.available = true;
+        md.gpu.gpus.push_back(g);
+    }
+    md.gpu.supported = true;
+    for (const char* name : {"lo", "enp5s0", "wlp6s0"}) {
+        NetworkInterfaceInfo n;
+        n.name = name; n.isUp = true; n.downloadRate = 2.5e5f;
+        md.network.interfaces.push_back(n);
+    }
+    return md;
+}
+
+void removeDatabase() {
+    for (const char* suffix : {"", "-wal", "-shm"}) fs::remove(std::string(kDbPath) + suffix);
+}
+
+std::unique_ptr<Database> freshDatabase() {
+    removeDatabase();
+    auto db = std::make_unique<Database>(kDbPath);
+    db->initialize();
+    return db;
+}
+
+/// range(0) snapshots per iteration, each in its own transaction as the pipeline does.
+void BM_InsertSnapshot(benchmark::State& state) {
+    auto db = freshDatabase();
+    MetricData md = sampleMetrics();
+    const auto batch = state.range(0);
+    for (auto _ : state)
+        for (int64_t i = 0; i < batch; ++i) db->insertSnapshot(md);
+    state.SetItemsProcessed(state.iterations() * batch);
+    db.reset();
+    removeDatabase();
+}
+BENCHMARK(BM_InsertSnapshot)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+/// exportToCSV() of a database holding range(0) snapshots.
+void BM_ExportCSV(benchmark::State& state) {
+    auto db = freshDatabase();
+    MetricData md = sampleMetrics();
+    for (int64_t i = 0; i < state.range(0); ++i) db->insertSnapshot(md);
+    fs::create_directories(kExportDir);
+
+    for (auto _ : state) db->exportToCSV(kExportDir);
+
+    uint64_t bytes = 0;
+    for (const auto& f : fs::directory_iterator(kExportDir)) bytes += f.file_size();
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    db.reset();
+    fs::remove_all(kExportDir);
+    removeDatabase();
+}
+BENCHMARK(BM_ExportCSV)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,129 @@
+/**
+ * @file synthetic_tree_bench.cpp
+ * @brief Collector scaling on machines we do not have, via synthetic /proc trees.
+ *
+ * Each benchmark writes a tree under the system temp directory once (a
+ * few seconds for the largest) and points the module at it with
+ * createFileReader(). The sizes match the machines we want to plan for:
+ * 50,000 processes, 1,024 cores and 500,000 sockets.
+ */
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include "core/cpu/cpu_linux.h"
+#include "core/io/file_reader.h"
+#include "core/network/network_linux.h"
+#include "core/process/process_linux.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+/// Root of a tree named @p name, rebuilt by @p build unless it already exists.
+template <typename Build>
+std::string treeRoot(const std::string& name, Build&& build) {
+    fs::path root = fs::temp_directory_path() / ("rm_bench_" + name);
+    if (!fs::exists(root / "complete")) {
+        fs::remove_all(root);
+        fs::create_directories(root / "proc");
+        build(root);
+        std::ofstream(root / "complete");
+    }
+    return root.string();
+}
+
+void writeFile(const fs::path& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+std::string procStat(int cores) {
+    std::string text = "cpu  80000 0 40000 800000 0 0 0 0 0 0\n";
+    char line[96];
+    for (int i = 0; i < cores; ++i) {
+        std::snprintf(line, sizeof(line), "cpu%d %d 0 %d 100000 10 0 5 0 0 0\n", i, 100 + i, 50 + i);
+        text += line;
+    }
+    return text + "intr 5000\nctxt 9000\nbtime 1700000000\nprocesses 42\n";
+}
+
+std::string pidTree(int pids) {
+    return treeRoot("pids_" + std::to_string(pids), [pids](const fs::path& root) {
+        writeFile(root / "proc/stat", procStat(64));
+        writeFile(root / "proc/meminfo", "MemTotal:       1056000000 kB\n");
+        char stat[160];
+        for (int pid = 1; pid <= pids; ++pid) {
+            fs::path dir = root / "proc" / std::to_string(pid);
+            fs::create_directory(dir);
+            std::snprintf(stat, sizeof(stat),
+                          "%d (worker-%d) S 1 1 1 0 -1 4194560 100 0 0 0 %d 5 0 0 20 0 4 0 100 1000000 200\n",
+                          pid, pid % 97, pid % 1000);
+            writeFile(dir / "stat", stat);
+            writeFile(dir / "status", "Name:\tworker\nUid:\t1000\t1000\t1000\t1000\nVmRSS:\t20480 kB\n");
+        }
+    });
+}
+
+std::string coreTree(int cores) {
+    return treeRoot("cores_" + std::to_string(cores), [cores](const fs::path& root) {
+        writeFile(root / "proc/stat", procStat(cores));
+        writeFile(root / "proc/loadavg", "100.00 90.00 80.00 12/40000 999\n");
+    });
+}
+
+std::string socketTree(int sockets) {
+    return treeRoot("sockets_" + std::to_string(sockets), [sockets](const fs::path& root) {
+        fs::create_directories(root / "proc/net");
+        std::ofstream out(root / "proc/net/tcp", std::ios::binary);
+        out << "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when"
+               " retrnsmt   uid  timeout inode\n";
+        char line[192];
+        for (int i = 0; i < sockets; ++i) {
+            std::snprintf(line, sizeof(line),
+                          "%6d: 0A000001:%04X 0A00020F:%04X %02X 00000000:00000000 00:00000000"
+                          " 00000000  1000        0 %d 1 0000000000000000 20 4 30 10 -1\n",
+                          i, 1024 + i % 60000, 443 + i % 7, 1 + i % 11, 100000 + i);
+            out << line;
+        }
+    });
+}
+
+void BM_SyntheticProcessTick(benchmark::State& state) {
+    auto files = createFileReader(pidTree(static_cast<int>(state.range(0))));
+    LinuxProcessManager pm(BatchBackend::Sync, files);
+    pm.setDetailedInfo(false);
+    pm.update();
+    state.SetLabel(pm.ioBackend());
+    for (auto _ : state) pm.update();
+    state.counters["processes"] = pm.snapshot().totalProcesses;
+}
+BENCHMARK(BM_SyntheticProcessTick)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+void BM_SyntheticCpuUpdate(benchmark::State& state) {
+    auto files = createFileReader(coreTree(static_cast<int>(state.range(0))));
+    LinuxCPU cpu(files);
+    cpu.setSensorDetail(true);
+    cpu.update();
+    for (auto _ : state) cpu.update();
+    state.counters["cores"] = cpu.snapshot().logicalCores;
+}
+BENCHMARK(BM_SyntheticCpuUpdate)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+void BM_SyntheticSocketTable(benchmark::State& state) {
+    auto files = createFileReader(socketTree(static_cast<int>(state.range(0))));
+    LinuxNetwork net(files);
+    net.setConnectionTracking(true);
+    net.update();
+    for (auto _ : state) net.update();
+    state.counters["connections"] = static_cast<double>(net.snapshot().connections.size());
+}
+BENCHMARK(BM_SyntheticSocketTable)->Arg(10000)->Arg(500000)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // __linux__
@@ -0,0 +1,49 @@
+/**
+ * @file event_dump.cpp
+ * @brief Decoder for the binary event log written by "ResourceMonitorCLI --events".
+ *
+ * Usage: ResourceMonitorEventDump [--json] <file.rmev>
+ *
+ * Prints one line per event: the local time to the microsecond, the
+ * thread id and the event text, or with --json one JSON object per line
+ * (ts_ns, tid, event, args, text) for feeding to jq or a notebook.
+ */
+
+#include "utils/event_log.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    EventDumpFormat format = EventDumpFormat::Text;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            format = EventDumpFormat::Json;
+        } else if (path.empty() && arg.rfind("--", 0) != 0) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--json] <file.rmev>\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << path << '\n';
+        return EXIT_FAILURE;
+    }
+    std::string error;
+    if (!decodeEventLog(in, std::cout, format, error)) {
+        std::cerr << path << ": " << error << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
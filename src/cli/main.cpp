@@ -2,8 +2,33 @@
  * @file main.cpp
  * @brief CLI resource monitor using the new snapshot-based API.
  *
- * Updates once per second, displays CPU, Memory, Network, Disk, and GPU
- * metrics in a formatted table.  Persists data to SQLite.
+ * Updates at the collection profile's tick rate (once per second by
+ * default), displays CPU, Memory, Network, Disk, and GPU metrics in a
+ * formatted table.  Persists data to SQLite.
+ *
+ * Usage: ResourceMonitorCLI [--profile minimal|standard|full|diagnostics]
+ *                           [--budget <percent of one core>]
+ *                           [--catch-up skip|burst|reanchor] [--io-uring]
+ *                           [--trace <file.json>] [--events <file.rmev>]
+ *                           [--record <file.rmcap> | --replay <file.rmcap>]
+ *
+ * --io-uring reads the per-process files through io_uring (see
+ * CollectionProfile::processIoUring); the kernel workers doing those reads
+ * are not counted against --budget.
+ *
+ * With --trace, collector activity is recorded from startup and written
+ * as Chrome trace-event JSON on exit. On POSIX systems SIGUSR1 toggles
+ * tracing at runtime; each stop writes the file.
+ *
+ * With --events, module timings, dropped pipeline samples, alert
+ * transitions and stale modules are recorded to a binary event log (see
+ * utils/event_log.h); decode it with ResourceMonitorEventDump.
+ *
+ * With --record, every procfs/sysfs read the collectors make is also
+ * written to a capture file (see core/io/capture.h). --replay runs the
+ * modules enabled by --profile over the ticks of such a capture in which
+ * they ran, as fast as they go, with no display or database, and prints
+ * how long their updates took. Replay with the profile the capture was recorded under.
  */
 
 #include <iostream>
@@ -14,20 +39,33 @@
 #include <atomic>
 #include <string>
 #include <cstdio>
+#include <functional>
+#include <vector>
 
-#include "core/cpu/cpu_common.h"
-#include "core/memory/memory_common.h"
-#include "core/network/network_common.h"
-#include "core/disk/disk_common.h"
-#include "core/gpu/gpu_common.h"
-#include "core/process/process_common.h"
-#include "core/system_info/system_info.h"
+#include "core/collector/collector.h"
 #include "core/database/database.h"
+#include "core/io/capture.h"
+#include "utils/event_log.h"
+#include "utils/histogram.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
 
 static std::atomic<bool> running{true};
 
+static std::atomic<bool> traceToggle{false};
+
 static void signalHandler(int) { running = false; }
+static void traceSignalHandler(int) { traceToggle = true; }
+
+/// Stop tracing and write what was recorded to @p path.
+static void saveTrace(const std::string& path) {
+    Tracer::stop();
+    if (Tracer::writeChromeJson(path))
+        Logger::log("Trace written to " + path + " (" + std::to_string(Tracer::spanCount())
+                    + " spans, " + std::to_string(Tracer::dropped()) + " dropped)");
+    else
+        Logger::error("Could not write trace to " + path);
+}
 
 static void clearConsole() {
 #ifdef _WIN32
@@ -59,50 +97,223 @@ static std::string fmtRate(float b) {
     return buf;
 }
 
-int main() {
+static void printUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--profile minimal|standard|full|diagnostics]"
+                 " [--budget <percent of one core>]"
+                 " [--catch-up skip|burst|reanchor] [--io-uring]"
+                 " [--trace <file.json>] [--events <file.rmev>]"
+                 " [--record <file.rmcap> | --replay <file.rmcap>]\n";
+}
+
+/// Accept both "--name value" and "--name=value".
+static bool optionValue(const std::string& name, int argc, char* argv[],
+                        int& i, std::string& value) {
+    std::string arg = argv[i];
+    if (arg == name && i + 1 < argc) {
+        value = argv[++i];
+        return true;
+    }
+    if (arg.rfind(name + "=", 0) == 0) {
+        value = arg.substr(name.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+/// Update the modules @p kind enables on the ticks of the capture at
+/// @p path in which they ran while recording, back to back, and print
+/// their update times.
+static int runReplay(const std::string& path, ProfileKind kind, bool ioUring) {
+    auto replay = loadCapture(path);
+    if (!replay) {
+        std::cerr << "Cannot read capture: " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    CollectionProfile profile = makeProfile(kind);
+    profile.processIoUring = profile.processIoUring || ioUring;
+    Collector::Modules mods = Collector::platformModules(replay);
+    if (mods.cpu)     mods.cpu->setSensorDetail(profile.cpuSensorDetail);
+    if (mods.memory)  mods.memory->setTopProcessScan(profile.memoryTopProcesses);
+    if (mods.network) mods.network->setConnectionTracking(profile.networkConnections);
+    if (mods.process) {
+        mods.process->setDetailedInfo(profile.processDetails);
+        mods.process->setIoUring(profile.processIoUring);
+    }
+
+    struct Timed {
+        ModuleId              id;
+        std::function<void()> update;
+        Histogram             us;
+    };
+    std::vector<Timed> timed;
+    auto add = [&](ModuleId id, auto* module) {
+        if (module && profile.schedule(id).enabled)
+            timed.push_back({id, [module] { module->update(); }, {}});
+    };
+    add(ModuleId::Cpu,     mods.cpu.get());
+    add(ModuleId::Memory,  mods.memory.get());
+    add(ModuleId::Network, mods.network.get());
+    add(ModuleId::Disk,    mods.disk.get());
+    add(ModuleId::Gpu,     mods.gpu.get());
+    add(ModuleId::Process, mods.process.get());
+
+    using Clock = std::chrono::steady_clock;
+    uint64_t bytes = 0;
+    const auto start = Clock::now();
+    while (replay->nextTick()) {
+        bytes += replay->tickBytes();
+        for (auto& m : timed) {
+            if (!replay->updated(static_cast<unsigned>(m.id))) continue;
+            auto t0 = Clock::now();
+            m.update();
+            m.us.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count()));
+        }
+    }
+    const double sec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const std::size_t ticks = replay->tickCount();
+    std::printf("Replayed %zu ticks (%.1f MB of reads) in %.3f s: %.0f ticks/s\n",
+                ticks, static_cast<double>(bytes) / (1024.0 * 1024.0), sec,
+                sec > 0.0 ? static_cast<double>(ticks) / sec : 0.0);
+    std::printf("  %-10s %10s %10s %10s %10s\n", "module", "mean us", "p50 us", "p99 us", "max us");
+    for (const auto& m : timed) {
+        std::printf("  %-10s %10.1f %10llu %10llu %10llu\n", moduleName(m.id), m.us.mean(),
+                    static_cast<unsigned long long>(m.us.percentile(0.50)),
+                    static_cast<unsigned long long>(m.us.percentile(0.99)),
+                    static_cast<unsigned long long>(m.us.max()));
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[]) {
+    ProfileKind profile = ProfileKind::Standard;
+    float budget = -1.0f;  // < 0: use the profile's budget
+    CatchUpPolicy catchUp = CatchUpPolicy::Skip;
+    bool ioUring = false;
+    std::string tracePath;
+    bool traceAtStart = false;
+    std::string eventsPath;
+    std::string recordPath;
+    std::string replayPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        if (optionValue("--profile", argc, argv, i, value)) {
+            if (!profileFromName(value, profile)) {
+                std::cerr << "Unknown profile: " << value << '\n';
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (optionValue("--budget", argc, argv, i, value)) {
+            try { budget = std::stof(value); } catch (...) { budget = -1.0f; }
+            if (budget < 0.0f) {
+                std::cerr << "Invalid budget: " << value << '\n';
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (optionValue("--catch-up", argc, argv, i, value)) {
+            if (!catchUpFromName(value, catchUp)) {
+                std::cerr << "Unknown catch-up policy: " << value << '\n';
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (std::string(argv[i]) == "--io-uring") {
+            ioUring = true;
+        } else if (optionValue("--trace", argc, argv, i, value)) {
+            tracePath    = value;
+            traceAtStart = true;
+        } else if (optionValue("--events", argc, argv, i, value)) {
+            eventsPath = value;
+        } else if (optionValue("--record", argc, argv, i, value)) {
+            recordPath = value;
+        } else if (optionValue("--replay", argc, argv, i, value)) {
+            replayPath = value;
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!recordPath.empty() && !replayPath.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!replayPath.empty()) {
+        if (traceAtStart) Tracer::start();
+        int rc = runReplay(replayPath, profile, ioUring);
+        if (Tracer::enabled()) saveTrace(tracePath);
+        return rc;
+    }
+
     Logger::initialize("resource_monitor.log");
     signal(SIGINT, signalHandler);
+#ifdef SIGUSR1
+    signal(SIGUSR1, traceSignalHandler);
+#endif
+    if (tracePath.empty()) tracePath = "resource_monitor_trace.json";
+    if (traceAtStart) Tracer::start();
+    if (!eventsPath.empty() && !EventLog::open(eventsPath))
+        Logger::error("Could not create event log " + eventsPath);
+
+    std::shared_ptr<RecordingFileReader> recorder;
+    if (!recordPath.empty()) {
+        recorder = createRecordingFileReader(hostFileReader(), recordPath);
+        if (!recorder) {
+            std::cerr << "Cannot create capture: " << recordPath << '\n';
+            return EXIT_FAILURE;
+        }
+        Logger::log("Recording reads to " + recordPath);
+    }
 
-    auto cpu     = createCPU();
-    auto memory  = createMemory();
-    auto network = createNetwork();
-    auto disk    = createDisk();
-    auto gpu     = createGPU();
-    SystemInfo sysInfo;
+    Collector collector(profile, recorder ? recorder : hostFileReader());
+    if (recorder) {
+        collector.setUpdateObserver([recorder](ModuleId id) {
+            recorder->markUpdate(static_cast<unsigned>(id));
+        });
+    }
+    if (budget >= 0.0f) collector.setBudgetPercent(budget);
+    if (ioUring) {
+        CollectionProfile p = collector.profile();
+        p.processIoUring = true;
+        collector.setProfile(p);
+    }
+    collector.setCatchUpPolicy(catchUp);
     Database db("resource_monitor.db");
     db.initialize();
 
-    if (!cpu || !memory || !network) {
-        std::cerr << "Failed to initialise monitoring modules.\n";
-        return EXIT_FAILURE;
-    }
+    // Everything the CLI prints or stores: CPU temperature and the top
+    // memory process. Connections and the process list are never shown.
+    auto sensorsSub  = collector.interests().subscribe(DataCategory::CpuSensors);
+    auto topProcsSub = collector.interests().subscribe(DataCategory::TopProcesses);
 
-    std::cout << "Monitoring resources... (Ctrl+C to stop)\n";
-    Logger::log("CLI started");
+    std::cout << "Monitoring resources with the '" << profileName(profile)
+              << "' profile... (Ctrl+C to stop)\n";
+    Logger::log(std::string("CLI started (profile: ") + profileName(profile) + ")");
 
     int tick = 0;
     const int W = 90;
 
     while (running) {
-        // Update all modules
-        cpu->update();
-        memory->update();
-        network->update();
-        if (disk) disk->update();
-        if (gpu) gpu->update();
-        sysInfo.update();
-
-        // Grab snapshots
-        auto cs = cpu->snapshot();
-        auto ms = memory->snapshot();
-        auto ns = network->snapshot();
-        DiskSnapshot ds; if (disk) ds = disk->snapshot();
-        GpuSnapshot gs;  if (gpu)  gs = gpu->snapshot();
-
-        // Build MetricData for DB
-        MetricData md;
-        md.cpu = cs; md.memory = ms; md.network = ns; md.disk = ds; md.gpu = gs;
-        md.systemInfo = sysInfo.snapshot();
+        collector.waitNextTick();
+        if (!running) break;
+        if (traceToggle.exchange(false)) {
+            if (Tracer::enabled()) {
+                saveTrace(tracePath);
+            } else {
+                Tracer::start();
+                Logger::log("Tracing started");
+            }
+        }
+
+        if (recorder) recorder->markTick();
+        MetricData md = collector.collect();
+        const auto& cs = md.cpu;
+        const auto& ms = md.memory;
+        const auto& ns = md.network;
+        const auto& ds = md.disk;
+        const auto& gs = md.gpu;
 
         if (++tick % 10 == 0) db.insertSnapshot(md);
 
@@ -185,11 +396,61 @@ int main() {
             }
         }
 
+        // Self
+        hdr("MONITOR");
+        const auto& st = md.collector;
+        if (st.budgetPercent > 0.0f)
+            snprintf(buf, 128, "%.2f%% of one core (budget %.2f%%)",
+                     st.overheadPercent, st.budgetPercent);
+        else
+            snprintf(buf, 128, "%.2f%% of one core", st.overheadPercent);
+        row("Overhead", buf);
+        std::string degraded;
+        for (const auto& m : st.modules) {
+            if (!m.degraded) continue;
+            if (!degraded.empty()) degraded += ", ";
+            snprintf(buf, 128, "%s (%.0f ms)", m.name.c_str(), m.periodMs);
+            degraded += buf;
+        }
+        row("Slowed down", degraded.empty() ? "none" : degraded);
+        std::string stale;
+        for (const auto& m : st.modules) {
+            if (!m.stale) continue;
+            if (!stale.empty()) stale += ", ";
+            snprintf(buf, 128, "%s (%llu missed)", m.name.c_str(),
+                     static_cast<unsigned long long>(m.deadlineMisses));
+            stale += buf;
+        }
+        row("Stale (missed deadline)", stale.empty() ? "none" : stale);
+        std::string starting;
+        for (const auto& m : st.modules) {
+            if (m.ready) continue;
+            if (!starting.empty()) starting += ", ";
+            starting += m.name;
+        }
+        if (!starting.empty()) row("Starting", starting);
+
+        const auto& tk = st.ticks;
+        snprintf(buf, 128, "p50 %.2f ms  p99 %.2f ms  max %.2f ms",
+                 tk.jitterUs.percentile(0.50) / 1000.0,
+                 tk.jitterUs.percentile(0.99) / 1000.0,
+                 tk.jitterUs.max() / 1000.0);
+        row("Tick jitter", buf);
+        snprintf(buf, 128, "%llu ticks, %llu missed, %llu overruns (catch-up: %s)",
+                 static_cast<unsigned long long>(tk.ticks),
+                 static_cast<unsigned long long>(tk.missedTicks),
+                 static_cast<unsigned long long>(tk.overruns), tk.catchUp.c_str());
+        row("Schedule", buf);
+
         line();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
     std::cout << "\nMonitoring stopped.\n";
+    if (Tracer::enabled()) saveTrace(tracePath);
+    if (EventLog::enabled()) EventLog::close();
+    if (recorder)
+        Logger::log("Capture " + recordPath + ": " + std::to_string(recorder->ticks())
+                    + " ticks, " + std::to_string(recorder->bytesWritten()) + " bytes");
     db.exportToCSV();
     Logger::log("CLI terminated");
     return 0;
@@ -4,6 +4,7 @@
  */
 
 #include "alert_manager.h"
+#include "../../utils/event_log.h"
 
 #include <algorithm>
 #include <ctime>
@@ -90,6 +91,8 @@ void AlertManager::evaluate(const MetricData& data) {
 
             if (rule.sustainedCount >= rule.sustainSeconds && !rule.triggered) {
                 rule.triggered = true;
+                static const EventType kTriggered("alert {} triggered: value {}, threshold {}");
+                EventLog::emit(kTriggered, rule.name, value, rule.threshold);
 
                 std::string ts = currentTimestamp();
                 rule.lastTriggered = ts;
@@ -123,6 +126,10 @@ void AlertManager::evaluate(const MetricData& data) {
             }
         } else {
             // Condition no longer met -- reset.
+            if (rule.triggered) {
+                static const EventType kCleared("alert {} cleared: value {}");
+                EventLog::emit(kCleared, rule.name, value);
+            }
             rule.sustainedCount = 0;
             rule.triggered      = false;
         }
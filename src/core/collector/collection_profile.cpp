@@ -0,0 +1,103 @@
+/**
+ * @file collection_profile.cpp
+ * @brief Built-in collection profile definitions.
+ */
+
+#include "collection_profile.h"
+
+#include <algorithm>
+#include <cctype>
+
+using std::chrono::milliseconds;
+
+CollectionProfile makeProfile(ProfileKind kind) {
+    CollectionProfile p;
+    p.kind = kind;
+
+    auto set = [&](ModuleId id, bool on, int periodMs) {
+        p.schedule(id).enabled = on;
+        p.schedule(id).period  = milliseconds(periodMs);
+    };
+
+    switch (kind) {
+        case ProfileKind::Minimal:
+            // CPU, memory, network and disk totals only. No fd walks, no
+            // per-process enumeration, no GPU driver calls.
+            set(ModuleId::Cpu,        true,   2000);
+            set(ModuleId::Memory,     true,   2000);
+            set(ModuleId::Network,    true,   2000);
+            set(ModuleId::Disk,       true,  10000);
+            set(ModuleId::Gpu,        false,  2000);
+            set(ModuleId::Process,    false,  5000);
+            set(ModuleId::SystemInfo, true,  10000);
+            p.cpuSensorDetail    = false;
+            p.memoryTopProcesses = false;
+            p.networkConnections = false;
+            p.processDetails     = false;
+            p.cpuBudgetPercent   = 0.5f;
+            break;
+
+        case ProfileKind::Standard:
+            set(ModuleId::Cpu,        true, 1000);
+            set(ModuleId::Memory,     true, 1000);
+            set(ModuleId::Network,    true, 1000);
+            set(ModuleId::Disk,       true, 2000);
+            set(ModuleId::Gpu,        true, 2000);
+            set(ModuleId::Process,    true, 2000);
+            set(ModuleId::SystemInfo, true, 5000);
+            p.cpuBudgetPercent = 1.0f;
+            break;
+
+        case ProfileKind::Full:
+            for (auto& m : p.modules) { m.enabled = true; m.period = milliseconds(1000); }
+            p.cpuBudgetPercent = 2.0f;
+            break;
+
+        case ProfileKind::Diagnostics:
+            for (auto& m : p.modules) {
+                m.enabled  = true;
+                m.period   = milliseconds(500);
+                m.deadline = milliseconds(400);
+            }
+            p.schedule(ModuleId::SystemInfo).period = milliseconds(1000);
+            // Collect everything regardless of who is looking.
+            p.demandDriven = false;
+            break;
+    }
+    return p;
+}
+
+const char* profileName(ProfileKind kind) {
+    switch (kind) {
+        case ProfileKind::Minimal:     return "minimal";
+        case ProfileKind::Standard:    return "standard";
+        case ProfileKind::Full:        return "full";
+        case ProfileKind::Diagnostics: return "diagnostics";
+    }
+    return "standard";
+}
+
+bool profileFromName(const std::string& name, ProfileKind& out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto k : {ProfileKind::Minimal, ProfileKind::Standard,
+                   ProfileKind::Full, ProfileKind::Diagnostics}) {
+        if (lower == profileName(k)) { out = k; return true; }
+    }
+    return false;
+}
+
+const char* moduleName(ModuleId id) {
+    switch (id) {
+        case ModuleId::Cpu:        return "CPU";
+        case ModuleId::Memory:     return "Memory";
+        case ModuleId::Network:    return "Network";
+        case ModuleId::Disk:       return "Disk";
+        case ModuleId::Gpu:        return "GPU";
+        case ModuleId::Process:    return "Process";
+        case ModuleId::SystemInfo: return "SystemInfo";
+        case ModuleId::Count:      break;
+    }
+    return "?";
+}
@@ -0,0 +1,101 @@
+/**
+ * @file collection_profile.h
+ * @brief Named collection profiles: which modules and sub-collectors run, and how often.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/// @brief Monitoring modules driven by the Collector.
+enum class ModuleId {
+    Cpu = 0,
+    Memory,
+    Network,
+    Disk,
+    Gpu,
+    Process,
+    SystemInfo,
+    Count
+};
+
+/// Number of entries in ModuleId (excluding Count).
+constexpr std::size_t kModuleCount = static_cast<std::size_t>(ModuleId::Count);
+
+/// @brief Built-in profiles, from cheapest to most detailed.
+enum class ProfileKind {
+    Minimal = 0,  ///< Host vitals only, for small edge boxes.
+    Standard,     ///< Everything, with the expensive parts at a slower rate.
+    Full,         ///< Everything at 1 Hz (the historical behaviour).
+    Diagnostics   ///< Everything at 2 Hz, for short troubleshooting sessions.
+};
+
+/// @brief Whether a module runs, its sampling period and update deadline.
+struct ModuleSchedule {
+    bool                      enabled = true;
+    std::chrono::milliseconds period{1000};
+    /// How long a tick waits for this module's update() before moving on
+    /// with the previous (stale) snapshot.
+    std::chrono::milliseconds deadline{500};
+};
+
+/**
+ * @brief Full description of what the Collector samples.
+ *
+ * The sub-collector flags map onto the per-module setters
+ * (CPU::setSensorDetail, Memory::setTopProcessScan,
+ * Network::setConnectionTracking, ProcessManager::setDetailedInfo,
+ * ProcessManager::setIoUring).
+ */
+struct CollectionProfile {
+    ProfileKind kind = ProfileKind::Standard;
+    std::array<ModuleSchedule, kModuleCount> modules{};
+
+    bool cpuSensorDetail    = true;  ///< Per-core frequency and hwmon temperature.
+    bool memoryTopProcesses = true;  ///< Periodic scan for the largest processes.
+    bool networkConnections = true;  ///< TCP/UDP connection table with owning PIDs.
+    bool processDetails     = true;  ///< Command line, path, I/O and GPU per process.
+    /// Batch the per-process reads through io_uring. Fewer syscalls, but
+    /// the io-wq workers' CPU time is not counted against cpuBudgetPercent.
+    bool processIoUring     = false;
+
+    /// Skip the sub-collectors above (and the process list) while no
+    /// consumer is subscribed to them; see InterestRegistry.
+    bool demandDriven = true;
+
+    /// Collector CPU budget in percent of one core (0 = unlimited). While
+    /// the measured overhead exceeds it, the periods of the most expensive
+    /// modules are lengthened.
+    float cpuBudgetPercent = 0.0f;
+
+    ModuleSchedule&       schedule(ModuleId id)       { return modules[static_cast<std::size_t>(id)]; }
+    const ModuleSchedule& schedule(ModuleId id) const { return modules[static_cast<std::size_t>(id)]; }
+};
+
+/**
+ * @brief Build one of the built-in profiles.
+ * @param kind Which profile to build.
+ * @return Fully populated profile.
+ */
+CollectionProfile makeProfile(ProfileKind kind);
+
+/**
+ * @brief Lower-case name of a profile ("minimal", "standard", ...).
+ */
+const char* profileName(ProfileKind kind);
+
+/**
+ * @brief Parse a profile name (case-insensitive).
+ * @param name Name as typed on the command line.
+ * @param out  Receives the profile kind on success.
+ * @return true if @p name is a known profile.
+ */
+bool profileFromName(const std::string& name, ProfileKind& out);
+
+/**
+ * @brief Display name of a module ("CPU", "Memory", ...).
+ */
+const char* moduleName(ModuleId id);
@@ -0,0 +1,574 @@
+/**
+ * @file collector.cpp
+ * @brief Profile-driven module scheduling and self-overhead budget.
+ */
+
+#include "collector.h"
+#include "../../utils/cpu_time.h"
+#include "../../utils/event_log.h"
+#include "../../utils/logger.h"
+#include "../../utils/tracer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+/// Modules due within this margin of their period run on the current tick,
+/// so scheduling jitter does not push them a whole tick late.
+constexpr std::chrono::milliseconds kDueSlack{50};
+
+/// Smoothing factor for the overhead and per-module cost moving averages.
+constexpr float kOverheadAlpha = 0.3f;
+
+/// Upper bound on how far the budget may stretch a module's period.
+constexpr float kMaxPeriodScale = 16.0f;
+
+/// Minimum time between two budget adjustments, so the smoothed overhead
+/// can reflect the previous change before another module is touched.
+constexpr std::chrono::seconds kAdjustHoldOff{2};
+
+/// Events for a module that ran this recently are ignored; the change is
+/// picked up by its next regular update. Keeps a flapping link or a burst
+/// of mounts from turning into a burst of ticks.
+constexpr std::chrono::milliseconds kEventHoldOff{250};
+
+/// How long to wait for a worker whose module was just built to finish its init job.
+constexpr std::chrono::milliseconds kInitSettle{50};
+
+/// How long the destructor waits for a blocked update before abandoning it.
+constexpr std::chrono::milliseconds kShutdownGrace{500};
+
+} // namespace
+
+Collector::Modules Collector::platformModules(std::shared_ptr<const FileReader> files) {
+    Modules m;
+    m.cpu        = createCPU(files);
+    m.memory     = createMemory(files);
+    m.network    = createNetwork(files);
+    m.disk       = createDisk(files);
+    m.gpu        = createGPU(files);
+    m.process    = createProcessManager(files);
+    m.systemInfo = std::make_unique<SystemInfo>();
+    return m;
+}
+
+/// Modules under construction, shared with the init jobs.
+struct Collector::Pending {
+    Modules    modules;
+    std::array<std::atomic<bool>, kModuleCount> built{};  ///< Constructor has returned.
+    std::mutex mtx;                ///< Guards owner.
+    Collector* owner = nullptr;    ///< Woken as each module becomes ready; cleared on destruction.
+};
+
+Collector::Collector(ProfileKind kind, std::shared_ptr<const FileReader> files)
+    : loop_(createEventLoop()),
+      pending_(std::make_shared<Pending>()),
+      profile_(makeProfile(kind))
+{
+    scale_.fill(1.0f);
+    startWorkers(nullptr);
+    pending_->owner = this;
+
+    // Each constructor runs as its worker's first job and then wakes the
+    // collecting thread, so the module shows up on an immediate extra
+    // tick. The job owns a reference to pending_, so one that outlives
+    // the Collector (a hung driver) still has somewhere to put its result.
+    auto init = [this](ModuleId id, auto member, auto factory) {
+        auto pending = pending_;
+        auto i = static_cast<std::size_t>(id);
+        workers_[i]->submit([pending, member, factory, i] {
+            TraceSpan span("init", moduleName(static_cast<ModuleId>(i)));
+            try {
+                pending->modules.*member = factory();
+            } catch (const std::exception& e) {
+                Logger::error(std::string("Collector: ") + moduleName(static_cast<ModuleId>(i))
+                              + " failed to start: " + e.what());
+            } catch (...) {
+                // Still mark it built, or waitForModules() waits out its timeout.
+                Logger::error(std::string("Collector: ") + moduleName(static_cast<ModuleId>(i))
+                              + " failed to start: unknown exception");
+            }
+            pending->built[i].store(true, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(pending->mtx);
+            if (pending->owner) pending->owner->wake();
+        });
+    };
+    init(ModuleId::Cpu,        &Modules::cpu,        [files] { return createCPU(files); });
+    init(ModuleId::Memory,     &Modules::memory,     [files] { return createMemory(files); });
+    init(ModuleId::Network,    &Modules::network,    [files] { return createNetwork(files); });
+    init(ModuleId::Disk,       &Modules::disk,       [files] { return createDisk(files); });
+    init(ModuleId::Gpu,        &Modules::gpu,        [files] { return createGPU(files); });
+    init(ModuleId::Process,    &Modules::process,    [files] { return createProcessManager(files); });
+    init(ModuleId::SystemInfo, &Modules::systemInfo, [] { return std::make_unique<SystemInfo>(); });
+
+    interests_.setWakeCallback([this] { wake(); });
+}
+
+Collector::Collector(ProfileKind kind, Modules modules)
+    : loop_(createEventLoop()),
+      mods_(std::move(modules)),
+      profile_(makeProfile(kind))
+{
+    scale_.fill(1.0f);
+    startWorkers(&mods_);
+    for (auto& r : ready_) r.store(true);
+    process_.store(mods_.process.get());
+
+    watchModule(ModuleId::Memory);
+    watchModule(ModuleId::Network);
+    watchModule(ModuleId::Disk);
+
+    interests_.setWakeCallback([this] { wake(); });
+}
+
+/// One worker per module; with @p present, only for the modules it holds.
+void Collector::startWorkers(const Modules* present) {
+    auto start = [&](ModuleId id, bool has) {
+        if (!present || has)
+            workers_[static_cast<std::size_t>(id)] =
+                std::make_unique<ModuleWorker>(std::string("rm-") + moduleName(id));
+    };
+    start(ModuleId::Cpu,        present && present->cpu        != nullptr);
+    start(ModuleId::Memory,     present && present->memory     != nullptr);
+    start(ModuleId::Network,    present && present->network    != nullptr);
+    start(ModuleId::Disk,       present && present->disk       != nullptr);
+    start(ModuleId::Gpu,        present && present->gpu        != nullptr);
+    start(ModuleId::Process,    present && present->process    != nullptr);
+    start(ModuleId::SystemInfo, present && present->systemInfo != nullptr);
+}
+
+void Collector::watchModule(ModuleId id) {
+    auto watch = [this, id](auto* module) {
+        if (module) module->watchEvents(*loop_, [this, id] { onModuleEvent(id); });
+    };
+    switch (id) {
+        case ModuleId::Memory:  watch(mods_.memory.get());  break;
+        case ModuleId::Network: watch(mods_.network.get()); break;
+        case ModuleId::Disk:    watch(mods_.disk.get());    break;
+        default: break;
+    }
+}
+
+/**
+ * Take over every module whose constructor has returned since the last
+ * tick. The init job wakes us just before it returns, so give its worker
+ * a moment to go idle; its job count then includes the init job.
+ */
+void Collector::adoptReady() {
+    if (!pending_) return;
+    auto adopt = [&](ModuleId id, auto& dst, auto& src) {
+        auto i = static_cast<std::size_t>(id);
+        if (ready_[i].load(std::memory_order_relaxed)) return;
+        if (!pending_->built[i].load(std::memory_order_acquire)) return;
+        if (!workers_[i]->waitUntil(Clock::now() + kInitSettle)) return;
+        dst = std::move(src);
+        readyMs_[i] = std::chrono::duration<float, std::milli>(Clock::now() - start_).count();
+        if (dst) {
+            seenCompleted_[i] = initJobs_[i] = workers_[i]->completed();
+            initCpuSec_ += workers_[i]->lastCpuMs() / 1000.0;
+            workers_[i]->resetUsage();  // report update() only
+            watchModule(id);
+        } else {
+            workers_[i].reset();  // idle, so this joins at once; as if never present
+        }
+        ready_[i].store(true, std::memory_order_release);
+
+        char msg[96];
+        snprintf(msg, sizeof(msg), "Collector: %s ready after %.0f ms%s",
+                 moduleName(id), readyMs_[i], dst ? "" : " (unavailable)");
+        Logger::log(msg);
+    };
+    adopt(ModuleId::Cpu,        mods_.cpu,        pending_->modules.cpu);
+    adopt(ModuleId::Memory,     mods_.memory,     pending_->modules.memory);
+    adopt(ModuleId::Network,    mods_.network,    pending_->modules.network);
+    adopt(ModuleId::Disk,       mods_.disk,       pending_->modules.disk);
+    adopt(ModuleId::Gpu,        mods_.gpu,        pending_->modules.gpu);
+    adopt(ModuleId::Process,    mods_.process,    pending_->modules.process);
+    adopt(ModuleId::SystemInfo, mods_.systemInfo, pending_->modules.systemInfo);
+    process_.store(mods_.process.get(), std::memory_order_release);
+
+    bool all = true;
+    for (const auto& r : ready_) all = all && r.load(std::memory_order_relaxed);
+    if (all) pending_.reset();
+}
+
+bool Collector::waitForModules(std::chrono::steady_clock::duration timeout) {
+    auto deadline = Clock::now() + timeout;
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        if (ready(static_cast<ModuleId>(i)) || !workers_[i]) continue;
+        if (!workers_[i]->waitUntil(deadline)) return false;
+    }
+    return true;
+}
+
+Collector::~Collector() {
+    interests_.setWakeCallback(nullptr);
+    if (pending_) {
+        std::lock_guard<std::mutex> lock(pending_->mtx);
+        pending_->owner = nullptr;
+    }
+    published_.close();
+
+    // Ask every worker to stop first so the grace periods overlap.
+    bool abandoned[kModuleCount] = {};
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        if (workers_[i]) abandoned[i] = !workers_[i]->shutdown(kShutdownGrace);
+    }
+    auto leakIf = [&](ModuleId id, auto& module) {
+        if (abandoned[static_cast<std::size_t>(id)]) (void)module.release();
+    };
+    leakIf(ModuleId::Cpu,        mods_.cpu);
+    leakIf(ModuleId::Memory,     mods_.memory);
+    leakIf(ModuleId::Network,    mods_.network);
+    leakIf(ModuleId::Disk,       mods_.disk);
+    leakIf(ModuleId::Gpu,        mods_.gpu);
+    leakIf(ModuleId::Process,    mods_.process);
+    leakIf(ModuleId::SystemInfo, mods_.systemInfo);
+}
+
+void Collector::setProfile(const CollectionProfile& profile) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        profile_ = profile;
+        scale_.fill(1.0f);
+    }
+    wake();
+}
+
+void Collector::setBudgetPercent(float percent) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    profile_.cpuBudgetPercent = std::max(0.0f, percent);
+}
+
+void Collector::setStageStatsSource(StageStatsFn fn) {
+    std::lock_guard<std::mutex> lock(stageMtx_);
+    stageStats_ = std::move(fn);
+}
+
+void Collector::setCatchUpPolicy(CatchUpPolicy policy) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    catchUp_ = policy;
+}
+
+CatchUpPolicy Collector::catchUpPolicy() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return catchUp_;
+}
+
+void Collector::waitFor(Clock::duration timeout) {
+    waitUntil(Clock::now() + timeout);
+}
+
+void Collector::waitUntil(Clock::time_point deadline) {
+    loop_->runUntil(deadline);
+}
+
+/// Runs on the collecting thread, from inside waitUntil().
+void Collector::onModuleEvent(ModuleId id) {
+    auto i = static_cast<std::size_t>(id);
+    if (lastRun_[i] != Clock::time_point{} && Clock::now() - lastRun_[i] < kEventHoldOff)
+        return;
+    lastRun_[i] = Clock::time_point{};
+    ++events_[i];
+    loop_->wake();
+}
+
+void Collector::waitNextTick() {
+    ticks_.setPolicy(catchUpPolicy());
+    ticks_.setPeriod(tickInterval());
+    if (ticks_.beforeWait(Clock::now()))
+        waitUntil(ticks_.deadline());
+}
+
+void Collector::wake() {
+    loop_->wake();
+}
+
+CollectionProfile Collector::profile() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return profile_;
+}
+
+float Collector::overheadPercent() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return overheadPct_;
+}
+
+float Collector::periodScale(ModuleId id) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return scale_[static_cast<std::size_t>(id)];
+}
+
+std::chrono::milliseconds Collector::tickInterval() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    long long shortest = 0;
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        const auto& m = profile_.modules[i];
+        if (!m.enabled) continue;
+        auto ms = static_cast<long long>(static_cast<float>(m.period.count()) * scale_[i]);
+        if (shortest == 0 || ms < shortest) shortest = ms;
+    }
+    return std::chrono::milliseconds(shortest > 0 ? shortest : 1000);
+}
+
+CollectionProfile Collector::effectiveProfile(const CollectionProfile& p) const {
+    if (!p.demandDriven) return p;
+    CollectionProfile e = p;
+    auto want = [&](DataCategory c) { return interests_.wanted(c); };
+    e.cpuSensorDetail    = p.cpuSensorDetail    && want(DataCategory::CpuSensors);
+    e.memoryTopProcesses = p.memoryTopProcesses && want(DataCategory::TopProcesses);
+    e.networkConnections = p.networkConnections && want(DataCategory::Connections);
+    e.processDetails     = p.processDetails     && want(DataCategory::ProcessDetails);
+    auto& proc = e.schedule(ModuleId::Process);
+    proc.enabled = proc.enabled && (want(DataCategory::Processes) || e.processDetails);
+    return e;
+}
+
+void Collector::applySubCollectors(const CollectionProfile& p) {
+    if (mods_.cpu)     mods_.cpu->setSensorDetail(p.cpuSensorDetail);
+    if (mods_.memory)  mods_.memory->setTopProcessScan(p.memoryTopProcesses);
+    if (mods_.network) mods_.network->setConnectionTracking(p.networkConnections);
+    if (mods_.process) {
+        mods_.process->setDetailedInfo(p.processDetails);
+        mods_.process->setIoUring(p.processIoUring);
+    }
+}
+
+bool Collector::isDue(ModuleId id, const CollectionProfile& p, Clock::time_point now) const {
+    const auto& sched = p.schedule(id);
+    if (!sched.enabled) return false;
+    const auto& last = lastRun_[static_cast<std::size_t>(id)];
+    if (last == Clock::time_point{}) return true;
+    auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(sched.period.count() * periodScale(id)));
+    return now - last + kDueSlack >= period;
+}
+
+void Collector::updateOverhead(double cpuSec, Clock::time_point now) {
+    if (!hasTick_) {
+        hasTick_    = true;
+        lastTick_   = now;
+        lastCpuSec_ = cpuSec;
+        return;
+    }
+
+    double wallSec = std::chrono::duration<double>(now - lastTick_).count();
+    double usedSec = cpuSec - lastCpuSec_;
+    lastTick_   = now;
+    lastCpuSec_ = cpuSec;
+    if (wallSec <= 0.0) return;
+
+    float pct = static_cast<float>(std::max(0.0, usedSec) / wallSec * 100.0);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    overheadPct_ = kOverheadAlpha * pct + (1.0f - kOverheadAlpha) * overheadPct_;
+}
+
+/**
+ * Over budget: double the period of the enabled module with the highest
+ * CPU cost per second. Comfortably under budget: halve the period of the
+ * most stretched module. One change per hold-off interval.
+ */
+void Collector::adaptToBudget(const CollectionProfile& p, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const float budget = p.cpuBudgetPercent;
+    if (budget <= 0.0f) {
+        scale_.fill(1.0f);
+        return;
+    }
+    if (lastAdjust_ != Clock::time_point{} && now - lastAdjust_ < kAdjustHoldOff) return;
+
+    int target = -1;
+    if (overheadPct_ > budget) {
+        float worst = 0.0f;
+        for (std::size_t i = 0; i < kModuleCount; ++i) {
+            if (!p.modules[i].enabled || scale_[i] >= kMaxPeriodScale) continue;
+            float periodMs = static_cast<float>(p.modules[i].period.count()) * scale_[i];
+            float cost = periodMs > 0.0f ? cpuMsPerRun_[i] / periodMs : 0.0f;
+            if (cost > worst) { worst = cost; target = static_cast<int>(i); }
+        }
+        if (target >= 0) scale_[target] = std::min(scale_[target] * 2.0f, kMaxPeriodScale);
+    } else if (overheadPct_ < budget * 0.5f) {
+        float most = 1.0f;
+        for (std::size_t i = 0; i < kModuleCount; ++i) {
+            if (scale_[i] > most) { most = scale_[i]; target = static_cast<int>(i); }
+        }
+        if (target >= 0) scale_[target] = std::max(1.0f, scale_[target] / 2.0f);
+    }
+    if (target >= 0) lastAdjust_ = now;
+}
+
+CollectorStats Collector::buildStats(const CollectionProfile& p) {
+    CollectorStats s;
+    s.profile = profileName(p.kind);
+    s.modules.resize(kModuleCount);
+    {
+        std::lock_guard<std::mutex> lock(stageMtx_);
+        if (stageStats_) s.stages = stageStats_();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    s.overheadPercent = overheadPct_;
+    s.budgetPercent   = p.cpuBudgetPercent;
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        auto& m = s.modules[i];
+        m.name         = moduleName(static_cast<ModuleId>(i));
+        m.enabled      = p.modules[i].enabled;
+        m.basePeriodMs = static_cast<float>(p.modules[i].period.count());
+        m.periodMs     = m.basePeriodMs * scale_[i];
+        m.cpuMsPerRun  = cpuMsPerRun_[i];
+        m.cpuPercent   = m.enabled && m.periodMs > 0.0f
+                       ? m.cpuMsPerRun / m.periodMs * 100.0f : 0.0f;
+        m.degraded     = scale_[i] > 1.0f;
+        m.stale        = stale_[i];
+        m.deadlineMisses = misses_[i];
+        m.eventUpdates   = events_[i];
+        m.ready          = ready(static_cast<ModuleId>(i));
+        m.readyMs        = readyMs_[i];
+        if (m.ready && workers_[i]) {
+            m.updateUs   = workers_[i]->latency();
+            m.updates    = m.updateUs.count();
+            IoUsage io   = workers_[i]->io();
+            m.syscalls   = io.syscalls;
+            m.fileOpens  = io.fileOpens;
+            m.bytesRead  = io.bytesRead;
+        }
+    }
+    s.ticks = ticks_.stats();
+    s.firstCompleteMs = firstCompleteMs_;
+    return s;
+}
+
+MetricData Collector::collect() {
+    TraceSpan span("collector", "collect");
+    adoptReady();
+    CollectionProfile p = effectiveProfile(profile());
+    applySubCollectors(p);
+
+    // A category that just gained a subscriber is collected on this tick
+    // rather than when its module's period next comes round.
+    static constexpr ModuleId kOwner[kDataCategoryCount] = {
+        ModuleId::Cpu, ModuleId::Memory, ModuleId::Network,
+        ModuleId::Process, ModuleId::Process
+    };
+    for (std::size_t i = 0; i < kDataCategoryCount; ++i) {
+        bool wanted = interests_.wanted(static_cast<DataCategory>(i));
+        if (wanted && !lastWanted_[i])
+            lastRun_[static_cast<std::size_t>(kOwner[i])] = Clock::time_point{};
+        lastWanted_[i] = wanted;
+    }
+
+    // Everything the calling thread did since the last tick (including
+    // the consumer's own alerting and persistence) counts as overhead,
+    // together with the CPU time of the module workers.
+    auto now = Clock::now();
+    auto wallNow = std::chrono::system_clock::now();
+    ticks_.tick(now);
+    updateOverhead(threadCpuSeconds() + workerCpuSeconds(), now);
+    adaptToBudget(p, now);
+    dispatch(p, now);
+
+    auto on = [&](ModuleId id) { return p.schedule(id).enabled; };
+
+    MetricData md;
+    if (mods_.cpu     && on(ModuleId::Cpu))     md.cpu     = mods_.cpu->snapshot();
+    if (mods_.memory  && on(ModuleId::Memory))  md.memory  = mods_.memory->snapshot();
+    if (mods_.network && on(ModuleId::Network)) md.network = mods_.network->snapshot();
+    if (mods_.disk    && on(ModuleId::Disk))    md.disk    = mods_.disk->snapshot();
+    if (mods_.gpu     && on(ModuleId::Gpu))     md.gpu     = mods_.gpu->snapshot();
+    if (mods_.process && on(ModuleId::Process)) md.process = mods_.process->snapshot();
+    if (mods_.systemInfo && on(ModuleId::SystemInfo))
+        md.systemInfo = mods_.systemInfo->snapshot();
+    if (firstCompleteMs_ == 0.0f) {
+        bool complete = true;
+        for (std::size_t i = 0; i < kModuleCount; ++i) {
+            if (!ready(static_cast<ModuleId>(i))) complete = false;
+            else if (p.modules[i].enabled && workers_[i] && seenCompleted_[i] == initJobs_[i])
+                complete = false;  // running, but no update() has finished yet
+        }
+        if (complete)
+            firstCompleteMs_ = std::chrono::duration<float, std::milli>(Clock::now() - start_).count();
+    }
+    md.collector  = buildStats(p);
+    md.timestamp  = wallNow;
+    md.elapsedSec = std::chrono::duration<double>(now - start_).count();
+    md.version    = published_.version() + 1;  // collect() has a single caller
+    published_.publish(md);
+    return md;
+}
+
+/**
+ * Hand every due module to its worker, then wait for each one until its
+ * deadline. Modules only publish a snapshot at the end of update(), so a
+ * module that is still running simply leaves its previous one in place.
+ */
+void Collector::dispatch(const CollectionProfile& p, Clock::time_point now) {
+    std::array<bool, kModuleCount> pending{};
+
+    auto submit = [&](ModuleId id, auto* module) {
+        auto i = static_cast<std::size_t>(id);
+        if (!module || !workers_[i] || !isDue(id, p, now)) return;
+        lastRun_[i] = now;
+        if (workers_[i]->submit([module, id] {
+                TraceSpan span("update", moduleName(id));
+                module->update();
+            })) {
+            ++submitted_[i];
+            pending[i] = true;
+            if (updateObserver_) updateObserver_(id);
+        } else {
+            // The previous update is still blocked: another period
+            // passes without fresh data.
+            ++misses_[i];
+        }
+    };
+    submit(ModuleId::Cpu,        mods_.cpu.get());
+    submit(ModuleId::Memory,     mods_.memory.get());
+    submit(ModuleId::Network,    mods_.network.get());
+    submit(ModuleId::Disk,       mods_.disk.get());
+    submit(ModuleId::Gpu,        mods_.gpu.get());
+    submit(ModuleId::Process,    mods_.process.get());
+    submit(ModuleId::SystemInfo, mods_.systemInfo.get());
+
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        if (!pending[i]) continue;
+        if (!workers_[i]->waitUntil(now + p.modules[i].deadline)) ++misses_[i];
+    }
+
+    // Fold in every update that finished since the last tick, including
+    // late ones from earlier ticks.
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        if (!workers_[i]) continue;
+        uint64_t done = workers_[i]->completed();
+        if (done != seenCompleted_[i]) {
+            seenCompleted_[i] = done;
+            float ms = workers_[i]->lastCpuMs();
+            cpuMsPerRun_[i] = cpuMsPerRun_[i] == 0.0f
+                            ? ms : kOverheadAlpha * ms + (1.0f - kOverheadAlpha) * cpuMsPerRun_[i];
+        }
+
+        bool stale = done < submitted_[i];
+        if (stale != stale_[i]) {
+            static const EventType kStale("module {} stale: {} (deadline {} ms)");
+            EventLog::emit(kStale, moduleName(static_cast<ModuleId>(i)), stale,
+                           static_cast<int64_t>(p.modules[i].deadline.count()));
+        }
+        if (stale && !stale_[i]) {
+            Logger::warn(std::string("Collector: ") + moduleName(static_cast<ModuleId>(i))
+                        + " update missed its " + std::to_string(p.modules[i].deadline.count())
+                         + " ms deadline; keeping the previous snapshot");
+        } else if (!stale && stale_[i]) {
+            Logger::log(std::string("Collector: ") + moduleName(static_cast<ModuleId>(i))
+                        + " update completed again");
+        }
+        stale_[i] = stale;
+    }
+}
+
+double Collector::workerCpuSeconds() const {
+    double total = 0.0;
+    for (const auto& w : workers_)
+        if (w) total += w->totalCpuSeconds();
+    return total - initCpuSec_;  // start-up cost is not steady-state overhead
+}
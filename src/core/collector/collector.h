@@ -0,0 +1,321 @@
+/**
+ * @file collector.h
+ * @brief Owns the monitoring modules and samples them according to a CollectionProfile.
+ *
+ * The GUI and CLI both drive a Collector from their own loop: call
+ * collect() once per tickInterval() and consume the returned MetricData.
+ * Each module is only updated when its period has elapsed; in between,
+ * its last snapshot is reused. The profile can be swapped at any time
+ * from another thread and takes effect on the next tick.
+ *
+ * Under a demand-driven profile the expensive categories (see
+ * DataCategory) are only collected while a consumer holds a
+ * subscription in interests(); a new subscriber wakes waitFor().
+ *
+ * The collector accounts for its own CPU time, per module and in total.
+ * When the total exceeds the profile's budget, the period of the module
+ * costing the most CPU per second is doubled. When usage falls back
+ * under half the budget, the most stretched module is relaxed again.
+ * The figures are published in MetricData::collector.
+ *
+ * Every module updates on its own ModuleWorker thread. collect() waits
+ * for each dispatched update only until the module's deadline; a module
+ * that misses it keeps its previous snapshot, is reported as stale and
+ * has the miss counted, and the tick completes without it. While the
+ * stuck update is still running, the module is not dispatched again.
+ *
+ * Loops pace themselves with waitNextTick(), which sleeps until the next
+ * deadline on an absolute steady-clock timeline (see TickScheduler), so
+ * collection time does not accumulate into drift. Every MetricData
+ * carries its own wall-clock and monotonic timestamps.
+ *
+ * The wait happens inside an EventLoop. Modules register kernel change
+ * notifications with it (watchEvents()); when one fires, that module is
+ * updated on an immediate extra tick instead of at its next period.
+ *
+ * Constructing a Collector for the platform modules does not block:
+ * every module is constructed on its own worker thread, in parallel, and
+ * joins the collection on the first tick after its constructor returns.
+ * Until then it contributes an empty snapshot and is reported as not
+ * ready, so consumers can show a placeholder for it.
+ *
+ * Each collect() also publishes its MetricData, stamped with an
+ * increasing version, to snapshots(). Consumers on other threads read
+ * the latest sample from there without copying it, compare versions to
+ * skip work when nothing changed, or block in waitForVersion().
+ *
+ * MetricData::collector also carries the collector's self-instrumentation:
+ * per module, a histogram of update() wall times and the syscalls, file
+ * opens and bytes read those updates cost; and, when a Pipeline drives
+ * the collector, the counters of every pipeline stage.
+ */
+
+#pragma once
+
+#include "collection_profile.h"
+#include "interest_registry.h"
+#include "module_worker.h"
+#include "snapshot_channel.h"
+#include "tick_scheduler.h"
+#include "../metrics.h"
+#include "../events/event_loop.h"
+#include "../cpu/cpu_common.h"
+#include "../memory/memory_common.h"
+#include "../network/network_common.h"
+#include "../disk/disk_common.h"
+#include "../gpu/gpu_common.h"
+#include "../process/process_common.h"
+#include "../system_info/system_info.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class Collector
+ * @brief Profile-driven scheduler over the platform monitoring modules.
+ */
+class Collector {
+public:
+    /// @brief The monitoring modules a Collector drives. Null entries are skipped.
+    struct Modules {
+        std::unique_ptr<CPU>            cpu;
+        std::unique_ptr<Memory>         memory;
+        std::unique_ptr<Network>        network;
+        std::unique_ptr<Disk>           disk;
+        std::unique_ptr<GPU>            gpu;
+        std::unique_ptr<ProcessManager> process;
+        std::unique_ptr<SystemInfo>     systemInfo;
+    };
+
+    /**
+     * @brief One instance of every platform module, from the createX() factories.
+     * @param files Where the modules read /proc and /sys: a synthetic tree, a recorder, a replay.
+     */
+    static Modules platformModules(std::shared_ptr<const FileReader> files = hostFileReader());
+
+    /**
+     * @brief Start creating every platform module and apply @p kind.
+     *
+     * Returns immediately; the module constructors (NVML loading, the
+     * first disk and process scans, ...) run concurrently on the module
+     * workers. See ready() and waitForModules().
+     *
+     * @param kind  Initial profile.
+     * @param files Where the modules read /proc and /sys (see FileReader).
+     */
+    explicit Collector(ProfileKind kind = ProfileKind::Standard,
+                       std::shared_ptr<const FileReader> files = hostFileReader());
+
+    /**
+     * @brief Drive caller-supplied modules (tests, replay). They are ready at once.
+     * @param kind    Initial profile.
+     * @param modules Modules to own.
+     */
+    Collector(ProfileKind kind, Modules modules);
+
+    /**
+     * @brief Stop the worker threads.
+     *
+     * A module whose update is still blocked after a short grace period is
+     * deliberately leaked together with its detached worker, so that a
+     * hung syscall cannot prevent the process from exiting.
+     */
+    ~Collector();
+
+    Collector(const Collector&) = delete;
+    Collector& operator=(const Collector&) = delete;
+
+    /**
+     * @brief Replace the active profile. Thread-safe.
+     * @param profile New profile; applied at the start of the next collect().
+     */
+    void setProfile(const CollectionProfile& profile);
+
+    /// @brief Convenience overload for the built-in profiles.
+    void setProfile(ProfileKind kind) { setProfile(makeProfile(kind)); }
+
+    /// @brief Copy of the active profile.
+    CollectionProfile profile() const;
+
+    /**
+     * @brief Override the active profile's CPU budget.
+     * @param percent Budget in percent of one core (0 = unlimited).
+     */
+    void setBudgetPercent(float percent);
+
+    /**
+     * @brief Run one tick.
+     *
+     * Updates every enabled module whose (stretched) period has elapsed,
+     * then assembles a MetricData from the latest module snapshots and
+     * publishes it to snapshots(). Disabled modules contribute empty
+     * snapshots.
+     *
+     * @return Snapshot of all modules plus collector statistics.
+     */
+    MetricData collect();
+
+    /// @brief Every sample collect() produced, latest first. Thread-safe.
+    const SnapshotChannel<MetricData>& snapshots() const { return published_; }
+
+    /// @brief Version of the latest published sample (0 before the first). Lock-free.
+    uint64_t version() const { return published_.version(); }
+
+    /**
+     * @brief Block until a sample newer than @p seen is published.
+     * @return The latest version; equal to @p seen on timeout or shutdown.
+     */
+    uint64_t waitForVersion(uint64_t seen, std::chrono::steady_clock::duration timeout) const {
+        return published_.waitForVersion(seen, timeout);
+    }
+
+    /**
+     * @brief How long the caller should wait between collect() calls.
+     * @return Shortest effective period among the enabled modules.
+     */
+    std::chrono::milliseconds tickInterval() const;
+
+    /**
+     * @brief Measured CPU time of the collecting thread, in percent of one core.
+     *
+     * Smoothed over recent ticks; 0 until two ticks have run.
+     */
+    float overheadPercent() const;
+
+    /**
+     * @brief Factor currently applied to a module's period (>= 1).
+     * @param id Module.
+     */
+    float periodScale(ModuleId id) const;
+
+    /// @brief Process manager, for kill / reprioritise actions. Null until ready. Thread-safe.
+    ProcessManager* processManager() { return process_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Whether a module has finished construction and joined collection. Thread-safe.
+     *
+     * An absent module counts as ready. A module whose constructor has
+     * returned becomes ready at the start of the next collect().
+     */
+    bool ready(ModuleId id) const {
+        return ready_[static_cast<std::size_t>(id)].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Block until every module constructor has returned, or @p timeout passes.
+     * @return true if all have; the next collect() then picks them up.
+     *
+     * Call from the thread that calls collect().
+     */
+    bool waitForModules(std::chrono::steady_clock::duration timeout);
+
+    /// @brief Source of the pipeline stage counters reported in CollectorStats::stages.
+    using StageStatsFn = std::function<std::vector<PipelineStageStats>()>;
+
+    /**
+     * @brief Report pipeline stage counters with every sample. Thread-safe.
+     * @param fn Called from collect(); null to stop reporting.
+     */
+    void setStageStatsSource(StageStatsFn fn);
+
+    /// @brief Called by collect() with each module whose update() it hands to a worker.
+    using UpdateObserver = std::function<void(ModuleId)>;
+
+    /**
+     * @brief Report which modules each tick updates (the CLI notes them in a capture).
+     * @param fn Called from collect(); null to stop. Set it from the thread that calls collect().
+     */
+    void setUpdateObserver(UpdateObserver fn) { updateObserver_ = std::move(fn); }
+
+    /// @brief Registry consumers subscribe to for demand-driven data.
+    InterestRegistry& interests() { return interests_; }
+
+    /**
+     * @brief Sleep until the next scheduled tick, or until wake() is called.
+     *
+     * The period follows tickInterval(). If the previous tick's work ran
+     * past the deadline this returns immediately and the overrun is
+     * recorded; ticks that were missed entirely are handled according to
+     * the catch-up policy. Call from the thread that calls collect().
+     */
+    void waitNextTick();
+
+    /// @brief How missed ticks are handled. Thread-safe.
+    void setCatchUpPolicy(CatchUpPolicy policy);
+    CatchUpPolicy catchUpPolicy() const;
+
+    /**
+     * @brief Sleep until @p timeout elapses or wake() is called.
+     *
+     * Collection loops use this instead of sleep_for so that a new
+     * subscriber, a profile change or shutdown is handled immediately.
+     */
+    void waitFor(std::chrono::steady_clock::duration timeout);
+
+    /// @brief Interrupt a pending waitFor() or waitNextTick().
+    void wake();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    CollectionProfile effectiveProfile(const CollectionProfile& p) const;
+    void applySubCollectors(const CollectionProfile& p);
+    bool isDue(ModuleId id, const CollectionProfile& p, Clock::time_point now) const;
+    void updateOverhead(double cpuSec, Clock::time_point now);
+    void dispatch(const CollectionProfile& p, Clock::time_point now);
+    void waitUntil(Clock::time_point deadline);
+    void onModuleEvent(ModuleId id);
+    void startWorkers(const Modules* present);
+    void watchModule(ModuleId id);
+    void adoptReady();
+    double workerCpuSeconds() const;
+    void adaptToBudget(const CollectionProfile& p, Clock::time_point now);
+    CollectorStats buildStats(const CollectionProfile& p);
+
+    std::unique_ptr<EventLoop> loop_;     ///< Declared first: modules unregister on destruction.
+    Modules          mods_;               ///< Ready modules; only touched by the collecting thread.
+    struct Pending;
+    std::shared_ptr<Pending> pending_;    ///< Filled by the init jobs; shared so an abandoned one can finish.
+    std::atomic<ProcessManager*> process_{nullptr};
+    std::array<std::atomic<bool>, kModuleCount> ready_{};
+    InterestRegistry interests_;
+    SnapshotChannel<MetricData> published_;
+    std::array<std::unique_ptr<ModuleWorker>, kModuleCount> workers_; ///< Null for absent modules.
+
+    mutable std::mutex mtx_;              ///< Guards the fields below.
+    CollectionProfile  profile_;          ///< Active profile.
+    float              overheadPct_ = 0.0f; ///< Smoothed self CPU %.
+    std::array<float, kModuleCount> scale_; ///< Budget back-off factor per module.
+    CatchUpPolicy      catchUp_ = CatchUpPolicy::Skip;
+
+    std::mutex         stageMtx_;         ///< Guards stageStats_; separate so the source may be slow.
+    StageStatsFn       stageStats_;
+
+    const Clock::time_point start_ = Clock::now(); ///< Origin of MetricData::elapsedSec.
+
+    // Only touched by the collecting thread.
+    TickScheduler ticks_;                 ///< Absolute tick timeline.
+    std::array<Clock::time_point, kModuleCount> lastRun_{}; ///< Last update() per module.
+    std::array<float, kModuleCount> cpuMsPerRun_{};         ///< Smoothed update() CPU cost.
+    std::array<uint64_t, kModuleCount> submitted_{};        ///< Jobs handed to each worker.
+    std::array<uint64_t, kModuleCount> seenCompleted_{};    ///< Worker completions already accounted.
+    std::array<uint64_t, kModuleCount> misses_{};           ///< Deadline misses per module.
+    std::array<bool, kModuleCount>     stale_{};            ///< Snapshot predates the last dispatch.
+    UpdateObserver                     updateObserver_;     ///< See setUpdateObserver().
+    std::array<uint64_t, kModuleCount> events_{};           ///< Updates triggered by watchEvents().
+    std::array<uint64_t, kModuleCount> initJobs_{};         ///< Worker jobs that were construction, not update().
+    std::array<float, kModuleCount>    readyMs_{};          ///< Construction-to-ready time per module.
+    double            initCpuSec_ = 0.0;  ///< Worker CPU spent in module constructors.
+    float             firstCompleteMs_ = 0.0f; ///< When every enabled module first had data.
+    Clock::time_point lastTick_{};        ///< Wall time of the previous collect().
+    Clock::time_point lastAdjust_{};      ///< When a period was last changed for budget.
+    double            lastCpuSec_ = 0.0;  ///< Thread CPU time at the previous collect().
+    bool              hasTick_    = false;
+    std::array<bool, kDataCategoryCount> lastWanted_{}; ///< Interest seen by the previous tick.
+};
@@ -0,0 +1,72 @@
+/**
+ * @file interest_registry.cpp
+ * @brief Subscriber bookkeeping for demand-driven collection.
+ */
+
+#include "interest_registry.h"
+
+bool categoryForMetric(AlertMetric metric, DataCategory& out) {
+    switch (metric) {
+        case AlertMetric::CpuTemp:
+            out = DataCategory::CpuSensors;
+            return true;
+        default:
+            return false;
+    }
+}
+
+InterestRegistry::Subscription&
+InterestRegistry::Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        registry_ = other.registry_;
+        category_ = other.category_;
+        other.registry_ = nullptr;
+    }
+    return *this;
+}
+
+void InterestRegistry::Subscription::reset() {
+    if (registry_) {
+        registry_->release(category_);
+        registry_ = nullptr;
+    }
+}
+
+InterestRegistry::Subscription InterestRegistry::subscribe(DataCategory category) {
+    int before = counts_[static_cast<std::size_t>(category)].fetch_add(1);
+    if (before == 0) {
+        std::function<void()> cb;
+        {
+            std::lock_guard<std::mutex> lock(cbMtx_);
+            cb = wake_;
+        }
+        if (cb) cb();
+    }
+    return Subscription(this, category);
+}
+
+void InterestRegistry::hold(Subscription& sub, DataCategory category, bool want) {
+    if (want && !sub.active()) {
+        sub = subscribe(category);
+    } else if (!want && sub.active()) {
+        sub.reset();
+    }
+}
+
+bool InterestRegistry::wanted(DataCategory category) const {
+    return subscribers(category) > 0;
+}
+
+int InterestRegistry::subscribers(DataCategory category) const {
+    return counts_[static_cast<std::size_t>(category)].load();
+}
+
+void InterestRegistry::setWakeCallback(std::function<void()> cb) {
+    std::lock_guard<std::mutex> lock(cbMtx_);
+    wake_ = std::move(cb);
+}
+
+void InterestRegistry::release(DataCategory category) {
+    counts_[static_cast<std::size_t>(category)].fetch_sub(1);
+}
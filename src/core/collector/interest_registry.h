@@ -0,0 +1,117 @@
+/**
+ * @file interest_registry.h
+ * @brief Consumer subscriptions to the expensive data categories.
+ *
+ * GUI tabs, the database writer, alert rules and exporters hold a
+ * Subscription for each category they read. The Collector only performs
+ * the work behind a category while it has at least one subscriber, and
+ * is woken as soon as a new subscriber appears so the data shows up on
+ * the very next tick instead of after a full period.
+ */
+
+#pragma once
+
+#include "../metrics.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+/// @brief Data whose collection is skipped when nobody is subscribed.
+enum class DataCategory {
+    CpuSensors = 0,  ///< Per-core frequency and CPU temperature.
+    TopProcesses,    ///< Memory module's largest-process scan.
+    Connections,     ///< TCP/UDP connection table with owning PIDs.
+    Processes,       ///< The process list (whole ProcessManager module).
+    ProcessDetails,  ///< Command line, path, I/O and GPU per process.
+    Count
+};
+
+/// Number of entries in DataCategory (excluding Count).
+constexpr std::size_t kDataCategoryCount = static_cast<std::size_t>(DataCategory::Count);
+
+/**
+ * @brief Category an alert metric depends on, if any.
+ * @param metric Alert metric.
+ * @param out    Receives the category.
+ * @return false if the metric is always collected.
+ */
+bool categoryForMetric(AlertMetric metric, DataCategory& out);
+
+/**
+ * @class InterestRegistry
+ * @brief Thread-safe subscriber counts per DataCategory.
+ *
+ * Subscriptions must not outlive the registry that issued them.
+ */
+class InterestRegistry {
+public:
+    /**
+     * @class Subscription
+     * @brief Move-only RAII handle; the interest is dropped on destruction.
+     */
+    class Subscription {
+    public:
+        Subscription() = default;
+        ~Subscription() { reset(); }
+
+        Subscription(Subscription&& other) noexcept { *this = std::move(other); }
+        Subscription& operator=(Subscription&& other) noexcept;
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        /// @brief Drop the interest now (idempotent).
+        void reset();
+
+        /// @brief True while this handle holds an interest.
+        bool active() const { return registry_ != nullptr; }
+
+    private:
+        friend class InterestRegistry;
+        Subscription(InterestRegistry* r, DataCategory c) : registry_(r), category_(c) {}
+
+        InterestRegistry* registry_ = nullptr;
+        DataCategory      category_ = DataCategory::CpuSensors;
+    };
+
+    InterestRegistry() = default;
+    InterestRegistry(const InterestRegistry&) = delete;
+    InterestRegistry& operator=(const InterestRegistry&) = delete;
+
+    /**
+     * @brief Register interest in a category.
+     * @param category Data the caller is going to read.
+     * @return Handle that keeps the interest alive.
+     */
+    Subscription subscribe(DataCategory category);
+
+    /**
+     * @brief Hold or drop an interest depending on @p want.
+     *
+     * Convenience for per-frame callers such as GUI tabs: subscribes
+     * into @p sub if it is empty and @p want is true, resets it if
+     * @p want is false, and otherwise does nothing.
+     */
+    void hold(Subscription& sub, DataCategory category, bool want);
+
+    /// @brief True if at least one subscriber wants @p category.
+    bool wanted(DataCategory category) const;
+
+    /// @brief Current number of subscribers to @p category.
+    int subscribers(DataCategory category) const;
+
+    /**
+     * @brief Callback run (outside any lock) when a category gains its first subscriber.
+     * @param cb Callback; replaces any previous one.
+     */
+    void setWakeCallback(std::function<void()> cb);
+
+private:
+    void release(DataCategory category);
+
+    std::array<std::atomic<int>, kDataCategoryCount> counts_{};
+    mutable std::mutex cbMtx_;            ///< Guards wake_.
+    std::function<void()> wake_;          ///< Notified on 0 -> 1 transitions.
+};
@@ -0,0 +1,157 @@
+/**
+ * @file module_worker.cpp
+ * @brief Per-module update thread with deadline-bounded waits.
+ */
+
+#include "module_worker.h"
+#include "../../utils/cpu_time.h"
+#include "../../utils/event_log.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+struct ModuleWorker::State {
+    std::mutex              mtx;
+    std::condition_variable jobCv;    ///< Signalled when a job is queued or on stop.
+    std::condition_variable idleCv;   ///< Signalled when a job completes.
+    std::function<void()>   job;
+    bool                    busy = false;
+    bool                    stop = false;
+    uint64_t                completed = 0;
+    float                   lastCpuMs = 0.0f;
+    double                  totalCpuSec = 0.0;
+    Histogram               latencyUs;
+    IoUsage                 io;
+    Label                   name;
+};
+
+namespace {
+const EventType kModuleUpdate("{} update took {} us, {} us CPU, {} syscalls, {} bytes read");
+}
+
+ModuleWorker::ModuleWorker(const std::string& name)
+    : state_(std::make_shared<State>())
+{
+    state_->name = name;
+    thread_ = std::thread(&ModuleWorker::run, state_);
+#ifdef __linux__
+    pthread_setname_np(thread_.native_handle(), name.substr(0, 15).c_str());
+#else
+    (void)name;
+#endif
+}
+
+ModuleWorker::~ModuleWorker() {
+    shutdown(std::chrono::seconds(1));
+}
+
+void ModuleWorker::run(std::shared_ptr<State> s) {
+    std::unique_lock<std::mutex> lock(s->mtx);
+    for (;;) {
+        s->jobCv.wait(lock, [&] { return s->stop || s->job; });
+        if (!s->job) return;  // stop requested while idle
+
+        auto job = std::move(s->job);
+        s->job = nullptr;
+        lock.unlock();
+
+        IoUsage ioBefore = threadIoUsage();
+        double  before   = threadCpuSeconds();
+        auto    t0       = Clock::now();
+        job();
+        auto    t1       = Clock::now();
+        double  used     = threadCpuSeconds() - before;
+        IoUsage io       = threadIoUsage() - ioBefore;
+        uint64_t us      = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+        EventLog::emit(kModuleUpdate, s->name, us, static_cast<uint64_t>(used * 1.0e6),
+                       io.syscalls, io.bytesRead);
+
+        lock.lock();
+        s->busy        = false;
+        s->lastCpuMs   = static_cast<float>(used * 1000.0);
+        s->totalCpuSec += used;
+        s->latencyUs.record(us);
+        s->io += io;
+        ++s->completed;
+        s->idleCv.notify_all();
+        if (s->stop) return;
+    }
+}
+
+bool ModuleWorker::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        if (state_->busy || state_->stop) return false;
+        state_->busy = true;
+        state_->job  = std::move(job);
+    }
+    state_->jobCv.notify_one();
+    return true;
+}
+
+bool ModuleWorker::waitUntil(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(state_->mtx);
+    return state_->idleCv.wait_until(lock, deadline, [&] { return !state_->busy; });
+}
+
+bool ModuleWorker::busy() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->busy;
+}
+
+uint64_t ModuleWorker::completed() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->completed;
+}
+
+float ModuleWorker::lastCpuMs() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->lastCpuMs;
+}
+
+double ModuleWorker::totalCpuSeconds() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->totalCpuSec;
+}
+
+Histogram ModuleWorker::latency() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->latencyUs;
+}
+
+IoUsage ModuleWorker::io() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->io;
+}
+
+void ModuleWorker::resetUsage() {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    state_->latencyUs.reset();
+    state_->io = IoUsage{};
+}
+
+bool ModuleWorker::shutdown(Clock::duration grace) {
+    if (!thread_.joinable()) return true;
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        state_->stop = true;
+        // A job queued but not yet started is simply dropped.
+        if (state_->job) {
+            state_->job  = nullptr;
+            state_->busy = false;
+        }
+    }
+    state_->jobCv.notify_one();
+
+    if (waitUntil(Clock::now() + grace)) {
+        thread_.join();
+        return true;
+    }
+    thread_.detach();
+    return false;
+}
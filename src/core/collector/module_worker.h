@@ -0,0 +1,101 @@
+/**
+ * @file module_worker.h
+ * @brief Dedicated thread that runs one module's update() under a deadline.
+ *
+ * The Collector gives every module its own worker so that a read that
+ * blocks in the kernel (statvfs on a dead NFS mount, a hung GPU driver,
+ * /proc of a process stuck in exit) only stalls that module. The
+ * collecting thread submits a job, waits until the module's deadline and
+ * moves on; the job keeps running and its result is picked up on a later
+ * tick.
+ *
+ * Every job is timed on the steady clock into a Histogram, and the I/O
+ * it did on the worker thread (see threadIoUsage()) is added up, so the
+ * cost of a module's update() can be reported per module.
+ */
+
+#pragma once
+
+#include "../../utils/histogram.h"
+#include "../../utils/io_counters.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * @class ModuleWorker
+ * @brief One background thread executing at most one job at a time.
+ */
+class ModuleWorker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Start the worker thread.
+     * @param name Thread name (shown in top / debuggers, truncated to 15 chars).
+     */
+    explicit ModuleWorker(const std::string& name);
+
+    /// @brief Equivalent to shutdown() with a one-second grace period.
+    ~ModuleWorker();
+
+    ModuleWorker(const ModuleWorker&) = delete;
+    ModuleWorker& operator=(const ModuleWorker&) = delete;
+
+    /**
+     * @brief Hand a job to the worker.
+     * @param job Work to run on the worker thread.
+     * @return false (and @p job is dropped) if the previous job is still running.
+     */
+    bool submit(std::function<void()> job);
+
+    /**
+     * @brief Block until the current job finishes or @p deadline passes.
+     * @return true if the worker is idle.
+     */
+    bool waitUntil(Clock::time_point deadline);
+
+    /// @brief Whether a job is queued or running.
+    bool busy() const;
+
+    /// @brief Number of jobs that have run to completion.
+    uint64_t completed() const;
+
+    /// @brief CPU time of the most recently completed job, in milliseconds.
+    float lastCpuMs() const;
+
+    /// @brief CPU time of all completed jobs, in seconds.
+    double totalCpuSeconds() const;
+
+    /// @brief Wall time of the jobs completed since the last resetUsage(), in microseconds.
+    Histogram latency() const;
+
+    /// @brief I/O done by the jobs completed since the last resetUsage().
+    IoUsage io() const;
+
+    /// @brief Clear latency() and io(), e.g. to leave out a one-off setup job.
+    void resetUsage();
+
+    /**
+     * @brief Stop the thread.
+     *
+     * Waits up to @p grace for a running job. A job that is still stuck
+     * after that is abandoned: the thread is detached and finishes (or
+     * not) on its own, so anything the job references must outlive it.
+     *
+     * @return true if the thread was joined, false if it was detached.
+     */
+    bool shutdown(Clock::duration grace);
+
+private:
+    struct State;
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;   ///< Shared with the thread, which may outlive us.
+    std::thread            thread_;
+};
@@ -0,0 +1,78 @@
+/**
+ * @file snapshot_channel.h
+ * @brief Latest-value channel with a version counter and change notification.
+ *
+ * The producer publish()es a new value each tick; every publish bumps a
+ * monotonically increasing version. Consumers keep the last version they
+ * saw and either check version() (one atomic load) before taking the
+ * value, or block in waitForVersion() until something newer arrives.
+ * Values are shared immutably, so reading the latest one never copies it.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+template <typename T>
+class SnapshotChannel {
+public:
+    /**
+     * @brief Replace the latest value and wake every waiter.
+     * @return The new value's version (1 for the first publish).
+     */
+    uint64_t publish(T value) {
+        auto next = std::make_shared<const T>(std::move(value));
+        uint64_t v;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            latest_.swap(next);
+            v = version_.load(std::memory_order_relaxed) + 1;
+            version_.store(v, std::memory_order_release);
+        }
+        cv_.notify_all();
+        return v;  // the previous value is released outside the lock
+    }
+
+    /// @brief Version of the latest value; 0 until the first publish. Lock-free.
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief The latest value, or null before the first publish.
+     * @param version If set, receives the version of the returned value.
+     */
+    std::shared_ptr<const T> latest(uint64_t* version = nullptr) const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (version) *version = version_.load(std::memory_order_relaxed);
+        return latest_;
+    }
+
+    /**
+     * @brief Block until the version exceeds @p seen, the timeout passes or close() is called.
+     * @return The current version; equal to @p seen on timeout.
+     */
+    uint64_t waitForVersion(uint64_t seen, std::chrono::steady_clock::duration timeout) const {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait_for(lk, timeout, [&] {
+            return closed_ || version_.load(std::memory_order_relaxed) > seen;
+        });
+        return version_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Release every current and future waitForVersion() (shutdown).
+    void close() {
+        { std::lock_guard<std::mutex> lk(mtx_); closed_ = true; }
+        cv_.notify_all();
+    }
+
+private:
+    mutable std::mutex              mtx_;
+    mutable std::condition_variable cv_;
+    std::shared_ptr<const T>        latest_;
+    std::atomic<uint64_t>           version_{0};
+    bool                            closed_ = false;
+};
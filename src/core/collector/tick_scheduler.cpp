@@ -0,0 +1,119 @@
+/**
+ * @file tick_scheduler.cpp
+ * @brief Drift-free tick timeline and catch-up policies.
+ */
+
+#include "tick_scheduler.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+uint64_t toMicros(std::chrono::steady_clock::duration d) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+} // namespace
+
+const char* catchUpName(CatchUpPolicy policy) {
+    switch (policy) {
+        case CatchUpPolicy::Skip:     return "skip";
+        case CatchUpPolicy::Burst:    return "burst";
+        case CatchUpPolicy::Reanchor: return "reanchor";
+    }
+    return "skip";
+}
+
+bool catchUpFromName(const std::string& name, CatchUpPolicy& out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto p : {CatchUpPolicy::Skip, CatchUpPolicy::Burst, CatchUpPolicy::Reanchor}) {
+        if (lower == catchUpName(p)) { out = p; return true; }
+    }
+    return false;
+}
+
+TickScheduler::TickScheduler(Clock::duration period, CatchUpPolicy policy)
+    : period_(period > Clock::duration::zero() ? period : std::chrono::seconds(1)),
+      policy_(policy)
+{
+    stats_.periodMs = std::chrono::duration<float, std::milli>(period_).count();
+}
+
+void TickScheduler::setPeriod(Clock::duration period) {
+    if (period <= Clock::duration::zero() || period == period_) return;
+    period_ = period;
+    stats_.periodMs = std::chrono::duration<float, std::milli>(period_).count();
+    if (scheduled_ != Clock::time_point{}) next_ = scheduled_ + period_;
+}
+
+bool TickScheduler::beforeWait(Clock::time_point now) {
+    if (bursting_) {
+        // Catching up on purpose: not an overrun.
+        skippedWait_ = true;
+        return false;
+    }
+    if (next_ == Clock::time_point{} || now < next_) {
+        skippedWait_ = false;
+        return true;
+    }
+    skippedWait_ = true;
+    ++stats_.overruns;
+    stats_.overrunUs.record(toMicros(now - next_));
+    return false;
+}
+
+void TickScheduler::tick(Clock::time_point now) {
+    stats_.catchUp = catchUpName(policy_);
+
+    if (next_ == Clock::time_point{}) {
+        // First tick anchors the grid.
+        scheduled_ = now;
+        next_      = now + period_;
+        ++stats_.ticks;
+        return;
+    }
+    if (now < next_) {
+        ++stats_.earlyTicks;
+        return;
+    }
+
+    auto late = now - next_;
+    if (!skippedWait_) stats_.jitterUs.record(toMicros(late));
+    skippedWait_ = false;
+    bursting_    = false;
+    ++stats_.ticks;
+
+    // Deadlines that have passed in addition to the one being served.
+    auto behind = static_cast<uint64_t>(late / period_);
+    scheduled_ = next_;
+
+    switch (policy_) {
+        case CatchUpPolicy::Skip:
+            stats_.missedTicks += behind;
+            scheduled_ += period_ * static_cast<long long>(behind);
+            next_ = scheduled_ + period_;
+            break;
+
+        case CatchUpPolicy::Burst: {
+            // Serve the missed deadlines one by one, dropping any beyond
+            // kMaxBurst so a long stall does not turn into a long burst.
+            auto dropped = behind > static_cast<uint64_t>(kMaxBurst)
+                         ? behind - static_cast<uint64_t>(kMaxBurst) : 0;
+            stats_.missedTicks += dropped;
+            scheduled_ += period_ * static_cast<long long>(dropped);
+            next_ = scheduled_ + period_;
+            bursting_ = next_ <= now;
+            break;
+        }
+
+        case CatchUpPolicy::Reanchor:
+            stats_.missedTicks += behind;
+            scheduled_ = now;
+            next_      = now + period_;
+            break;
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file tick_scheduler.h
+ * @brief Absolute-deadline tick timeline with missed-tick detection.
+ *
+ * Ticks are scheduled at anchor + n * period on the steady clock, so the
+ * time spent collecting never accumulates into drift. When the loop falls
+ * a whole period or more behind (a stalled tick, a suspended machine),
+ * the CatchUpPolicy decides what happens to the ticks that were missed.
+ *
+ * Not thread-safe; owned by the Collector and driven from the collecting
+ * thread only.
+ */
+
+#pragma once
+
+#include "../metrics.h"
+
+#include <chrono>
+#include <string>
+
+/// @brief What to do with scheduled ticks that have already passed.
+enum class CatchUpPolicy {
+    Skip = 0,   ///< Drop them and continue on the original grid (default).
+    Burst,      ///< Run them back to back (at most a few) to keep the sample count.
+    Reanchor    ///< Drop them and restart the grid from the current time.
+};
+
+/// @brief Lower-case name of a policy ("skip", "burst", "reanchor").
+const char* catchUpName(CatchUpPolicy policy);
+
+/// @brief Parse a policy name (case-insensitive). @return false if unknown.
+bool catchUpFromName(const std::string& name, CatchUpPolicy& out);
+
+/**
+ * @class TickScheduler
+ * @brief Computes tick deadlines and accounts for jitter and overruns.
+ *
+ * Usage per iteration: beforeWait(now); sleep until deadline() (or an
+ * earlier wake-up); tick(now); do the work.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Ticks missed beyond this many are skipped even under Burst.
+    static constexpr int kMaxBurst = 3;
+
+    explicit TickScheduler(Clock::duration period = std::chrono::seconds(1),
+                           CatchUpPolicy policy = CatchUpPolicy::Skip);
+
+    /**
+     * @brief Change the period. The next deadline becomes the current
+     *        tick's scheduled time plus the new period.
+     */
+    void setPeriod(Clock::duration period);
+    Clock::duration period() const { return period_; }
+
+    void setPolicy(CatchUpPolicy policy) { policy_ = policy; }
+    CatchUpPolicy policy() const { return policy_; }
+
+    /// @brief When the next tick is due (time_point{} before the first tick).
+    Clock::time_point deadline() const { return next_; }
+
+    /**
+     * @brief Call when the tick's work is done, before sleeping.
+     * @return false if the deadline has already passed (an overrun, which
+     *         is recorded); the caller should not sleep.
+     */
+    bool beforeWait(Clock::time_point now);
+
+    /**
+     * @brief Call at the start of a tick.
+     *
+     * A tick before the deadline (an early wake-up) is counted but does
+     * not advance the schedule. Otherwise the lateness is recorded as
+     * jitter (unless it was caused by an overrun), missed ticks are
+     * counted and the next deadline is chosen according to the policy.
+     */
+    void tick(Clock::time_point now);
+
+    /// @brief Cumulative statistics.
+    const TickStats& stats() const { return stats_; }
+
+private:
+    Clock::duration   period_;
+    CatchUpPolicy     policy_;
+    Clock::time_point scheduled_{};  ///< Scheduled time of the current tick.
+    Clock::time_point next_{};       ///< Scheduled time of the next tick.
+    bool              skippedWait_ = false; ///< Tick started without sleeping (lateness is not jitter).
+    bool              bursting_    = false; ///< Next deadline already passed under Burst.
+    TickStats         stats_;
+};
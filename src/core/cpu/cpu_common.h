@@ -6,6 +6,8 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
+#include <atomic>
 #include <memory>
 
 /**
@@ -25,10 +27,23 @@ public:
      * @return Most recent CpuSnapshot.
      */
     virtual CpuSnapshot snapshot() const = 0;
+
+    /**
+     * @brief Enable or disable per-core frequency and temperature sensors.
+     *
+     * With detail off only the aggregate counters are sampled; frequency
+     * comes from the first core and temperature is reported as -1.
+     * @param on True to read the sensors on every update().
+     */
+    void setSensorDetail(bool on) { sensorDetail_ = on; }
+
+protected:
+    std::atomic<bool> sensorDetail_{true}; ///< Read per-core sensors in update().
 };
 
 /**
  * @brief Create a platform-specific CPU monitor instance.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  * @return Unique pointer to a CPU implementation.
  */
-std::unique_ptr<CPU> createCPU();
+std::unique_ptr<CPU> createCPU(std::shared_ptr<const FileReader> files = hostFileReader());
@@ -13,10 +13,11 @@
 #error "Unsupported platform"
 #endif
 
-std::unique_ptr<CPU> createCPU() {
+std::unique_ptr<CPU> createCPU(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsCPU>();
 #else
-    return std::make_unique<LinuxCPU>();
+    return std::make_unique<LinuxCPU>(std::move(files));
 #endif
 }
@@ -6,57 +6,103 @@
 #ifdef __linux__
 
 #include "cpu_linux.h"
+#include "../io/proc_parse.h"
+#include "../../utils/tracer.h"
 
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <algorithm>
 #include <numeric>
 #include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <dirent.h>
 #include <unistd.h>
-#include <filesystem>
 
-namespace fs = std::filesystem;
+namespace {
 
-LinuxCPU::LinuxCPU()
-    : prevTime_(std::chrono::steady_clock::now())
+using proc_parse::forEachLine;
+using proc_parse::parseDec;
+using proc_parse::startsWith;
+
+/// The value after the ':' of a "key : value" line, or null.
+const char* valueOf(const char* line, size_t len) {
+    auto* colon = static_cast<const char*>(std::memchr(line, ':', len));
+    return colon ? colon + 1 : nullptr;
+}
+
+} // namespace
+
+LinuxCPU::LinuxCPU(std::shared_ptr<const FileReader> files)
+    : files_(std::move(files)),
+      prevTime_(files_->now())
 {
-    logicalCores_ = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    files_->read("/proc/stat", statBuf_);
+    if (files_->isHost()) {
+        logicalCores_ = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    } else {
+        // A synthetic tree describes its own machine: count its cpuN lines.
+        for (auto pos = statBuf_.find("\ncpu"); pos != std::string::npos;
+             pos = statBuf_.find("\ncpu", pos + 1))
+            if (std::isdigit(static_cast<unsigned char>(statBuf_[pos + 4]))) ++logicalCores_;
+    }
     if (logicalCores_ < 1) logicalCores_ = 1;
 
-    prevCores_.resize(logicalCores_);
-    usageHistory_.reserve(kMaxHistory);
-
-    std::ifstream stat("/proc/stat");
-    if (stat.is_open()) {
-        std::string line;
-        while (std::getline(stat, line)) {
-            if (line.compare(0, 4, "cpu ") == 0) {
-                std::istringstream ss(line.substr(4));
-                ss >> prevAgg_.user >> prevAgg_.nice >> prevAgg_.system
-                   >> prevAgg_.idle >> prevAgg_.iowait >> prevAgg_.irq
-                   >> prevAgg_.softirq >> prevAgg_.steal;
-            } else if (line.compare(0, 3, "cpu") == 0 && std::isdigit(line[3])) {
-                int idx = 0;
-                std::istringstream ss(line.substr(3));
-                ss >> idx;
-                if (idx >= 0 && idx < logicalCores_) {
-                    auto& c = prevCores_[idx];
-                    ss >> c.user >> c.nice >> c.system >> c.idle
-                       >> c.iowait >> c.irq >> c.softirq >> c.steal;
-                }
-            } else if (line.compare(0, 4, "ctxt") == 0) {
-                std::istringstream ss(line.substr(4));
-                ss >> prevCtx_;
-            } else if (line.compare(0, 4, "intr") == 0) {
-                std::istringstream ss(line.substr(4));
-                ss >> prevIntr_;
+    prev_.cores.resize(logicalCores_);
+    cur_.cores.resize(logicalCores_);
+    usageHistory_.reserve(kMaxHistory + 1);
+
+    parseProcStat(statBuf_, prev_);
+
+    // Cores per package does not change while running.
+    physicalCores_ = logicalCores_;
+    if (files_->read("/proc/cpuinfo", cpuinfoBuf_)) {
+        forEachLine(cpuinfoBuf_, [&](const char* line, size_t len) {
+            if (!startsWith(line, len, "cpu cores", 9)) return true;
+            if (const char* v = valueOf(line, len)) {
+                int c = std::atoi(v);
+                if (c > 0 && c <= logicalCores_) physicalCores_ = c;
             }
-        }
+            return false;
+        });
     }
 }
 
+void LinuxCPU::parseProcStat(const std::string& text, ProcStat& out) {
+    out.agg = CoreTick{};
+    std::fill(out.cores.begin(), out.cores.end(), CoreTick{});
+    out.ctxt = 0;
+    out.intr = 0;
+    const uint64_t nCores = out.cores.size();
+
+    // A short line leaves its remaining fields at 0.
+    auto parseTicks = [](const char* p, const char* eol, CoreTick& t) {
+        uint64_t* fields[] = {&t.user, &t.nice, &t.system, &t.idle,
+                              &t.iowait, &t.irq, &t.softirq, &t.steal};
+        for (uint64_t* f : fields)
+            if (!parseDec(p, eol, *f)) return;
+    };
+
+    forEachLine(text, [&](const char* line, size_t len) {
+        const char* eol = line + len;
+        if (startsWith(line, len, "cpu ", 4)) {
+            parseTicks(line + 4, eol, out.agg);
+        } else if (startsWith(line, len, "cpu", 3) && len > 3
+                   && std::isdigit(static_cast<unsigned char>(line[3]))) {
+            const char* p = line + 3;
+            uint64_t idx = 0;
+            if (parseDec(p, eol, idx) && idx < nCores) parseTicks(p, eol, out.cores[idx]);
+        } else if (startsWith(line, len, "ctxt", 4)) {
+            const char* p = line + 4;
+            parseDec(p, eol, out.ctxt);
+        } else if (startsWith(line, len, "intr", 4)) {
+            const char* p = line + 4;
+            parseDec(p, eol, out.intr);
+        }
+        return true;
+    });
+}
+
 float LinuxCPU::computeUsage(const CoreTick& prev, const CoreTick& cur) {
     uint64_t dTotal  = cur.total() - prev.total();
     uint64_t dActive = cur.activeTime() - prev.activeTime();
@@ -65,244 +111,184 @@ float LinuxCPU::computeUsage(const CoreTick& prev, const CoreTick& cur) {
 }
 
 /**
- * @brief Read CPU temperature from /sys/class/hwmon, trying known drivers first.
- * @return Temperature in Celsius, or -1 on failure.
+ * @brief Find the CPU temperature input under /sys/class/hwmon, trying known drivers first.
+ * @return Path of a tempN_input reading above 0, or empty if there is none.
  */
-float LinuxCPU::readTemperature() const {
+std::string LinuxCPU::findTemperatureInput() const {
     static const char* preferredDrivers[] = {
         "coretemp", "k10temp", "zenpower",
         "it87", "nct6775", "nct6776", "nct6779",
         "thinkpad", "acpitz"
     };
 
-    try {
-        for (const char* wanted : preferredDrivers) {
-            for (const auto& hwmon : fs::directory_iterator("/sys/class/hwmon")) {
-                std::ifstream nameFile(hwmon.path() / "name");
-                if (!nameFile.is_open()) continue;
-
-                std::string name;
-                std::getline(nameFile, name);
-                while (!name.empty() && (name.back() == '\n' || name.back() == ' '))
-                    name.pop_back();
-
-                if (name != wanted) continue;
-
-                for (int idx = 1; idx <= 4; ++idx) {
-                    std::string tempPath = (hwmon.path() / ("temp" + std::to_string(idx) + "_input")).string();
-                    std::ifstream tempFile(tempPath);
-                    if (tempFile.is_open()) {
-                        int millideg = 0;
-                        tempFile >> millideg;
-                        if (!tempFile.fail() && millideg > 0)
-                            return static_cast<float>(millideg) / 1000.0f;
-                    }
-                }
-            }
-        }
+    std::vector<std::string> hwmons;
+    files_->forEachEntry("/sys/class/hwmon", [&hwmons](const char* name) {
+        hwmons.push_back(std::string("/sys/class/hwmon/") + name);
+        return true;
+    });
+    std::sort(hwmons.begin(), hwmons.end());
+
+    std::string text;
+    auto valid = [&](const std::string& path) {
+        return files_->read(path.c_str(), text) && std::strtol(text.c_str(), nullptr, 10) > 0;
+    };
+
+    for (const char* wanted : preferredDrivers) {
+        for (const auto& hwmon : hwmons) {
+            if (!files_->read((hwmon + "/name").c_str(), text)) continue;
+            while (!text.empty() && (text.back() == '\n' || text.back() == ' '))
+                text.pop_back();
+
+            if (text != wanted) continue;
 
-        for (const auto& hwmon : fs::directory_iterator("/sys/class/hwmon")) {
-            std::ifstream tempFile(hwmon.path() / "temp1_input");
-            if (tempFile.is_open()) {
-                int millideg = 0;
-                tempFile >> millideg;
-                if (!tempFile.fail() && millideg > 0)
-                    return static_cast<float>(millideg) / 1000.0f;
+            for (int idx = 1; idx <= 4; ++idx) {
+                std::string input = hwmon + "/temp" + std::to_string(idx) + "_input";
+                if (valid(input)) return input;
             }
         }
-    } catch (...) {
     }
-    return -1.0f;
+
+    for (const auto& hwmon : hwmons) {
+        std::string input = hwmon + "/temp1_input";
+        if (valid(input)) return input;
+    }
+    return {};
+}
+
+float LinuxCPU::readTemperature(std::chrono::steady_clock::time_point now) {
+    auto current = [&]() {
+        if (!files_->read(tempInput_.c_str(), textBuf_)) return -1.0f;
+        long millideg = std::strtol(textBuf_.c_str(), nullptr, 10);
+        return millideg > 0 ? static_cast<float>(millideg) / 1000.0f : -1.0f;
+    };
+    if (!tempInput_.empty()) {
+        float c = current();
+        if (c > 0.0f) return c;
+    }
+    // The search reads every hwmon device, so it runs again only when the
+    // input stops answering, or once a minute while there is none.
+    if (tempInput_.empty() && now - lastTempSearch_ < std::chrono::minutes(1)) return -1.0f;
+    lastTempSearch_ = now;
+    tempInput_ = findTemperatureInput();
+    return tempInput_.empty() ? -1.0f : current();
 }
 
 void LinuxCPU::update() {
-    CpuSnapshot snap;
+    // Rebuild the previous snapshot in place so its core vector is reused.
+    CpuSnapshot& snap = spare_;
+    {
+        std::vector<CoreInfo> cores = std::move(snap.cores);
+        snap = CpuSnapshot{};
+        snap.cores = std::move(cores);
+    }
     snap.logicalCores  = logicalCores_;
-    snap.physicalCores = logicalCores_;
+    snap.physicalCores = physicalCores_;
 
-    auto now = std::chrono::steady_clock::now();
+    auto now = files_->now();
     double elapsed = std::chrono::duration<double>(now - prevTime_).count();
     if (elapsed <= 0.0) elapsed = 1.0;
 
-    CoreTick aggNow{};
-    std::vector<CoreTick> coresNow(logicalCores_);
-    uint64_t ctxNow  = 0;
-    uint64_t intrNow = 0;
-
     {
-        std::ifstream stat("/proc/stat");
-        if (stat.is_open()) {
-            std::string line;
-            while (std::getline(stat, line)) {
-                if (line.compare(0, 4, "cpu ") == 0) {
-                    std::istringstream ss(line.substr(4));
-                    ss >> aggNow.user >> aggNow.nice >> aggNow.system
-                       >> aggNow.idle >> aggNow.iowait >> aggNow.irq
-                       >> aggNow.softirq >> aggNow.steal;
-                } else if (line.compare(0, 3, "cpu") == 0 && std::isdigit(line[3])) {
-                    int idx = 0;
-                    std::istringstream ss(line.substr(3));
-                    ss >> idx;
-                    if (idx >= 0 && idx < logicalCores_) {
-                        auto& c = coresNow[idx];
-                        ss >> c.user >> c.nice >> c.system >> c.idle
-                           >> c.iowait >> c.irq >> c.softirq >> c.steal;
-                    }
-                } else if (line.compare(0, 4, "ctxt") == 0) {
-                    std::istringstream ss(line.substr(4));
-                    ss >> ctxNow;
-                } else if (line.compare(0, 4, "intr") == 0) {
-                    std::istringstream ss(line.substr(4));
-                    ss >> intrNow;
-                }
-            }
-        }
+        TraceSpan span("parse", "/proc/stat");
+        files_->read("/proc/stat", statBuf_);  // left empty on failure
+        parseProcStat(statBuf_, cur_);
     }
+    const CoreTick& aggNow  = cur_.agg;
+    const CoreTick& prevAgg = prev_.agg;
 
     {
-        uint64_t dTotal = aggNow.total() - prevAgg_.total();
+        uint64_t dTotal = aggNow.total() - prevAgg.total();
         if (dTotal > 0) {
             auto pct = [&](uint64_t cur, uint64_t prev) {
                 return static_cast<float>(cur - prev) * 100.0f / static_cast<float>(dTotal);
             };
-            snap.userPercent   = pct(aggNow.user + aggNow.nice, prevAgg_.user + prevAgg_.nice);
+            snap.userPercent   = pct(aggNow.user + aggNow.nice, prevAgg.user + prevAgg.nice);
             snap.systemPercent = pct(aggNow.system + aggNow.irq + aggNow.softirq,
-                                     prevAgg_.system + prevAgg_.irq + prevAgg_.softirq);
-            snap.idlePercent   = pct(aggNow.idle, prevAgg_.idle);
-            snap.iowaitPercent = pct(aggNow.iowait, prevAgg_.iowait);
+                                     prevAgg.system + prevAgg.irq + prevAgg.softirq);
+            snap.idlePercent   = pct(aggNow.idle, prevAgg.idle);
+            snap.iowaitPercent = pct(aggNow.iowait, prevAgg.iowait);
             snap.totalUsage    = 100.0f - snap.idlePercent - snap.iowaitPercent;
             if (snap.totalUsage < 0.0f) snap.totalUsage = 0.0f;
         }
     }
 
-    snap.cores.resize(logicalCores_);
+    snap.cores.assign(logicalCores_, CoreInfo{});
     for (int i = 0; i < logicalCores_; ++i) {
         snap.cores[i].id    = i;
-        snap.cores[i].usage = computeUsage(prevCores_[i], coresNow[i]);
-        snap.cores[i].temperature = -1.0f;
+        snap.cores[i].usage = computeUsage(prev_.cores[i], cur_.cores[i]);
     }
 
     if (elapsed > 0.0) {
         snap.contextSwitchesPerSec = static_cast<float>(
-            static_cast<double>(ctxNow - prevCtx_) / elapsed);
+            static_cast<double>(cur_.ctxt - prev_.ctxt) / elapsed);
         snap.interruptsPerSec = static_cast<float>(
-            static_cast<double>(intrNow - prevIntr_) / elapsed);
+            static_cast<double>(cur_.intr - prev_.intr) / elapsed);
     }
 
-    prevAgg_   = aggNow;
-    prevCores_ = coresNow;
-    prevCtx_   = ctxNow;
-    prevIntr_  = intrNow;
-    prevTime_  = now;
+    std::swap(prev_, cur_);
+    prevTime_ = now;
 
     {
         float freqSum   = 0.0f;
         int   freqCount = 0;
-        bool  sysfsOk   = false;
-
-        for (int i = 0; i < logicalCores_; ++i) {
-            std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(i)
-                             + "/cpufreq/scaling_cur_freq";
-            std::ifstream f(path);
-            if (f.is_open()) {
-                int khz = 0;
-                f >> khz;
-                if (!f.fail() && khz > 0) {
+
+        // Without sensor detail the first core stands in for the package.
+        const int freqCores = sensorDetail_ ? logicalCores_ : 1;
+        for (int i = 0; i < freqCores; ++i) {
+            char path[80];
+            std::snprintf(path, sizeof(path),
+                          "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", i);
+            if (files_->read(path, textBuf_)) {
+                long khz = std::strtol(textBuf_.c_str(), nullptr, 10);
+                if (khz > 0) {
                     float mhz = static_cast<float>(khz) / 1000.0f;
-                    if (i < logicalCores_)
-                        snap.cores[i].frequency = mhz;
+                    snap.cores[i].frequency = mhz;
                     freqSum += mhz;
                     ++freqCount;
-                    sysfsOk = true;
                 }
             }
         }
 
-        if (freqCount > 0)
-            snap.frequency = freqSum / static_cast<float>(freqCount);
-
-        if (!sysfsOk) {
-            std::ifstream cpuinfo("/proc/cpuinfo");
-            if (cpuinfo.is_open()) {
-                std::string line;
-                float cFreqSum = 0.0f;
-                int   cFreqCount = 0;
-                int   coreIdx = 0;
-                while (std::getline(cpuinfo, line)) {
-                    if (line.compare(0, 7, "cpu MHz") == 0) {
-                        auto pos = line.find(':');
-                        if (pos != std::string::npos) {
-                            float mhz = 0.0f;
-                            try { mhz = std::stof(line.substr(pos + 1)); } catch (...) {}
-                            cFreqSum += mhz;
-                            ++cFreqCount;
-                            if (coreIdx < logicalCores_)
-                                snap.cores[coreIdx].frequency = mhz;
-                            ++coreIdx;
-                        }
-                    }
+        // No cpufreq (most VMs): fall back to the "cpu MHz" lines.
+        if (freqCount == 0 && files_->read("/proc/cpuinfo", cpuinfoBuf_)) {
+            int coreIdx = 0;
+            forEachLine(cpuinfoBuf_, [&](const char* line, size_t len) {
+                if (!startsWith(line, len, "cpu MHz", 7)) return true;
+                if (const char* v = valueOf(line, len)) {
+                    float mhz = std::strtof(v, nullptr);
+                    freqSum += mhz;
+                    ++freqCount;
+                    if (coreIdx < logicalCores_)
+                        snap.cores[coreIdx].frequency = mhz;
+                    ++coreIdx;
                 }
-                if (cFreqCount > 0)
-                    snap.frequency = cFreqSum / static_cast<float>(cFreqCount);
-            }
+                return true;
+            });
         }
-    }
 
-    {
-        std::ifstream cpuinfo("/proc/cpuinfo");
-        if (cpuinfo.is_open()) {
-            std::string line;
-            while (std::getline(cpuinfo, line)) {
-                if (line.compare(0, 9, "cpu cores") == 0) {
-                    auto pos = line.find(':');
-                    if (pos != std::string::npos) {
-                        try {
-                            int c = std::stoi(line.substr(pos + 1));
-                            if (c > 0) snap.physicalCores = c;
-                        } catch (...) {}
-                    }
-                    break;
-                }
-            }
-        }
-        if (snap.physicalCores == 0 || snap.physicalCores > logicalCores_)
-            snap.physicalCores = logicalCores_;
+        if (freqCount > 0)
+            snap.frequency = freqSum / static_cast<float>(freqCount);
     }
 
-    {
-        std::ifstream la("/proc/loadavg");
-        if (la.is_open()) {
-            la >> snap.loadAvg1 >> snap.loadAvg5 >> snap.loadAvg15;
-        }
+    if (files_->read("/proc/loadavg", textBuf_)) {
+        std::sscanf(textBuf_.c_str(), "%f %f %f",
+                    &snap.loadAvg1, &snap.loadAvg5, &snap.loadAvg15);
+        // Fourth field is "running/total" scheduling entities.
+        int running = 0, total = 0;
+        if (std::sscanf(textBuf_.c_str(), "%*f %*f %*f %d/%d", &running, &total) == 2)
+            snap.totalThreads = total;
     }
 
-    {
+    // This process's own threads, always from the host.
+    if (DIR* task = opendir("/proc/self/task")) {
         int count = 0;
-        try {
-            for (const auto& entry : fs::directory_iterator("/proc/self/task")) {
-                (void)entry;
-                ++count;
-            }
-        } catch (...) {}
+        while (dirent* e = readdir(task))
+            if (e->d_name[0] != '.') ++count;
+        closedir(task);
         snap.processThreads = count;
     }
 
-    {
-        std::ifstream la("/proc/loadavg");
-        if (la.is_open()) {
-            float f1, f2, f3;
-            std::string runTotal;
-            la >> f1 >> f2 >> f3 >> runTotal;
-            auto slash = runTotal.find('/');
-            if (slash != std::string::npos) {
-                try {
-                    snap.totalThreads = std::stoi(runTotal.substr(slash + 1));
-                } catch (...) {}
-            }
-        }
-    }
-
-    snap.temperature = readTemperature();
+    snap.temperature = sensorDetail_ ? readTemperature(now) : -1.0f;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -317,7 +303,7 @@ void LinuxCPU::update() {
             snap.highestUsage = *std::max_element(usageHistory_.begin(), usageHistory_.end());
         }
 
-        current_ = std::move(snap);
+        std::swap(current_, spare_);
     }
 }
 
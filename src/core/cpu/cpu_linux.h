@@ -8,18 +8,22 @@
 #ifdef __linux__
 
 #include "cpu_common.h"
+#include "../io/file_reader.h"
 
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <cstdint>
 #include <chrono>
+#include <string>
 
 /**
  * @brief Linux CPU monitor using /proc/stat, /proc/cpuinfo, and sysfs.
  */
 class LinuxCPU : public CPU {
 public:
-    LinuxCPU();
+    /// @param files Where /proc and /sys are read from.
+    explicit LinuxCPU(std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxCPU() override = default;
 
     /**
@@ -33,7 +37,6 @@ public:
      */
     CpuSnapshot snapshot() const          override;
 
-private:
     /**
      * @brief Holds one sample of /proc/stat tick counters for a single CPU or aggregate.
      */
@@ -62,20 +65,45 @@ private:
         uint64_t activeTime() const { return total() - idle - iowait; }
     };
 
-    CoreTick prevAgg_; ///< Previous aggregate tick values
-    std::vector<CoreTick> prevCores_; ///< Previous per-core tick values
+    /**
+     * @brief The counters update() uses from one /proc/stat sample.
+     */
+    struct ProcStat {
+        CoreTick              agg;        ///< The aggregate "cpu" line
+        std::vector<CoreTick> cores;      ///< "cpuN" lines; sized by the caller, others ignored
+        uint64_t              ctxt = 0;   ///< Context switches since boot
+        uint64_t              intr = 0;   ///< Interrupts since boot
+    };
+
+    /**
+     * @brief Parse the text of /proc/stat.
+     * @param text Whole file contents.
+     * @param out  Receives the counters; out.cores must already be sized.
+     */
+    static void parseProcStat(const std::string& text, ProcStat& out);
 
-    uint64_t prevCtx_       = 0; ///< Previous context switch count
-    uint64_t prevIntr_      = 0; ///< Previous interrupt count
+private:
+    std::shared_ptr<const FileReader> files_; ///< Source of /proc and /sys
+
+    ProcStat prev_; ///< Previous /proc/stat sample
+    ProcStat cur_;  ///< This tick's sample; swapped with prev_
+    std::string statBuf_; ///< Reused /proc/stat read buffer
+    std::string cpuinfoBuf_; ///< Reused /proc/cpuinfo read buffer
+    std::string textBuf_; ///< Reused buffer for /proc/loadavg and cpufreq reads
     std::chrono::steady_clock::time_point prevTime_; ///< Timestamp of last update
 
-    int logicalCores_ = 0; ///< Number of online logical CPUs
+    int logicalCores_  = 0; ///< Online logical CPUs (sysconf, or the tree's /proc/stat)
+    int physicalCores_ = 0; ///< "cpu cores" from /proc/cpuinfo, read once
+
+    std::string tempInput_; ///< hwmon tempN_input readTemperature() uses; empty if none
+    std::chrono::steady_clock::time_point lastTempSearch_{}; ///< Last findTemperatureInput()
 
     static constexpr size_t kMaxHistory = 300; ///< Max stored usage samples
     std::vector<float> usageHistory_; ///< Rolling CPU usage history
 
     mutable std::mutex mutex_; ///< Guards current_
     CpuSnapshot        current_; ///< Latest snapshot
+    CpuSnapshot        spare_;   ///< Previous current_, rebuilt in place by update()
 
     /**
      * @brief Compute CPU usage percentage between two tick samples.
@@ -86,10 +114,17 @@ private:
     static float computeUsage(const CoreTick& prev, const CoreTick& cur);
 
     /**
-     * @brief Read CPU temperature from /sys/class/hwmon.
+     * @brief Read CPU temperature from the cached hwmon input, finding it first if needed.
+     * @param now This tick's time, to rate-limit searching when there is no sensor.
      * @return Temperature in Celsius, or -1 on failure.
      */
-    float        readTemperature() const;
+    float        readTemperature(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Search /sys/class/hwmon for the CPU temperature input.
+     * @return Its path, or empty if no sensor reads above 0.
+     */
+    std::string  findTemperatureInput() const;
 };
 
 #endif // __linux__
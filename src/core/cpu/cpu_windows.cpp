@@ -265,7 +265,7 @@ void WindowsCPU::update() {
         }
     }
 
-    snap.temperature = queryTemperatureWMI();
+    snap.temperature = sensorDetail_ ? queryTemperatureWMI() : -1.0f;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
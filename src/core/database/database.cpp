@@ -5,6 +5,7 @@
 
 #include "database.h"
 #include "../../utils/logger.h"
+#include "../../utils/tracer.h"
 #include <sqlite3.h>
 #include <fstream>
 #include <chrono>
@@ -68,10 +69,17 @@ bool Database::initialize() {
         "  total_sent INTEGER, total_recv INTEGER,"
         "  interface_count INTEGER);",
 
-        "CREATE TABLE IF NOT EXISTS disk_metrics ("
+        // Dictionary for repeated strings (device, mount point, fs type).
+        "CREATE TABLE IF NOT EXISTS labels ("
+        "  id INTEGER PRIMARY KEY,"
+        "  text TEXT NOT NULL UNIQUE);",
+
+        "CREATE TABLE IF NOT EXISTS disk_samples ("
         "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
         "  timestamp TEXT NOT NULL,"
-        "  device TEXT, mount_point TEXT, fs_type TEXT,"
+        "  device_id INTEGER REFERENCES labels(id),"
+        "  mount_id INTEGER REFERENCES labels(id),"
+        "  fs_id INTEGER REFERENCES labels(id),"
         "  usage_pct REAL, total_bytes INTEGER, used_bytes INTEGER,"
         "  read_rate REAL, write_rate REAL);",
 
@@ -88,24 +96,126 @@ bool Database::initialize() {
         "  rule_name TEXT, message TEXT,"
         "  value REAL, threshold REAL);",
 
+        // Self-instrumentation; only written when enabled. kind is
+        // 'module' (one update()) or 'stage' (one pipeline stage run).
+        "CREATE TABLE IF NOT EXISTS collector_stats ("
+        "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "  timestamp TEXT NOT NULL,"
+        "  component TEXT, kind TEXT, runs INTEGER,"
+        "  p50_us INTEGER, p99_us INTEGER, max_us INTEGER, cpu_ms_per_run REAL,"
+        "  syscalls INTEGER, file_opens INTEGER, bytes_read INTEGER,"
+        "  dropped INTEGER);",
+
         // Indexes on timestamp for fast range queries / pruning
         "CREATE INDEX IF NOT EXISTS idx_cpu_ts    ON cpu_metrics(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_mem_ts    ON memory_metrics(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_net_ts    ON network_metrics(timestamp);",
-        "CREATE INDEX IF NOT EXISTS idx_disk_ts   ON disk_metrics(timestamp);",
+        "CREATE INDEX IF NOT EXISTS idx_disk_samples_ts ON disk_samples(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_gpu_ts    ON gpu_metrics(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_alert_ts  ON alert_events(timestamp);",
+        "CREATE INDEX IF NOT EXISTS idx_stats_ts  ON collector_stats(timestamp);",
     };
 
     for (auto& sql : tables) {
         if (!exec(sql)) return false;
     }
 
+    // disk_metrics used to be a table with the strings inline; it is now
+    // a view that expands the label ids, so exports are unchanged.
+    if (!migrateLegacyDiskTable()) return false;
+    if (!exec("CREATE VIEW IF NOT EXISTS disk_metrics AS"
+              " SELECT s.id, s.timestamp,"
+              "  d.text AS device, m.text AS mount_point, f.text AS fs_type,"
+              "  s.usage_pct, s.total_bytes, s.used_bytes, s.read_rate, s.write_rate"
+              " FROM disk_samples s"
+              " LEFT JOIN labels d ON d.id = s.device_id"
+              " LEFT JOIN labels m ON m.id = s.mount_id"
+              " LEFT JOIN labels f ON f.id = s.fs_id;"))
+        return false;
+
     prepareStatements();
     Logger::log("DB: initialised (" + dbPath_ + ")");
     return true;
 }
 
+/**
+ * Move rows from a pre-dictionary disk_metrics table into disk_samples.
+ * Runs once per database file; a no-op when disk_metrics is already the view.
+ */
+bool Database::migrateLegacyDiskTable() {
+    sqlite3_stmt* stmt = nullptr;
+    bool legacy = false;
+    if (sqlite3_prepare_v2(db_, "SELECT 1 FROM sqlite_master"
+                                " WHERE name='disk_metrics' AND type='table';",
+                           -1, &stmt, nullptr) == SQLITE_OK) {
+        legacy = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+    }
+    if (!legacy) return true;
+
+    const char* steps[] = {
+        "BEGIN;",
+        "INSERT OR IGNORE INTO labels(text)"
+        " SELECT device FROM disk_metrics WHERE device IS NOT NULL"
+        " UNION SELECT mount_point FROM disk_metrics WHERE mount_point IS NOT NULL"
+        " UNION SELECT fs_type FROM disk_metrics WHERE fs_type IS NOT NULL;",
+        "INSERT INTO disk_samples"
+        " (timestamp,device_id,mount_id,fs_id,usage_pct,"
+        "  total_bytes,used_bytes,read_rate,write_rate)"
+        " SELECT timestamp,"
+        "  (SELECT id FROM labels WHERE text = device),"
+        "  (SELECT id FROM labels WHERE text = mount_point),"
+        "  (SELECT id FROM labels WHERE text = fs_type),"
+        "  usage_pct,total_bytes,used_bytes,read_rate,write_rate"
+        " FROM disk_metrics ORDER BY id;",
+        "DROP TABLE disk_metrics;",
+        "COMMIT;",
+    };
+    for (auto& sql : steps) {
+        if (!exec(sql)) {
+            exec("ROLLBACK;");
+            return false;
+        }
+    }
+    Logger::log("DB: migrated disk_metrics to dictionary-encoded disk_samples");
+    return true;
+}
+
+/**
+ * Row id in the labels table for @p label, inserting it on first use.
+ * Cached by the label's pool id, so steady-state inserts do no lookups.
+ * Labels past a full intern pool all share kOverflowId and have lost their
+ * text, so they get 0 (no label) rather than one row standing for all.
+ */
+int64_t Database::labelRow(Label label) {
+    if (label.id() == InternPool::kOverflowId) return 0;
+    if (label.id() < labelRows_.size() && labelRows_[label.id()] != 0)
+        return labelRows_[label.id()];
+
+    int64_t row = textRow(label.str());
+    if (row != 0) {
+        if (label.id() >= labelRows_.size()) labelRows_.resize(label.id() + 1, 0);
+        labelRows_[label.id()] = row;
+    }
+    return row;
+}
+
+/// labels.id for @p text, inserting it if new. Uncached; for text that is not a Label.
+int64_t Database::textRow(const std::string& text) {
+    int64_t row = 0;
+    if (stmtLabelIns_ && stmtLabelSel_) {
+        sqlite3_reset(stmtLabelIns_);
+        sqlite3_bind_text(stmtLabelIns_, 1, text.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmtLabelIns_);
+
+        sqlite3_reset(stmtLabelSel_);
+        sqlite3_bind_text(stmtLabelSel_, 1, text.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmtLabelSel_) == SQLITE_ROW)
+            row = sqlite3_column_int64(stmtLabelSel_, 0);
+    }
+    return row;
+}
+
 // ---------------------------------------------------------------------------
 // Prepared-statement helpers
 // ---------------------------------------------------------------------------
@@ -137,11 +247,14 @@ void Database::prepareStatements() {
             " interface_count) "
             "VALUES(?,?,?,?,?,?);", stmtNet_);
 
-    prepare("INSERT INTO disk_metrics "
-            "(timestamp,device,mount_point,fs_type,usage_pct,"
+    prepare("INSERT INTO disk_samples "
+            "(timestamp,device_id,mount_id,fs_id,usage_pct,"
             " total_bytes,used_bytes,read_rate,write_rate) "
             "VALUES(?,?,?,?,?,?,?,?,?);", stmtDisk_);
 
+    prepare("INSERT OR IGNORE INTO labels(text) VALUES(?);", stmtLabelIns_);
+    prepare("SELECT id FROM labels WHERE text = ?;", stmtLabelSel_);
+
     prepare("INSERT INTO gpu_metrics "
             "(timestamp,name,utilization,memory_used,memory_total,"
             " temperature,power_watts) "
@@ -150,12 +263,18 @@ void Database::prepareStatements() {
     prepare("INSERT INTO alert_events "
             "(timestamp,rule_name,message,value,threshold) "
             "VALUES(?,?,?,?,?);", stmtAlert_);
+
+    prepare("INSERT INTO collector_stats "
+            "(timestamp,component,kind,runs,p50_us,p99_us,max_us,cpu_ms_per_run,"
+            " syscalls,file_opens,bytes_read,dropped) "
+            "VALUES(?,?,?,?,?,?,?,?,?,?,?,?);", stmtStats_);
 }
 
 void Database::finalizeStatements() {
     auto fin = [](sqlite3_stmt*& s) { if (s) { sqlite3_finalize(s); s = nullptr; } };
     fin(stmtCpu_); fin(stmtMem_); fin(stmtNet_);
-    fin(stmtDisk_); fin(stmtGpu_); fin(stmtAlert_);
+    fin(stmtDisk_); fin(stmtGpu_); fin(stmtAlert_); fin(stmtStats_);
+    fin(stmtLabelIns_); fin(stmtLabelSel_);
 }
 
 // ---------------------------------------------------------------------------
@@ -165,8 +284,11 @@ void Database::finalizeStatements() {
 void Database::insertSnapshot(const MetricData& data) {
     std::lock_guard<std::mutex> lock(mtx_);
     if (!db_) return;
+    TraceSpan span("db", "insertSnapshot");
 
-    std::string ts = currentTimestamp();
+    // Use the time the sample was taken, not when it reached the writer.
+    std::string ts = formatTimestamp(data.timestamp == std::chrono::system_clock::time_point{}
+                                         ? std::chrono::system_clock::now() : data.timestamp);
 
     exec("BEGIN TRANSACTION;");
 
@@ -226,9 +348,9 @@ void Database::insertSnapshot(const MetricData& data) {
         for (auto& d : data.disk.disks) {
             sqlite3_reset(stmtDisk_);
             sqlite3_bind_text  (stmtDisk_, 1, ts.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text  (stmtDisk_, 2, d.device.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text  (stmtDisk_, 3, d.mountPoint.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text  (stmtDisk_, 4, d.fsType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64 (stmtDisk_, 2, labelRow(d.device));
+            sqlite3_bind_int64 (stmtDisk_, 3, textRow(d.mountPoint));
+            sqlite3_bind_int64 (stmtDisk_, 4, labelRow(d.fsType));
             sqlite3_bind_double(stmtDisk_, 5, d.usagePercent);
             sqlite3_bind_int64 (stmtDisk_, 6, static_cast<sqlite3_int64>(d.totalBytes));
             sqlite3_bind_int64 (stmtDisk_, 7, static_cast<sqlite3_int64>(d.usedBytes));
@@ -253,9 +375,55 @@ void Database::insertSnapshot(const MetricData& data) {
         }
     }
 
+    if (recordStats_) insertCollectorStats(ts, data.collector);
+
     exec("COMMIT;");
 }
 
+void Database::setRecordCollectorStats(bool enabled) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    recordStats_ = enabled;
+}
+
+bool Database::recordCollectorStats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return recordStats_;
+}
+
+/// One row per module and per pipeline stage; counters are cumulative.
+void Database::insertCollectorStats(const std::string& ts, const CollectorStats& stats) {
+    if (!stmtStats_) return;
+
+    auto row = [&](const std::string& component, const char* kind, uint64_t runs,
+                   const Histogram& h, double cpuMs, uint64_t syscalls,
+                   uint64_t opens, uint64_t bytes, uint64_t dropped) {
+        sqlite3_reset(stmtStats_);
+        sqlite3_bind_text  (stmtStats_, 1, ts.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text  (stmtStats_, 2, component.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text  (stmtStats_, 3, kind, -1, SQLITE_STATIC);
+        sqlite3_bind_int64 (stmtStats_, 4, static_cast<sqlite3_int64>(runs));
+        sqlite3_bind_int64 (stmtStats_, 5, static_cast<sqlite3_int64>(h.percentile(0.5)));
+        sqlite3_bind_int64 (stmtStats_, 6, static_cast<sqlite3_int64>(h.percentile(0.99)));
+        sqlite3_bind_int64 (stmtStats_, 7, static_cast<sqlite3_int64>(h.max()));
+        sqlite3_bind_double(stmtStats_, 8, cpuMs);
+        sqlite3_bind_int64 (stmtStats_, 9, static_cast<sqlite3_int64>(syscalls));
+        sqlite3_bind_int64 (stmtStats_,10, static_cast<sqlite3_int64>(opens));
+        sqlite3_bind_int64 (stmtStats_,11, static_cast<sqlite3_int64>(bytes));
+        sqlite3_bind_int64 (stmtStats_,12, static_cast<sqlite3_int64>(dropped));
+        sqlite3_step(stmtStats_);
+    };
+
+    for (const auto& m : stats.modules) {
+        if (!m.enabled) continue;
+        row(m.name, "module", m.updates, m.updateUs, m.cpuMsPerRun,
+            m.syscalls, m.fileOpens, m.bytesRead, 0);
+    }
+    for (const auto& st : stats.stages)
+        row(st.name, "stage", st.processed, st.latencyUs,
+            st.processed ? st.cpuSeconds * 1000.0 / static_cast<double>(st.processed) : 0.0,
+            0, 0, 0, st.dropped);
+}
+
 // ---------------------------------------------------------------------------
 // Alert events
 // ---------------------------------------------------------------------------
@@ -282,7 +450,7 @@ void Database::pruneOlderThan(int days) {
     std::string cutoff = "datetime('now', '-" + std::to_string(days) + " days')";
     const char* tables[] = {
         "cpu_metrics","memory_metrics","network_metrics",
-        "disk_metrics","gpu_metrics","alert_events"
+        "disk_samples","gpu_metrics","alert_events","collector_stats"
     };
     for (auto& t : tables) {
         std::string sql = "DELETE FROM " + std::string(t) +
@@ -472,9 +640,8 @@ bool Database::exec(const char* sql) {
     return true;
 }
 
-std::string Database::currentTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto tt  = std::chrono::system_clock::to_time_t(now);
+std::string Database::formatTimestamp(std::chrono::system_clock::time_point tp) const {
+    auto tt  = std::chrono::system_clock::to_time_t(tp);
     std::tm tm{};
 #ifdef _WIN32
     localtime_s(&tm, &tt);
@@ -4,14 +4,19 @@
  *
  * Uses WAL journal mode for concurrent read performance and prepared
  * statements to prevent SQL injection.  Supports batch inserts via
- * explicit transactions.
+ * explicit transactions.  Disk device, mount point and filesystem names
+ * are dictionary-encoded through a labels table (disk_metrics is a view).
+ * Optionally, the collector's self-instrumentation (per-module update and
+ * per-stage latency and I/O) is stored in collector_stats.
  */
 
 #pragma once
 
 #include "../metrics.h"
+#include <chrono>
 #include <string>
 #include <mutex>
+#include <vector>
 
 struct sqlite3;
 struct sqlite3_stmt;
@@ -30,6 +35,10 @@ public:
     /// Insert a full MetricData snapshot (CPU, Memory, Network, Disk, GPU).
     void insertSnapshot(const MetricData& data);
 
+    /// Also store MetricData::collector module and stage counters on every insertSnapshot().
+    void setRecordCollectorStats(bool enabled);
+    bool recordCollectorStats() const;
+
     /// Insert an alert event.
     void insertAlertEvent(const AlertEvent& ev);
 
@@ -60,9 +69,20 @@ private:
     sqlite3_stmt* stmtDisk_    = nullptr;
     sqlite3_stmt* stmtGpu_     = nullptr;
     sqlite3_stmt* stmtAlert_   = nullptr;
+    sqlite3_stmt* stmtStats_   = nullptr;
+    sqlite3_stmt* stmtLabelIns_ = nullptr;
+    sqlite3_stmt* stmtLabelSel_ = nullptr;
+
+    /// labels.id per InternPool id (0 = not yet known), see labelRow().
+    std::vector<int64_t> labelRows_;
+    bool recordStats_ = false;
 
     void prepareStatements();
     void finalizeStatements();
     bool exec(const char* sql);
-    std::string currentTimestamp() const;
+    bool migrateLegacyDiskTable();
+    int64_t labelRow(Label label);
+    int64_t textRow(const std::string& text);
+    void insertCollectorStats(const std::string& ts, const CollectorStats& stats);
+    std::string formatTimestamp(std::chrono::system_clock::time_point tp) const;
 };
@@ -6,6 +6,9 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
+#include "../events/event_loop.h"
+#include <functional>
 #include <memory>
 
 /**
@@ -25,10 +28,22 @@ public:
      * @return Most recent DiskSnapshot.
      */
     virtual DiskSnapshot snapshot() const = 0;
+
+    /**
+     * @brief Register event sources that signal mount table changes.
+     *
+     * Called once by the Collector. @p onChange runs on the collecting
+     * thread and schedules an immediate update(). The default registers
+     * nothing and the module is only polled.
+     */
+    virtual void watchEvents(EventLoop& loop, std::function<void()> onChange) {
+        (void)loop; (void)onChange;
+    }
 };
 
 /**
  * @brief Create a platform-specific Disk implementation.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  * @return Owning pointer to the concrete Disk instance.
  */
-std::unique_ptr<Disk> createDisk();
+std::unique_ptr<Disk> createDisk(std::shared_ptr<const FileReader> files = hostFileReader());
@@ -17,11 +17,12 @@
  * @brief Create a Disk instance for the current platform.
  * @return Owning pointer to a WindowsDisk or LinuxDisk.
  */
-std::unique_ptr<Disk> createDisk() {
+std::unique_ptr<Disk> createDisk(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsDisk>();
 #elif defined(__linux__)
-    return std::make_unique<LinuxDisk>();
+    return std::make_unique<LinuxDisk>(std::move(files));
 #else
     return nullptr;
 #endif
@@ -6,71 +6,90 @@
 #ifdef __linux__
 
 #include "disk_linux.h"
-
-#include <sys/statvfs.h>
+#include "../io/proc_parse.h"
+#include "../../utils/tracer.h"
 
 #include <algorithm>
 #include <cstring>
-#include <fstream>
-#include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 static constexpr uint64_t SECTOR_SIZE = 512;
 
-LinuxDisk::LinuxDisk()
-    : prevTime_(std::chrono::steady_clock::now())
+namespace {
+
+using proc_parse::forEachLine;
+using proc_parse::parseDec;
+
+const char* skipSpaces(const char* p, const char* eol) {
+    while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+/// The next whitespace-separated field at @p p, before @p eol; advances @p p past it.
+std::string_view nextField(const char*& p, const char* eol) {
+    p = skipSpaces(p, eol);
+    const char* begin = p;
+    while (p < eol && *p != ' ' && *p != '\t') ++p;
+    return std::string_view(begin, static_cast<size_t>(p - begin));
+}
+
+} // namespace
+
+LinuxDisk::LinuxDisk(std::shared_ptr<const FileReader> files)
+    : files_(std::move(files)),
+      prevTime_(files_->now())
 {
-    prevStats_ = readDiskStats();
+    readDiskStats(prevStats_);
 }
 
 void LinuxDisk::update() {
-    DiskSnapshot snap;
-
-    auto mounts = readMounts();
-    for (const auto& m : mounts) {
-        struct statvfs vfs {};
-        if (statvfs(m.mountPoint.c_str(), &vfs) != 0) {
+    // Rebuild the previous snapshot in place so its disk vector is reused.
+    // Entries are overwritten rather than rebuilt so their mount point
+    // strings keep their storage.
+    DiskSnapshot& snap = spare_;
+    std::size_t count = 0;
+
+    readMounts();
+    for (const auto& m : mounts_) {
+        FsUsage usage;
+        if (!files_->statFs(m.mountPoint.c_str(), usage)) {
             continue;
         }
 
-        DiskInfo info;
+        if (count == snap.disks.size()) snap.disks.emplace_back();
+        DiskInfo& info = snap.disks[count++];
+        std::string mountPoint = std::move(info.mountPoint);
+        info = DiskInfo{};
         info.device     = m.device;
-        info.mountPoint = m.mountPoint;
+        info.mountPoint = std::move(mountPoint);
+        info.mountPoint.assign(m.mountPoint);
         info.fsType     = m.fsType;
 
-        uint64_t blockSize = vfs.f_frsize ? vfs.f_frsize : vfs.f_bsize;
-        info.totalBytes = static_cast<uint64_t>(vfs.f_blocks) * blockSize;
-        info.freeBytes  = static_cast<uint64_t>(vfs.f_bfree)  * blockSize;
+        info.totalBytes = usage.totalBytes;
+        info.freeBytes  = usage.freeBytes;
         info.usedBytes  = info.totalBytes - info.freeBytes;
         if (info.totalBytes > 0) {
             info.usagePercent = static_cast<float>(info.usedBytes) * 100.0f
                               / static_cast<float>(info.totalBytes);
         }
         info.temperature = -1.0f;
-
-        snap.disks.push_back(std::move(info));
     }
+    snap.disks.resize(count);
 
-    auto now      = std::chrono::steady_clock::now();
-    auto elapsed  = std::chrono::duration_cast<std::chrono::milliseconds>(now - prevTime_);
-    double dtMs   = static_cast<double>(elapsed.count());
+    auto now      = files_->now();
+    double dtMs   = std::chrono::duration<double, std::milli>(now - prevTime_).count();
     if (dtMs <= 0.0) dtMs = 1.0;
 
-    auto curStats = readDiskStats();
-
-    std::unordered_map<std::string, DiskInfo*> byName;
-    for (auto& d : snap.disks) {
-        std::string shortName = baseDeviceName(d.device);
-        byName[shortName] = &d;
-    }
+    readDiskStats(curStats_);
 
     float totalRead  = 0.0f;
     float totalWrite = 0.0f;
 
-    for (const auto& [name, cur] : curStats) {
-        auto pit = prevStats_.find(name);
+    // A handful of devices: linear lookups beat building maps every tick.
+    for (const auto& [name, cur] : curStats_) {
+        auto pit = std::find_if(prevStats_.begin(), prevStats_.end(),
+                                [name = name](const auto& e) { return e.first == name; });
         if (pit == prevStats_.end()) continue;
         const DiskStats& prev = pit->second;
 
@@ -89,17 +108,18 @@ void LinuxDisk::update() {
         float util     = static_cast<float>(dIo) * 100.0f / static_cast<float>(dtMs);
         if (util > 100.0f) util = 100.0f;
 
-        auto it = byName.find(name);
-        if (it != byName.end()) {
-            DiskInfo* d = it->second;
-            d->readBytesPerSec  = readBps;
-            d->writeBytesPerSec = writeBps;
-            d->readOpsPerSec    = readOps;
-            d->writeOpsPerSec   = writeOps;
-            d->utilizationPct   = util;
+        // The last mount of a device wins, as when these were keyed by name.
+        for (auto it = snap.disks.rbegin(); it != snap.disks.rend(); ++it) {
+            if (baseDeviceName(it->device.str()) != name.str()) continue;
+            it->readBytesPerSec  = readBps;
+            it->writeBytesPerSec = writeBps;
+            it->readOpsPerSec    = readOps;
+            it->writeOpsPerSec   = writeOps;
+            it->utilizationPct   = util;
+            break;
         }
 
-        if (isRealDiskName(name)) {
+        if (isRealDiskName(name.str())) {
             totalRead  += readBps;
             totalWrite += writeBps;
         }
@@ -108,11 +128,11 @@ void LinuxDisk::update() {
     snap.totalReadRate  = totalRead;
     snap.totalWriteRate = totalWrite;
 
-    prevStats_ = std::move(curStats);
+    std::swap(prevStats_, curStats_);
     prevTime_  = now;
 
     std::lock_guard<std::mutex> lock(mutex_);
-    current_ = std::move(snap);
+    std::swap(current_, spare_);
 }
 
 DiskSnapshot LinuxDisk::snapshot() const {
@@ -120,63 +140,77 @@ DiskSnapshot LinuxDisk::snapshot() const {
     return current_;
 }
 
-std::vector<LinuxDisk::MountEntry> LinuxDisk::readMounts() const {
-    std::vector<MountEntry> results;
-    std::ifstream fin("/proc/mounts");
-    if (!fin.is_open()) return results;
-
-    std::string line;
-    while (std::getline(fin, line)) {
-        std::istringstream ss(line);
-        MountEntry e;
-        std::string opts;
-        int dump = 0, pass = 0;
-        if (!(ss >> e.device >> e.mountPoint >> e.fsType)) continue;
-
-        if (!isRealDevice(e.device)) continue;
+void LinuxDisk::watchEvents(EventLoop& loop, std::function<void()> onChange) {
+    if (!files_->isHost()) return;
+    int fd = openMountWatch();
+    mountWatch_.watch(loop, fd, EventLoop::Priority,
+                      [fd, onChange](uint32_t) {
+                          consumeMountChange(fd);
+                          onChange();
+                      });
+}
 
-        results.push_back(std::move(e));
+void LinuxDisk::readMounts() {
+    std::size_t count = 0;
+    if (files_->read("/proc/mounts", mountsBuf_)) {
+        forEachLine(mountsBuf_, [this, &count](const char* p, size_t len) {
+            const char* eol = p + len;
+            std::string_view device     = nextField(p, eol);
+            std::string_view mountPoint = nextField(p, eol);
+            std::string_view fsType     = nextField(p, eol);
+            if (fsType.empty() || !isRealDevice(device)) return true;
+            if (count == mounts_.size()) mounts_.emplace_back();
+            MountEntry& m = mounts_[count++];
+            m.device = device;
+            m.mountPoint.assign(mountPoint);
+            m.fsType = fsType;
+            return true;
+        });
     }
-    return results;
+    mounts_.resize(count);
 }
 
-std::unordered_map<std::string, LinuxDisk::DiskStats>
-LinuxDisk::readDiskStats() const {
-    std::unordered_map<std::string, DiskStats> result;
-    std::ifstream fin("/proc/diskstats");
-    if (!fin.is_open()) return result;
-
-    std::string line;
-    while (std::getline(fin, line)) {
-        std::istringstream ss(line);
-        int major = 0, minor = 0;
-        std::string name;
-        if (!(ss >> major >> minor >> name)) continue;
-
-        if (!isRealDiskName(name) && name.find("sd") == std::string::npos &&
-            name.find("nvme") == std::string::npos && name.find("vd") == std::string::npos) {
-            continue;
+void LinuxDisk::readDiskStats(DiskStatsList& out) {
+    TraceSpan span("parse", "/proc/diskstats");
+    out.clear();
+    if (files_->read("/proc/diskstats", statsBuf_)) parseDiskStats(statsBuf_, out);
+}
+
+void LinuxDisk::parseDiskStats(const std::string& text, DiskStatsList& out) {
+    out.clear();
+    forEachLine(text, [&out](const char* p, size_t len) {
+        const char* eol = p + len;
+        uint64_t major = 0, minor = 0;
+        if (!parseDec(p, eol, major) || !parseDec(p, eol, minor)) return true;
+        std::string_view name = nextField(p, eol);
+        if (name.empty()) return true;
+
+        if (!isRealDiskName(name) && name.find("sd") == std::string_view::npos &&
+            name.find("nvme") == std::string_view::npos && name.find("vd") == std::string_view::npos) {
+            return true;
         }
 
         DiskStats ds;
-        uint64_t ignore;
-        if (!(ss >> ds.readsCompleted >> ignore >> ds.sectorsRead >> ignore
-                 >> ds.writesCompleted >> ignore >> ds.sectorsWritten >> ignore
-                 >> ignore >> ds.ioTicks)) {
-            continue;
+        uint64_t ignore = 0;
+        if (!(parseDec(p, eol, ds.readsCompleted) && parseDec(p, eol, ignore)
+              && parseDec(p, eol, ds.sectorsRead) && parseDec(p, eol, ignore)
+              && parseDec(p, eol, ds.writesCompleted) && parseDec(p, eol, ignore)
+              && parseDec(p, eol, ds.sectorsWritten) && parseDec(p, eol, ignore)
+              && parseDec(p, eol, ignore) && parseDec(p, eol, ds.ioTicks))) {
+            return true;
         }
-        result[name] = ds;
-    }
-    return result;
+        out.emplace_back(Label(name), ds);
+        return true;
+    });
 }
 
-std::string LinuxDisk::baseDeviceName(const std::string& device) {
+std::string_view LinuxDisk::baseDeviceName(std::string_view device) {
     auto pos = device.rfind('/');
-    if (pos != std::string::npos) return device.substr(pos + 1);
+    if (pos != std::string_view::npos) return device.substr(pos + 1);
     return device;
 }
 
-bool LinuxDisk::isRealDevice(const std::string& devPath) {
+bool LinuxDisk::isRealDevice(std::string_view devPath) {
     if (devPath.rfind("/dev/sd",   0) == 0) return true;
     if (devPath.rfind("/dev/nvme", 0) == 0) return true;
     if (devPath.rfind("/dev/vd",   0) == 0) return true;
@@ -185,12 +219,12 @@ bool LinuxDisk::isRealDevice(const std::string& devPath) {
     return false;
 }
 
-bool LinuxDisk::isRealDiskName(const std::string& name) {
+bool LinuxDisk::isRealDiskName(std::string_view name) {
     if (name.rfind("sd",   0) == 0 && name.size() <= 3) return true;
     if (name.rfind("vd",   0) == 0 && name.size() <= 3) return true;
     if (name.rfind("xvd",  0) == 0 && name.size() <= 4) return true;
     if (name.rfind("hd",   0) == 0 && name.size() <= 3) return true;
-    if (name.rfind("nvme", 0) == 0 && name.find('p') == std::string::npos) return true;
+    if (name.rfind("nvme", 0) == 0 && name.find('p') == std::string_view::npos) return true;
     return false;
 }
 
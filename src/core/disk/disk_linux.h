@@ -8,12 +8,16 @@
 #ifdef __linux__
 
 #include "disk_common.h"
+#include "../events/event_sources_linux.h"
+#include "../io/file_reader.h"
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 /**
@@ -21,7 +25,8 @@
  */
 class LinuxDisk : public Disk {
 public:
-    LinuxDisk();
+    /// @param files Where /proc is read from; mount points are looked up beneath its root.
+    explicit LinuxDisk(std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxDisk() override = default;
 
     /**
@@ -35,7 +40,13 @@ public:
      */
     DiskSnapshot snapshot() const        override;
 
-private:
+    /**
+     * @brief Watch /proc/self/mounts so new and removed mounts show up at once.
+     *
+     * Only on the live host; a synthetic tree's mounts do not change.
+     */
+    void         watchEvents(EventLoop& loop, std::function<void()> onChange) override;
+
     /**
      * @brief Raw I/O counters from one /proc/diskstats entry.
      */
@@ -47,53 +58,71 @@ private:
         uint64_t ioTicks         = 0; ///< Milliseconds spent doing I/O
     };
 
+    /// Raw counters by short device name (e.g. "sda"), in /proc/diskstats order.
+    using DiskStatsList = std::vector<std::pair<Label, DiskStats>>;
+
+    /**
+     * @brief Parse the text of /proc/diskstats, keeping disk-like devices.
+     * @param text Whole file contents.
+     * @param out  Cleared, then filled with one entry per device.
+     */
+    static void parseDiskStats(const std::string& text, DiskStatsList& out);
+
+private:
     /**
      * @brief One entry parsed from /proc/mounts.
      */
     struct MountEntry {
-        std::string device;     ///< Device path, e.g. /dev/sda1
-        std::string mountPoint; ///< Mount point path
-        std::string fsType;     ///< Filesystem type, e.g. ext4
+        Label device;     ///< Device path, e.g. /dev/sda1
+        std::string mountPoint; ///< Mount point path (not interned: bind mounts churn)
+        Label fsType;     ///< Filesystem type, e.g. ext4
     };
 
     /**
-     * @brief Parse /proc/mounts for real block devices.
-     * @return List of mount entries.
+     * @brief Parse /proc/mounts for real block devices into mounts_.
      */
-    std::vector<MountEntry> readMounts() const;
+    void readMounts();
 
     /**
-     * @brief Parse /proc/diskstats for I/O counters.
-     * @return Map of device name to raw I/O stats.
+     * @brief Read and parse /proc/diskstats for I/O counters.
+     * @param out Receives the raw I/O stats per device.
      */
-    std::unordered_map<std::string, DiskStats> readDiskStats() const;
+    void readDiskStats(DiskStatsList& out);
 
     /**
      * @brief Extract short device name from a full path (e.g. "/dev/sda1" -> "sda1").
      * @param device Full device path.
      * @return Short device name.
      */
-    static std::string baseDeviceName(const std::string& device);
+    static std::string_view baseDeviceName(std::string_view device);
 
     /**
      * @brief Check if a device path refers to a real block device.
      * @param devPath Device path to check.
      * @return True if it is a recognized block device.
      */
-    static bool isRealDevice(const std::string& devPath);
+    static bool isRealDevice(std::string_view devPath);
 
     /**
      * @brief Check if a name is a whole-disk device (not a partition).
      * @param name Short device name.
      * @return True for whole-disk names like sda, nvme0n1.
      */
-    static bool isRealDiskName(const std::string& name);
-
-    std::unordered_map<std::string, DiskStats> prevStats_; ///< Previous tick stats for delta computation
+    static bool isRealDiskName(std::string_view name);
+
+    std::shared_ptr<const FileReader>          files_;     ///< Source of /proc
+    DiskStatsList                              prevStats_; ///< Previous tick stats for delta computation
+    DiskStatsList                              curStats_;  ///< This tick's stats; swapped with prevStats_
+    std::vector<MountEntry>                    mounts_;    ///< This tick's real-device mounts
+    std::string                                statsBuf_;  ///< Reused /proc/diskstats read buffer
+    std::string                                mountsBuf_; ///< Reused /proc/mounts read buffer
     std::chrono::steady_clock::time_point      prevTime_;  ///< Timestamp of previous tick
 
     mutable std::mutex mutex_;   ///< Protects current_
     DiskSnapshot       current_; ///< Latest snapshot
+    DiskSnapshot       spare_;   ///< Previous current_, rebuilt in place by update()
+
+    WatchedFd          mountWatch_; ///< /proc/self/mounts change notification
 };
 
 #endif
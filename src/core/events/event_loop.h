@@ -0,0 +1,77 @@
+/**
+ * @file event_loop.h
+ * @brief Abstract event loop the collecting thread sleeps in.
+ *
+ * The Collector waits for its next tick inside an EventLoop instead of a
+ * plain sleep. Monitoring modules register file descriptors that become
+ * ready when something changes (a PSI trigger fires, the mount table is
+ * edited, a netlink link/address notification arrives); their callback
+ * runs on the collecting thread and can request an immediate update, so
+ * changes are reported without waiting for the next poll.
+ *
+ * On Linux this is one epoll set with a timerfd for the tick deadline and
+ * an eventfd for wake-ups. Elsewhere a condition-variable fallback
+ * provides the timer and wake-up but no descriptor sources.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Abstract interface for the platform event loop.
+ */
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Readiness flags passed to addFd() and to callbacks.
+    enum Events : uint32_t {
+        Readable = 1u << 0, ///< Data to read (EPOLLIN).
+        Priority = 1u << 1, ///< Exceptional condition (EPOLLPRI: PSI, /proc/mounts).
+        Error    = 1u << 2  ///< Error or hang-up on the descriptor.
+    };
+
+    /// Invoked on the looping thread with the Events that are ready.
+    using Callback = std::function<void(uint32_t events)>;
+
+    virtual ~EventLoop() = default;
+
+    /**
+     * @brief Watch a descriptor. The caller keeps ownership of @p fd and
+     *        must call removeFd() before closing it.
+     * @param fd     Descriptor to watch (level-triggered).
+     * @param events Events of interest.
+     * @param cb     Called whenever any of @p events is ready.
+     * @return false if the descriptor could not be added or the loop does
+     *         not support descriptor sources.
+     */
+    virtual bool addFd(int fd, uint32_t events, Callback cb) = 0;
+
+    /// @brief Stop watching @p fd. Safe to call for unknown descriptors.
+    virtual void removeFd(int fd) = 0;
+
+    /**
+     * @brief Dispatch descriptor callbacks until @p deadline or wake().
+     *
+     * A wake() that happens while nobody is waiting is remembered, so the
+     * next call returns immediately. Also returns early if interrupted by
+     * a signal.
+     */
+    virtual void runUntil(Clock::time_point deadline) = 0;
+
+    /// @brief End the current (or next) runUntil(). Thread-safe.
+    virtual void wake() = 0;
+
+    /// @brief Whether addFd() can succeed on this platform.
+    virtual bool supportsFds() const = 0;
+};
+
+/**
+ * @brief Create the best event loop for this platform.
+ * @return epoll-based loop on Linux (if available), portable fallback otherwise.
+ */
+std::unique_ptr<EventLoop> createEventLoop();
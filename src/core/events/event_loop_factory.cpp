@@ -0,0 +1,23 @@
+/**
+ * @file event_loop_factory.cpp
+ * @brief Creates the platform-appropriate EventLoop implementation.
+ */
+
+#include "event_loop.h"
+#include "event_loop_portable.h"
+
+#ifdef __linux__
+#include "event_loop_linux.h"
+#endif
+
+/**
+ * @brief Create an EventLoop for the current platform.
+ * @return LinuxEventLoop when its kernel objects can be created, else PortableEventLoop.
+ */
+std::unique_ptr<EventLoop> createEventLoop() {
+#ifdef __linux__
+    auto loop = std::make_unique<LinuxEventLoop>();
+    if (loop->valid()) return loop;
+#endif
+    return std::make_unique<PortableEventLoop>();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file event_loop_linux.cpp
+ * @brief epoll-based event loop with timerfd deadlines and eventfd wake-ups.
+ */
+
+#ifdef __linux__
+
+#include "event_loop_linux.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace {
+
+constexpr int kMaxEvents = 16;
+
+uint32_t toEpoll(uint32_t events) {
+    uint32_t e = 0;
+    if (events & EventLoop::Readable) e |= EPOLLIN;
+    if (events & EventLoop::Priority) e |= EPOLLPRI;
+    return e;  // EPOLLERR / EPOLLHUP are always reported
+}
+
+uint32_t fromEpoll(uint32_t e) {
+    uint32_t events = 0;
+    if (e & EPOLLIN)               events |= EventLoop::Readable;
+    if (e & EPOLLPRI)              events |= EventLoop::Priority;
+    if (e & (EPOLLERR | EPOLLHUP)) events |= EventLoop::Error;
+    return events;
+}
+
+void drain(int fd) {
+    uint64_t v;
+    while (read(fd, &v, sizeof(v)) == static_cast<ssize_t>(sizeof(v))) {}
+}
+
+} // namespace
+
+LinuxEventLoop::LinuxEventLoop() {
+    epfd_    = epoll_create1(EPOLL_CLOEXEC);
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    wakeFd_  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!valid()) return;
+
+    for (int fd : {timerFd_, wakeFd_}) {
+        epoll_event ev{};
+        ev.events  = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+}
+
+LinuxEventLoop::~LinuxEventLoop() {
+    for (int fd : {wakeFd_, timerFd_, epfd_})
+        if (fd >= 0) close(fd);
+}
+
+bool LinuxEventLoop::addFd(int fd, uint32_t events, Callback cb) {
+    if (!valid() || fd < 0 || !cb) return false;
+    epoll_event ev{};
+    ev.events  = toEpoll(events);
+    ev.data.fd = fd;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) != 0) return false;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    handlers_[fd] = std::make_shared<Callback>(std::move(cb));
+    return true;
+}
+
+void LinuxEventLoop::removeFd(int fd) {
+    if (!valid()) return;
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+    std::lock_guard<std::mutex> lock(mtx_);
+    handlers_.erase(fd);
+}
+
+void LinuxEventLoop::runUntil(Clock::time_point deadline) {
+    // An already-passed deadline still gives ready descriptors (and a
+    // pending wake-up) one non-blocking pass.
+    bool pollOnce = deadline <= Clock::now();
+    if (!pollOnce) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      deadline.time_since_epoch()).count();
+        itimerspec its{};
+        its.it_value.tv_sec  = static_cast<time_t>(ns / 1000000000);
+        its.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+        // Re-arming also clears an expiry left over from an earlier wait.
+        timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &its, nullptr);
+    }
+
+    epoll_event evs[kMaxEvents];
+    for (;;) {
+        int n = epoll_wait(epfd_, evs, kMaxEvents, pollOnce ? 0 : -1);
+        if (n < 0) return;  // EINTR: let the caller check its stop flag
+
+        bool done = pollOnce;
+        for (int i = 0; i < n; ++i) {
+            int fd = evs[i].data.fd;
+            if (fd == timerFd_ || fd == wakeFd_) {
+                drain(fd);
+                done = true;
+                continue;
+            }
+            std::shared_ptr<Callback> cb;
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                auto it = handlers_.find(fd);
+                if (it != handlers_.end()) cb = it->second;
+            }
+            if (cb) (*cb)(fromEpoll(evs[i].events));
+        }
+        if (done) return;
+    }
+}
+
+void LinuxEventLoop::wake() {
+    uint64_t one = 1;
+    ssize_t r = write(wakeFd_, &one, sizeof(one));
+    (void)r;  // EAGAIN means a wake-up is already pending
+}
+
+#endif // __linux__
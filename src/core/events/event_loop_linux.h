@@ -0,0 +1,48 @@
+/**
+ * @file event_loop_linux.h
+ * @brief epoll + timerfd + eventfd implementation of EventLoop.
+ */
+
+#pragma once
+
+#ifdef __linux__
+
+#include "event_loop.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Linux EventLoop built on a single epoll set.
+ *
+ * The tick deadline is an absolute CLOCK_MONOTONIC timerfd (the clock
+ * behind std::chrono::steady_clock), so the wake-up is nanosecond-exact
+ * rather than rounded to epoll_wait's millisecond timeout. wake() writes
+ * to an eventfd.
+ */
+class LinuxEventLoop : public EventLoop {
+public:
+    LinuxEventLoop();
+    ~LinuxEventLoop() override;
+
+    /// @brief Whether the epoll, timer and wake descriptors were created.
+    bool valid() const { return epfd_ >= 0 && timerFd_ >= 0 && wakeFd_ >= 0; }
+
+    bool addFd(int fd, uint32_t events, Callback cb) override;
+    void removeFd(int fd) override;
+    void runUntil(Clock::time_point deadline) override;
+    void wake() override;
+    bool supportsFds() const override { return true; }
+
+private:
+    int epfd_    = -1;
+    int timerFd_ = -1;
+    int wakeFd_  = -1;
+
+    std::mutex mtx_;  ///< Guards handlers_.
+    /// Callbacks by descriptor; shared so removeFd() during dispatch is safe.
+    std::unordered_map<int, std::shared_ptr<Callback>> handlers_;
+};
+
+#endif // __linux__
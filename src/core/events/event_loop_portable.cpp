@@ -0,0 +1,20 @@
+/**
+ * @file event_loop_portable.cpp
+ * @brief Condition-variable implementation of EventLoop.
+ */
+
+#include "event_loop_portable.h"
+
+void PortableEventLoop::runUntil(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait_until(lock, deadline, [this] { return woken_; });
+    woken_ = false;
+}
+
+void PortableEventLoop::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        woken_ = true;
+    }
+    cv_.notify_all();
+}
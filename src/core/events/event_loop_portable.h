@@ -0,0 +1,31 @@
+/**
+ * @file event_loop_portable.h
+ * @brief Condition-variable event loop: timer and wake-up only.
+ */
+
+#pragma once
+
+#include "event_loop.h"
+
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief Fallback EventLoop without descriptor sources.
+ *
+ * Used on Windows and on Linux if epoll, timerfd or eventfd cannot be
+ * created. Modules then simply fall back to being polled.
+ */
+class PortableEventLoop : public EventLoop {
+public:
+    bool addFd(int, uint32_t, Callback) override { return false; }
+    void removeFd(int) override {}
+    void runUntil(Clock::time_point deadline) override;
+    void wake() override;
+    bool supportsFds() const override { return false; }
+
+private:
+    std::mutex              mtx_;
+    std::condition_variable cv_;
+    bool                    woken_ = false;
+};
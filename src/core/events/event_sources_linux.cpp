@@ -0,0 +1,103 @@
+/**
+ * @file event_sources_linux.cpp
+ * @brief PSI trigger, mount-table and rtnetlink change notifications.
+ */
+
+#ifdef __linux__
+
+#include "event_sources_linux.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+bool WatchedFd::watch(EventLoop& loop, int fd, uint32_t events, EventLoop::Callback cb) {
+    reset();
+    if (fd < 0) return false;
+    if (!loop.addFd(fd, events, std::move(cb))) {
+        close(fd);
+        return false;
+    }
+    loop_ = &loop;
+    fd_   = fd;
+    return true;
+}
+
+void WatchedFd::reset() {
+    if (fd_ < 0) return;
+    if (loop_) loop_->removeFd(fd_);
+    close(fd_);
+    fd_   = -1;
+    loop_ = nullptr;
+}
+
+int openPsiTrigger(const char* path, unsigned stallUs, unsigned windowUs) {
+    int fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+    char spec[64];
+    int len = snprintf(spec, sizeof(spec), "some %u %u", stallUs, windowUs);
+    // The trigger string must include the terminating NUL.
+    if (write(fd, spec, static_cast<size_t>(len) + 1) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int openMountWatch() {
+    return open("/proc/self/mounts", O_RDONLY | O_CLOEXEC);
+}
+
+void consumeMountChange(int fd) {
+    // The kernel clears the pending event once the file has been re-read.
+    char buf[4096];
+    lseek(fd, 0, SEEK_SET);
+    while (read(fd, buf, sizeof(buf)) > 0) {}
+}
+
+int openLinkWatch() {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) return -1;
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool consumeLinkMessages(int fd) {
+    alignas(nlmsghdr) char buf[8192];
+    bool relevant = false;
+    for (;;) {
+        ssize_t len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (len < 0 && errno == ENOBUFS) {
+            // The socket overflowed and messages were lost; assume a change.
+            relevant = true;
+            continue;
+        }
+        if (len <= 0) break;
+        auto remaining = static_cast<unsigned>(len);
+        for (auto* nh = reinterpret_cast<nlmsghdr*>(buf); NLMSG_OK(nh, remaining);
+             nh = NLMSG_NEXT(nh, remaining)) {
+            switch (nh->nlmsg_type) {
+                case RTM_NEWLINK: case RTM_DELLINK:
+                case RTM_NEWADDR: case RTM_DELADDR:
+                    relevant = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return relevant;
+}
+
+#endif // __linux__
@@ -0,0 +1,75 @@
+/**
+ * @file event_sources_linux.h
+ * @brief Kernel change-notification descriptors used by the Linux modules.
+ */
+
+#pragma once
+
+#ifdef __linux__
+
+#include "event_loop.h"
+
+/**
+ * @brief Descriptor registered with an EventLoop, removed and closed on destruction.
+ */
+class WatchedFd {
+public:
+    WatchedFd() = default;
+    ~WatchedFd() { reset(); }
+
+    WatchedFd(const WatchedFd&) = delete;
+    WatchedFd& operator=(const WatchedFd&) = delete;
+
+    /**
+     * @brief Take ownership of @p fd and register it with @p loop.
+     * @return false (and @p fd is closed) if registration failed.
+     */
+    bool watch(EventLoop& loop, int fd, uint32_t events, EventLoop::Callback cb);
+
+    /// @brief Unregister and close the descriptor, if any.
+    void reset();
+
+    int  fd()     const { return fd_; }
+    bool active() const { return fd_ >= 0; }
+
+private:
+    EventLoop* loop_ = nullptr;
+    int        fd_   = -1;
+};
+
+/**
+ * @brief Open a PSI trigger (Documentation/accounting/psi.rst).
+ *
+ * The descriptor reports Priority when stall time in any @p windowUs
+ * window exceeds @p stallUs. Unprivileged triggers need a window that is
+ * a multiple of 2 s.
+ *
+ * @param path     "/proc/pressure/cpu", "/proc/pressure/memory", ...
+ * @return Descriptor, or -1 if PSI is unavailable or not permitted.
+ */
+int openPsiTrigger(const char* path, unsigned stallUs, unsigned windowUs);
+
+/**
+ * @brief Open /proc/self/mounts for change notification.
+ *
+ * Reports Priority | Error whenever the mount table changes; the event
+ * stays pending until consumeMountChange() is called.
+ */
+int openMountWatch();
+
+/// @brief Acknowledge a mount-table change on a descriptor from openMountWatch().
+void consumeMountChange(int fd);
+
+/**
+ * @brief Open a NETLINK_ROUTE socket subscribed to link and address changes.
+ * @return Non-blocking descriptor, or -1.
+ */
+int openLinkWatch();
+
+/**
+ * @brief Read every pending message from a socket from openLinkWatch().
+ * @return true if any link or address message was among them.
+ */
+bool consumeLinkMessages(int fd);
+
+#endif // __linux__
@@ -0,0 +1,112 @@
+/**
+ * @file drm_fdinfo.cpp
+ * @brief DRM fdinfo usage-key parser shared by the per-process GPU accounting.
+ */
+
+#include "drm_fdinfo.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+/// Strip leading and trailing blanks (fdinfo values are tab-separated).
+std::string trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return {};
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+/// Parse "<number> [unit]" where unit is one of ns, KiB, MiB, GiB or empty.
+uint64_t parseQuantity(const std::string& value) {
+    char* end = nullptr;
+    uint64_t n = std::strtoull(value.c_str(), &end, 10);
+    std::string unit = trim(end ? std::string(end) : std::string());
+    if (unit == "KiB") return n * 1024ull;
+    if (unit == "MiB") return n * 1024ull * 1024ull;
+    if (unit == "GiB") return n * 1024ull * 1024ull * 1024ull;
+    return n;
+}
+
+bool startsWith(const std::string& s, const char* prefix) {
+    return s.rfind(prefix, 0) == 0;
+}
+
+/// Device-local memory regions: amdgpu/xe name them "vram*", i915 "local*".
+bool isVramRegion(const std::string& region) {
+    return startsWith(region, "vram") || startsWith(region, "local");
+}
+
+DrmEngineUsage& engineFor(DrmClientUsage& out, const std::string& name) {
+    for (auto& e : out.engines) {
+        if (e.name == name) return e;
+    }
+    out.engines.push_back(DrmEngineUsage{});
+    out.engines.back().name = name;
+    return out.engines.back();
+}
+
+} // namespace
+
+bool parseDrmFdinfo(const std::string& text, DrmClientUsage& out) {
+    out = DrmClientUsage{};
+    bool haveClient = false;
+    bool haveResident = false;
+    uint64_t residentVram = 0;
+    uint64_t memoryVram = 0;
+
+    std::istringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line)) {
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string key = line.substr(0, colon);
+        if (!startsWith(key, "drm-")) continue;
+        std::string value = trim(line.substr(colon + 1));
+
+        if (key == "drm-driver") {
+            out.driver = value;
+        } else if (key == "drm-pdev") {
+            out.pdev = value;
+        } else if (key == "drm-client-id") {
+            out.clientId = std::strtoull(value.c_str(), nullptr, 10);
+            haveClient = true;
+        } else if (startsWith(key, "drm-engine-capacity-")) {
+            unsigned cap = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+            engineFor(out, key.substr(20)).capacity = std::max(1u, cap);
+        } else if (startsWith(key, "drm-engine-")) {
+            engineFor(out, key.substr(11)).busyNs = parseQuantity(value);
+        } else if (startsWith(key, "drm-total-cycles-")) {
+            engineFor(out, key.substr(17)).totalCycles = parseQuantity(value);
+        } else if (startsWith(key, "drm-cycles-")) {
+            engineFor(out, key.substr(11)).cycles = parseQuantity(value);
+        } else if (startsWith(key, "drm-resident-")) {
+            if (isVramRegion(key.substr(13))) {
+                residentVram += parseQuantity(value);
+                haveResident = true;
+            }
+        } else if (startsWith(key, "drm-memory-")) {
+            // Legacy amdgpu key, equivalent to drm-resident-<region>.
+            if (isVramRegion(key.substr(11))) memoryVram += parseQuantity(value);
+        }
+    }
+
+    out.vramBytes = haveResident ? residentVram : memoryVram;
+    return haveClient;
+}
+
+float drmEngineBusyPercent(const DrmEngineUsage& prev, const DrmEngineUsage& cur,
+                           double wallNs) {
+    double pct = 0.0;
+    if (cur.totalCycles > prev.totalCycles) {
+        double busy  = static_cast<double>(cur.cycles - std::min(prev.cycles, cur.cycles));
+        double total = static_cast<double>(cur.totalCycles - prev.totalCycles);
+        pct = 100.0 * busy / total;
+    } else if (wallNs > 0.0 && cur.busyNs >= prev.busyNs) {
+        pct = 100.0 * static_cast<double>(cur.busyNs - prev.busyNs) / wallNs;
+    }
+    pct /= static_cast<double>(std::max(1u, cur.capacity));
+    return static_cast<float>(std::clamp(pct, 0.0, 100.0));
+}
@@ -0,0 +1,56 @@
+/**
+ * @file drm_fdinfo.h
+ * @brief Parser for the per-client DRM usage keys in /proc/[pid]/fdinfo/[fd].
+ *
+ * The amdgpu, i915 and xe drivers publish per-client GPU statistics in
+ * the fdinfo of every open DRM file descriptor (see the kernel's
+ * Documentation/gpu/drm-usage-stats.rst). The parser here is pure string
+ * handling so it can be exercised against recorded fixtures on any host.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Cumulative counters for one engine class of a DRM client.
+struct DrmEngineUsage {
+    std::string name;             ///< Engine class ("gfx", "render", "rcs", ...).
+    uint64_t    busyNs      = 0;  ///< drm-engine-<name>: busy time in nanoseconds.
+    uint64_t    cycles      = 0;  ///< drm-cycles-<name>: busy GPU cycles (xe).
+    uint64_t    totalCycles = 0;  ///< drm-total-cycles-<name>: elapsed GPU cycles (xe).
+    unsigned    capacity    = 1;  ///< drm-engine-capacity-<name>: engines in the class.
+};
+
+/// @brief Usage keys of one DRM client (one open device context).
+struct DrmClientUsage {
+    std::string driver;           ///< drm-driver ("amdgpu", "i915", "xe").
+    std::string pdev;             ///< drm-pdev PCI address of the device.
+    uint64_t    clientId  = 0;    ///< drm-client-id, unique per device.
+    uint64_t    vramBytes = 0;    ///< Resident device-local memory in bytes.
+    std::vector<DrmEngineUsage> engines; ///< Per-engine-class counters.
+};
+
+/**
+ * @brief Parse the text of a DRM fdinfo file.
+ * @param text Full contents of /proc/[pid]/fdinfo/[fd].
+ * @param out  Receives the parsed client usage.
+ * @return true if the text describes a DRM client (drm-client-id present).
+ */
+bool parseDrmFdinfo(const std::string& text, DrmClientUsage& out);
+
+/**
+ * @brief Busy percentage of one engine class between two samples.
+ *
+ * Cycle counters are preferred when the driver reports them (xe);
+ * otherwise the busy-time delta is divided by the wall-clock delta.
+ * The result is normalised by the engine class capacity.
+ *
+ * @param prev   Earlier sample of the engine.
+ * @param cur    Later sample of the same engine and client.
+ * @param wallNs Wall-clock nanoseconds between the two samples.
+ * @return Busy percentage (0-100).
+ */
+float drmEngineBusyPercent(const DrmEngineUsage& prev, const DrmEngineUsage& cur,
+                           double wallNs);
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
 #include <memory>
 
 /**
@@ -29,6 +30,7 @@ public:
 
 /**
  * @brief Create a platform-specific GPU monitor instance.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  * @return Owning pointer to the concrete GPU implementation.
  */
-std::unique_ptr<GPU> createGPU();
+std::unique_ptr<GPU> createGPU(std::shared_ptr<const FileReader> files = hostFileReader());
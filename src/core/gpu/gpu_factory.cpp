@@ -17,11 +17,12 @@
  * @brief Create a GPU monitor for the current platform.
  * @return Owning pointer to a WindowsGPU or LinuxGPU instance.
  */
-std::unique_ptr<GPU> createGPU() {
+std::unique_ptr<GPU> createGPU(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsGPU>();
 #elif defined(__linux__)
-    return std::make_unique<LinuxGPU>();
+    return std::make_unique<LinuxGPU>(std::move(files));
 #else
     return nullptr;
 #endif
@@ -11,55 +11,60 @@
 
 #include <algorithm>
 #include <cstring>
-#include <filesystem>
-#include <fstream>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
-namespace fs = std::filesystem;
-
-LinuxGPU::LinuxGPU() {
-    loadNvml();
+LinuxGPU::LinuxGPU(std::shared_ptr<const FileReader> files)
+    : files_(std::move(files))
+{
+    if (files_->isHost()) loadNvml();  // a synthetic tree has no NVIDIA driver behind it
 }
 
 LinuxGPU::~LinuxGPU() {
     unloadNvml();
 }
 
-int64_t LinuxGPU::readSysfsInt(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) return -1;
-    int64_t val = -1;
-    f >> val;
-    return f.fail() ? -1 : val;
+int64_t LinuxGPU::readSysfsInt(const std::string& path) const {
+    std::string text;
+    if (!files_->read(path.c_str(), text)) return -1;
+    char* end = nullptr;
+    long long val = std::strtoll(text.c_str(), &end, 10);
+    return end == text.c_str() ? -1 : static_cast<int64_t>(val);
 }
 
-std::string LinuxGPU::readSysfsString(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) return {};
+std::string LinuxGPU::readSysfsString(const std::string& path) const {
     std::string line;
-    std::getline(f, line);
-    while (!line.empty() && (line.back() == '\n' || line.back() == '\r' || line.back() == ' '))
+    if (!files_->read(path.c_str(), line)) return {};
+    auto nl = line.find('\n');
+    if (nl != std::string::npos) line.erase(nl);
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
         line.pop_back();
     return line;
 }
 
-std::string LinuxGPU::findHwmonDir(const std::string& devicePath) {
+std::string LinuxGPU::readDriverName(const std::string& devicePath) const {
+    std::string target;
+    if (!files_->readLink((devicePath + "/driver").c_str(), target)) return {};
+    auto slash = target.rfind('/');
+    return slash == std::string::npos ? target : target.substr(slash + 1);
+}
+
+std::string LinuxGPU::findHwmonDir(const std::string& devicePath) const {
     std::string hwmonBase = devicePath + "/hwmon";
-    try {
-        for (const auto& entry : fs::directory_iterator(hwmonBase)) {
-            if (entry.is_directory()) {
-                return entry.path().string();
-            }
-        }
-    } catch (...) {}
-    return {};
+    std::string found;
+    files_->forEachEntry(hwmonBase.c_str(), [&](const char* name) {
+        found = hwmonBase + "/" + name;
+        return false;
+    });
+    return found;
 }
 
-float LinuxGPU::parseActiveDpmFreq(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) return 0.0f;
+float LinuxGPU::parseActiveDpmFreq(const std::string& path) const {
+    std::string text;
+    if (!files_->read(path.c_str(), text)) return 0.0f;
 
+    std::istringstream f(text);
     std::string line;
     while (std::getline(f, line)) {
         if (line.find('*') != std::string::npos) {
@@ -179,26 +184,27 @@ void LinuxGPU::queryNvml(std::vector<GpuInfo>& out) {
     }
 }
 
+std::vector<std::string> LinuxGPU::drmCards() const {
+    std::vector<std::string> cards;
+    files_->forEachEntry("/sys/class/drm", [&cards](const char* name) {
+        // "card0" is a GPU; "card0-DP-1" is one of its connectors.
+        if (std::strncmp(name, "card", 4) == 0 && !std::strchr(name, '-'))
+            cards.push_back(std::string("/sys/class/drm/") + name);
+        return true;
+    });
+    std::sort(cards.begin(), cards.end());
+    return cards;
+}
+
 void LinuxGPU::queryAmdgpu(std::vector<GpuInfo>& out) {
     try {
-        for (const auto& card : fs::directory_iterator("/sys/class/drm")) {
-            std::string cardName = card.path().filename().string();
-
-            if (cardName.compare(0, 4, "card") != 0) continue;
-            if (cardName.find('-') != std::string::npos) continue;
-
-            std::string devPath = card.path().string() + "/device";
+        for (const auto& cardPath : drmCards()) {
+            std::string devPath = cardPath + "/device";
 
             std::string vendorStr = readSysfsString(devPath + "/vendor");
             if (vendorStr.find("0x1002") == std::string::npos) continue;
 
-            {
-                std::string driverLink = devPath + "/driver";
-                try {
-                    auto target = fs::read_symlink(driverLink).filename().string();
-                    if (target != "amdgpu") continue;
-                } catch (...) { continue; }
-            }
+            if (readDriverName(devPath) != "amdgpu") continue;
 
             GpuInfo info;
             info.available = true;
@@ -259,25 +265,14 @@ void LinuxGPU::queryAmdgpu(std::vector<GpuInfo>& out) {
 
 void LinuxGPU::queryIntel(std::vector<GpuInfo>& out) {
     try {
-        for (const auto& card : fs::directory_iterator("/sys/class/drm")) {
-            std::string cardName = card.path().filename().string();
-            if (cardName.compare(0, 4, "card") != 0) continue;
-            if (cardName.find('-') != std::string::npos) continue;
-
-            std::string cardPath = card.path().string();
-            std::string devPath  = cardPath + "/device";
+        for (const auto& cardPath : drmCards()) {
+            std::string devPath = cardPath + "/device";
 
             std::string vendorStr = readSysfsString(devPath + "/vendor");
             if (vendorStr.find("0x8086") == std::string::npos) continue;
 
-            std::string driverName;
-            {
-                std::string driverLink = devPath + "/driver";
-                try {
-                    driverName = fs::read_symlink(driverLink).filename().string();
-                } catch (...) { continue; }
-                if (driverName != "i915" && driverName != "xe") continue;
-            }
+            std::string driverName = readDriverName(devPath);
+            if (driverName != "i915" && driverName != "xe") continue;
 
             GpuInfo info;
             info.available = true;
@@ -8,8 +8,10 @@
 #ifdef __linux__
 
 #include "gpu_common.h"
+#include "../io/file_reader.h"
 
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -55,7 +57,8 @@ using pfn_nvmlDeviceGetDriverVersion = nvmlReturn_t (*)(char*, unsigned int);
  */
 class LinuxGPU : public GPU {
 public:
-    LinuxGPU();
+    /// @param files Where /sys is read from. NVML is only used on the live host.
+    explicit LinuxGPU(std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxGPU() override;
 
     void        update()                override;
@@ -103,31 +106,43 @@ private:
 
     /**
      * @brief Read a single integer from a sysfs file.
-     * @param path Absolute path to the sysfs file.
+     * @param path Host path of the sysfs file.
      * @return The parsed value, or -1 on failure.
      */
-    static int64_t readSysfsInt(const std::string& path);
+    int64_t readSysfsInt(const std::string& path) const;
 
     /**
      * @brief Read the first line from a sysfs file.
-     * @param path Absolute path to the sysfs file.
+     * @param path Host path of the sysfs file.
      * @return Trimmed line contents, or empty string on failure.
      */
-    static std::string readSysfsString(const std::string& path);
+    std::string readSysfsString(const std::string& path) const;
+
+    /**
+     * @brief Name of the kernel driver bound to a device.
+     * @param devicePath Host path of the device in sysfs.
+     * @return Last component of its "driver" link, or empty if unbound.
+     */
+    std::string readDriverName(const std::string& devicePath) const;
+
+    /// @brief Host paths of the GPUs under /sys/class/drm ("card0", not its connectors), sorted.
+    std::vector<std::string> drmCards() const;
 
     /**
      * @brief Find the first hwmon subdirectory under a device path.
-     * @param devicePath Path to the device in sysfs.
-     * @return Full path to the hwmon directory, or empty on failure.
+     * @param devicePath Host path of the device in sysfs.
+     * @return Host path of the hwmon directory, or empty on failure.
      */
-    static std::string findHwmonDir(const std::string& devicePath);
+    std::string findHwmonDir(const std::string& devicePath) const;
 
     /**
      * @brief Parse the active frequency from a DPM frequency file.
-     * @param path Path to pp_dpm_sclk or pp_dpm_mclk.
+     * @param path Host path of pp_dpm_sclk or pp_dpm_mclk.
      * @return Active frequency in MHz, or 0 if not found.
      */
-    static float parseActiveDpmFreq(const std::string& path);
+    float parseActiveDpmFreq(const std::string& path) const;
+
+    std::shared_ptr<const FileReader> files_; ///< Source of /sys
 
     mutable std::mutex mutex_;   ///< Guards current_
     GpuSnapshot        current_; ///< Latest snapshot
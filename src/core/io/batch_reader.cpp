@@ -0,0 +1,106 @@
+/**
+ * @file batch_reader.cpp
+ * @brief Synchronous BatchReader and backend selection.
+ */
+
+#include "batch_reader.h"
+#include "../../utils/io_counters.h"
+
+#ifdef RM_HAVE_IO_URING
+#include "uring_reader_linux.h"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define RM_OPEN  _open
+#define RM_READ  _read
+#define RM_CLOSE _close
+#define RM_O_RDONLY (_O_RDONLY | _O_BINARY)
+#else
+#include <unistd.h>
+#define RM_OPEN  open
+#define RM_READ  read
+#define RM_CLOSE close
+#define RM_O_RDONLY (O_RDONLY | O_CLOEXEC)
+#endif
+
+void SyncBatchReader::readOne(FileRead& req) {
+    req.data.clear();
+    req.error = 0;
+
+    int fd = RM_OPEN(req.path.c_str(), RM_O_RDONLY);
+    ++syscalls_;
+    noteSyscalls(1);
+    if (fd < 0) {
+        req.error = errno;
+        return;
+    }
+    noteFileOpen();
+
+    req.data.resize(req.maxBytes);
+    std::size_t got = 0;
+    while (got < req.maxBytes) {
+        auto n = RM_READ(fd, &req.data[got], static_cast<unsigned>(req.maxBytes - got));
+        ++syscalls_;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            req.error = errno;
+            break;
+        }
+        if (n == 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    req.data.resize(req.error ? 0 : got);
+
+    RM_CLOSE(fd);
+    ++syscalls_;
+    noteSyscalls(1);
+}
+
+void SyncBatchReader::readAll(FileRead* reqs, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) readOne(reqs[i]);
+}
+
+bool readFileInto(const char* path, std::string& out) {
+    out.clear();
+    int fd = RM_OPEN(path, RM_O_RDONLY);
+    noteSyscalls(1);
+    if (fd < 0) return false;
+    noteFileOpen();
+
+    bool ok = true;
+    std::size_t got = 0;
+    for (;;) {
+        // Grow geometrically but never below the capacity already held.
+        if (out.size() - got < 4096)
+            out.resize(std::max<std::size_t>(out.capacity(), got + 4096));
+        auto n = RM_READ(fd, &out[got], static_cast<unsigned>(out.size() - got));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        if (n == 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    RM_CLOSE(fd);
+    noteSyscalls(1);
+    out.resize(ok ? got : 0);
+    return ok;
+}
+
+std::unique_ptr<BatchReader> createBatchReader(BatchBackend backend) {
+#ifdef RM_HAVE_IO_URING
+    if (backend != BatchBackend::Sync) {
+        auto uring = std::make_unique<UringBatchReader>();
+        if (uring->valid()) return uring;
+    }
+#else
+    (void)backend;
+#endif
+    return std::make_unique<SyncBatchReader>();
+}
@@ -0,0 +1,97 @@
+/**
+ * @file batch_reader.h
+ * @brief Read many small procfs/sysfs files in one batch.
+ *
+ * A process tick reads several files for every PID. Callers describe all
+ * of them up front as FileRead requests and hand the whole vector to a
+ * BatchReader; the contents come back in place and are then given to the
+ * usual text parsers.
+ *
+ * Two backends exist:
+ *  - Sync: open/read/close per file (portable, always available).
+ *  - IoUring (Linux): each file is an OPENAT -> READ -> CLOSE chain of
+ *    linked SQEs on a direct (fixed) descriptor, submitted a ring-full
+ *    at a time, so a batch of thousands of files costs a handful of
+ *    io_uring_enter calls instead of three syscalls per file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief One file to read.
+struct FileRead {
+    std::string path;              ///< Absolute path.
+    std::size_t maxBytes = 4096;   ///< Read at most this much (files are read from offset 0).
+    std::string data;              ///< Out: file contents (possibly truncated to maxBytes).
+    int         error = 0;         ///< Out: 0 on success, otherwise an errno value.
+};
+
+/// @brief Which implementation createBatchReader() should return.
+enum class BatchBackend {
+    Auto = 0,  ///< io_uring when compiled in and permitted by the kernel, else Sync.
+    Sync,      ///< Plain open/read/close.
+    IoUring    ///< io_uring; falls back to Sync if unavailable.
+};
+
+/**
+ * @brief Abstract batched file reader.
+ *
+ * Not thread-safe; each module owns its own reader.
+ */
+class BatchReader {
+public:
+    virtual ~BatchReader() = default;
+
+    /**
+     * @brief Read @p count requests starting at @p reqs, filling data and error.
+     *
+     * Each request's data buffer is reused, so a caller that keeps its
+     * FileRead objects between batches does not reallocate them.
+     */
+    virtual void readAll(FileRead* reqs, std::size_t count) = 0;
+
+    /// @brief Read every request in @p reqs; order is preserved.
+    void readAll(std::vector<FileRead>& reqs) { readAll(reqs.data(), reqs.size()); }
+
+    /// @brief Backend name ("sync" or "io_uring").
+    virtual const char* name() const = 0;
+
+    /// @brief System calls issued by this reader so far (for benchmarks).
+    uint64_t syscalls() const { return syscalls_; }
+
+protected:
+    uint64_t syscalls_ = 0;
+};
+
+/**
+ * @brief Synchronous reader: open, read until EOF or maxBytes, close.
+ */
+class SyncBatchReader : public BatchReader {
+public:
+    using BatchReader::readAll;
+    void readAll(FileRead* reqs, std::size_t count) override;
+    const char* name() const override { return "sync"; }
+
+    /// @brief Read a single request (shared with the io_uring fallback path).
+    void readOne(FileRead& req);
+};
+
+/**
+ * @brief Read a whole file of unknown size into @p out, reusing its capacity.
+ * @param path File to read.
+ * @param out  Receives the contents; cleared on failure.
+ * @return false if the file could not be opened or read.
+ */
+bool readFileInto(const char* path, std::string& out);
+
+/**
+ * @brief Create a reader.
+ * @param backend Requested backend.
+ * @return Never null; Sync if the requested backend is unavailable.
+ */
+std::unique_ptr<BatchReader> createBatchReader(BatchBackend backend = BatchBackend::Auto);
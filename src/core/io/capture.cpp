@@ -0,0 +1,425 @@
+/**
+ * @file capture.cpp
+ * @brief Capture file writer and replay reader.
+ */
+
+#include "capture.h"
+#include "batch_reader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+constexpr char     kMagic[8] = {'R', 'M', 'C', 'A', 'P', 'T', 'U', 'R'};
+constexpr uint32_t kVersion  = 2;  ///< 2 added 'U'; version 1 captures still load.
+
+uint64_t sinceEpochNs(std::chrono::system_clock::time_point t) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+}
+
+uint64_t sinceEpochNs(std::chrono::steady_clock::time_point t) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+}
+
+void putU32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>(v >> (8 * i)));
+}
+
+void putU64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>(v >> (8 * i)));
+}
+
+uint64_t getLE(const char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+    return v;
+}
+
+/// Bounds-checked cursor over a capture.
+class Cursor {
+public:
+    explicit Cursor(std::string_view bytes) : bytes_(bytes) {}
+
+    bool done() const { return pos_ == bytes_.size(); }
+
+    bool u8(char& v) {
+        if (pos_ + 1 > bytes_.size()) return false;
+        v = bytes_[pos_++];
+        return true;
+    }
+    bool u32(uint32_t& v) {
+        if (pos_ + 4 > bytes_.size()) return false;
+        v = static_cast<uint32_t>(getLE(bytes_.data() + pos_, 4));
+        pos_ += 4;
+        return true;
+    }
+    bool u64(uint64_t& v) {
+        if (pos_ + 8 > bytes_.size()) return false;
+        v = getLE(bytes_.data() + pos_, 8);
+        pos_ += 8;
+        return true;
+    }
+    bool blob(std::string_view& v) {
+        uint32_t len = 0;
+        if (!u32(len) || pos_ + len > bytes_.size()) return false;
+        v = bytes_.substr(pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+private:
+    std::string_view bytes_;
+    std::size_t      pos_ = 0;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+RecordingFileReader::RecordingFileReader(std::shared_ptr<const FileReader> inner,
+                                         const std::string& path)
+    : FileReader(inner->root()),
+      inner_(std::move(inner)),
+      out_(path, std::ios::binary | std::ios::trunc),
+      tickStart_(std::chrono::steady_clock::now())
+{
+    if (!out_.is_open()) return;
+    std::string header(kMagic, sizeof(kMagic));
+    putU32(header, kVersion);
+    putU64(header, sinceEpochNs(std::chrono::system_clock::now()));
+    putU64(header, sinceEpochNs(tickStart_));
+    out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    written_ = header.size();
+}
+
+RecordingFileReader::~RecordingFileReader() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (out_.is_open()) out_.flush();
+}
+
+void RecordingFileReader::markTick() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    tickStart_ = std::chrono::steady_clock::now();
+    ++ticks_;
+    if (!out_.is_open()) return;
+    std::string rec(1, 'T');
+    putU64(rec, sinceEpochNs(std::chrono::system_clock::now()));
+    putU64(rec, sinceEpochNs(tickStart_));
+    out_.write(rec.data(), static_cast<std::streamsize>(rec.size()));
+    written_ += rec.size();
+}
+
+void RecordingFileReader::markUpdate(unsigned module) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!out_.is_open() || module >= 32) return;
+    const char rec[2] = {'U', static_cast<char>(module)};
+    out_.write(rec, sizeof(rec));
+    written_ += sizeof(rec);
+}
+
+uint64_t RecordingFileReader::ticks() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return ticks_;
+}
+
+std::chrono::steady_clock::time_point RecordingFileReader::now() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return tickStart_;
+}
+
+uint64_t RecordingFileReader::bytesWritten() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return written_;
+}
+
+void RecordingFileReader::record(char tag, std::string_view path, std::string_view data) const {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!out_.is_open()) return;
+    auto offsetUs = std::chrono::duration_cast<std::chrono::microseconds>(now - tickStart_).count();
+
+    std::string rec;
+    auto it = paths_.find(std::string(path));
+    if (it == paths_.end()) {
+        rec.push_back('P');
+        putU32(rec, static_cast<uint32_t>(path.size()));
+        rec.append(path);
+        Last last;
+        last.id = static_cast<uint32_t>(paths_.size());
+        it = paths_.emplace(std::string(path), std::move(last)).first;
+    }
+    Last& last = it->second;
+
+    const bool repeat = last.tag == tag && (tag == 'M' || last.data == data);
+    rec.push_back(repeat ? 'R' : tag);
+    putU32(rec, last.id);
+    putU32(rec, static_cast<uint32_t>(std::clamp<long long>(offsetUs, 0, UINT32_MAX)));
+    if (!repeat && tag != 'M') {
+        putU32(rec, static_cast<uint32_t>(data.size()));
+        rec.append(data);
+    }
+    if (!repeat) {
+        last.tag = tag;
+        last.data.assign(tag == 'M' ? std::string_view{} : data);
+    }
+
+    out_.write(rec.data(), static_cast<std::streamsize>(rec.size()));
+    written_ += rec.size();
+}
+
+bool RecordingFileReader::read(const char* path, std::string& out) const {
+    bool ok = inner_->read(path, out);
+    record(ok ? 'F' : 'M', path, out);
+    return ok;
+}
+
+bool RecordingFileReader::readLink(const char* path, std::string& out) const {
+    bool ok = inner_->readLink(path, out);
+    record(ok ? 'L' : 'M', path, out);
+    return ok;
+}
+
+bool RecordingFileReader::forEachEntry(const char* path,
+                                       const std::function<bool(const char* name)>& fn) const {
+    std::string names;
+    bool ok = inner_->forEachEntry(path, [&](const char* name) {
+        names.append(name).push_back('\0');
+        return fn(name);
+    });
+    record(ok ? 'D' : 'M', path, names);
+    return ok;
+}
+
+bool RecordingFileReader::statFs(const char* path, FsUsage& out) const {
+    bool ok = inner_->statFs(path, out);
+    std::string data;
+    putU64(data, out.totalBytes);
+    putU64(data, out.freeBytes);
+    record(ok ? 'S' : 'M', path, data);
+    return ok;
+}
+
+void RecordingFileReader::readAll(BatchReader& reader, FileRead* reqs, std::size_t count) const {
+    inner_->readAll(reader, reqs, count);
+    for (std::size_t i = 0; i < count; ++i)
+        record(reqs[i].error ? 'M' : 'F', reqs[i].path, reqs[i].data);
+}
+
+std::shared_ptr<RecordingFileReader> createRecordingFileReader(
+    std::shared_ptr<const FileReader> inner, const std::string& path) {
+    auto recorder = std::make_shared<RecordingFileReader>(std::move(inner), path);
+    if (!recorder->isOpen()) return nullptr;
+    return recorder;
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+// ---------------------------------------------------------------------------
+
+ReplayFileReader::ReplayFileReader(std::string capturePath)
+    : FileReader(std::move(capturePath)) {}
+
+bool ReplayFileReader::load(std::string bytes) {
+    bytes_ = std::move(bytes);
+    ids_.clear();
+    initial_.clear();
+    changes_.clear();
+    ticks_.clear();
+    pos_ = 0;
+
+    auto fail = [this] {
+        ids_.clear();
+        initial_.clear();
+        changes_.clear();
+        ticks_.clear();
+        state_.clear();
+        return false;
+    };
+
+    std::string_view all(bytes_);
+    if (all.size() < sizeof(kMagic) || all.compare(0, sizeof(kMagic),
+                                                   std::string_view(kMagic, sizeof(kMagic))) != 0)
+        return fail();
+    Cursor in(all.substr(sizeof(kMagic)));
+    uint32_t version = 0;
+    if (!in.u32(version) || version < 1 || version > kVersion) return fail();
+    if (!in.u64(startWallNs_) || !in.u64(startMonoNs_)) return fail();
+
+    std::vector<Value> last;       // per path: latest value, for 'R'
+    bool marked = false;           // any 'U' record
+    while (!in.done()) {
+        char tag = 0;
+        if (!in.u8(tag)) return fail();
+
+        if (tag == 'T') {
+            Tick t{};
+            if (!in.u64(t.wallNs) || !in.u64(t.monoNs)) return fail();
+            t.begin = t.end = changes_.size();
+            if (!ticks_.empty()) ticks_.back().end = changes_.size();
+            ticks_.push_back(t);
+            continue;
+        }
+        if (tag == 'U') {
+            char module = 0;
+            if (!in.u8(module) || static_cast<unsigned char>(module) >= 32) return fail();
+            if (!ticks_.empty()) ticks_.back().updates |= 1u << static_cast<unsigned char>(module);
+            marked = true;
+            continue;
+        }
+        if (tag == 'P') {
+            std::string_view path;
+            if (!in.blob(path)) return fail();
+            ids_.emplace(std::string(path), static_cast<uint32_t>(last.size()));
+            last.emplace_back();
+            initial_.emplace_back();
+            continue;
+        }
+
+        uint32_t id = 0, offsetUs = 0;
+        if (!in.u32(id) || !in.u32(offsetUs) || id >= last.size()) return fail();
+        Value v;
+        switch (tag) {
+            case 'F': case 'L': case 'D': case 'S':
+                v.tag = tag;
+                if (!in.blob(v.data)) return fail();
+                break;
+            case 'M':
+                break;
+            case 'R':
+                v = last[id];
+                break;
+            default:
+                return fail();
+        }
+        last[id] = v;
+
+        // Only reads before the first tick make up the state before it; a
+        // path first read in tick N stays missing until tick N.
+        if (ticks_.empty()) {
+            initial_[id] = v;
+        } else {
+            changes_.push_back({id, v});
+            if (v.tag != 'M') ticks_.back().bytes += v.data.size();
+        }
+    }
+    if (!ticks_.empty()) ticks_.back().end = changes_.size();
+    if (!marked)
+        for (auto& t : ticks_) t.updates = ~0u;
+
+    state_ = initial_;
+    return true;
+}
+
+bool ReplayFileReader::nextTick() {
+    if (pos_ >= ticks_.size()) return false;
+    const Tick& t = ticks_[pos_++];
+    for (std::size_t i = t.begin; i < t.end; ++i) state_[changes_[i].id] = changes_[i].value;
+    return true;
+}
+
+void ReplayFileReader::rewind() {
+    state_ = initial_;
+    pos_ = 0;
+}
+
+std::chrono::system_clock::time_point ReplayFileReader::recordedAt() const {
+    uint64_t ns = pos_ ? ticks_[pos_ - 1].wallNs : startWallNs_;
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+uint64_t ReplayFileReader::tickBytes() const {
+    return pos_ ? ticks_[pos_ - 1].bytes : 0;
+}
+
+bool ReplayFileReader::updated(unsigned module) const {
+    return pos_ && module < 32 && ((ticks_[pos_ - 1].updates >> module) & 1u);
+}
+
+std::chrono::steady_clock::time_point ReplayFileReader::now() const {
+    uint64_t ns = pos_ ? ticks_[pos_ - 1].monoNs : startMonoNs_;
+    return std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+const ReplayFileReader::Value* ReplayFileReader::find(const char* path, char tag) const {
+    auto it = ids_.find(path);
+    if (it == ids_.end()) return nullptr;
+    const Value& v = state_[it->second];
+    return v.tag == tag ? &v : nullptr;
+}
+
+bool ReplayFileReader::read(const char* path, std::string& out) const {
+    const Value* v = find(path, 'F');
+    if (!v) {
+        out.clear();
+        return false;
+    }
+    out.assign(v->data);
+    return true;
+}
+
+bool ReplayFileReader::readLink(const char* path, std::string& out) const {
+    const Value* v = find(path, 'L');
+    if (!v) {
+        out.clear();
+        return false;
+    }
+    out.assign(v->data);
+    return true;
+}
+
+bool ReplayFileReader::forEachEntry(const char* path,
+                                    const std::function<bool(const char* name)>& fn) const {
+    const Value* v = find(path, 'D');
+    if (!v) return false;
+    // Each name is NUL-terminated inside bytes_, so it can be handed out as is.
+    for (std::size_t pos = 0; pos < v->data.size();) {
+        const char* name = v->data.data() + pos;
+        if (!fn(name)) break;
+        pos += std::strlen(name) + 1;
+    }
+    return true;
+}
+
+bool ReplayFileReader::statFs(const char* path, FsUsage& out) const {
+    out = FsUsage{};
+    const Value* v = find(path, 'S');
+    if (!v || v->data.size() != 16) return false;
+    out.totalBytes = getLE(v->data.data(), 8);
+    out.freeBytes  = getLE(v->data.data() + 8, 8);
+    return true;
+}
+
+void ReplayFileReader::readAll(BatchReader&, FileRead* reqs, std::size_t count) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        FileRead& r = reqs[i];
+        const Value* v = find(r.path.c_str(), 'F');
+        if (!v) {
+            r.data.clear();
+            r.error = ENOENT;
+            continue;
+        }
+        r.data.assign(v->data.substr(0, r.maxBytes));
+        r.error = 0;
+    }
+}
+
+std::shared_ptr<ReplayFileReader> loadCapture(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return nullptr;
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    auto replay = std::make_shared<ReplayFileReader>(path);
+    if (!replay->load(std::move(bytes))) return nullptr;
+    return replay;
+}
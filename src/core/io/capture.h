@@ -0,0 +1,224 @@
+/**
+ * @file capture.h
+ * @brief Record the collectors' procfs and sysfs reads to a file and replay them.
+ *
+ * A RecordingFileReader stands in front of the host reader. Every file,
+ * link target, directory listing and filesystem size a collector reads
+ * through it is appended to a capture file, stamped with its offset into
+ * the current tick. The owner calls markTick() before each tick, so the
+ * capture is a sequence of ticks, each holding the raw bytes read during
+ * it, and markUpdate() for each module it updates in that tick. A read whose result is identical to the previous read of the same
+ * path is stored as a two-word reference, so static files (cpuinfo, link
+ * speeds, idle processes' status) cost almost nothing after the first tick.
+ *
+ * A ReplayFileReader loads a capture and answers reads from it. It holds
+ * the recorded machine as it was at the current tick; nextTick() applies
+ * the next tick's reads and moves now() to that tick's recorded time.
+ * Collectors built on it (Collector::platformModules(replay)) run their
+ * real parsers and rate maths against production data with no disk
+ * access and no waiting, so a capture taken on a busy host can be
+ * profiled deterministically or used to reproduce a bug offline. A path
+ * the recording had not read yet is missing. updated() tells which modules
+ * ran in the current tick; a module on a longer period than the tick must
+ * be replayed only on those ticks, or its rates are computed over the
+ * wrong interval.
+ *
+ * Both readers give the modules the start of the tick as now(), so rates
+ * computed during a replay equal the ones computed while recording.
+ * Anything a module learns without a FileReader call is not captured:
+ * NVML queries, /proc/self, and the event watches of the live host.
+ *
+ * File layout, all integers little-endian:
+ * @code
+ *   header  "RMCAPTUR" u32 version  u64 wall_ns  u64 mono_ns
+ *   record  u8 tag, then by tag:
+ *     'T' tick      u64 wall_ns  u64 mono_ns
+ *     'U' update    u8 module                      (a module that ran in this tick)
+ *     'P' path      u32 len  bytes                 (ids are 0, 1, 2... in order)
+ *     'F' file      u32 path  u32 offset_us  u32 len  bytes
+ *     'L' link      u32 path  u32 offset_us  u32 len  bytes
+ *     'D' directory u32 path  u32 offset_us  u32 len  names, each NUL-terminated
+ *     'S' statfs    u32 path  u32 offset_us  u32 16   u64 total  u64 free
+ *     'M' missing   u32 path  u32 offset_us
+ *     'R' repeat    u32 path  u32 offset_us        (same as the path's last record)
+ * @endcode
+ * Reads made before the first 'T' (module constructors) belong to none of
+ * the ticks and are in place before the first one. A capture with no 'U'
+ * records (version 1, or an owner that never calls markUpdate()) counts
+ * every module as updated in every tick.
+ */
+
+#pragma once
+
+#include "file_reader.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class RecordingFileReader
+ * @brief Passes reads through to another reader and appends them to a capture file.
+ *
+ * Thread-safe: modules read from their own worker threads.
+ */
+class RecordingFileReader : public FileReader {
+public:
+    /// @brief Open @p path for writing; check isOpen(). Prefer createRecordingFileReader().
+    RecordingFileReader(std::shared_ptr<const FileReader> inner, const std::string& path);
+    ~RecordingFileReader() override;
+
+    /// @brief Whether the capture file could be created.
+    bool isOpen() const { return out_.is_open(); }
+
+    /// @brief Start a new tick; reads from here on belong to it.
+    void markTick();
+
+    /**
+     * @brief Note that module @p module updates during the current tick.
+     * @param module Owner-defined number below 32 (the Collector's ModuleId).
+     */
+    void markUpdate(unsigned module);
+
+    /// @brief Ticks marked so far.
+    uint64_t ticks() const;
+
+    /// @brief Size of the capture written so far, in bytes.
+    uint64_t bytesWritten() const;
+
+    bool read(const char* path, std::string& out) const override;
+    bool readLink(const char* path, std::string& out) const override;
+    bool forEachEntry(const char* path,
+                      const std::function<bool(const char* name)>& fn) const override;
+    bool statFs(const char* path, FsUsage& out) const override;
+    void readAll(BatchReader& reader, FileRead* reqs, std::size_t count) const override;
+
+    /// @brief Start of the current tick, which is what a replay reproduces.
+    std::chrono::steady_clock::time_point now() const override;
+
+private:
+    /// Append one read of @p path; @p data is ignored for 'M'.
+    void record(char tag, std::string_view path, std::string_view data) const;
+
+    std::shared_ptr<const FileReader> inner_;
+
+    mutable std::mutex    mtx_;        ///< Guards everything below
+    mutable std::ofstream out_;
+    mutable uint64_t      written_ = 0;
+    uint64_t              ticks_   = 0;
+    std::chrono::steady_clock::time_point tickStart_;
+
+    /// The last record of a path, to detect repeats.
+    struct Last {
+        uint32_t    id;
+        char        tag = 0;
+        std::string data;
+    };
+    mutable std::unordered_map<std::string, Last> paths_;
+};
+
+/**
+ * @class ReplayFileReader
+ * @brief Serves the reads of a capture, one recorded tick at a time.
+ *
+ * Reads are thread-safe with each other; nextTick() and rewind() must not
+ * run concurrently with them (call them between collector ticks).
+ * path() names locations inside the capture file, which do not exist, so
+ * event watches and anything else outside the FileReader calls find nothing.
+ */
+class ReplayFileReader : public FileReader {
+public:
+    /// @brief An empty replay; see loadCapture().
+    explicit ReplayFileReader(std::string capturePath);
+
+    /**
+     * @brief Parse a capture held in memory.
+     * @return false if it is not a capture or is truncated; the reader is then empty.
+     */
+    bool load(std::string bytes);
+
+    /// @brief Ticks in the capture.
+    std::size_t tickCount() const { return ticks_.size(); }
+
+    /// @brief Ticks applied so far (0 before the first nextTick()).
+    std::size_t position() const { return pos_; }
+
+    /**
+     * @brief Apply the next recorded tick.
+     * @return false once every tick has been applied.
+     */
+    bool nextTick();
+
+    /// @brief Back to the state before the first tick.
+    void rewind();
+
+    /// @brief Wall-clock time the current tick was recorded (the capture start before the first).
+    std::chrono::system_clock::time_point recordedAt() const;
+
+    /// @brief Bytes the collectors read during the current tick, repeats included.
+    uint64_t tickBytes() const;
+
+    /// @brief Whether module @p module (see markUpdate()) ran in the current tick.
+    bool updated(unsigned module) const;
+
+    bool read(const char* path, std::string& out) const override;
+    bool readLink(const char* path, std::string& out) const override;
+    bool forEachEntry(const char* path,
+                      const std::function<bool(const char* name)>& fn) const override;
+    bool statFs(const char* path, FsUsage& out) const override;
+    void readAll(BatchReader& reader, FileRead* reqs, std::size_t count) const override;
+
+    /// @brief The current tick's recorded monotonic time, so rates match the recording.
+    std::chrono::steady_clock::time_point now() const override;
+
+private:
+    /// What a path held at one point of the recording.
+    struct Value {
+        char             tag = 'M';  ///< 'F', 'L', 'D', 'S' or 'M'
+        std::string_view data;       ///< Points into bytes_
+    };
+    struct Change {
+        uint32_t id;
+        Value    value;
+    };
+    struct Tick {
+        uint64_t    wallNs;
+        uint64_t    monoNs;
+        std::size_t begin;  ///< Range of changes_
+        std::size_t end;
+        uint64_t    bytes;
+        uint32_t    updates;  ///< Bit per module that ran
+    };
+
+    /// State of @p path for a read expecting @p tag; null if absent or of another kind.
+    const Value* find(const char* path, char tag) const;
+
+    std::string         bytes_;     ///< Whole capture; every Value points into it
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<Value>  initial_;   ///< Per path: state before the first tick (missing if unread)
+    std::vector<Value>  state_;     ///< Per path: state at the current tick
+    std::vector<Change> changes_;
+    std::vector<Tick>   ticks_;
+    std::size_t         pos_ = 0;
+    uint64_t            startWallNs_ = 0;
+    uint64_t            startMonoNs_ = 0;
+};
+
+/**
+ * @brief Record every read made through @p inner to the capture file @p path.
+ * @return Null if the file could not be created.
+ */
+std::shared_ptr<RecordingFileReader> createRecordingFileReader(
+    std::shared_ptr<const FileReader> inner, const std::string& path);
+
+/**
+ * @brief Load the capture file @p path for replay.
+ * @return Null if it cannot be read or is not a valid capture.
+ */
+std::shared_ptr<ReplayFileReader> loadCapture(const std::string& path);
@@ -0,0 +1,123 @@
+/**
+ * @file file_reader.cpp
+ * @brief Root-prefixed file, link and directory access.
+ */
+
+#include "file_reader.h"
+#include "batch_reader.h"
+#include "../../utils/io_counters.h"
+
+#ifdef _WIN32
+#include <filesystem>
+#include <system_error>
+#else
+#include <dirent.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+#endif
+
+FileReader::FileReader(std::string root) : root_(std::move(root)) {
+    while (!root_.empty() && root_.back() == '/') root_.pop_back();
+}
+
+std::string FileReader::path(std::string_view path) const {
+    std::string full;
+    full.reserve(root_.size() + path.size());
+    full.append(root_).append(path);
+    return full;
+}
+
+const char* FileReader::rooted(const char* path) const {
+    if (root_.empty()) return path;
+    thread_local std::string buf;  // keeps its capacity between calls
+    buf.assign(root_).append(path);
+    return buf.c_str();
+}
+
+bool FileReader::read(const char* path, std::string& out) const {
+    return readFileInto(rooted(path), out);
+}
+
+bool FileReader::readLink(const char* path, std::string& out) const {
+    out.clear();
+#ifdef _WIN32
+    std::error_code ec;
+    auto target = std::filesystem::read_symlink(rooted(path), ec);
+    if (ec) return false;
+    out = target.string();
+    return true;
+#else
+    char buf[4096];
+    ssize_t len = readlink(rooted(path), buf, sizeof(buf) - 1);
+    if (len <= 0) return false;
+    out.assign(buf, static_cast<std::size_t>(len));
+    return true;
+#endif
+}
+
+bool FileReader::forEachEntry(const char* path,
+                              const std::function<bool(const char* name)>& fn) const {
+#ifdef _WIN32
+    std::error_code ec;
+    std::filesystem::directory_iterator it(rooted(path), ec), end;
+    if (ec) return false;
+    for (; it != end; it.increment(ec)) {
+        if (ec) break;
+        if (!fn(it->path().filename().string().c_str())) break;
+    }
+    return true;
+#else
+    DIR* dir = opendir(rooted(path));
+    noteSyscalls(1);
+    if (!dir) return false;
+    noteFileOpen();
+
+    while (const dirent* e = readdir(dir)) {
+        const char* name = e->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+        if (!fn(name)) break;
+    }
+    closedir(dir);
+    noteSyscalls(1);
+    return true;
+#endif
+}
+
+bool FileReader::statFs(const char* path, FsUsage& out) const {
+    out = FsUsage{};
+#ifdef _WIN32
+    std::error_code ec;
+    auto space = std::filesystem::space(rooted(path), ec);
+    if (ec) return false;
+    out.totalBytes = space.capacity;
+    out.freeBytes  = space.free;
+    return true;
+#else
+    struct statvfs vfs {};
+    if (statvfs(rooted(path), &vfs) != 0) return false;
+    uint64_t blockSize = vfs.f_frsize ? vfs.f_frsize : vfs.f_bsize;
+    out.totalBytes = static_cast<uint64_t>(vfs.f_blocks) * blockSize;
+    out.freeBytes  = static_cast<uint64_t>(vfs.f_bfree)  * blockSize;
+    return true;
+#endif
+}
+
+void FileReader::readAll(BatchReader& reader, FileRead* reqs, std::size_t count) const {
+    if (root_.empty()) {
+        reader.readAll(reqs, count);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) reqs[i].path.insert(0, root_);
+    reader.readAll(reqs, count);
+    for (std::size_t i = 0; i < count; ++i) reqs[i].path.erase(0, root_.size());
+}
+
+std::shared_ptr<const FileReader> hostFileReader() {
+    static const auto host = std::make_shared<const FileReader>();
+    return host;
+}
+
+std::shared_ptr<const FileReader> createFileReader(std::string root) {
+    if (root.empty() || root == "/") return hostFileReader();
+    return std::make_shared<const FileReader>(std::move(root));
+}
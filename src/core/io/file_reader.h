@@ -0,0 +1,114 @@
+/**
+ * @file file_reader.h
+ * @brief Where the Linux collectors read procfs and sysfs from.
+ *
+ * Every Linux module takes a FileReader and names files by their host
+ * path ("/proc/stat", "/sys/class/drm"). The reader places its root in
+ * front of each one, so a module built with createFileReader("fixtures/
+ * big") reads "fixtures/big/proc/stat" instead. That lets tests and
+ * benchmarks run the real collectors against synthetic trees: 50,000
+ * PID directories, a /proc/stat with 1,000 cores or a socket table with
+ * 500,000 rows, on a laptop.
+ *
+ * read(), readLink(), forEachEntry(), statFs() and readAll() are virtual
+ * so another reader can serve or observe the files itself: a test can
+ * count them, and capture.h records every read of a live host to a file
+ * and replays it later. Collectors therefore go through these calls for
+ * everything they read. Code that must hand a real path to another API
+ * (an event watch) uses path(), which a replayed capture cannot serve.
+ *
+ * Only the contents of the tree move with the root. Facts about the
+ * monitor's own process (/proc/self, user names, clock ticks) still come
+ * from the host.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+class BatchReader;
+struct FileRead;
+
+/// @brief Size and free space of a mounted filesystem.
+struct FsUsage {
+    uint64_t totalBytes = 0;
+    uint64_t freeBytes  = 0;
+};
+
+class FileReader {
+public:
+    /// @param root Directory standing in for "/"; empty for the live host.
+    explicit FileReader(std::string root = {});
+    virtual ~FileReader() = default;
+
+    /// @brief The prefix applied to every path; empty for the live host.
+    const std::string& root() const { return root_; }
+
+    /// @brief True when reading the live host.
+    bool isHost() const { return root_.empty(); }
+
+    /// @brief Real path of host path @p path, e.g. "/proc/stat" -> "<root>/proc/stat".
+    std::string path(std::string_view path) const;
+
+    /**
+     * @brief Read the whole file at host path @p path into @p out, reusing its capacity.
+     * @return false if it could not be opened or read; @p out is then empty.
+     */
+    virtual bool read(const char* path, std::string& out) const;
+
+    /**
+     * @brief Target of the symbolic link at host path @p path.
+     * @return false if it is not a readable link; @p out is then empty.
+     */
+    virtual bool readLink(const char* path, std::string& out) const;
+
+    /**
+     * @brief Call @p fn with the name of each entry of directory @p path.
+     *
+     * "." and ".." are skipped. Returning false from @p fn stops early.
+     * @return false if the directory could not be opened.
+     */
+    virtual bool forEachEntry(const char* path,
+                              const std::function<bool(const char* name)>& fn) const;
+
+    /**
+     * @brief Size of the filesystem mounted at host path @p path (statvfs).
+     * @return false if it could not be queried.
+     */
+    virtual bool statFs(const char* path, FsUsage& out) const;
+
+    /**
+     * @brief Read @p count requests, named by host path, through @p reader.
+     *
+     * The root is put in front of each request's path for the duration of
+     * the batch and removed again, so reused requests do not reallocate.
+     */
+    virtual void readAll(BatchReader& reader, FileRead* reqs, std::size_t count) const;
+
+    /// @brief Time to compute rates against; a replay answers with the recorded time.
+    virtual std::chrono::steady_clock::time_point now() const {
+        return std::chrono::steady_clock::now();
+    }
+
+private:
+    /// @p path under the root, in a per-thread buffer valid until the next call.
+    const char* rooted(const char* path) const;
+
+    std::string root_;
+};
+
+/// @brief The shared reader for the live host.
+std::shared_ptr<const FileReader> hostFileReader();
+
+/**
+ * @brief A reader for the tree under @p root.
+ * @param root Directory laid out like "/" (with proc/ and sys/ beneath it).
+ *             Empty, or "/", gives the host reader.
+ */
+std::shared_ptr<const FileReader> createFileReader(std::string root);
@@ -0,0 +1,49 @@
+/**
+ * @file proc_parse.h
+ * @brief Allocation-free line and field scanning for procfs text.
+ *
+ * The Linux modules read /proc files into reused buffers and parse them
+ * in place with these helpers rather than through streams or sscanf.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace proc_parse {
+
+/**
+ * Call @p fn(line, length) for each '\n'-terminated line of @p text
+ * (the last line may lack the '\n'). Stops early when @p fn returns false.
+ */
+template <typename Fn>
+void forEachLine(const std::string& text, Fn&& fn) {
+    const char* p   = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        auto* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* eol = nl ? nl : end;
+        if (!fn(p, static_cast<size_t>(eol - p))) return;
+        p = eol + 1;
+    }
+}
+
+/// Whether the @p len bytes at @p line begin with the @p n bytes of @p prefix.
+inline bool startsWith(const char* line, size_t len, const char* prefix, size_t n) {
+    return len >= n && std::memcmp(line, prefix, n) == 0;
+}
+
+/// Parse a decimal field after optional spaces at @p p, before @p eol. @return false if there is none.
+inline bool parseDec(const char*& p, const char* eol, uint64_t& out) {
+    while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+    if (p == eol || *p < '0' || *p > '9') return false;
+    uint64_t v = 0;
+    while (p < eol && *p >= '0' && *p <= '9') v = v * 10 + static_cast<uint64_t>(*p++ - '0');
+    out = v;
+    return true;
+}
+
+} // namespace proc_parse
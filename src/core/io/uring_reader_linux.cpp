@@ -0,0 +1,260 @@
+/**
+ * @file uring_reader_linux.cpp
+ * @brief Linked open/read/close batches on an io_uring with direct descriptors.
+ */
+
+#if defined(__linux__) && defined(RM_HAVE_IO_URING)
+
+#include "uring_reader_linux.h"
+#include "../../utils/io_counters.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+namespace {
+
+int sysSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+                                    flags, nullptr, 0));
+}
+
+int sysRegister(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+unsigned loadAcquire(const unsigned* p)        { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+void     storeRelease(unsigned* p, unsigned v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+
+/// user_data layout: request index in the chunk << 2 | step.
+enum Step : uint64_t { Open = 0, Read = 1, Close = 2, Cancel = 3 };
+uint64_t tag(unsigned i, Step s) { return (static_cast<uint64_t>(i) << 2) | s; }
+
+} // namespace
+
+UringBatchReader::UringBatchReader(unsigned entries) {
+    io_uring_params p{};
+    int fd = sysSetup(entries, &p);
+    if (fd < 0) return;
+
+    sqRingSz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cqRingSz_ = p.cq_off.cqes  + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) sqRingSz_ = cqRingSz_ = std::max(sqRingSz_, cqRingSz_);
+
+    sqRing_ = mmap(nullptr, sqRingSz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) { sqRing_ = nullptr; close(fd); return; }
+    if (single) {
+        cqRing_ = sqRing_;
+    } else {
+        cqRing_ = mmap(nullptr, cqRingSz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd, IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED) {
+            cqRing_ = nullptr;
+            munmap(sqRing_, sqRingSz_);
+            sqRing_ = nullptr;
+            close(fd);
+            return;
+        }
+    }
+    sqesSz_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        if (cqRing_ != sqRing_) munmap(cqRing_, cqRingSz_);
+        munmap(sqRing_, sqRingSz_);
+        sqRing_ = cqRing_ = nullptr;
+        close(fd);
+        return;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<char*>(sqRing_);
+    auto* cq = static_cast<char*>(cqRing_);
+    sqHead_  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sqTail_  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sqMask_  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    cqHead_  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cqTail_  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cqMask_  = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes_    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    sqLocalTail_ = *sqTail_;
+    ringFd_ = fd;
+
+    // One empty direct-descriptor slot per file in flight.
+    unsigned slots = p.sq_entries / 3;
+    io_uring_rsrc_register reg{};
+    reg.nr    = slots;
+    reg.flags = IORING_RSRC_REGISTER_SPARSE;
+    if (sysRegister(ringFd_, IORING_REGISTER_FILES2, &reg, sizeof(reg)) == 0)
+        slots_ = slots;
+}
+
+UringBatchReader::~UringBatchReader() {
+    if (sqes_) munmap(sqes_, sqesSz_);
+    if (cqRing_ && cqRing_ != sqRing_) munmap(cqRing_, cqRingSz_);
+    if (sqRing_) munmap(sqRing_, sqRingSz_);
+    if (ringFd_ >= 0) close(ringFd_);
+}
+
+io_uring_sqe* UringBatchReader::nextSqe() {
+    unsigned idx = sqLocalTail_ & *sqMask_;
+    io_uring_sqe* sqe = &sqes_[idx];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray_[idx] = idx;
+    ++sqLocalTail_;
+    return sqe;
+}
+
+int UringBatchReader::enter(unsigned toSubmit, unsigned minComplete) {
+    ++syscalls_;
+    noteSyscalls(1);
+    for (;;) {
+        int r = sysEnter(ringFd_, toSubmit, minComplete, IORING_ENTER_GETEVENTS);
+        if (r >= 0) return r;
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return r;
+    }
+}
+
+void UringBatchReader::readChunk(FileRead* reqs, unsigned count) {
+    for (unsigned i = 0; i < count; ++i) {
+        FileRead& r = reqs[i];
+        r.error = 0;
+        r.data.resize(std::max<std::size_t>(r.maxBytes, 1));
+
+        io_uring_sqe* open = nextSqe();
+        open->opcode     = IORING_OP_OPENAT;
+        open->fd         = AT_FDCWD;
+        open->addr       = reinterpret_cast<uint64_t>(r.path.c_str());
+        open->open_flags = O_RDONLY;
+        open->file_index = i + 1;            // install into slot i
+        open->flags      = IOSQE_IO_LINK;
+        open->user_data  = tag(i, Open);
+
+        io_uring_sqe* read = nextSqe();
+        read->opcode    = IORING_OP_READ;
+        read->fd        = static_cast<int>(i); // slot index
+        read->addr      = reinterpret_cast<uint64_t>(&r.data[0]);
+        read->len       = static_cast<unsigned>(r.maxBytes);
+        read->off       = 0;
+        read->flags     = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+        read->user_data = tag(i, Read);
+
+        io_uring_sqe* cls = nextSqe();
+        cls->opcode     = IORING_OP_CLOSE;
+        cls->file_index = i + 1;
+        cls->user_data  = tag(i, Close);
+    }
+
+    unsigned toSubmit = 3 * count;
+    storeRelease(sqTail_, sqLocalTail_);
+
+    std::vector<int>& readRes = readRes_;
+    readRes.assign(count, -ECANCELED);
+    unsigned pending = toSubmit;
+    while (pending > 0) {
+        if (enter(toSubmit, pending) < 0) {
+            // Give up on the ring; this chunk and later batches use the
+            // sync path, but only once the kernel is done with the paths,
+            // buffers and slots of the chains it already took.
+            abandon(pending);
+            slots_ = 0;
+            break;
+        }
+        toSubmit = 0;
+
+        unsigned head = *cqHead_;
+        unsigned tail = loadAcquire(cqTail_);
+        for (; head != tail; ++head, --pending) {
+            const io_uring_cqe& cqe = cqes_[head & *cqMask_];
+            unsigned i = static_cast<unsigned>(cqe.user_data >> 2);
+            switch (static_cast<Step>(cqe.user_data & 3)) {
+                case Open:
+                    if (cqe.res < 0) reqs[i].error = -cqe.res;
+                    else noteFileOpen();
+                    break;
+                case Read:
+                    readRes[i] = cqe.res;
+                    if (cqe.res > 0) noteBytesRead(static_cast<uint64_t>(cqe.res));
+                    break;
+                case Close:
+                case Cancel:
+                    break;
+            }
+        }
+        storeRelease(cqHead_, head);
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        FileRead& r = reqs[i];
+        if (r.error == 0 && readRes[i] < 0) r.error = -readRes[i];
+        r.data.resize(r.error == 0 ? static_cast<std::size_t>(readRes[i]) : 0);
+    }
+}
+
+void UringBatchReader::abandon(unsigned pending) {
+    // SQEs the kernel has not consumed will never complete; withdraw them
+    // so the cancel below is the only thing the next enter() submits.
+    const unsigned taken = loadAcquire(sqHead_);
+    pending -= sqLocalTail_ - taken;
+    sqLocalTail_ = taken;
+    storeRelease(sqTail_, taken);
+    if (pending == 0) return;
+
+    // Cancel whatever has not run yet; the chains still post one CQE per
+    // SQE, so the count to wait for is unchanged (plus the cancel's own).
+    io_uring_sqe* cancel = nextSqe();
+    cancel->opcode       = IORING_OP_ASYNC_CANCEL;
+    cancel->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+    cancel->user_data    = tag(0, Cancel);
+    storeRelease(sqTail_, sqLocalTail_);
+    if (enter(1, 0) == 1) {
+        ++pending;
+    } else {
+        sqLocalTail_ = taken;
+        storeRelease(sqTail_, taken);
+    }
+
+    // If enter() keeps failing, poll the completion ring instead; returning
+    // from any syscall runs the task work that posts completions.
+    while (pending > 0) {
+        if (enter(0, 1) < 0) {
+            timespec ms{0, 1000000};
+            nanosleep(&ms, nullptr);
+        }
+        unsigned head = *cqHead_;
+        unsigned tail = loadAcquire(cqTail_);
+        for (; head != tail && pending > 0; ++head) --pending;
+        storeRelease(cqHead_, head);
+    }
+}
+
+void UringBatchReader::readAll(FileRead* reqs, std::size_t count) {
+    std::size_t off = 0;
+    while (off < count && valid()) {
+        auto n = static_cast<unsigned>(std::min<std::size_t>(slots_, count - off));
+        readChunk(reqs + off, n);
+        if (!valid()) break;  // ring failed: redo this chunk synchronously
+        off += n;
+    }
+
+    if (off < count) {
+        SyncBatchReader sync;
+        sync.readAll(reqs + off, count - off);
+        syscalls_ += sync.syscalls();
+    }
+}
+
+#endif // __linux__ && RM_HAVE_IO_URING
@@ -0,0 +1,73 @@
+/**
+ * @file uring_reader_linux.h
+ * @brief io_uring implementation of BatchReader (raw syscalls, no liburing).
+ */
+
+#pragma once
+
+#if defined(__linux__) && defined(RM_HAVE_IO_URING)
+
+#include "batch_reader.h"
+
+#include <linux/io_uring.h>
+
+/**
+ * @brief Reads files as linked OPENAT -> READ -> CLOSE chains.
+ *
+ * Each file in a submission gets its own slot in a sparse fixed-file
+ * table: OPENAT installs the descriptor directly into the slot, READ uses
+ * it with IOSQE_FIXED_FILE, and CLOSE (hard-linked, so it runs even if
+ * the read fails) frees it. No descriptor ever enters the process fd
+ * table. Reads go straight into each request's string buffer.
+ *
+ * Requires Linux 5.19 (sparse direct descriptors); valid() is false on
+ * older kernels or where io_uring is disabled, and createBatchReader()
+ * then falls back to SyncBatchReader.
+ */
+class UringBatchReader : public BatchReader {
+public:
+    /// @param entries Submission queue size; a third of it is files per submission.
+    explicit UringBatchReader(unsigned entries = 384);
+    ~UringBatchReader() override;
+
+    UringBatchReader(const UringBatchReader&) = delete;
+    UringBatchReader& operator=(const UringBatchReader&) = delete;
+
+    /// @brief Whether the ring and fixed-file table were set up.
+    bool valid() const { return ringFd_ >= 0 && slots_ > 0; }
+
+    using BatchReader::readAll;
+    void readAll(FileRead* reqs, std::size_t count) override;
+    const char* name() const override { return "io_uring"; }
+
+private:
+    /// Submit and reap one chunk of at most slots_ requests.
+    void readChunk(FileRead* reqs, unsigned count);
+    /// After a failed enter(), wait out the @p pending completions still owed.
+    void abandon(unsigned pending);
+    io_uring_sqe* nextSqe();
+    int  enter(unsigned toSubmit, unsigned minComplete);
+
+    int      ringFd_ = -1;
+    unsigned slots_  = 0;     ///< Fixed-file slots = files per submission.
+
+    void*    sqRing_   = nullptr;
+    size_t   sqRingSz_ = 0;
+    void*    cqRing_   = nullptr;  ///< Same mapping as sqRing_ with IORING_FEAT_SINGLE_MMAP.
+    size_t   cqRingSz_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t   sqesSz_    = 0;
+
+    unsigned* sqHead_  = nullptr;
+    unsigned* sqTail_  = nullptr;
+    unsigned* sqMask_  = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_  = nullptr;
+    unsigned* cqTail_  = nullptr;
+    unsigned* cqMask_  = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned  sqLocalTail_ = 0;    ///< SQEs prepared but not yet published.
+    std::vector<int> readRes_;     ///< READ result per slot, reused across chunks.
+};
+
+#endif // __linux__ && RM_HAVE_IO_URING
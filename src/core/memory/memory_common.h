@@ -6,6 +6,10 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
+#include "../events/event_loop.h"
+#include <atomic>
+#include <functional>
 #include <memory>
 
 /**
@@ -25,10 +29,34 @@ public:
      * @return Most recent MemorySnapshot.
      */
     virtual MemorySnapshot snapshot() const = 0;
+
+    /**
+     * @brief Register event sources that signal memory pressure.
+     *
+     * Called once by the Collector. @p onChange runs on the collecting
+     * thread and schedules an immediate update(). The default registers
+     * nothing and the module is only polled.
+     */
+    virtual void watchEvents(EventLoop& loop, std::function<void()> onChange) {
+        (void)loop; (void)onChange;
+    }
+
+    /**
+     * @brief Enable or disable the periodic top-process scan.
+     *
+     * The scan walks every process on the system; with it off the
+     * top-process fields stay empty.
+     * @param on True to scan for the largest processes.
+     */
+    void setTopProcessScan(bool on) { topProcessScan_ = on; }
+
+protected:
+    std::atomic<bool> topProcessScan_{true}; ///< Run the top-process scan in update().
 };
 
 /**
  * @brief Create a platform-specific Memory implementation.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  * @return Owning pointer to the concrete Memory subclass.
  */
-std::unique_ptr<Memory> createMemory();
+std::unique_ptr<Memory> createMemory(std::shared_ptr<const FileReader> files = hostFileReader());
@@ -17,10 +17,11 @@
  * @brief Instantiate the correct Memory subclass for the current OS.
  * @return Owning pointer to a WindowsMemory or LinuxMemory instance.
  */
-std::unique_ptr<Memory> createMemory() {
+std::unique_ptr<Memory> createMemory(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsMemory>();
 #else
-    return std::make_unique<LinuxMemory>();
+    return std::make_unique<LinuxMemory>(std::move(files));
 #endif
 }
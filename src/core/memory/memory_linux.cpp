@@ -6,36 +6,34 @@
 #ifdef __linux__
 
 #include "memory_linux.h"
+#include "../../utils/tracer.h"
 
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <algorithm>
 #include <numeric>
 #include <cstring>
 #include <cctype>
-#include <dirent.h>
-#include <filesystem>
+#include <cstdlib>
 
-namespace fs = std::filesystem;
-
-LinuxMemory::LinuxMemory()
-    : lastProcessScan_(std::chrono::steady_clock::now() - std::chrono::seconds(kProcessScanIntervalSec + 1))
-    , prevTime_(std::chrono::steady_clock::now())
+LinuxMemory::LinuxMemory(std::shared_ptr<const FileReader> files)
+    : files_(std::move(files))
+    , lastProcessScan_(files_->now() - std::chrono::seconds(kProcessScanIntervalSec + 1))
+    , prevTime_(files_->now())
 {
-    std::ifstream vmstat("/proc/vmstat");
-    if (vmstat.is_open()) {
-        std::string key;
-        uint64_t val = 0;
-        while (vmstat >> key >> val) {
-            if (key == "pgfault") {
-                prevPgFault_ = val;
-                break;
-            }
-        }
-    }
+    readPgFault(prevPgFault_);
+    usageHistory_.reserve(kMaxHistory + 1);
+}
 
-    usageHistory_.reserve(kMaxHistory);
+bool LinuxMemory::readPgFault(uint64_t& out) {
+    if (!files_->read("/proc/vmstat", vmstatBuf_)) return false;
+    static constexpr char kKey[] = "\npgfault ";
+    std::size_t pos = vmstatBuf_.compare(0, sizeof(kKey) - 2, kKey + 1) == 0
+                    ? 0 : vmstatBuf_.find(kKey);
+    if (pos == std::string::npos) return false;
+    pos += pos == 0 ? sizeof(kKey) - 2 : sizeof(kKey) - 1;  // past the key
+    out = std::strtoull(vmstatBuf_.c_str() + pos, nullptr, 10);
+    return true;
 }
 
 /**
@@ -44,7 +42,7 @@ LinuxMemory::LinuxMemory()
  * @param outMem   Receives its RSS in bytes.
  * @param topProcs Receives up to 5 top processes sorted descending by RSS.
  */
-void LinuxMemory::scanTopProcess(std::string& outName, uint64_t& outMem,
+void LinuxMemory::scanTopProcess(Label& outName, uint64_t& outMem,
                                  std::vector<MemorySnapshot::TopProcess>& topProcs)
 {
     struct ProcEntry {
@@ -53,38 +51,36 @@ void LinuxMemory::scanTopProcess(std::string& outName, uint64_t& outMem,
     };
     std::vector<ProcEntry> entries;
 
-    try {
-        for (const auto& entry : fs::directory_iterator("/proc")) {
-            if (!entry.is_directory()) continue;
-
-            const std::string fname = entry.path().filename().string();
-            if (fname.empty() || !std::isdigit(static_cast<unsigned char>(fname[0])))
-                continue;
-
-            std::ifstream status(entry.path() / "status");
-            if (!status.is_open()) continue;
-
-            ProcEntry pe;
-            std::string line;
-
-            while (std::getline(status, line)) {
-                if (line.compare(0, 5, "Name:") == 0) {
-                    pe.name = line.substr(5);
-                    auto it = pe.name.begin();
-                    while (it != pe.name.end() && (*it == ' ' || *it == '\t'))
-                        ++it;
-                    pe.name.erase(pe.name.begin(), it);
-                } else if (line.compare(0, 6, "VmRSS:") == 0) {
-                    std::istringstream ss(line.substr(6));
-                    ss >> pe.rssKb;
-                    break;
-                }
+    std::vector<std::string> pids;
+    files_->forEachEntry("/proc", [&pids](const char* name) {
+        if (std::isdigit(static_cast<unsigned char>(name[0]))) pids.emplace_back(name);
+        return true;
+    });
+
+    std::string text;
+    for (const auto& pid : pids) {
+        if (!files_->read(("/proc/" + pid + "/status").c_str(), text)) continue;
+
+        std::istringstream status(text);
+        ProcEntry pe;
+        std::string line;
+
+        while (std::getline(status, line)) {
+            if (line.compare(0, 5, "Name:") == 0) {
+                pe.name = line.substr(5);
+                auto it = pe.name.begin();
+                while (it != pe.name.end() && (*it == ' ' || *it == '\t'))
+                    ++it;
+                pe.name.erase(pe.name.begin(), it);
+            } else if (line.compare(0, 6, "VmRSS:") == 0) {
+                std::istringstream ss(line.substr(6));
+                ss >> pe.rssKb;
+                break;
             }
-
-            if (pe.rssKb > 0)
-                entries.push_back(std::move(pe));
         }
-    } catch (...) {
+
+        if (pe.rssKb > 0)
+            entries.push_back(std::move(pe));
     }
 
     std::sort(entries.begin(), entries.end(),
@@ -108,89 +104,95 @@ void LinuxMemory::scanTopProcess(std::string& outName, uint64_t& outMem,
     }
 }
 
+void LinuxMemory::parseMeminfo(const std::string& text, MemInfo& out) {
+    static const struct {
+        const char* key;  ///< Including the ':'
+        uint64_t MemInfo::* field;
+    } kFields[] = {
+        {"MemTotal:",     &MemInfo::memTotal},
+        {"MemAvailable:", &MemInfo::memAvailable},
+        {"MemFree:",      &MemInfo::memFree},
+        {"Buffers:",      &MemInfo::buffers},
+        {"Cached:",       &MemInfo::cached},
+        {"SwapTotal:",    &MemInfo::swapTotal},
+        {"SwapFree:",     &MemInfo::swapFree},
+        {"Committed_AS:", &MemInfo::committedAS},
+        {"CommitLimit:",  &MemInfo::commitLimit},
+        {"Slab:",         &MemInfo::slab},
+        {"SReclaimable:", &MemInfo::sReclaimable},
+    };
+
+    const char* p   = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        auto* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* eol = nl ? nl : end;
+        auto* colon = static_cast<const char*>(std::memchr(p, ':', static_cast<size_t>(eol - p)));
+        if (colon) {
+            const size_t keyLen = static_cast<size_t>(colon - p) + 1;
+            for (const auto& f : kFields) {
+                if (std::strlen(f.key) != keyLen || std::memcmp(p, f.key, keyLen) != 0) continue;
+                out.*f.field = std::strtoull(colon + 1, nullptr, 10);
+                break;
+            }
+        }
+        p = eol + 1;
+    }
+}
+
 void LinuxMemory::update() {
-    MemorySnapshot snap;
+    // Rebuild the previous snapshot in place so its top-process vector is reused.
+    MemorySnapshot& snap = spare_;
+    {
+        std::vector<MemorySnapshot::TopProcess> top = std::move(snap.topProcesses);
+        snap = MemorySnapshot{};
+        snap.topProcesses = std::move(top);
+    }
 
-    auto now = std::chrono::steady_clock::now();
+    auto now = files_->now();
     double elapsed = std::chrono::duration<double>(now - prevTime_).count();
     if (elapsed <= 0.0) elapsed = 1.0;
 
     {
-        std::ifstream meminfo("/proc/meminfo");
-        if (meminfo.is_open()) {
-            uint64_t memTotal      = 0;
-            uint64_t memAvailable  = 0;
-            uint64_t memFree       = 0;
-            uint64_t buffers       = 0;
-            uint64_t cached        = 0;
-            uint64_t swapTotal     = 0;
-            uint64_t swapFree      = 0;
-            uint64_t committedAS   = 0;
-            uint64_t commitLimit   = 0;
-            uint64_t slab          = 0;
-            uint64_t sReclaimable  = 0;
-
-            std::string line;
-            while (std::getline(meminfo, line)) {
-                std::istringstream ss(line);
-                std::string key;
-                uint64_t    val = 0;
-                ss >> key >> val;
-
-                if      (key == "MemTotal:")      memTotal     = val;
-                else if (key == "MemAvailable:")  memAvailable = val;
-                else if (key == "MemFree:")       memFree      = val;
-                else if (key == "Buffers:")       buffers      = val;
-                else if (key == "Cached:")        cached       = val;
-                else if (key == "SwapTotal:")     swapTotal    = val;
-                else if (key == "SwapFree:")      swapFree     = val;
-                else if (key == "Committed_AS:")  committedAS  = val;
-                else if (key == "CommitLimit:")   commitLimit  = val;
-                else if (key == "Slab:")          slab         = val;
-                else if (key == "SReclaimable:")  sReclaimable = val;
-            }
+        TraceSpan span("parse", "/proc/meminfo");
+        if (files_->read("/proc/meminfo", meminfoBuf_)) {
+            MemInfo mi;
+            parseMeminfo(meminfoBuf_, mi);
 
             constexpr uint64_t KB = 1024ULL;
 
-            snap.totalBytes     = memTotal     * KB;
-            snap.availableBytes = memAvailable * KB;
-            snap.usedBytes      = (memTotal - memAvailable) * KB;
-            snap.cachedBytes    = (cached + sReclaimable)   * KB;
-            snap.bufferedBytes  = buffers * KB;
-
-            snap.swapTotal  = swapTotal * KB;
-            snap.swapFree   = swapFree  * KB;
-            snap.swapUsed   = (swapTotal >= swapFree) ? (swapTotal - swapFree) * KB : 0;
-            snap.swapPercent = (swapTotal > 0)
-                ? static_cast<float>(swapTotal - swapFree) * 100.0f
-                  / static_cast<float>(swapTotal)
+            snap.totalBytes     = mi.memTotal     * KB;
+            snap.availableBytes = mi.memAvailable * KB;
+            snap.usedBytes      = (mi.memTotal - mi.memAvailable) * KB;
+            snap.cachedBytes    = (mi.cached + mi.sReclaimable) * KB;
+            snap.bufferedBytes  = mi.buffers * KB;
+
+            snap.swapTotal  = mi.swapTotal * KB;
+            snap.swapFree   = mi.swapFree  * KB;
+            snap.swapUsed   = (mi.swapTotal >= mi.swapFree) ? (mi.swapTotal - mi.swapFree) * KB : 0;
+            snap.swapPercent = (mi.swapTotal > 0)
+                ? static_cast<float>(mi.swapTotal - mi.swapFree) * 100.0f
+                  / static_cast<float>(mi.swapTotal)
                 : 0.0f;
 
-            snap.committedBytes   = committedAS * KB;
-            snap.commitLimitBytes = commitLimit  * KB;
+            snap.committedBytes   = mi.committedAS * KB;
+            snap.commitLimitBytes = mi.commitLimit * KB;
 
-            if (memTotal > 0) {
-                snap.usagePercent = static_cast<float>(memTotal - memAvailable) * 100.0f
-                                    / static_cast<float>(memTotal);
+            if (mi.memTotal > 0) {
+                snap.usagePercent = static_cast<float>(mi.memTotal - mi.memAvailable) * 100.0f
+                                    / static_cast<float>(mi.memTotal);
             }
         }
     }
 
     {
-        std::ifstream vmstat("/proc/vmstat");
-        if (vmstat.is_open()) {
-            std::string key;
-            uint64_t    val = 0;
-            while (vmstat >> key >> val) {
-                if (key == "pgfault") {
-                    if (elapsed > 0.0 && val >= prevPgFault_) {
-                        snap.pageFaultsPerSec = static_cast<float>(
-                            static_cast<double>(val - prevPgFault_) / elapsed);
-                    }
-                    prevPgFault_ = val;
-                    break;
-                }
+        uint64_t val = 0;
+        if (readPgFault(val)) {
+            if (elapsed > 0.0 && val >= prevPgFault_) {
+                snap.pageFaultsPerSec = static_cast<float>(
+                    static_cast<double>(val - prevPgFault_) / elapsed);
             }
+            prevPgFault_ = val;
         }
     }
 
@@ -199,7 +201,12 @@ void LinuxMemory::update() {
     {
         auto secsSinceScan = std::chrono::duration_cast<std::chrono::seconds>(
             now - lastProcessScan_).count();
-        if (secsSinceScan >= kProcessScanIntervalSec) {
+        if (!topProcessScan_) {
+            cachedTopName_ = {};
+            cachedTopMem_  = 0;
+            cachedTopProcs_.clear();
+            lastProcessScan_ = {};  // rescan as soon as it is re-enabled
+        } else if (secsSinceScan >= kProcessScanIntervalSec) {
             scanTopProcess(cachedTopName_, cachedTopMem_, cachedTopProcs_);
             lastProcessScan_ = now;
         }
@@ -220,7 +227,7 @@ void LinuxMemory::update() {
             snap.averageUsage = sum / static_cast<float>(usageHistory_.size());
         }
 
-        current_ = std::move(snap);
+        std::swap(current_, spare_);
     }
 }
 
@@ -233,4 +240,11 @@ MemorySnapshot LinuxMemory::snapshot() const {
     return current_;
 }
 
+void LinuxMemory::watchEvents(EventLoop& loop, std::function<void()> onChange) {
+    std::string psi = files_->path("/proc/pressure/memory");
+    psiWatch_.watch(loop, openPsiTrigger(psi.c_str(), 150000, 2000000),
+                    EventLoop::Priority,
+                    [onChange](uint32_t) { onChange(); });
+}
+
 #endif
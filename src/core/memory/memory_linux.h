@@ -8,7 +8,10 @@
 #ifdef __linux__
 
 #include "memory_common.h"
+#include "../events/event_sources_linux.h"
+#include "../io/file_reader.h"
 
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <string>
@@ -20,7 +23,8 @@
  */
 class LinuxMemory : public Memory {
 public:
-    LinuxMemory();
+    /// @param files Where /proc is read from.
+    explicit LinuxMemory(std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxMemory() override = default;
 
     /**
@@ -34,10 +38,40 @@ public:
      */
     MemorySnapshot snapshot() const          override;
 
+    /**
+     * @brief Watch /proc/pressure/memory for stalls of 150 ms within 2 s.
+     */
+    void           watchEvents(EventLoop& loop, std::function<void()> onChange) override;
+
+    /**
+     * @brief The /proc/meminfo fields update() uses, in kB.
+     */
+    struct MemInfo {
+        uint64_t memTotal     = 0;
+        uint64_t memAvailable = 0;
+        uint64_t memFree      = 0;
+        uint64_t buffers      = 0;
+        uint64_t cached       = 0;
+        uint64_t swapTotal    = 0;
+        uint64_t swapFree     = 0;
+        uint64_t committedAS  = 0;
+        uint64_t commitLimit  = 0;
+        uint64_t slab         = 0;
+        uint64_t sReclaimable = 0;
+    };
+
+    /**
+     * @brief Parse the text of /proc/meminfo.
+     * @param text Whole file contents.
+     * @param out  Receives the fields; missing ones are left at 0.
+     */
+    static void parseMeminfo(const std::string& text, MemInfo& out);
+
 private:
+    std::shared_ptr<const FileReader> files_;               ///< Source of /proc.
     std::chrono::steady_clock::time_point lastProcessScan_; ///< Last time process list was scanned.
     static constexpr int kProcessScanIntervalSec = 5;       ///< Seconds between process scans.
-    std::string cachedTopName_;                              ///< Name of the top-memory process.
+    Label       cachedTopName_;                              ///< Name of the top-memory process.
     uint64_t    cachedTopMem_ = 0;                           ///< RSS of the top process in bytes.
 
     uint64_t prevPgFault_ = 0;                               ///< Previous pgfault count from /proc/vmstat.
@@ -46,8 +80,19 @@ private:
     static constexpr size_t kMaxHistory = 300;               ///< Max usage-history samples kept.
     std::vector<float> usageHistory_;                        ///< Rolling memory usage percentages.
 
+    std::string meminfoBuf_;                                 ///< Reused /proc/meminfo read buffer.
+    std::string vmstatBuf_;                                  ///< Reused /proc/vmstat read buffer.
+
+    /**
+     * @brief Read the pgfault counter from /proc/vmstat.
+     * @param out Receives the count.
+     * @return false if the file or the field is missing.
+     */
+    bool readPgFault(uint64_t& out);
+
     mutable std::mutex mutex_;                               ///< Guards current_ for thread safety.
     MemorySnapshot     current_;                             ///< Latest snapshot, protected by mutex_.
+    MemorySnapshot     spare_;                               ///< Previous current_, rebuilt in place by update().
 
     /**
      * @brief Scan /proc to find the top 5 processes by RSS.
@@ -55,9 +100,10 @@ private:
      * @param outMem   Receives its RSS in bytes.
      * @param topProcs Receives up to 5 top processes sorted by memory.
      */
-    void scanTopProcess(std::string& outName, uint64_t& outMem,
+    void scanTopProcess(Label& outName, uint64_t& outMem,
                         std::vector<MemorySnapshot::TopProcess>& topProcs);
     std::vector<MemorySnapshot::TopProcess> cachedTopProcs_; ///< Cached top-5 processes.
+    WatchedFd psiWatch_;                                     ///< PSI memory trigger, if available.
 };
 
 #endif
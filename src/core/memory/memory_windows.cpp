@@ -178,7 +178,12 @@ void WindowsMemory::update() {
     {
         auto secsSinceScan = std::chrono::duration_cast<std::chrono::seconds>(
             now - lastProcessScan_).count();
-        if (secsSinceScan >= kProcessScanIntervalSec) {
+        if (!topProcessScan_) {
+            cachedTopName_.clear();
+            cachedTopMem_ = 0;
+            cachedTopProcs_.clear();
+            lastProcessScan_ = {};  // rescan as soon as it is re-enabled
+        } else if (secsSinceScan >= kProcessScanIntervalSec) {
             scanTopProcess(cachedTopName_, cachedTopMem_, cachedTopProcs_);
             lastProcessScan_ = now;
         }
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include "../utils/histogram.h"
+#include "../utils/intern.h"
+
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -66,7 +71,7 @@ struct MemorySnapshot {
 
     float    pageFaultsPerSec= 0.0f; ///< Page faults per second.
 
-    std::string topProcessName;      ///< Name of the top memory-consuming process.
+    Label       topProcessName;      ///< Name of the top memory-consuming process.
     uint64_t    topProcessMemory = 0;///< Memory used by the top process in bytes.
 
     uint64_t pagedPoolBytes = 0;     ///< Windows paged pool size in bytes.
@@ -74,7 +79,7 @@ struct MemorySnapshot {
 
     /// @brief A process entry for the top-consumers list.
     struct TopProcess {
-        std::string name;            ///< Process name.
+        Label    name;               ///< Process name.
         uint64_t memoryBytes = 0;    ///< Memory used in bytes.
     };
     std::vector<TopProcess> topProcesses; ///< Top 5 memory consumers.
@@ -84,7 +89,7 @@ struct MemorySnapshot {
 
 /// @brief Per-interface network statistics.
 struct NetworkInterfaceInfo {
-    std::string name;                ///< Interface name.
+    Label       name;                ///< Interface name.
     std::string ipAddress;           ///< IP address.
     std::string macAddress;          ///< MAC address.
     bool     isUp           = false; ///< Whether the interface is active.
@@ -107,9 +112,9 @@ struct TcpConnection {
     uint16_t    localPort    = 0;    ///< Local port number.
     std::string remoteAddr;          ///< Remote address.
     uint16_t    remotePort   = 0;    ///< Remote port number.
-    std::string state;               ///< TCP state (e.g. ESTABLISHED).
+    Label       state;               ///< TCP state (e.g. ESTABLISHED).
     int         pid          = 0;    ///< Owning process ID.
-    std::string processName;         ///< Owning process name.
+    Label       processName;         ///< Owning process name.
 };
 
 /// @brief Aggregated network metrics across all interfaces.
@@ -120,16 +125,16 @@ struct NetworkSnapshot {
     uint64_t totalBytesRecv   = 0;       ///< Total bytes received across all interfaces.
     float    highestUpload    = 0.0f;    ///< Peak upload rate observed.
     float    highestDownload  = 0.0f;    ///< Peak download rate observed.
-    std::string topProcess;              ///< Process with highest network activity.
+    Label    topProcess;                 ///< Process with highest network activity.
     std::vector<NetworkInterfaceInfo> interfaces; ///< Per-interface details.
     std::vector<TcpConnection>        connections;///< Active TCP connections.
 };
 
 /// @brief Per-disk storage and I/O metrics.
 struct DiskInfo {
-    std::string device;              ///< Device path (e.g. "/dev/sda", "C:").
-    std::string mountPoint;          ///< Mount point (e.g. "/", "C:\\").
-    std::string fsType;              ///< Filesystem type (e.g. "ext4", "NTFS").
+    Label       device;              ///< Device path (e.g. "/dev/sda", "C:").
+    std::string mountPoint;          ///< Mount point (e.g. "/", "C:\\"); not interned, see intern.h.
+    Label       fsType;              ///< Filesystem type (e.g. "ext4", "NTFS").
     uint64_t totalBytes      = 0;    ///< Total capacity in bytes.
     uint64_t usedBytes       = 0;    ///< Used space in bytes.
     uint64_t freeBytes       = 0;    ///< Free space in bytes.
@@ -176,10 +181,10 @@ struct GpuSnapshot {
 struct ProcessInfo {
     int         pid           = 0;   ///< Process ID.
     int         ppid          = 0;   ///< Parent process ID.
-    std::string name;                ///< Process name.
+    Label       name;                ///< Process name.
     std::string path;                ///< Executable path.
     std::string cmdline;             ///< Full command line.
-    std::string user;                ///< Owning user.
+    Label       user;                ///< Owning user.
     char        state         = '?'; ///< Process state (R, S, D, Z, T, etc.).
     float       cpuPercent    = 0.0f;///< CPU usage percentage.
     uint64_t    memoryBytes   = 0;   ///< Resident memory in bytes.
@@ -189,6 +194,8 @@ struct ProcessInfo {
     int         threads       = 0;   ///< Thread count.
     int         priority      = 0;   ///< Scheduling priority.
     int         nice          = 0;   ///< Nice value.
+    float       gpuPercent    = -1.0f;///< Busiest GPU engine class %, -1 if unknown.
+    uint64_t    gpuMemoryBytes = 0;  ///< Resident device-local (VRAM) memory in bytes.
 };
 
 /// @brief Snapshot of all running processes.
@@ -247,6 +254,63 @@ struct AlertEvent {
     float       threshold = 0.0f;    ///< Threshold that was breached.
 };
 
+/// @brief Per-module scheduling and cost, as seen by the collector.
+struct CollectorModuleStats {
+    std::string name;                ///< Module name ("CPU", "Process", ...).
+    bool        enabled      = false;///< Scheduled under the active profile and interest.
+    float       basePeriodMs = 0.0f; ///< Period requested by the profile.
+    float       periodMs     = 0.0f; ///< Effective period after budget adaptation.
+    float       cpuMsPerRun  = 0.0f; ///< Smoothed CPU time of one update() in ms.
+    float       cpuPercent   = 0.0f; ///< Estimated share of one core at periodMs.
+    bool        degraded     = false;///< Period lengthened to stay within budget.
+    bool        stale        = false;///< Last update missed its deadline; snapshot is old.
+    uint64_t    deadlineMisses = 0;  ///< Ticks on which this module produced no fresh data.
+    uint64_t    eventUpdates   = 0;  ///< Updates triggered by a kernel change notification.
+    bool        ready        = true; ///< Constructed and collecting (false while starting up).
+    float       readyMs      = 0.0f; ///< Time from Collector construction until ready.
+    uint64_t    updates      = 0;    ///< update() calls completed.
+    Histogram   updateUs;            ///< Wall time of each update(), in us.
+    uint64_t    syscalls     = 0;    ///< I/O syscalls made by update() (cumulative).
+    uint64_t    fileOpens    = 0;    ///< Files opened by update() (cumulative).
+    uint64_t    bytesRead    = 0;    ///< Bytes read and parsed by update() (cumulative).
+};
+
+/// @brief Counters for one pipeline stage (see Pipeline). Units are microseconds.
+struct PipelineStageStats {
+    std::string name;
+    uint64_t    processed     = 0;  ///< Samples the stage finished.
+    uint64_t    dropped       = 0;  ///< Samples rejected because its queue was full.
+    std::size_t queueDepth    = 0;  ///< Samples waiting right now.
+    std::size_t maxQueueDepth = 0;  ///< Highest depth seen.
+    std::size_t capacity      = 0;  ///< Queue capacity (0 for the collection stage).
+    double      cpuSeconds    = 0;  ///< CPU time spent in the stage function.
+    Histogram   latencyUs;          ///< Time spent in the stage function.
+    Histogram   waitUs;             ///< Time from enqueue to dequeue.
+};
+
+/// @brief Tick timing on the collector's absolute schedule (cumulative).
+struct TickStats {
+    std::string catchUp;          ///< Catch-up policy name ("skip", "burst", "reanchor").
+    float     periodMs    = 0.0f; ///< Current tick period.
+    uint64_t  ticks       = 0;    ///< Scheduled ticks taken.
+    uint64_t  missedTicks = 0;    ///< Scheduled ticks dropped because the loop fell behind.
+    uint64_t  overruns    = 0;    ///< Ticks whose work ran past the next deadline.
+    uint64_t  earlyTicks  = 0;    ///< Extra ticks triggered by wake() before the deadline.
+    Histogram jitterUs;           ///< Wake-up lateness relative to the deadline, in us.
+    Histogram overrunUs;          ///< How far overrunning ticks ran past the deadline, in us.
+};
+
+/// @brief The monitor's own overhead, filled by the Collector each tick.
+struct CollectorStats {
+    std::string profile;                       ///< Active collection profile name.
+    float overheadPercent = 0.0f;              ///< Smoothed collector CPU, % of one core.
+    float budgetPercent   = 0.0f;              ///< Configured budget (0 = unlimited).
+    std::vector<CollectorModuleStats> modules; ///< One entry per module.
+    TickStats ticks;                           ///< Scheduling accuracy.
+    float firstCompleteMs = 0.0f;              ///< Startup until every enabled module had data (0 until then).
+    std::vector<PipelineStageStats> stages;    ///< Pipeline stages as of the previous tick (empty without a Pipeline).
+};
+
 /// @brief Master snapshot filled by the collector thread each tick.
 struct MetricData {
     CpuSnapshot        cpu;          ///< CPU metrics.
@@ -256,4 +320,14 @@ struct MetricData {
     GpuSnapshot        gpu;          ///< GPU metrics.
     ProcessSnapshot    process;      ///< Process metrics.
     SystemInfoSnapshot systemInfo;   ///< Static system information.
+    CollectorStats     collector;    ///< Self-overhead of the collector.
+
+    /// Wall-clock time the sample was taken (for storage and export).
+    std::chrono::system_clock::time_point timestamp{};
+    /// Seconds since the Collector started, on the monotonic clock
+    /// (for graph axes and interval maths; unaffected by clock changes).
+    double             elapsedSec = 0.0;
+    /// Sequence number from Collector::collect(), starting at 1; equal
+    /// versions mean the same sample.
+    uint64_t           version = 0;
 };
@@ -6,6 +6,10 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
+#include "../events/event_loop.h"
+#include <atomic>
+#include <functional>
 #include <memory>
 
 /**
@@ -25,10 +29,35 @@ public:
      * @return NetworkSnapshot from the most recent update() call.
      */
     virtual NetworkSnapshot snapshot() const = 0;
+
+    /**
+     * @brief Register event sources that signal interface or address changes.
+     *
+     * Called once by the Collector. @p onChange runs on the collecting
+     * thread and schedules an immediate update(). The default registers
+     * nothing and the module is only polled.
+     */
+    virtual void watchEvents(EventLoop& loop, std::function<void()> onChange) {
+        (void)loop; (void)onChange;
+    }
+
+    /**
+     * @brief Enable or disable the TCP/UDP connection table.
+     *
+     * Building the table requires mapping sockets to PIDs, which is the
+     * most expensive part of the module; with it off only interface
+     * counters are collected.
+     * @param on True to collect connections on every update().
+     */
+    void setConnectionTracking(bool on) { connectionTracking_ = on; }
+
+protected:
+    std::atomic<bool> connectionTracking_{true}; ///< Collect connections in update().
 };
 
 /**
  * @brief Create a platform-specific Network instance.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  * @return Owning pointer to the concrete implementation.
  */
-std::unique_ptr<Network> createNetwork();
+std::unique_ptr<Network> createNetwork(std::shared_ptr<const FileReader> files = hostFileReader());
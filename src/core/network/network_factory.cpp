@@ -13,11 +13,12 @@
 #error "Unsupported platform"
 #endif
 
-std::unique_ptr<Network> createNetwork() {
+std::unique_ptr<Network> createNetwork(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsNetwork>();
 #elif defined(__linux__)
-    return std::make_unique<LinuxNetwork>();
+    return std::make_unique<LinuxNetwork>(std::move(files));
 #else
     return nullptr;
 #endif
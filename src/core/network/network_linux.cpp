@@ -6,186 +6,246 @@
 #ifdef __linux__
 
 #include "network_linux.h"
+#include "../process/fd_scanner_linux.h"
+#include "../../utils/tracer.h"
 
 #include <algorithm>
 #include <cctype>
 #include <iterator>
 #include <cstdio>
 #include <cstring>
-#include <dirent.h>
-#include <fstream>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netinet/in.h>
 #include <netpacket/packet.h>
 #include <arpa/inet.h>
-#include <sstream>
+#include <memory_resource>
+#include <string_view>
 #include <string>
 #include <unistd.h>
 #include <vector>
 
-LinuxNetwork::LinuxNetwork()
-    : prevTime_(std::chrono::steady_clock::now()),
-      lastInodeScan_(std::chrono::steady_clock::now() - std::chrono::seconds(10))
+LinuxNetwork::LinuxNetwork(std::shared_ptr<const FileReader> files)
+    : files_(std::move(files)),
+      fdScanner_(LinuxFdScanner::forReader(files_)),
+      prevTime_(files_->now())
 {
 }
 
 LinuxNetwork::~LinuxNetwork() = default;
 
-std::string LinuxNetwork::tcpStateToString(int state) {
-    switch (state) {
-        case 0x01: return "ESTABLISHED";
-        case 0x02: return "SYN_SENT";
-        case 0x03: return "SYN_RECV";
-        case 0x04: return "FIN_WAIT1";
-        case 0x05: return "FIN_WAIT2";
-        case 0x06: return "TIME_WAIT";
-        case 0x07: return "CLOSE";
-        case 0x08: return "CLOSE_WAIT";
-        case 0x09: return "LAST_ACK";
-        case 0x0A: return "LISTEN";
-        case 0x0B: return "CLOSING";
-        default:   return "UNKNOWN";
+namespace {
+
+/// Reset an interface entry to defaults but keep its string buffers.
+void recycle(NetworkInterfaceInfo& info) {
+    NetworkInterfaceInfo fresh;
+    fresh.ipAddress.swap(info.ipAddress);
+    fresh.macAddress.swap(info.macAddress);
+    fresh.ipAddress.clear();
+    fresh.macAddress.clear();
+    info = std::move(fresh);
+}
+
+/// Reset a connection entry to defaults but keep its string buffers.
+void recycle(TcpConnection& conn) {
+    TcpConnection fresh;
+    fresh.localAddr.swap(conn.localAddr);
+    fresh.remoteAddr.swap(conn.remoteAddr);
+    fresh.localAddr.clear();
+    fresh.remoteAddr.clear();
+    conn = std::move(fresh);
+}
+
+const char* skipSpaces(const char* p) {
+    while (*p == ' ' || *p == '\t') ++p;
+    return p;
+}
+
+const char* skipToken(const char* p) {
+    p = skipSpaces(p);
+    while (*p && !std::isspace(static_cast<unsigned char>(*p))) ++p;
+    return p;
+}
+
+/// Parse up to @p maxDigits hex digits at @p p and advance past them.
+uint32_t parseHex(const char*& p, int maxDigits) {
+    uint32_t v = 0;
+    for (int i = 0; i < maxDigits && std::isxdigit(static_cast<unsigned char>(*p)); ++i, ++p) {
+        char c = *p;
+        v = v * 16 + static_cast<uint32_t>(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+    }
+    return v;
+}
+
+/// Parse a decimal field after optional spaces, without crossing the line end.
+uint64_t parseDec(const char*& p) {
+    p = skipSpaces(p);
+    uint64_t v = 0;
+    while (*p >= '0' && *p <= '9') v = v * 10 + static_cast<uint64_t>(*p++ - '0');
+    return v;
+}
+
+/**
+ * Parse "ADDR:PORT" as printed in /proc/net/{tcp,udp}[6]. The address is
+ * the raw in-kernel bytes, printed as 32-bit words in host byte order.
+ */
+bool parseEndpoint(const char*& p, bool v6, std::string& ip, uint16_t& port) {
+    p = skipSpaces(p);
+    unsigned char addr[16] = {};
+    for (int i = 0; i < (v6 ? 4 : 1); ++i) {
+        uint32_t group = parseHex(p, 8);
+        std::memcpy(addr + i * 4, &group, sizeof(group));
     }
+    if (*p != ':') return false;
+    ++p;
+    port = static_cast<uint16_t>(parseHex(p, 4));
+
+    char buf[INET6_ADDRSTRLEN] = {};
+    inet_ntop(v6 ? AF_INET6 : AF_INET, addr, buf, sizeof(buf));
+    ip.assign(buf);
+    return true;
 }
 
-std::string LinuxNetwork::resolveProcessName(int pid) {
-    if (pid <= 0) return "N/A";
+} // namespace
+
+Label LinuxNetwork::tcpStateToString(int state) {
+    // Indexed by the kernel's TCP state number (include/net/tcp_states.h).
+    static const Label kStates[] = {
+        "UNKNOWN", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1",
+        "FIN_WAIT2", "TIME_WAIT", "CLOSE", "CLOSE_WAIT", "LAST_ACK",
+        "LISTEN", "CLOSING",
+    };
+    return (state >= 0x01 && state <= 0x0B) ? kStates[state] : kStates[0];
+}
+
+Label LinuxNetwork::resolveProcessName(int pid) {
+    static const Label kNotApplicable = "N/A";
+    if (pid <= 0) return kNotApplicable;
 
     auto it = processNameCache_.find(pid);
     if (it != processNameCache_.end()) return it->second;
 
-    std::string name = "Unknown";
-    std::string commPath = "/proc/" + std::to_string(pid) + "/comm";
-    std::ifstream f(commPath);
-    if (f.is_open()) {
-        std::getline(f, name);
-        if (name.empty()) name = "Unknown";
+    char commPath[32];
+    std::snprintf(commPath, sizeof(commPath), "/proc/%d/comm", pid);
+    std::string_view name = "Unknown";
+    if (files_->read(commPath, sysBuf_)) {
+        std::string_view comm(sysBuf_);
+        comm = comm.substr(0, comm.find('\n'));
+        if (!comm.empty()) name = comm;
     }
-    processNameCache_[pid] = name;
-    return name;
+    Label label(name);
+    processNameCache_.emplace(pid, label);
+    return label;
 }
 
 void LinuxNetwork::refreshInodePidMap() {
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::seconds>(now - lastInodeScan_).count() < 5) {
-        return;
-    }
-    lastInodeScan_ = now;
-    inodePidMap_.clear();
-
-    DIR* procDir = opendir("/proc");
-    if (!procDir) return;
-
-    struct dirent* pEntry = nullptr;
-    while ((pEntry = readdir(procDir)) != nullptr) {
-        if (pEntry->d_type != DT_DIR && pEntry->d_type != DT_UNKNOWN) continue;
-        const char* dname = pEntry->d_name;
-        bool allDigit = true;
-        for (const char* p = dname; *p; ++p) {
-            if (!std::isdigit(static_cast<unsigned char>(*p))) { allDigit = false; break; }
-        }
-        if (!allDigit || dname[0] == '\0') continue;
-
-        int pid = std::atoi(dname);
-        std::string fdDir = std::string("/proc/") + dname + "/fd";
-        DIR* fdDirPtr = opendir(fdDir.c_str());
-        if (!fdDirPtr) continue;
-
-        struct dirent* fdEntry = nullptr;
-        while ((fdEntry = readdir(fdDirPtr)) != nullptr) {
-            std::string linkPath = fdDir + "/" + fdEntry->d_name;
-            char target[256] = {};
-            ssize_t len = readlink(linkPath.c_str(), target, sizeof(target) - 1);
-            if (len <= 0) continue;
-            target[len] = '\0';
-
-            if (std::strncmp(target, "socket:[", 8) == 0) {
-                uint64_t inode = std::strtoull(target + 8, nullptr, 10);
-                if (inode > 0) {
-                    inodePidMap_[inode] = pid;
-                }
-            }
-        }
-        closedir(fdDirPtr);
-    }
-    closedir(procDir);
+    // The fd walk is shared with the process manager (DRM fdinfo), so only
+    // copy the map when the scanner has produced a new generation.
+    auto& scanner = *fdScanner_;
+    scanner.refresh();
+    uint64_t gen = scanner.generation();
+    if (gen == inodeGeneration_) return;
+    inodePidMap_ = scanner.socketInodes();
+    inodeGeneration_ = gen;
 }
 
 void LinuxNetwork::parseNetDev(std::vector<NetworkInterfaceInfo>& ifaces, double dtSec) {
-    std::ifstream f("/proc/net/dev");
-    if (!f.is_open()) return;
-
-    std::string line;
-    std::getline(f, line);
-    std::getline(f, line);
-
-    std::unordered_map<std::string, IfPrev> newPrev;
-
-    while (std::getline(f, line)) {
-        auto colon = line.find(':');
-        if (colon == std::string::npos) continue;
-
-        std::string name = line.substr(0, colon);
-        name.erase(0, name.find_first_not_of(" \t"));
-        name.erase(name.find_last_not_of(" \t") + 1);
-
-        if (name == "lo") continue;
-
-        std::istringstream ss(line.substr(colon + 1));
-        uint64_t rxBytes, rxPackets, rxErrors, rxDrops, rxFifo, rxFrame, rxCompressed, rxMulticast;
-        uint64_t txBytes, txPackets, txErrors, txDrops, txFifo, txColls, txCarrier, txCompressed;
-
-        ss >> rxBytes >> rxPackets >> rxErrors >> rxDrops
-           >> rxFifo  >> rxFrame   >> rxCompressed >> rxMulticast
-           >> txBytes >> txPackets >> txErrors >> txDrops
-           >> txFifo  >> txColls   >> txCarrier >> txCompressed;
-
-        NetworkInterfaceInfo info;
-        info.name       = name;
-        info.totalRecv  = rxBytes;
-        info.totalSent  = txBytes;
-        info.packetsIn  = rxPackets;
-        info.packetsOut = txPackets;
-        info.errorsIn   = rxErrors;
-        info.errorsOut  = txErrors;
-        info.dropsIn    = rxDrops;
-        info.dropsOut   = txDrops;
-
-        info.isUp          = readOperState(name);
-        info.linkSpeedMbps = readLinkSpeed(name);
-
-        if (hasPrevSample_) {
-            auto pit = prevCounters_.find(name);
-            if (pit != prevCounters_.end()) {
-                uint64_t dRx = (rxBytes >= pit->second.rxBytes)
-                                ? (rxBytes - pit->second.rxBytes) : 0;
-                uint64_t dTx = (txBytes >= pit->second.txBytes)
-                                ? (txBytes - pit->second.txBytes) : 0;
+    TraceSpan span("parse", "/proc/net/dev");
+    std::size_t n = 0;
+    if (files_->read("/proc/net/dev", fileBuf_)) {
+        const char* p   = fileBuf_.c_str();
+        const char* end = p + fileBuf_.size();
+
+        // Two header lines.
+        for (int i = 0; i < 2 && p < end; ++i) {
+            auto* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            p = nl ? nl + 1 : end;
+        }
+
+        while (p < end) {
+            auto* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char* eol = nl ? nl : end;
+            const char* line = p;
+            p = eol + 1;
+
+            auto* colon = static_cast<const char*>(std::memchr(line, ':', static_cast<size_t>(eol - line)));
+            if (!colon) continue;
+
+            const char* nameBegin = skipSpaces(line);
+            const char* nameEnd   = colon;
+            while (nameEnd > nameBegin && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t')) --nameEnd;
+            if (nameEnd - nameBegin == 2 && std::memcmp(nameBegin, "lo", 2) == 0) continue;
+
+            const char* q = colon + 1;
+            uint64_t f[16];
+            for (auto& v : f) v = parseDec(q);
+            const uint64_t rxBytes = f[0], rxPackets = f[1], rxErrors = f[2], rxDrops = f[3];
+            const uint64_t txBytes = f[8], txPackets = f[9], txErrors = f[10], txDrops = f[11];
+
+            if (n == ifaces.size()) ifaces.emplace_back();
+            NetworkInterfaceInfo& info = ifaces[n++];
+            recycle(info);
+            const std::string_view name(nameBegin, static_cast<size_t>(nameEnd - nameBegin));
+            info.name = name;
+            info.totalRecv  = rxBytes;
+            info.totalSent  = txBytes;
+            info.packetsIn  = rxPackets;
+            info.packetsOut = txPackets;
+            info.errorsIn   = rxErrors;
+            info.errorsOut  = txErrors;
+            info.dropsIn    = rxDrops;
+            info.dropsOut   = txDrops;
+
+            info.isUp          = readOperState(name);
+            info.linkSpeedMbps = readLinkSpeed(name);
+
+            // Names past a full intern pool all share kOverflowId, so those
+            // are keyed by their text instead.
+            IfPrev* prev;
+            bool known;
+            if (info.name.id() == InternPool::kOverflowId) {
+                auto [it, added] = overflowCounters_.try_emplace(std::string(name));
+                prev = &it->second;
+                known = !added;
+            } else {
+                auto [it, added] = prevCounters_.try_emplace(info.name.id());
+                prev = &it->second;
+                known = !added;
+            }
+            if (hasPrevSample_ && known) {
+                uint64_t dRx = (rxBytes >= prev->rxBytes) ? (rxBytes - prev->rxBytes) : 0;
+                uint64_t dTx = (txBytes >= prev->txBytes) ? (txBytes - prev->txBytes) : 0;
                 info.downloadRate = static_cast<float>(dRx / dtSec);
                 info.uploadRate   = static_cast<float>(dTx / dtSec);
             }
-        }
 
-        newPrev[name] = { rxBytes, txBytes, rxPackets, txPackets,
-                          rxErrors, txErrors, rxDrops, txDrops };
-
-        ifaces.push_back(std::move(info));
+            *prev = { rxBytes, txBytes, rxPackets, txPackets,
+                      rxErrors, txErrors, rxDrops, txDrops, tick_ };
+        }
     }
+    ifaces.resize(n);
 
-    prevCounters_ = std::move(newPrev);
+    // Forget interfaces that have disappeared.
+    for (auto it = prevCounters_.begin(); it != prevCounters_.end();) {
+        if (it->second.seenTick != tick_) it = prevCounters_.erase(it);
+        else ++it;
+    }
+    for (auto it = overflowCounters_.begin(); it != overflowCounters_.end();) {
+        if (it->second.seenTick != tick_) it = overflowCounters_.erase(it);
+        else ++it;
+    }
 }
 
 void LinuxNetwork::fillAddresses(std::vector<NetworkInterfaceInfo>& ifaces) {
     struct ifaddrs* ifap = nullptr;
     if (getifaddrs(&ifap) != 0) return;
 
-    std::unordered_map<std::string, std::string> ipMap;
-    std::unordered_map<std::string, std::string> macMap;
+    std::pmr::unordered_map<std::string_view, std::pmr::string> ipMap(arena_.resource());
+    std::pmr::unordered_map<std::string_view, std::pmr::string> macMap(arena_.resource());
 
     for (auto* ifa = ifap; ifa; ifa = ifa->ifa_next) {
         if (!ifa->ifa_addr) continue;
-        std::string ifName = ifa->ifa_name;
+        std::string_view ifName = ifa->ifa_name;  // valid until freeifaddrs()
 
         if (ifa->ifa_addr->sa_family == AF_INET) {
             auto* sa = reinterpret_cast<sockaddr_in*>(ifa->ifa_addr);
@@ -204,217 +264,72 @@ void LinuxNetwork::fillAddresses(std::vector<NetworkInterfaceInfo>& ifaces) {
             }
         }
     }
-    freeifaddrs(ifap);
 
     for (auto& info : ifaces) {
-        auto iit = ipMap.find(info.name);
-        if (iit != ipMap.end()) info.ipAddress = iit->second;
-        auto mit = macMap.find(info.name);
-        if (mit != macMap.end()) info.macAddress = mit->second;
+        auto iit = ipMap.find(info.name.str());
+        if (iit != ipMap.end()) info.ipAddress.assign(iit->second);
+        auto mit = macMap.find(info.name.str());
+        if (mit != macMap.end()) info.macAddress.assign(mit->second);
     }
+    freeifaddrs(ifap);
 }
 
-float LinuxNetwork::readLinkSpeed(const std::string& iface) {
-    std::string path = "/sys/class/net/" + iface + "/speed";
-    std::ifstream f(path);
-    if (!f.is_open()) return 0.0f;
-    int speed = 0;
-    f >> speed;
-    if (f.fail() || speed < 0) return 0.0f;
+float LinuxNetwork::readLinkSpeed(std::string_view iface) {
+    char path[IFNAMSIZ + 32];
+    std::snprintf(path, sizeof(path), "/sys/class/net/%.*s/speed",
+                  static_cast<int>(iface.size()), iface.data());
+    if (!files_->read(path, sysBuf_) || sysBuf_.empty()) return 0.0f;
+    int speed = std::atoi(sysBuf_.c_str());
+    if (speed < 0) return 0.0f;
     return static_cast<float>(speed);
 }
 
-bool LinuxNetwork::readOperState(const std::string& iface) {
-    std::string path = "/sys/class/net/" + iface + "/operstate";
-    std::ifstream f(path);
-    if (!f.is_open()) return false;
-    std::string state;
-    f >> state;
-    return (state == "up");
+bool LinuxNetwork::readOperState(std::string_view iface) {
+    char path[IFNAMSIZ + 32];
+    std::snprintf(path, sizeof(path), "/sys/class/net/%.*s/operstate",
+                  static_cast<int>(iface.size()), iface.data());
+    if (!files_->read(path, sysBuf_)) return false;
+    return sysBuf_.compare(0, 3, "up\n") == 0 || sysBuf_ == "up";
 }
 
-std::vector<TcpConnection> LinuxNetwork::parseTcpConnections() {
-    std::vector<TcpConnection> conns;
-
-    refreshInodePidMap();
-
-    std::ifstream f("/proc/net/tcp");
-    if (!f.is_open()) return conns;
-
-    std::string line;
-    std::getline(f, line);
-
-    while (std::getline(f, line)) {
-        std::istringstream ss(line);
-        std::string sl, localHex, remoteHex, stHex;
-        std::string txrx, trtm, retrans;
-        int uid = 0;
-        int timeout = 0;
-        uint64_t inode = 0;
-
-        ss >> sl >> localHex >> remoteHex >> stHex
-           >> txrx >> trtm >> retrans >> uid >> timeout >> inode;
-
-        auto parseAddr = [](const std::string& hex, std::string& ip, uint16_t& port) {
-            auto colon = hex.find(':');
-            if (colon == std::string::npos) return;
-            uint32_t ipRaw = static_cast<uint32_t>(std::strtoul(hex.substr(0, colon).c_str(), nullptr, 16));
-            port = static_cast<uint16_t>(std::strtoul(hex.substr(colon + 1).c_str(), nullptr, 16));
-            in_addr addr;
-            addr.s_addr = ipRaw;
-            char buf[INET_ADDRSTRLEN] = {};
-            inet_ntop(AF_INET, &addr, buf, sizeof(buf));
-            ip = buf;
-        };
-
-        TcpConnection conn;
-        parseAddr(localHex,  conn.localAddr,  conn.localPort);
-        parseAddr(remoteHex, conn.remoteAddr, conn.remotePort);
-
-        int stateInt = static_cast<int>(std::strtol(stHex.c_str(), nullptr, 16));
-        conn.state = tcpStateToString(stateInt);
-
-        auto pit = inodePidMap_.find(inode);
-        if (pit != inodePidMap_.end()) {
-            conn.pid = pit->second;
-            conn.processName = resolveProcessName(conn.pid);
-        } else {
-            conn.pid = 0;
-            conn.processName = "N/A";
-        }
-
-        conns.push_back(std::move(conn));
-    }
-
-    return conns;
+void LinuxNetwork::parseSocketTable(const char* path, bool v6, bool udp,
+                                    std::vector<TcpConnection>& conns, std::size_t& n) {
+    TraceSpan span("parse", path);  // always a literal
+    if (files_->read(path, fileBuf_)) parseSocketText(fileBuf_, v6, udp, conns, n);
 }
 
-std::vector<TcpConnection> LinuxNetwork::parseTcp6Connections() {
-    std::vector<TcpConnection> conns;
-    refreshInodePidMap();
-
-    std::ifstream f("/proc/net/tcp6");
-    if (!f.is_open()) return conns;
-
-    std::string line;
-    std::getline(f, line);
-
-    while (std::getline(f, line)) {
-        std::istringstream ss(line);
-        std::string sl, localHex, remoteHex, stHex;
-        std::string txrx, trtm, retrans;
-        int uid = 0, timeout = 0;
-        uint64_t inode = 0;
-
-        ss >> sl >> localHex >> remoteHex >> stHex
-           >> txrx >> trtm >> retrans >> uid >> timeout >> inode;
-
-        auto parseAddr6 = [](const std::string& hex, std::string& ip, uint16_t& port) {
-            auto colon = hex.find(':');
-            if (colon == std::string::npos || colon < 32) return;
-            std::string addrHex = hex.substr(0, colon);
-            port = static_cast<uint16_t>(std::strtoul(hex.substr(colon + 1).c_str(), nullptr, 16));
-
-            unsigned char addr[16] = {};
-            for (int i = 0; i < 4; ++i) {
-                uint32_t group = static_cast<uint32_t>(
-                    std::strtoul(addrHex.substr(i * 8, 8).c_str(), nullptr, 16));
-                addr[i*4 + 0] = static_cast<unsigned char>((group >>  0) & 0xFF);
-                addr[i*4 + 1] = static_cast<unsigned char>((group >>  8) & 0xFF);
-                addr[i*4 + 2] = static_cast<unsigned char>((group >> 16) & 0xFF);
-                addr[i*4 + 3] = static_cast<unsigned char>((group >> 24) & 0xFF);
-            }
-
-            char buf[INET6_ADDRSTRLEN] = {};
-            inet_ntop(AF_INET6, addr, buf, sizeof(buf));
-            ip = buf;
-        };
+void LinuxNetwork::parseSocketText(const std::string& text, bool v6, bool udp,
+                                   std::vector<TcpConnection>& conns, std::size_t& n) {
+    const char* p   = text.c_str();
+    const char* end = p + text.size();
 
-        TcpConnection conn;
-        parseAddr6(localHex,  conn.localAddr,  conn.localPort);
-        parseAddr6(remoteHex, conn.remoteAddr, conn.remotePort);
+    // Header line.
+    auto* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    p = nl ? nl + 1 : end;
 
-        int stateInt = static_cast<int>(std::strtol(stHex.c_str(), nullptr, 16));
-        conn.state = tcpStateToString(stateInt);
+    while (p < end) {
+        nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* q = p;
+        p = nl ? nl + 1 : end;
 
-        auto pit = inodePidMap_.find(inode);
-        if (pit != inodePidMap_.end()) {
-            conn.pid = pit->second;
-            conn.processName = resolveProcessName(conn.pid);
-        } else {
-            conn.pid = 0;
-            conn.processName = "N/A";
-        }
+        //  sl local_address rem_address st tx_queue:rx_queue tr:tm->when retrnsmt uid timeout inode
+        q = skipToken(q);
 
-        conns.push_back(std::move(conn));
-    }
+        if (n == conns.size()) conns.emplace_back();
+        TcpConnection& conn = conns[n];
+        recycle(conn);
+        if (!parseEndpoint(q, v6, conn.localAddr,  conn.localPort))  continue;
+        if (!parseEndpoint(q, v6, conn.remoteAddr, conn.remotePort)) continue;
 
-    return conns;
-}
+        q = skipSpaces(q);
+        int stateInt = static_cast<int>(parseHex(q, 2));
+        static const Label kUdp = "UDP";
+        conn.state = udp ? kUdp : tcpStateToString(stateInt);
 
-std::vector<TcpConnection> LinuxNetwork::parseUdpConnections(const std::string& path) {
-    std::vector<TcpConnection> conns;
-    refreshInodePidMap();
-
-    std::ifstream f(path);
-    if (!f.is_open()) return conns;
-
-    bool isV6 = (path.find("udp6") != std::string::npos);
-
-    std::string line;
-    std::getline(f, line);
-
-    while (std::getline(f, line)) {
-        std::istringstream ss(line);
-        std::string sl, localHex, remoteHex, stHex;
-        std::string txrx, trtm, retrans;
-        int uid = 0, timeout = 0;
-        uint64_t inode = 0;
-
-        ss >> sl >> localHex >> remoteHex >> stHex
-           >> txrx >> trtm >> retrans >> uid >> timeout >> inode;
-
-        TcpConnection conn;
-        conn.state = "UDP";
-
-        if (isV6) {
-            auto parseAddr6 = [](const std::string& hex, std::string& ip, uint16_t& port) {
-                auto colon = hex.find(':');
-                if (colon == std::string::npos || colon < 32) return;
-                std::string addrHex = hex.substr(0, colon);
-                port = static_cast<uint16_t>(std::strtoul(hex.substr(colon + 1).c_str(), nullptr, 16));
-
-                unsigned char addr[16] = {};
-                for (int i = 0; i < 4; ++i) {
-                    uint32_t group = static_cast<uint32_t>(
-                        std::strtoul(addrHex.substr(i * 8, 8).c_str(), nullptr, 16));
-                    addr[i*4 + 0] = static_cast<unsigned char>((group >>  0) & 0xFF);
-                    addr[i*4 + 1] = static_cast<unsigned char>((group >>  8) & 0xFF);
-                    addr[i*4 + 2] = static_cast<unsigned char>((group >> 16) & 0xFF);
-                    addr[i*4 + 3] = static_cast<unsigned char>((group >> 24) & 0xFF);
-                }
-
-                char buf[INET6_ADDRSTRLEN] = {};
-                inet_ntop(AF_INET6, addr, buf, sizeof(buf));
-                ip = buf;
-            };
-            parseAddr6(localHex,  conn.localAddr,  conn.localPort);
-            parseAddr6(remoteHex, conn.remoteAddr, conn.remotePort);
-        } else {
-            auto parseAddr4 = [](const std::string& hex, std::string& ip, uint16_t& port) {
-                auto colon = hex.find(':');
-                if (colon == std::string::npos) return;
-                uint32_t ipRaw = static_cast<uint32_t>(std::strtoul(hex.substr(0, colon).c_str(), nullptr, 16));
-                port = static_cast<uint16_t>(std::strtoul(hex.substr(colon + 1).c_str(), nullptr, 16));
-                in_addr addr;
-                addr.s_addr = ipRaw;
-                char buf[INET_ADDRSTRLEN] = {};
-                inet_ntop(AF_INET, &addr, buf, sizeof(buf));
-                ip = buf;
-            };
-            parseAddr4(localHex,  conn.localAddr,  conn.localPort);
-            parseAddr4(remoteHex, conn.remoteAddr, conn.remotePort);
-        }
+        for (int i = 0; i < 3; ++i) q = skipToken(q);  // queues, timer, retransmits
+        parseDec(q);                                    // uid
+        parseDec(q);                                    // timeout
+        uint64_t inode = parseDec(q);
 
         auto pit = inodePidMap_.find(inode);
         if (pit != inodePidMap_.end()) {
@@ -422,18 +337,24 @@ std::vector<TcpConnection> LinuxNetwork::parseUdpConnections(const std::string&
             conn.processName = resolveProcessName(conn.pid);
         } else {
             conn.pid = 0;
-            conn.processName = "N/A";
+            conn.processName = resolveProcessName(0);
         }
-
-        conns.push_back(std::move(conn));
+        ++n;
     }
-
-    return conns;
 }
 
 void LinuxNetwork::update() {
-    NetworkSnapshot local;
-    auto now = std::chrono::steady_clock::now();
+    arena_.reset();
+    ++tick_;
+
+    // Rebuild the spare snapshot (published two ticks ago) in place.
+    NetworkSnapshot& local = spare_;
+    local.totalUploadRate   = 0.0f;
+    local.totalDownloadRate = 0.0f;
+    local.totalBytesSent    = 0;
+    local.totalBytesRecv    = 0;
+
+    auto now = files_->now();
     double dtSec = std::chrono::duration<double>(now - prevTime_).count();
     if (dtSec <= 0.0) dtSec = 1.0;
 
@@ -448,36 +369,33 @@ void LinuxNetwork::update() {
         local.totalDownloadRate += iface.downloadRate;
     }
 
-    local.connections = parseTcpConnections();
-    {
-        auto v6conns = parseTcp6Connections();
-        local.connections.insert(local.connections.end(),
-                                 std::make_move_iterator(v6conns.begin()),
-                                 std::make_move_iterator(v6conns.end()));
-        auto udp4 = parseUdpConnections("/proc/net/udp");
-        local.connections.insert(local.connections.end(),
-                                 std::make_move_iterator(udp4.begin()),
-                                 std::make_move_iterator(udp4.end()));
-        auto udp6 = parseUdpConnections("/proc/net/udp6");
-        local.connections.insert(local.connections.end(),
-                                 std::make_move_iterator(udp6.begin()),
-                                 std::make_move_iterator(udp6.end()));
+    // Connections need the socket-to-PID map, which is the expensive part
+    // of this module; profiles can switch them off.
+    std::size_t nConns = 0;
+    if (connectionTracking_) {
+        refreshInodePidMap();
+        parseSocketTable("/proc/net/tcp",  false, false, local.connections, nConns);
+        parseSocketTable("/proc/net/tcp6", true,  false, local.connections, nConns);
+        parseSocketTable("/proc/net/udp",  false, true,  local.connections, nConns);
+        parseSocketTable("/proc/net/udp6", true,  true,  local.connections, nConns);
     }
+    local.connections.resize(nConns);
 
-    {
-        std::unordered_map<int, int> pidEstabCount;
+    if (connectionTracking_) {
+        const Label established = tcpStateToString(0x01);
+        estabCount_.clear();
         for (const auto& c : local.connections) {
-            if (c.state == "ESTABLISHED" && c.pid > 0) {
-                pidEstabCount[c.pid]++;
+            if (c.pid > 0 && c.state == established) {
+                estabCount_[c.pid]++;
             }
         }
-        if (!pidEstabCount.empty()) {
-            auto best = std::max_element(pidEstabCount.begin(), pidEstabCount.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
-            local.topProcess = resolveProcessName(best->first);
-        } else {
-            local.topProcess = "N/A";
-        }
+        int bestPid = 0, bestCount = 0;
+        estabCount_.forEach([&](int pid, int count) {
+            if (count > bestCount) { bestPid = pid; bestCount = count; }
+        });
+        local.topProcess = resolveProcessName(bestPid);
+    } else {
+        local.topProcess = resolveProcessName(0);
     }
 
     float newHighUp   = highestUpload_;
@@ -489,7 +407,7 @@ void LinuxNetwork::update() {
 
     {
         std::lock_guard<std::mutex> lock(mtx_);
-        snap_            = std::move(local);
+        std::swap(snap_, spare_);
         highestUpload_   = newHighUp;
         highestDownload_ = newHighDown;
     }
@@ -503,4 +421,12 @@ NetworkSnapshot LinuxNetwork::snapshot() const {
     return snap_;
 }
 
+void LinuxNetwork::watchEvents(EventLoop& loop, std::function<void()> onChange) {
+    int fd = openLinkWatch();
+    linkWatch_.watch(loop, fd, EventLoop::Readable,
+                     [fd, onChange](uint32_t) {
+                         if (consumeLinkMessages(fd)) onChange();
+                     });
+}
+
 #endif
@@ -8,20 +8,33 @@
 #ifdef __linux__
 
 #include "network_common.h"
+#include "../events/event_sources_linux.h"
+#include "../io/file_reader.h"
+#include "../../utils/pid_table.h"
+#include "../../utils/tick_arena.h"
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
 #include <cstdint>
 #include <chrono>
 
+class LinuxFdScanner;
+
 /**
  * @brief Linux network monitor using /proc and sysfs.
+ *
+ * Like the process manager, update() rebuilds the spare snapshot in place
+ * and reads procfs into a reused buffer, so a steady tick does not touch
+ * the heap beyond getifaddrs().
  */
 class LinuxNetwork : public Network {
 public:
-    LinuxNetwork();
+    /// @param files Where /proc and /sys are read from.
+    explicit LinuxNetwork(std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxNetwork() override;
 
     /**
@@ -35,6 +48,22 @@ public:
      */
     NetworkSnapshot snapshot() const override;
 
+    /**
+     * @brief Subscribe to rtnetlink link and address notifications.
+     */
+    void watchEvents(EventLoop& loop, std::function<void()> onChange) override;
+
+    /**
+     * @brief Parse the text of one /proc/net socket table (tcp, tcp6, udp, udp6).
+     * @param text  Whole file contents, header line included.
+     * @param v6    Addresses are 32 hex digits rather than 8.
+     * @param udp   Report the state as "UDP" instead of decoding it.
+     * @param conns Output; entries [0, n) are in use and reused in place.
+     * @param n     In/out count of entries used so far.
+     */
+    void parseSocketText(const std::string& text, bool v6, bool udp,
+                         std::vector<TcpConnection>& conns, std::size_t& n);
+
 private:
     /// Per-interface byte and packet counters from the previous sample.
     struct IfPrev {
@@ -46,21 +75,31 @@ private:
         uint64_t txErrors  = 0;
         uint64_t rxDrops   = 0;
         uint64_t txDrops   = 0;
+        uint64_t seenTick  = 0;   ///< Last tick the interface was listed.
     };
 
     /// Maps socket inode numbers to owning PIDs.
     using InodePidMap = std::unordered_map<uint64_t, int>;
 
+    std::shared_ptr<const FileReader> files_; ///< Source of /proc and /sys.
+    std::shared_ptr<LinuxFdScanner> fdScanner_; ///< Socket inode owners, shared with the process manager.
     mutable std::mutex mtx_;              ///< Guards snap_ for thread-safe reads.
     NetworkSnapshot snap_;                ///< Most recent snapshot from update().
+    NetworkSnapshot spare_;               ///< Previous snap_, rebuilt in place by update().
+    TickArena arena_;                     ///< Per-tick scratch (address maps).
+    std::string fileBuf_;                 ///< Reused /proc/net read buffer.
+    std::string sysBuf_;                  ///< Reused sysfs read buffer.
+    PidTable<int> estabCount_;            ///< ESTABLISHED connections per PID this tick.
+    uint64_t tick_ = 0;                   ///< update() count, for IfPrev::seenTick.
     float highestUpload_   = 0.0f;        ///< Lifetime peak upload rate (bytes/s).
     float highestDownload_ = 0.0f;        ///< Lifetime peak download rate (bytes/s).
-    std::unordered_map<std::string, IfPrev> prevCounters_; ///< Previous counters by interface name.
+    std::unordered_map<uint32_t, IfPrev> prevCounters_;    ///< Previous counters by interface Label id.
+    std::unordered_map<std::string, IfPrev> overflowCounters_; ///< Same, by name, for kOverflowId labels.
     std::chrono::steady_clock::time_point prevTime_;       ///< Timestamp of previous update().
     bool hasPrevSample_ = false;          ///< True after at least one update() completes.
-    std::unordered_map<int, std::string> processNameCache_; ///< PID-to-name lookup cache.
+    std::unordered_map<int, Label> processNameCache_; ///< PID-to-name lookup cache.
     InodePidMap inodePidMap_;             ///< Cached inode-to-PID mapping.
-    std::chrono::steady_clock::time_point lastInodeScan_;  ///< When inodePidMap_ was last refreshed.
+    uint64_t inodeGeneration_ = 0;        ///< Fd-scanner generation inodePidMap_ was copied from.
 
     /**
      * @brief Parse /proc/net/dev and populate interface info with counters and rates.
@@ -80,36 +119,24 @@ private:
      * @param iface Interface name (e.g. "eth0").
      * @return Link speed in Mbps, or 0 on failure.
      */
-    static float readLinkSpeed(const std::string& iface);
+    float readLinkSpeed(std::string_view iface);
 
     /**
      * @brief Check if an interface is up via sysfs operstate.
      * @param iface Interface name.
      * @return True if operstate is "up".
      */
-    static bool readOperState(const std::string& iface);
+    bool readOperState(std::string_view iface);
 
     /**
-     * @brief Parse /proc/net/tcp for IPv4 TCP connections.
-     * @return Vector of parsed TCP connections.
+     * @brief Read one /proc/net socket table and parse it with parseSocketText().
+     * @param path  Path to the proc file (e.g. "/proc/net/tcp6").
      */
-    std::vector<TcpConnection> parseTcpConnections();
+    void parseSocketTable(const char* path, bool v6, bool udp,
+                          std::vector<TcpConnection>& conns, std::size_t& n);
 
     /**
-     * @brief Parse /proc/net/tcp6 for IPv6 TCP connections.
-     * @return Vector of parsed TCP connections.
-     */
-    std::vector<TcpConnection> parseTcp6Connections();
-
-    /**
-     * @brief Parse a /proc/net/udp or udp6 file for UDP endpoints.
-     * @param path Path to the proc file (e.g. "/proc/net/udp").
-     * @return Vector of parsed UDP connections.
-     */
-    std::vector<TcpConnection> parseUdpConnections(const std::string& path);
-
-    /**
-     * @brief Rebuild the inode-to-PID map by scanning /proc/[pid]/fd/.
+     * @brief Refresh the inode-to-PID map from the shared /proc/[pid]/fd scan.
      */
     void refreshInodePidMap();
 
@@ -118,14 +145,16 @@ private:
      * @param pid Process identifier.
      * @return Process name or "Unknown"/"N/A".
      */
-    std::string resolveProcessName(int pid);
+    Label resolveProcessName(int pid);
 
     /**
      * @brief Convert a hex TCP state code to a human-readable string.
      * @param state Linux TCP state value from /proc/net/tcp.
      * @return State name such as "ESTABLISHED" or "LISTEN".
      */
-    static std::string tcpStateToString(int state);
+    static Label tcpStateToString(int state);
+
+    WatchedFd linkWatch_;  ///< NETLINK_ROUTE socket, if available.
 };
 
 #endif
@@ -191,9 +191,11 @@ void WindowsNetwork::update() {
         prevCounters_ = std::move(newPrev);
     }
 
+    // The connection tables are the expensive part of this module;
+    // profiles can switch them off.
     std::unordered_map<int, int> pidEstabCount;
 
-    {
+    if (connectionTracking_) {
         DWORD tcpSize = 0;
         GetExtendedTcpTable(nullptr, &tcpSize, FALSE, AF_INET,
                             TCP_TABLE_OWNER_PID_ALL, 0);
@@ -238,7 +240,7 @@ void WindowsNetwork::update() {
         }
     }
 
-    {
+    if (connectionTracking_) {
         DWORD tcpSize = 0;
         GetExtendedTcpTable(nullptr, &tcpSize, FALSE, AF_INET6,
                             TCP_TABLE_OWNER_PID_ALL, 0);
@@ -279,7 +281,7 @@ void WindowsNetwork::update() {
         }
     }
 
-    {
+    if (connectionTracking_) {
         DWORD udpSize = 0;
         GetExtendedUdpTable(nullptr, &udpSize, FALSE, AF_INET,
                             UDP_TABLE_OWNER_PID, 0);
@@ -310,7 +312,7 @@ void WindowsNetwork::update() {
         }
     }
 
-    {
+    if (connectionTracking_) {
         DWORD udpSize = 0;
         GetExtendedUdpTable(nullptr, &udpSize, FALSE, AF_INET6,
                             UDP_TABLE_OWNER_PID, 0);
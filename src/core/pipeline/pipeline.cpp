@@ -0,0 +1,179 @@
+/**
+ * @file pipeline.cpp
+ * @brief Stage threads, queue hand-off and per-stage accounting.
+ */
+
+#include "pipeline.h"
+#include "../collector/collector.h"
+#include "../../utils/cpu_time.h"
+#include "../../utils/event_log.h"
+#include "../../utils/tracer.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace {
+
+void nameThread(std::thread& t, const std::string& name) {
+#ifdef __linux__
+    pthread_setname_np(t.native_handle(), ("rm-" + name).substr(0, 15).c_str());
+#else
+    (void)t;
+    (void)name;
+#endif
+}
+
+uint64_t toUs(std::chrono::steady_clock::duration d) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+} // namespace
+
+Pipeline::Pipeline(Collector& collector, std::size_t queueCapacity)
+    : collector_(collector), capacity_(queueCapacity)
+{
+    collectStats_.name = "collect";
+}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+void Pipeline::addStage(const std::string& name, StageFn fn) {
+    if (running_) return;
+    stages_.push_back(std::make_unique<Stage>(name, std::move(fn), capacity_));
+    stages_.back()->stats.capacity = stages_.back()->queue.capacity();
+}
+
+void Pipeline::setBeforeCollect(std::function<void()> fn) {
+    if (running_) return;
+    beforeCollect_ = std::move(fn);
+}
+
+void Pipeline::start() {
+    if (running_.exchange(true)) return;
+    for (std::size_t i = 0; i < stages_.size(); ++i) {
+        auto& st = *stages_[i];
+        st.stop   = false;
+        st.thread = std::thread(&Pipeline::stageLoop, this, i);
+        nameThread(st.thread, st.stats.name);
+    }
+    collector_.setStageStatsSource([this] { return stats(); });
+    collectThread_ = std::thread(&Pipeline::collectLoop, this);
+    nameThread(collectThread_, collectStats_.name);
+}
+
+void Pipeline::stop() {
+    if (!running_.exchange(false)) return;
+    collector_.wake();
+    if (collectThread_.joinable()) collectThread_.join();
+    collector_.setStageStatsSource(nullptr);
+
+    // In order, so each stage drains into one that is still running.
+    for (auto& st : stages_) {
+        {
+            std::lock_guard<std::mutex> lock(st->wakeMtx);
+            st->stop = true;
+        }
+        st->wakeCv.notify_one();
+        if (st->thread.joinable()) st->thread.join();
+    }
+}
+
+void Pipeline::collectLoop() {
+    collector_.collect();  // prime the delta-based counters
+
+    Item item;
+    while (running_) {
+        collector_.waitNextTick();
+        if (!running_) break;
+        if (beforeCollect_) beforeCollect_();
+
+        auto   t0   = Clock::now();
+        double cpu0 = threadCpuSeconds();
+        item.md = collector_.collect();
+        double cpu  = threadCpuSeconds() - cpu0;
+        auto   t1   = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(statsMtx_);
+            collectStats_.latencyUs.record(toUs(t1 - t0));
+            collectStats_.cpuSeconds += cpu;
+            ++collectStats_.processed;
+        }
+        item.queued = t1;
+        forward(0, item);
+    }
+}
+
+void Pipeline::stageLoop(std::size_t index) {
+    Stage& st = *stages_[index];
+    Item item;
+    for (;;) {
+        if (!st.queue.tryPop(item)) {
+            std::unique_lock<std::mutex> lock(st.wakeMtx);
+            st.wakeCv.wait(lock, [&] { return st.stop || !st.queue.empty(); });
+            if (st.queue.empty()) return;  // stopped and drained
+            continue;
+        }
+
+        auto   t0   = Clock::now();
+        double cpu0 = threadCpuSeconds();
+        {
+            TraceSpan span("stage", st.traceName);
+            st.fn(item.md);
+        }
+        double cpu  = threadCpuSeconds() - cpu0;
+        auto   t1   = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(statsMtx_);
+            st.stats.waitUs.record(toUs(t0 - item.queued));
+            st.stats.latencyUs.record(toUs(t1 - t0));
+            st.stats.cpuSeconds += cpu;
+            ++st.stats.processed;
+        }
+        item.queued = t1;
+        forward(index + 1, item);
+    }
+}
+
+/**
+ * Queue @p item for stage @p index. On success @p item comes back holding
+ * an older sample's storage; if the queue is full the sample is dropped.
+ */
+void Pipeline::forward(std::size_t index, Item& item) {
+    if (index >= stages_.size()) return;
+    Stage& next = *stages_[index];
+
+    bool pushed = next.queue.tryPush(item);
+    {
+        std::lock_guard<std::mutex> lock(statsMtx_);
+        if (pushed)
+            next.stats.maxQueueDepth = std::max(next.stats.maxQueueDepth, next.queue.size());
+        else
+            ++next.stats.dropped;
+    }
+    if (!pushed) {
+        static const EventType kDropped("pipeline stage {} queue full; sample dropped");
+        EventLog::emit(kDropped, next.traceName);
+        return;
+    }
+
+    { std::lock_guard<std::mutex> lock(next.wakeMtx); }
+    next.wakeCv.notify_one();
+}
+
+std::vector<PipelineStageStats> Pipeline::stats() const {
+    std::lock_guard<std::mutex> lock(statsMtx_);
+    std::vector<PipelineStageStats> out;
+    out.reserve(stages_.size() + 1);
+    out.push_back(collectStats_);
+    for (const auto& st : stages_) {
+        out.push_back(st->stats);
+        out.back().queueDepth = st->queue.size();
+    }
+    return out;
+}
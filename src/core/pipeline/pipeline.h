@@ -0,0 +1,138 @@
+/**
+ * @file pipeline.h
+ * @brief Collection and its downstream consumers as threads joined by bounded queues.
+ *
+ * Without a pipeline one thread collects a sample, evaluates alerts,
+ * appends to history and writes the database before it can wait for the
+ * next tick, so a slow insert delays collection. A Pipeline gives the
+ * collection loop its own thread and runs every downstream stage
+ * (alerts, history, persistence, ...) on a thread of its own, connected
+ * in order by SpscQueues. A stage whose input queue is full has the
+ * sample dropped and counted instead of blocking the stage before it, so
+ * the collection cadence does not depend on what happens downstream.
+ *
+ * Publishing to readers happens at the end of the collection stage:
+ * Collector::collect() hands every sample to its SnapshotChannel, so the
+ * UI sees a sample as soon as it exists.
+ *
+ * Each stage reports how many samples it processed and dropped, its
+ * current and peak queue depth, and histograms of its run time and of
+ * how long samples waited in its queue. While running, the pipeline
+ * also hands these to the Collector, so every sample carries them in
+ * CollectorStats::stages.
+ */
+
+#pragma once
+
+#include "spsc_queue.h"
+#include "../metrics.h"
+#include "../../utils/histogram.h"
+#include "../../utils/tracer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Collector;
+
+/**
+ * @class Pipeline
+ * @brief Runs a Collector and an ordered list of consumer stages on separate threads.
+ */
+class Pipeline {
+public:
+    /// @brief Work done by a stage; may modify the sample for later stages.
+    using StageFn = std::function<void(MetricData&)>;
+
+    /**
+     * @param collector     Collector to drive; must outlive the pipeline.
+     * @param queueCapacity Samples each stage may have waiting.
+     */
+    explicit Pipeline(Collector& collector, std::size_t queueCapacity = 8);
+
+    /// @brief Calls stop().
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Append a stage. Only valid before start().
+     * @param name Stage name; the thread is called "rm-<name>".
+     * @param fn   Work to run for every sample.
+     */
+    void addStage(const std::string& name, StageFn fn);
+
+    /// @brief Run @p fn on the collection thread before every collect(). Only valid before start().
+    void setBeforeCollect(std::function<void()> fn);
+
+    /**
+     * @brief Start the collection thread and one thread per stage.
+     *
+     * The collection thread first calls collect() once without forwarding
+     * the result, to prime the delta-based counters, then collects on
+     * every Collector::waitNextTick().
+     */
+    void start();
+
+    /**
+     * @brief Stop collecting and join every thread. Idempotent.
+     *
+     * Samples already queued still pass through the remaining stages
+     * before their threads exit.
+     */
+    void stop();
+
+    bool running() const { return running_.load(); }
+
+    /// @brief Counters for the collection stage followed by every added stage.
+    std::vector<PipelineStageStats> stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// A sample in flight, stamped when it was queued.
+    struct Item {
+        MetricData        md;
+        Clock::time_point queued{};
+    };
+
+    struct Stage {
+        Stage(std::string n, StageFn f, std::size_t capacity)
+            : fn(std::move(f)), queue(capacity), traceName(Tracer::intern(n)) {
+            stats.name = std::move(n);
+        }
+
+        StageFn                 fn;
+        SpscQueue<Item>         queue;      ///< Input, filled by the previous stage.
+        const char*             traceName;  ///< Stage name for TraceSpan.
+        std::mutex              wakeMtx;    ///< Pairs with wakeCv for sleeping on an empty queue.
+        std::condition_variable wakeCv;
+        bool                    stop = false;  ///< Guarded by wakeMtx.
+        std::thread             thread;
+        PipelineStageStats      stats;      ///< Guarded by Pipeline::statsMtx_.
+    };
+
+    void collectLoop();
+    void stageLoop(std::size_t index);
+    void forward(std::size_t index, Item& item);
+
+    Collector&                          collector_;
+    std::size_t                         capacity_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::function<void()>               beforeCollect_;
+
+    std::atomic<bool>  running_{false};
+    std::thread        collectThread_;
+
+    mutable std::mutex statsMtx_;       ///< Guards every PipelineStageStats.
+    PipelineStageStats collectStats_;
+};
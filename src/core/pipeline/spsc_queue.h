@@ -0,0 +1,82 @@
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free single-producer/single-consumer ring.
+ *
+ * Connects two pipeline stages. tryPush() fails instead of blocking when
+ * the ring is full, so a slow consumer can never hold up its producer;
+ * the producer decides what to do with the rejected item. Items are
+ * swapped rather than copied in and out of their slots, so each side
+ * gets back the storage of an earlier item and containers keep their
+ * capacity from one lap of the ring to the next.
+ *
+ * Exactly one thread may push and exactly one thread may pop.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class SpscQueue {
+public:
+    /// @param capacity Maximum number of queued items (rounded up to a power of two).
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t n = 2;
+        while (n < capacity) n *= 2;
+        mask_  = n - 1;
+        slots_ = std::make_unique<T[]>(n);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Swap @p item into the ring. Producer only.
+     * @return false if full (@p item untouched); on success @p item holds
+     *         the slot's previous contents.
+     */
+    bool tryPush(T& item) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) return false;
+        std::swap(slots_[tail & mask_], item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Swap the oldest item into @p out. Consumer only. @return false if empty.
+    bool tryPop(T& out) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        std::swap(out, slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Items currently queued (approximate while both sides run).
+     *
+     * Safe from a third thread: head is read first, so the later tail is
+     * never behind it, and the result is capped at capacity() in case the
+     * consumer pops and the producer refills in between the two loads.
+     */
+    std::size_t size() const {
+        std::size_t head = head_.load(std::memory_order_acquire);
+        std::size_t tail = tail_.load(std::memory_order_acquire);
+        return std::min(tail - head, capacity());
+    }
+
+    bool empty() const { return size() == 0; }
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0};  ///< Next slot to pop.
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0};  ///< Next slot to push.
+    alignas(kCacheLine) std::size_t              mask_ = 0;
+    std::unique_ptr<T[]>                         slots_;
+};
@@ -0,0 +1,120 @@
+/**
+ * @file fd_scanner_linux.cpp
+ * @brief Single /proc/[pid]/fd walk producing socket inodes and DRM client usage.
+ */
+
+#ifdef __linux__
+
+#include "fd_scanner_linux.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+LinuxFdScanner& LinuxFdScanner::instance() {
+    static LinuxFdScanner scanner(hostFileReader());
+    return scanner;
+}
+
+std::shared_ptr<LinuxFdScanner> LinuxFdScanner::forReader(
+    const std::shared_ptr<const FileReader>& files) {
+    if (!files || files == hostFileReader())
+        return std::shared_ptr<LinuxFdScanner>(std::shared_ptr<LinuxFdScanner>{}, &instance());
+
+    // A live scanner keeps its reader alive, so the address cannot be reused while it is mapped.
+    static std::mutex mtx;
+    static std::map<const FileReader*, std::weak_ptr<LinuxFdScanner>> scanners;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& slot = scanners[files.get()];
+    auto scanner = slot.lock();
+    if (!scanner) {
+        scanner.reset(new LinuxFdScanner(files));
+        slot = scanner;
+    }
+    return scanner;
+}
+
+bool LinuxFdScanner::refresh(std::chrono::steady_clock::duration maxAge) {
+    std::lock_guard<std::mutex> scanLock(scanMtx_);
+
+    {
+        std::lock_guard<std::mutex> lock(dataMtx_);
+        if (generation_ > 0 && files_->now() - scanTime_ < maxAge)
+            return false;
+    }
+
+    InodePidMap inodes;
+    DrmClientMap drm;
+    scan(inodes, drm);
+    auto now = files_->now();
+
+    std::lock_guard<std::mutex> lock(dataMtx_);
+    inodes_   = std::move(inodes);
+    drm_      = std::move(drm);
+    scanTime_ = now;
+    ++generation_;
+    return true;
+}
+
+uint64_t LinuxFdScanner::generation() const {
+    std::lock_guard<std::mutex> lock(dataMtx_);
+    return generation_;
+}
+
+std::chrono::steady_clock::time_point LinuxFdScanner::scanTime() const {
+    std::lock_guard<std::mutex> lock(dataMtx_);
+    return scanTime_;
+}
+
+LinuxFdScanner::InodePidMap LinuxFdScanner::socketInodes() const {
+    std::lock_guard<std::mutex> lock(dataMtx_);
+    return inodes_;
+}
+
+LinuxFdScanner::DrmClientMap LinuxFdScanner::drmClients() const {
+    std::lock_guard<std::mutex> lock(dataMtx_);
+    return drm_;
+}
+
+void LinuxFdScanner::scan(InodePidMap& inodes, DrmClientMap& drm) const {
+    std::string fdDir, linkPath, target, text;
+    files_->forEachEntry("/proc", [&](const char* dname) {
+        for (const char* p = dname; *p; ++p)
+            if (!std::isdigit(static_cast<unsigned char>(*p))) return true;
+
+        int pid = std::atoi(dname);
+        fdDir.assign("/proc/").append(dname).append("/fd/");
+        files_->forEachEntry(fdDir.c_str(), [&](const char* fd) {
+            linkPath.assign(fdDir).append(fd);
+            if (!files_->readLink(linkPath.c_str(), target)) return true;
+
+            if (target.compare(0, 8, "socket:[") == 0) {
+                uint64_t inode = std::strtoull(target.c_str() + 8, nullptr, 10);
+                if (inode > 0) {
+                    inodes[inode] = pid;
+                }
+            } else if (target.compare(0, 9, "/dev/dri/") == 0) {
+                // Only DRM fds carry usage keys; read their fdinfo while we
+                // are here rather than walking the fd directory again.
+                linkPath.assign("/proc/").append(dname).append("/fdinfo/").append(fd);
+                if (!files_->read(linkPath.c_str(), text)) return true;
+                DrmClientUsage client;
+                if (!parseDrmFdinfo(text, client)) return true;
+
+                // dup()ed fds report the same client; count it once.
+                auto& clients = drm[pid];
+                bool seen = std::any_of(clients.begin(), clients.end(),
+                    [&](const DrmClientUsage& c) {
+                        return c.clientId == client.clientId && c.pdev == client.pdev;
+                    });
+                if (!seen) clients.push_back(std::move(client));
+            }
+            return true;
+        });
+        return true;
+    });
+}
+
+#endif // __linux__
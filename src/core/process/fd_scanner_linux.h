@@ -0,0 +1,85 @@
+/**
+ * @file fd_scanner_linux.h
+ * @brief Shared walker over /proc/[pid]/fd used by the network and process modules.
+ *
+ * Enumerating every process's file descriptors is one of the most expensive
+ * things the monitor does, so it is done once per interval and the results
+ * are shared: socket inodes feed the network connection-to-PID mapping and
+ * DRM device fds feed the per-process GPU accounting.
+ */
+
+#pragma once
+
+#ifdef __linux__
+
+#include "../gpu/drm_fdinfo.h"
+#include "../io/file_reader.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class LinuxFdScanner
+ * @brief Process-wide cache of the last /proc/[pid]/fd walk.
+ */
+class LinuxFdScanner {
+public:
+    /// Maps socket inode numbers to owning PIDs.
+    using InodePidMap = std::unordered_map<uint64_t, int>;
+
+    /// DRM clients held open by each PID, deduplicated by client id.
+    using DrmClientMap = std::unordered_map<int, std::vector<DrmClientUsage>>;
+
+    /// Default rescan interval shared by all consumers.
+    static constexpr std::chrono::seconds kDefaultMaxAge{5};
+
+    /// @brief The scanner for the live host.
+    static LinuxFdScanner& instance();
+
+    /**
+     * @brief The scanner for the tree @p files reads, shared by every module using that reader.
+     *
+     * The host scanner is never destroyed. Another reader's scanner lives
+     * as long as a module holds it, and keeps the reader alive until then.
+     */
+    static std::shared_ptr<LinuxFdScanner> forReader(const std::shared_ptr<const FileReader>& files);
+
+    /**
+     * @brief Rescan /proc if the cached results are older than @p maxAge.
+     * @param maxAge Maximum acceptable age of the cached results.
+     * @return true if a new scan was performed by this call.
+     */
+    bool refresh(std::chrono::steady_clock::duration maxAge = kDefaultMaxAge);
+
+    /// @brief Incremented after every completed scan.
+    uint64_t generation() const;
+
+    /// @brief Time at which the current results were collected.
+    std::chrono::steady_clock::time_point scanTime() const;
+
+    /// @brief Copy of the socket-inode-to-PID map from the last scan.
+    InodePidMap socketInodes() const;
+
+    /// @brief Copy of the per-PID DRM client usage from the last scan.
+    DrmClientMap drmClients() const;
+
+private:
+    explicit LinuxFdScanner(std::shared_ptr<const FileReader> files) : files_(std::move(files)) {}
+
+    /// Walk /proc/[pid]/fd and fill the output maps.
+    void scan(InodePidMap& inodes, DrmClientMap& drm) const;
+
+    std::shared_ptr<const FileReader> files_; ///< Tree being scanned.
+    std::mutex scanMtx_;                  ///< Serialises scans between consumers.
+    mutable std::mutex dataMtx_;          ///< Guards the published results below.
+    InodePidMap  inodes_;                 ///< Socket inode to PID.
+    DrmClientMap drm_;                    ///< PID to DRM clients.
+    uint64_t     generation_ = 0;         ///< Completed scan count.
+    std::chrono::steady_clock::time_point scanTime_{}; ///< When results were collected.
+};
+
+#endif // __linux__
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "../metrics.h"
+#include "../io/file_reader.h"
+#include <atomic>
 #include <memory>
 
 /**
@@ -49,9 +51,35 @@ public:
      * @return true if the priority was successfully changed, false otherwise.
      */
     virtual bool setProcessPriority(int pid, int priority) = 0;
+
+    /**
+     * @brief Enable or disable the per-process detail reads.
+     *
+     * Details are the command line, executable path, I/O counters and
+     * GPU usage. With them off only the identity, state, CPU and memory
+     * of each process are collected.
+     * @param on True to read details on every update().
+     */
+    void setDetailedInfo(bool on) { detailedInfo_ = on; }
+
+    /**
+     * @brief Read the per-process files through io_uring where available.
+     *
+     * Off by default: the ring hands opens to io-wq kernel workers, whose
+     * CPU time is not charged to the collector thread and so escapes the
+     * profile's CPU budget. Ignored where io_uring is not available.
+     * @param on True to switch backends at the next update().
+     */
+    void setIoUring(bool on) { ioUring_ = on; }
+
+protected:
+    std::atomic<bool> detailedInfo_{true}; ///< Read per-process details in update().
+    std::atomic<bool> ioUring_{false};     ///< Batch the reads through io_uring.
 };
 
 /**
  * @brief Factory: returns a platform-specific ProcessManager instance.
+ * @param files Where the Linux implementation reads /proc and /sys (ignored on Windows).
  */
-std::unique_ptr<ProcessManager> createProcessManager();
+std::unique_ptr<ProcessManager> createProcessManager(
+    std::shared_ptr<const FileReader> files = hostFileReader());
@@ -15,13 +15,15 @@
 
 /**
  * @brief Factory function to create a ProcessManager instance based on the platform.
+ * @param files Where the Linux implementation reads /proc.
  * @return std::unique_ptr<ProcessManager> owning the concrete implementation.
  */
-std::unique_ptr<ProcessManager> createProcessManager() {
+std::unique_ptr<ProcessManager> createProcessManager(std::shared_ptr<const FileReader> files) {
 #ifdef _WIN32
+    (void)files;
     return std::make_unique<WindowsProcessManager>();
 #elif defined(__linux__)
-    return std::make_unique<LinuxProcessManager>();
+    return std::make_unique<LinuxProcessManager>(BatchBackend::Sync, std::move(files));
 #else
     return nullptr;
 #endif
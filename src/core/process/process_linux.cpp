@@ -4,22 +4,28 @@
  *
  * Enumerates /proc for numeric PID directories. For each PID reads
  * /proc/[pid]/stat, status, cmdline, and io to populate ProcessInfo.
- * CPU% is computed from utime+stime deltas in clock ticks.
+ * The reads for a block of PIDs are issued together through the
+ * BatchReader, then parsed from memory.
+ * CPU% is computed from utime+stime deltas in clock ticks. GPU% and
+ * VRAM come from the DRM usage keys in /proc/[pid]/fdinfo, which the
+ * shared fd scanner reads during the same walk the network module uses.
  */
 
 #ifdef __linux__
 
 #include "process_linux.h"
+#include "../io/proc_parse.h"
+#include "../../utils/tracer.h"
 
-#include <dirent.h>
 #include <unistd.h>
 #include <signal.h>
 #include <sys/resource.h>
 #include <sys/sysinfo.h>
 #include <pwd.h>
 
-#include <fstream>
-#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
 #include <algorithm>
 #include <cctype>
 #include <cstring>
@@ -29,19 +35,40 @@
 // Construction / destruction
 // ---------------------------------------------------------------------------
 
-LinuxProcessManager::LinuxProcessManager() {
+LinuxProcessManager::LinuxProcessManager(BatchBackend backend,
+                                         std::shared_ptr<const FileReader> files)
+    : files_(std::move(files)),
+      fdScanner_(LinuxFdScanner::forReader(files_)),
+      reader_(createBatchReader(backend)),
+      readerUring_(backend != BatchBackend::Sync)
+{
+    ioUring_ = readerUring_;
     clkTck_ = sysconf(_SC_CLK_TCK);
     if (clkTck_ <= 0) clkTck_ = 100;
 
-    numProcessors_ = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
-    if (numProcessors_ < 1) numProcessors_ = 1;
+    if (files_->isHost()) {
+        numProcessors_ = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
 
-    // Total physical memory.
-    struct sysinfo si{};
-    if (sysinfo(&si) == 0) {
-        totalMemBytes_ = static_cast<uint64_t>(si.totalram)
-                        * static_cast<uint64_t>(si.mem_unit);
+        // Total physical memory.
+        struct sysinfo si{};
+        if (sysinfo(&si) == 0) {
+            totalMemBytes_ = static_cast<uint64_t>(si.totalram)
+                            * static_cast<uint64_t>(si.mem_unit);
+        }
+    } else {
+        // A synthetic tree describes its own machine.
+        std::string text;
+        numProcessors_ = 0;
+        if (files_->read("/proc/stat", text)) {
+            for (const char* p = std::strstr(text.c_str(), "\ncpu"); p; p = std::strstr(p + 1, "\ncpu"))
+                if (std::isdigit(static_cast<unsigned char>(p[4]))) ++numProcessors_;
+        }
+        if (files_->read("/proc/meminfo", text)) {
+            if (const char* p = std::strstr(text.c_str(), "MemTotal:"))
+                totalMemBytes_ = std::strtoull(p + 9, nullptr, 10) * 1024ULL;
+        }
     }
+    if (numProcessors_ < 1) numProcessors_ = 1;
 }
 
 LinuxProcessManager::~LinuxProcessManager() = default;
@@ -50,6 +77,23 @@ LinuxProcessManager::~LinuxProcessManager() = default;
 // Helpers
 // ---------------------------------------------------------------------------
 
+namespace {
+
+/// Strip a ProcessInfo back to defaults but keep its string buffers.
+void recycle(ProcessInfo& info) {
+    ProcessInfo fresh;
+    fresh.path.swap(info.path);
+    fresh.cmdline.swap(info.cmdline);
+    fresh.path.clear();
+    fresh.cmdline.clear();
+    info = std::move(fresh);
+}
+
+using proc_parse::forEachLine;
+using proc_parse::startsWith;
+
+} // namespace
+
 /**
  * Parse /proc/[pid]/stat.
  * Fields (1-indexed): pid (comm) state ppid ... utime(14) stime(15)
@@ -57,43 +101,50 @@ LinuxProcessManager::~LinuxProcessManager() = default;
  * The comm field is enclosed in parentheses and may contain spaces,
  * so we locate the last ')' to find where comm ends.
  */
-bool LinuxProcessManager::parseStat(int pid, ProcessInfo& info, CpuTicks& ticks) const {
-    std::ifstream f("/proc/" + std::to_string(pid) + "/stat");
-    if (!f.is_open()) return false;
-
-    std::string line;
-    if (!std::getline(f, line)) return false;
+bool LinuxProcessManager::parseStat(const std::string& text, int pid,
+                                    ProcessInfo& info, CpuTicks& ticks) {
+    const char* line = text.c_str();
+    auto* nl = static_cast<const char*>(std::memchr(line, '\n', text.size()));
+    const char* end = nl ? nl : line + text.size();
+    if (end == line) return false;
 
     // Find the name inside parentheses.
-    auto openParen  = line.find('(');
-    auto closeParen = line.rfind(')');
-    if (openParen == std::string::npos || closeParen == std::string::npos)
+    auto* openParen = static_cast<const char*>(std::memchr(line, '(', static_cast<size_t>(end - line)));
+    const char* closeParen = end;
+    while (closeParen > line && *--closeParen != ')') {}
+    if (!openParen || *closeParen != ')' || closeParen < openParen)
         return false;
 
-    info.name = line.substr(openParen + 1, closeParen - openParen - 1);
-
-    // Everything after the closing paren, skip the space.
-    std::istringstream ss(line.substr(closeParen + 2));
+    if (closeParen + 2 > end) return false;
+    info.name = std::string_view(openParen + 1, static_cast<size_t>(closeParen - openParen - 1));
 
     // Fields after (comm): state(3) ppid(4) pgrp(5) session(6) tty_nr(7)
     // tpgid(8) flags(9) minflt(10) cminflt(11) majflt(12) cmajflt(13)
     // utime(14) stime(15) cutime(16) cstime(17) priority(18) nice(19)
     // num_threads(20)
-    char state;
-    int ppid;
-    unsigned long long dummy;
-    unsigned long long utime, stime;
-    int priorityVal, niceVal, numThreads;
-
-    ss >> state >> ppid;
+    const char* p = closeParen + 2;
+    bool ok = true;
+    auto next = [&]() -> long long {
+        char* e = nullptr;
+        long long v = std::strtoll(p, &e, 10);
+        if (e == p) ok = false;
+        p = e;
+        return v;
+    };
+
+    char state = *p++;
+    int ppid = static_cast<int>(next());
     // Skip fields 5-13 (9 fields).
-    for (int i = 0; i < 9; ++i) ss >> dummy;
-    ss >> utime >> stime;
+    for (int i = 0; i < 9; ++i) next();
+    auto utime = static_cast<unsigned long long>(next());
+    auto stime = static_cast<unsigned long long>(next());
     // Skip cutime(16), cstime(17).
-    ss >> dummy >> dummy;
-    ss >> priorityVal >> niceVal >> numThreads;
+    next(); next();
+    int priorityVal = static_cast<int>(next());
+    int niceVal     = static_cast<int>(next());
+    int numThreads  = static_cast<int>(next());
 
-    if (ss.fail()) return false;
+    if (!ok) return false;
 
     info.pid      = pid;
     info.state    = state;
@@ -111,57 +162,40 @@ bool LinuxProcessManager::parseStat(int pid, ProcessInfo& info, CpuTicks& ticks)
 /**
  * Parse /proc/[pid]/status for VmRSS and Uid.
  */
-bool LinuxProcessManager::parseStatus(int pid, ProcessInfo& info) const {
-    std::ifstream f("/proc/" + std::to_string(pid) + "/status");
-    if (!f.is_open()) return false;
-
-    std::string line;
+void LinuxProcessManager::parseStatus(const std::string& text, ProcessInfo& info) {
     bool gotRss = false, gotUid = false;
 
-    while (std::getline(f, line)) {
-        if (line.compare(0, 6, "VmRSS:") == 0) {
+    forEachLine(text, [&](const char* line, size_t len) {
+        if (startsWith(line, len, "VmRSS:", 6)) {
             // Value is in kB.
-            std::istringstream ss(line.substr(6));
-            uint64_t rssKb = 0;
-            ss >> rssKb;
+            uint64_t rssKb = std::strtoull(line + 6, nullptr, 10);
             info.memoryBytes = rssKb * 1024ULL;
             if (totalMemBytes_ > 0) {
                 info.memoryPercent = static_cast<float>(info.memoryBytes)
                                      / static_cast<float>(totalMemBytes_) * 100.0f;
             }
             gotRss = true;
-        } else if (line.compare(0, 4, "Uid:") == 0) {
-            std::istringstream ss(line.substr(4));
-            unsigned int uid = 0;
-            ss >> uid; // real UID
+        } else if (startsWith(line, len, "Uid:", 4)) {
+            auto uid = static_cast<unsigned int>(std::strtoul(line + 4, nullptr, 10)); // real UID
             info.user = uidToName(uid);
             gotUid = true;
         }
-        if (gotRss && gotUid) break;
-    }
-    return true;
+        return !(gotRss && gotUid);
+    });
 }
 
 /**
  * Read /proc/[pid]/cmdline. Arguments are null-separated; join with spaces.
  */
-std::string LinuxProcessManager::parseCmdline(int pid) const {
-    std::ifstream f("/proc/" + std::to_string(pid) + "/cmdline",
-                    std::ios::binary);
-    if (!f.is_open()) return {};
-
-    std::string raw((std::istreambuf_iterator<char>(f)),
-                     std::istreambuf_iterator<char>());
-
+void LinuxProcessManager::parseCmdline(const std::string& raw, std::string& out) {
+    out.assign(raw);
     // Replace null bytes with spaces.
-    for (auto& c : raw) {
+    for (auto& c : out) {
         if (c == '\0') c = ' ';
     }
     // Trim trailing space.
-    while (!raw.empty() && raw.back() == ' ')
-        raw.pop_back();
-
-    return raw;
+    while (!out.empty() && out.back() == ' ')
+        out.pop_back();
 }
 
 /**
@@ -169,30 +203,84 @@ std::string LinuxProcessManager::parseCmdline(int pid) const {
  * The caller computes rates from deltas.
  * May fail with EACCES for processes owned by other users.
  */
-bool LinuxProcessManager::parseIo(int pid, IoBytes& ioOut) const {
-    std::ifstream f("/proc/" + std::to_string(pid) + "/io");
-    if (!f.is_open()) return false;
-
-    std::string line;
-    while (std::getline(f, line)) {
-        if (line.compare(0, 12, "read_bytes: ") == 0) {
-            try { ioOut.readBytes = std::stoll(line.substr(12)); } catch (...) {}
-        } else if (line.compare(0, 13, "write_bytes: ") == 0) {
-            try { ioOut.writeBytes = std::stoll(line.substr(13)); } catch (...) {}
+bool LinuxProcessManager::parseIo(const std::string& text, IoBytes& ioOut) {
+    if (text.empty()) return false;
+    forEachLine(text, [&](const char* line, size_t len) {
+        if (startsWith(line, len, "read_bytes: ", 12)) {
+            ioOut.readBytes = std::strtoll(line + 12, nullptr, 10);
+        } else if (startsWith(line, len, "write_bytes: ", 13)) {
+            ioOut.writeBytes = std::strtoll(line + 13, nullptr, 10);
         }
-    }
+        return true;
+    });
     return true;
 }
 
 /**
- * Convert a numeric UID to a username via getpwuid().
+ * Convert a numeric UID to a username via getpwuid(), cached per UID.
  */
-std::string LinuxProcessManager::uidToName(unsigned int uid) const {
+Label LinuxProcessManager::uidToName(unsigned int uid) {
+    auto it = uidNames_.find(uid);
+    if (it != uidNames_.end()) return it->second;
+
     struct passwd* pw = getpwuid(uid);
-    if (pw && pw->pw_name) {
-        return pw->pw_name;
+    Label name = (pw && pw->pw_name) ? Label(pw->pw_name) : Label(std::to_string(uid));
+    uidNames_.emplace(uid, name);
+    return name;
+}
+
+/**
+ * Recompute per-PID GPU usage when the fd scanner has a new generation.
+ * A process may hold several DRM clients (one per device context); the
+ * busy % of each engine class is summed across them and the busiest
+ * class is reported, mirroring how GPU tools present per-process load.
+ */
+void LinuxProcessManager::refreshGpuUsage() {
+    auto& scanner = *fdScanner_;
+    scanner.refresh();
+    uint64_t gen = scanner.generation();
+    if (gen == drmGeneration_) return;
+
+    auto drm = scanner.drmClients();
+    auto scanTime = scanner.scanTime();
+    double wallNs = 0.0;
+    if (drmGeneration_ > 0) {
+        wallNs = std::chrono::duration<double, std::nano>(scanTime - prevDrmTime_).count();
+    }
+
+    std::unordered_map<int, GpuUsage> usage;
+    for (const auto& [pid, clients] : drm) {
+        GpuUsage u;
+        std::unordered_map<std::string, float> perEngine;
+        auto prevIt = prevDrm_.find(pid);
+        for (const auto& client : clients) {
+            u.vramBytes += client.vramBytes;
+            if (prevIt == prevDrm_.end()) continue;
+
+            const DrmClientUsage* prev = nullptr;
+            for (const auto& p : prevIt->second) {
+                if (p.clientId == client.clientId && p.pdev == client.pdev) { prev = &p; break; }
+            }
+            if (!prev) continue;
+
+            for (const auto& eng : client.engines) {
+                for (const auto& prevEng : prev->engines) {
+                    if (prevEng.name != eng.name) continue;
+                    perEngine[eng.name] += drmEngineBusyPercent(prevEng, eng, wallNs);
+                    break;
+                }
+            }
+        }
+        for (const auto& [name, pct] : perEngine) {
+            u.percent = std::max(u.percent, std::min(pct, 100.0f));
+        }
+        usage[pid] = u;
     }
-    return std::to_string(uid);
+
+    gpuUsage_      = std::move(usage);
+    prevDrm_       = std::move(drm);
+    prevDrmTime_   = scanTime;
+    drmGeneration_ = gen;
 }
 
 // ---------------------------------------------------------------------------
@@ -200,11 +288,11 @@ std::string LinuxProcessManager::uidToName(unsigned int uid) const {
 // ---------------------------------------------------------------------------
 
 void LinuxProcessManager::update() {
-    ProcessSnapshot newSnap;
-    std::unordered_map<int, CpuTicks> newTicks;
-    std::unordered_map<int, IoBytes>  newIo;
+    arena_.reset();
+    curTicks_.clear();
+    curIo_.clear();
 
-    auto now = std::chrono::steady_clock::now();
+    auto now = files_->now();
     double wallDeltaSec = 0.0;
     if (hasPrevSample_) {
         wallDeltaSec = std::chrono::duration<double>(now - prevWall_).count();
@@ -213,113 +301,153 @@ void LinuxProcessManager::update() {
     int totalThreads     = 0;
     int runningProcesses = 0;
 
-    DIR* procDir = opendir("/proc");
-    if (!procDir) {
-        return; // Cannot enumerate — keep stale snapshot.
+    const bool details = detailedInfo_;
+    if (details) refreshGpuUsage();
+
+    const bool uring = ioUring_;
+    if (uring != readerUring_) {
+        reader_      = createBatchReader(uring ? BatchBackend::IoUring : BatchBackend::Sync);
+        readerUring_ = uring;
     }
 
-    struct dirent* entry;
-    while ((entry = readdir(procDir)) != nullptr) {
+    std::pmr::vector<int> pids(arena_.resource());
+    bool listed = files_->forEachEntry("/proc", [&pids](const char* dname) {
         // Only numeric directory names correspond to PIDs.
-        const char* dname = entry->d_name;
-        if (!std::isdigit(static_cast<unsigned char>(dname[0])))
-            continue;
-
-        // Verify all characters are digits.
-        bool allDigits = true;
-        for (const char* p = dname; *p; ++p) {
-            if (!std::isdigit(static_cast<unsigned char>(*p))) {
-                allDigits = false;
-                break;
-            }
-        }
-        if (!allDigits) continue;
+        for (const char* p = dname; *p; ++p)
+            if (!std::isdigit(static_cast<unsigned char>(*p))) return true;
 
         int pid = std::atoi(dname);
-        if (pid <= 0) continue;
-
-        ProcessInfo info;
-        CpuTicks ticks;
-
-        // Parse /proc/[pid]/stat (critical — skip if unavailable).
-        if (!parseStat(pid, info, ticks))
-            continue;
-
-        // Parse /proc/[pid]/status for memory and user.
-        parseStatus(pid, info);
-
-        // Parse /proc/[pid]/cmdline.
-        info.cmdline = parseCmdline(pid);
+        if (pid > 0) pids.push_back(pid);
+        return true;
+    });
+    if (!listed) {
+        return; // Cannot enumerate — keep stale snapshot.
+    }
 
-        // Parse /proc/[pid]/io and compute I/O rates from deltas.
+    curTicks_.reserve(pids.size());
+    if (details) curIo_.reserve(pids.size());
+
+    // Files read per PID, in request order.
+    enum : std::size_t { kStat, kStatus, kCmdline, kIo };
+    const std::size_t perPid = details ? 4 : 2;
+    if (reads_.size() < kPidBlock * perPid) reads_.resize(kPidBlock * perPid);
+
+    // Rebuild the spare snapshot (the one published two ticks ago) in
+    // place, reusing its vector and per-process string capacity.
+    auto& procs = spare_.processes;
+    std::size_t n = 0;
+
+    for (std::size_t base = 0; base < pids.size(); base += kPidBlock) {
+        const std::size_t count = std::min(kPidBlock, pids.size() - base);
+
+        for (std::size_t k = 0; k < count; ++k) {
+            char dir[32];
+            int len = std::snprintf(dir, sizeof(dir), "/proc/%d/", pids[base + k]);
+            FileRead* r = &reads_[k * perPid];
+            r[kStat].path.assign(dir, len).append("stat");       r[kStat].maxBytes   = 1024;
+            r[kStatus].path.assign(dir, len).append("status");   r[kStatus].maxBytes = 4096;
+            if (details) {
+                r[kCmdline].path.assign(dir, len).append("cmdline"); r[kCmdline].maxBytes = 4096;
+                r[kIo].path.assign(dir, len).append("io");           r[kIo].maxBytes      = 512;
+            }
+        }
         {
-            IoBytes curIo;
-            if (parseIo(pid, curIo)) {
-                newIo[pid] = curIo;
-                if (hasPrevSample_ && wallDeltaSec > 0.0) {
-                    auto it = prevIo_.find(pid);
-                    if (it != prevIo_.end()) {
-                        int64_t dRead  = curIo.readBytes  - it->second.readBytes;
-                        int64_t dWrite = curIo.writeBytes - it->second.writeBytes;
-                        if (dRead  < 0) dRead  = 0;
-                        if (dWrite < 0) dWrite = 0;
-                        info.readBytesPerSec  = static_cast<int64_t>(
-                            static_cast<double>(dRead) / wallDeltaSec);
-                        info.writeBytesPerSec = static_cast<int64_t>(
-                            static_cast<double>(dWrite) / wallDeltaSec);
+            TraceSpan span("io", "read /proc/<pid>");
+            files_->readAll(*reader_, reads_.data(), count * perPid);
+        }
+
+        TraceSpan parseSpan("parse", "/proc/<pid>");
+        for (std::size_t k = 0; k < count; ++k) {
+            const int pid = pids[base + k];
+            FileRead* r = &reads_[k * perPid];
+
+            if (n == procs.size()) procs.emplace_back();
+            ProcessInfo& info = procs[n];
+            recycle(info);
+            CpuTicks ticks;
+
+            // Parse /proc/[pid]/stat (critical — skip if unavailable).
+            if (r[kStat].error || !parseStat(r[kStat].data, pid, info, ticks))
+                continue;
+
+            // Parse /proc/[pid]/status for memory and user.
+            parseStatus(r[kStatus].data, info);
+
+            // Parse /proc/[pid]/cmdline.
+            if (details) parseCmdline(r[kCmdline].data, info.cmdline);
+
+            // Parse /proc/[pid]/io and compute I/O rates from deltas.
+            if (details) {
+                IoBytes curIo;
+                if (parseIo(r[kIo].data, curIo)) {
+                    curIo_[pid] = curIo;
+                    if (hasPrevSample_ && wallDeltaSec > 0.0) {
+                        if (const IoBytes* prev = prevIo_.find(pid)) {
+                            int64_t dRead  = curIo.readBytes  - prev->readBytes;
+                            int64_t dWrite = curIo.writeBytes - prev->writeBytes;
+                            if (dRead  < 0) dRead  = 0;
+                            if (dWrite < 0) dWrite = 0;
+                            info.readBytesPerSec  = static_cast<int64_t>(
+                                static_cast<double>(dRead) / wallDeltaSec);
+                            info.writeBytesPerSec = static_cast<int64_t>(
+                                static_cast<double>(dWrite) / wallDeltaSec);
+                        }
                     }
                 }
             }
-        }
 
-        // Path: use /proc/[pid]/exe symlink content (from cmdline first arg
-        // as fallback is already in cmdline).
-        {
-            char buf[4096]{};
-            std::string exeLink = "/proc/" + std::to_string(pid) + "/exe";
-            ssize_t len = readlink(exeLink.c_str(), buf, sizeof(buf) - 1);
-            if (len > 0) {
-                buf[len] = '\0';
-                info.path = buf;
+            // Path: use /proc/[pid]/exe symlink content (from cmdline first arg
+            // as fallback is already in cmdline). readlink has no batched form.
+            if (details) {
+                char exeLink[32];
+                std::snprintf(exeLink, sizeof(exeLink), "/proc/%d/exe", pid);
+                files_->readLink(exeLink, info.path);
             }
-        }
 
-        // CPU%.
-        newTicks[pid] = ticks;
-        if (hasPrevSample_ && wallDeltaSec > 0.0) {
-            auto it = prevTicks_.find(pid);
-            if (it != prevTicks_.end()) {
-                unsigned long long dUtime = ticks.utime - it->second.utime;
-                unsigned long long dStime = ticks.stime - it->second.stime;
-                double cpuSec = static_cast<double>(dUtime + dStime)
-                                / static_cast<double>(clkTck_);
-                info.cpuPercent = static_cast<float>(
-                    cpuSec / (wallDeltaSec * numProcessors_) * 100.0);
-                if (info.cpuPercent < 0.0f)   info.cpuPercent = 0.0f;
-                if (info.cpuPercent > 100.0f) info.cpuPercent = 100.0f;
+            // CPU%.
+            curTicks_[pid] = ticks;
+            if (hasPrevSample_ && wallDeltaSec > 0.0) {
+                if (const CpuTicks* prev = prevTicks_.find(pid)) {
+                    unsigned long long dUtime = ticks.utime - prev->utime;
+                    unsigned long long dStime = ticks.stime - prev->stime;
+                    double cpuSec = static_cast<double>(dUtime + dStime)
+                                    / static_cast<double>(clkTck_);
+                    info.cpuPercent = static_cast<float>(
+                        cpuSec / (wallDeltaSec * numProcessors_) * 100.0);
+                    if (info.cpuPercent < 0.0f)   info.cpuPercent = 0.0f;
+                    if (info.cpuPercent > 100.0f) info.cpuPercent = 100.0f;
+                }
             }
-        }
 
-        totalThreads += info.threads;
-        if (info.state == 'R') ++runningProcesses;
+            // GPU% and VRAM (only processes holding a DRM client).
+            if (details) {
+                auto it = gpuUsage_.find(pid);
+                if (it != gpuUsage_.end()) {
+                    info.gpuPercent     = it->second.percent;
+                    info.gpuMemoryBytes = it->second.vramBytes;
+                }
+            }
 
-        newSnap.processes.push_back(std::move(info));
+            totalThreads += info.threads;
+            if (info.state == 'R') ++runningProcesses;
+            ++n;
+        }
     }
-    closedir(procDir);
+    procs.resize(n);
 
-    newSnap.totalProcesses   = static_cast<int>(newSnap.processes.size());
-    newSnap.totalThreads     = totalThreads;
-    newSnap.runningProcesses = runningProcesses;
+    spare_.totalProcesses   = static_cast<int>(n);
+    spare_.totalThreads     = totalThreads;
+    spare_.runningProcesses = runningProcesses;
 
     // --- Swap into shared state ---
     {
         std::lock_guard<std::mutex> lock(mtx_);
-        snap_       = std::move(newSnap);
-        prevTicks_  = std::move(newTicks);
-        prevIo_     = std::move(newIo);
+        std::swap(snap_, spare_);
         prevWall_   = now;
         hasPrevSample_ = true;
     }
+    prevTicks_.swap(curTicks_);
+    prevIo_.swap(curIo_);
 }
 
 // ---------------------------------------------------------------------------
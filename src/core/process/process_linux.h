@@ -8,9 +8,15 @@
 #ifdef __linux__
 
 #include "process_common.h"
+#include "fd_scanner_linux.h"
+#include "../io/batch_reader.h"
+#include "../io/file_reader.h"
+#include "../../utils/pid_table.h"
+#include "../../utils/tick_arena.h"
 
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <chrono>
 #include <string>
@@ -21,19 +27,38 @@
  * @brief Gathers process metrics on Linux via /proc filesystem.
  *
  * Iterates /proc/[pid]/ directories to read stat, status, cmdline,
- * and io files. Computes CPU% from utime/stime deltas.
+ * and io files. Computes CPU% from utime/stime deltas, and GPU% and
+ * VRAM from the DRM fdinfo collected by the shared LinuxFdScanner.
+ *
+ * The per-PID files are read in batches through a BatchReader (io_uring
+ * when enabled with setIoUring()) and the contents are handed to the text parsers.
+ *
+ * update() is written to reach a steady state with almost no heap
+ * traffic: the snapshot is built into the spare buffer from the tick
+ * before last (reusing its vector and string capacity), previous-tick
+ * counters live in double-buffered PidTables, and scratch lists come
+ * from a TickArena.
  */
 class LinuxProcessManager : public ProcessManager {
 public:
-    LinuxProcessManager();
+    /// @param backend How the per-PID files are read.
+    /// @param files   Where /proc is read from.
+    explicit LinuxProcessManager(BatchBackend backend = BatchBackend::Sync,
+                                 std::shared_ptr<const FileReader> files = hostFileReader());
     ~LinuxProcessManager() override;
 
+    /// @brief Name of the file-reading backend in use ("sync" or "io_uring");
+    /// setIoUring() takes effect at the next update().
+    const char* ioBackend() const { return reader_->name(); }
+
+    /// @brief System calls issued by the batch reader so far.
+    uint64_t ioSyscalls() const { return reader_->syscalls(); }
+
     void             update()                               override;
     ProcessSnapshot  snapshot() const                       override;
     bool             killProcess(int pid)                   override;
     bool             setProcessPriority(int pid, int pri)   override;
 
-private:
     // ---- per-process CPU delta tracking ----
     struct CpuTicks {
         unsigned long long utime = 0;
@@ -46,22 +71,59 @@ private:
         int64_t writeBytes = 0;
     };
 
+    // ---- text parsers for the per-PID files (also used by the benchmarks) ----
+    static bool parseStat(const std::string& text, int pid, ProcessInfo& info, CpuTicks& ticks);
+    void parseStatus(const std::string& text, ProcessInfo& info);
+    static void parseCmdline(const std::string& raw, std::string& out);
+    static bool parseIo(const std::string& text, IoBytes& ioOut);
+
+private:
     // ---- helpers ----
-    bool parseStat(int pid, ProcessInfo& info, CpuTicks& ticks) const;
-    bool parseStatus(int pid, ProcessInfo& info) const;
-    std::string parseCmdline(int pid) const;
-    bool parseIo(int pid, IoBytes& ioOut) const;
-    std::string uidToName(unsigned int uid) const;
+    Label uidToName(unsigned int uid);
+    void refreshGpuUsage();
+
+    /// PIDs whose files go into one BatchReader submission.
+    static constexpr std::size_t kPidBlock = 256;
 
     // ---- state ----
+    std::shared_ptr<const FileReader> files_;  ///< Source of /proc.
+    std::shared_ptr<LinuxFdScanner> fdScanner_; ///< DRM clients, shared with the network module.
+    std::unique_ptr<BatchReader> reader_;  ///< Only used from update().
+    bool                         readerUring_ = false;  ///< reader_ was created for io_uring.
+    std::vector<FileRead>        reads_;   ///< Reused request buffer.
+
     mutable std::mutex mtx_;
     ProcessSnapshot    snap_;
+    ProcessSnapshot    spare_;   ///< Previous snap_, rebuilt in place by update().
+
+    TickArena arena_;            ///< Per-tick scratch (PID list).
+
+    /// utime+stime per PID: previous tick and the one being built.
+    PidTable<CpuTicks> prevTicks_, curTicks_;
+
+    /// I/O bytes per PID: previous tick and the one being built.
+    PidTable<IoBytes> prevIo_, curIo_;
+
+    /// getpwuid() results; a tick sees only a handful of distinct UIDs.
+    std::unordered_map<unsigned int, Label> uidNames_;
+
+    // ---- per-process GPU usage from DRM fdinfo ----
+    struct GpuUsage {
+        float    percent   = 0.0f;
+        uint64_t vramBytes = 0;
+    };
+
+    /// DRM clients per PID from the previous fd-scanner generation.
+    LinuxFdScanner::DrmClientMap prevDrm_;
+
+    /// Scan time of prevDrm_.
+    std::chrono::steady_clock::time_point prevDrmTime_;
 
-    /// Previous utime+stime per PID for CPU% delta computation.
-    std::unordered_map<int, CpuTicks> prevTicks_;
+    /// Fd-scanner generation gpuUsage_ was computed from.
+    uint64_t drmGeneration_ = 0;
 
-    /// Previous I/O bytes per PID for rate computation.
-    std::unordered_map<int, IoBytes> prevIo_;
+    /// GPU busy % and VRAM per PID that holds a DRM client.
+    std::unordered_map<int, GpuUsage> gpuUsage_;
 
     /// Wall-clock timestamp of the previous update() call.
     std::chrono::steady_clock::time_point prevWall_;
@@ -70,10 +132,10 @@ private:
     /// Clock ticks per second (from sysconf).
     long clkTck_ = 100;
 
-    /// Number of logical processors.
+    /// Number of logical processors (from sysconf, or the tree's /proc/stat).
     int numProcessors_ = 1;
 
-    /// Total physical memory in bytes (for memoryPercent).
+    /// Total physical memory in bytes (for memoryPercent; sysinfo or the tree's /proc/meminfo).
     uint64_t totalMemBytes_ = 0;
 };
 
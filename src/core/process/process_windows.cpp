@@ -149,7 +149,7 @@ void WindowsProcessManager::update() {
                 }
 
                 // --- Path ---
-                info.path = queryProcessPath(hProc);
+                if (detailedInfo_) info.path = queryProcessPath(hProc);
 
                 // --- User ---
                 info.user = queryProcessUser(hProc);
@@ -200,7 +200,7 @@ void WindowsProcessManager::update() {
                 }
 
                 // --- I/O (delta-based rates) ---
-                {
+                if (detailedInfo_) {
                     IO_COUNTERS ioc{};
                     if (GetProcessIoCounters(hProc, &ioc)) {
                         IoBytes curIo;
@@ -3,12 +3,23 @@
  * @brief ImGui + ImPlot resource monitor application.
  *
  * All rendering is immediate-mode: each frame rebuilds the entire UI
- * from the latest MetricData snapshot.  A background collector thread
- * polls the OS at ~1 Hz, and the render loop runs at vsync (~60 fps).
+ * from the latest MetricData snapshot.  A Pipeline collects on its own
+ * thread at ~1 Hz and hands each sample to alert, history and database
+ * stages on threads of their own.  Every sample is published through the
+ * Collector's SnapshotChannel; the renderer picks up a new sample only
+ * when its version changes and shares it rather than copying it.  The
+ * render loop draws at vsync while there is input or fresh data and
+ * otherwise sleeps until one of the two arrives.
  *
- * History buffers (ScrollingBuffer) hold up to 3 600 samples (1 hour
- * at 1 Hz).  ImPlot reads directly from the ring buffer via its
- * offset parameter — zero copies.
+ * History buffers (HistoryRing) hold an hour of raw samples plus 10 s
+ * min/max/avg buckets for 24 hours and 1 min buckets for 7 days.  Each
+ * plot draws from the finest tier that covers the chosen history span
+ * (View > History span).  Only the points in the plot's x range are
+ * drawn, found by binary search over the ring.  More than four per pixel
+ * column are decimated to the first, min, max and last point of each
+ * column (utils/decimate.h), which draws the same pixels; the result is
+ * cached until the next sample.  Fewer are read in place — zero copies —
+ * unless the ring wraps inside the range, when they are copied once.
  */
 
 #pragma once
@@ -17,27 +28,26 @@
 #include "implot.h"
 
 #include "../core/metrics.h"
-#include "../core/cpu/cpu_common.h"
-#include "../core/memory/memory_common.h"
-#include "../core/network/network_common.h"
-#include "../core/disk/disk_common.h"
-#include "../core/gpu/gpu_common.h"
-#include "../core/process/process_common.h"
-#include "../core/system_info/system_info.h"
+#include "../core/collector/collector.h"
 #include "../core/alerts/alert_manager.h"
 #include "../core/database/database.h"
+#include "../core/pipeline/pipeline.h"
 #include "../utils/logger.h"
-#include "../utils/scrolling_buffer.h"
+#include "../utils/decimate.h"
+#include "../utils/history_ring.h"
+#include "../utils/tracer.h"
 
+#include <array>
 #include <memory>
-#include <thread>
 #include <atomic>
 #include <mutex>
 #include <chrono>
 #include <algorithm>
 #include <cstring>
 #include <cstdio>
+#include <iterator>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct GLFWwindow;
@@ -76,37 +86,69 @@ public:
 private:
     GLFWwindow* window_ = nullptr;
 
+    /// Construction time, declared first so startup is timed from here.
+    const std::chrono::steady_clock::time_point launched_ = std::chrono::steady_clock::now();
+
     // ---- Modules ------------------------------------------------------------
-    std::unique_ptr<CPU>            cpu_;
-    std::unique_ptr<Memory>         memory_;
-    std::unique_ptr<Network>        network_;
-    std::unique_ptr<Disk>           disk_;
-    std::unique_ptr<GPU>            gpu_;
-    std::unique_ptr<ProcessManager> process_;
-    SystemInfo                      sysInfo_;
+    Collector                       collector_{ProfileKind::Full};
     AlertManager                    alerts_;
     Database                        db_;
 
+    // ---- Demand-driven collection (declared after collector_) ---------------
+    InterestRegistry::Subscription  tabCpuSensors_, tabTopProcs_, tabConnections_;
+    InterestRegistry::Subscription  tabProcesses_, tabProcDetails_;
+    InterestRegistry::Subscription  dbSensors_, dbTopProcs_;
+    std::array<InterestRegistry::Subscription, kDataCategoryCount> alertSubs_;
+
     // ---- Shared state -------------------------------------------------------
-    std::thread        collectorThread_;
     std::atomic<bool>  running_{false};
-    mutable std::recursive_mutex dataMtx_;
-    MetricData         latest_;
-    float              elapsedTime_ = 0.0f;
+    mutable std::recursive_mutex dataMtx_;  ///< Guards the history buffers.
+
+    // Render thread only: the sample being drawn and its version.
+    std::shared_ptr<const MetricData> view_ = std::make_shared<const MetricData>();
+    uint64_t           viewVersion_   = 0;
+    int                pendingFrames_ = 0;  ///< Frames left to draw before idling.
+    bool               firstFrameShown_ = false;
 
     // ---- History buffers ----------------------------------------------------
-    ScrollingBuffer hCpu_, hMem_, hSwap_;
-    ScrollingBuffer hNetUp_, hNetDown_;
-    ScrollingBuffer hDiskRead_, hDiskWrite_;
-    ScrollingBuffer hGpuUtil_, hGpuTemp_, hGpuMem_;
-    std::vector<ScrollingBuffer> hCores_;
+    HistoryRing hCpu_, hMem_, hSwap_;
+    HistoryRing hNetUp_, hNetDown_;
+    HistoryRing hDiskRead_, hDiskWrite_;
+    HistoryRing hGpuUtil_, hGpuTemp_, hGpuMem_;
+    std::vector<HistoryRing> hCores_;
+    bool coresResized_ = false;  ///< hCores_ reallocated since the plot caches were last cleared.
+
+    /// A plot's visible points, copied or decimated to its pixel width;
+    /// reused until the series gains a sample or the plot is resized or
+    /// re-windowed.
+    struct PlotCache {
+        const float* source    = nullptr;   ///< X array it was built from
+        int          rawSize   = -1;
+        int          rawOffset = -1;
+        int          columns   = 0;
+        double       xMin      = 0.0;
+        double       xMax      = 0.0;
+        std::vector<float> x, y, y2;
+    };
+    // Render thread only, keyed by series.
+    std::unordered_map<const HistoryRing*, PlotCache> lineCache_, fillCache_;
+
+    // ---- Collection pipeline (after everything its stages use) --------------
+    Pipeline pipeline_{collector_};
 
     // ---- UI state -----------------------------------------------------------
     int  currentTab_        = 0;
     bool showDemoWindow_    = false;
+    bool showDiagnostics_   = false;
+    int  historySpanIdx_    = 0;    ///< Index into kHistorySpans
+    bool tracing_           = false;
+    bool dbCollectorStats_  = false;
     bool dbEnabled_         = true;
     int  dbIntervalTicks_   = 10;
     int  tickCounter_       = 0;
+    int  profileIdx_        = static_cast<int>(ProfileKind::Full);
+    float budgetPct_        = makeProfile(ProfileKind::Full).cpuBudgetPercent;
+    int  catchUpIdx_        = static_cast<int>(CatchUpPolicy::Skip);
 
     // Process tab
     char processFilter_[128] = {};
@@ -129,7 +171,12 @@ private:
     char exportStatus_[128] = {};
 
     // ---- Methods ------------------------------------------------------------
-    void collectorLoop();
+    void setupPipeline();
+    void setTracing(bool on);
+    void appendHistory(const MetricData& md);
+    void syncConsumerInterest();
+    void wakeRenderer();
+    void refreshView();
     void render();
     void renderMenuBar();
     void renderOverview();
@@ -141,12 +188,25 @@ private:
     void renderProcessTab();
     void renderAlertTab();
     void renderSystemTab();
+    void renderDiagnostics();
 
-    void plotLine(const char* label, ScrollingBuffer& buf, float tNow,
-                  float histSec = 60.0f, const ImVec4& col = Theme::AccentBlue);
-    void plotShaded(const char* label, ScrollingBuffer& buf, float tNow,
+    float historySpan() const;
+    void plotLine(const char* label, HistoryRing& buf, float tNow,
+                  float histSec = 60.0f, const ImVec4& col = Theme::AccentBlue,
+                  float weight = 2.0f);
+    void plotShaded(const char* label, HistoryRing& buf, float tNow,
                     float histSec = 60.0f, const ImVec4& col = Theme::AccentBlue);
+    /// Arrays to hand ImPlot: into a ring (zero copy) or into a PlotCache.
+    struct PlotSlice {
+        const float* x;
+        const float* y;
+        const float* y2;   ///< Band upper edge; null unless asked for
+        int          count;
+    };
+    PlotSlice visiblePoints(std::unordered_map<const HistoryRing*, PlotCache>& cache,
+                            const HistoryRing& buf, int tier, bool band);
     void bigNumber(const char* label, float value, const char* fmt = "%.1f%%");
+    bool moduleReady(const MetricData& d, ModuleId id);
 };
 
 // ===========================================================================
@@ -155,105 +215,214 @@ private:
 
 inline App::App()
     : db_("resource_monitor.db")
-{}
+{
+    setupPipeline();
+}
 
 inline App::~App() { shutdown(); }
 
 // ---------------------------------------------------------------------------
-//  Collector thread
+//  Collection pipeline
 // ---------------------------------------------------------------------------
-inline void App::collectorLoop() {
-    using clock = std::chrono::steady_clock;
-
-    auto doUpdate = [&]() {
-        if (cpu_)     cpu_->update();
-        if (memory_)  memory_->update();
-        if (network_) network_->update();
-        if (disk_)    disk_->update();
-        if (gpu_)     gpu_->update();
-        if (process_) process_->update();
-        sysInfo_.update();
-    };
-
-    doUpdate();
-
-    while (running_) {
-        auto t0 = clock::now();
-        doUpdate();
-
-        MetricData md;
-        if (cpu_)     md.cpu     = cpu_->snapshot();
-        if (memory_)  md.memory  = memory_->snapshot();
-        if (network_) md.network = network_->snapshot();
-        if (disk_)    md.disk    = disk_->snapshot();
-        if (gpu_)     md.gpu     = gpu_->snapshot();
-        if (process_) md.process = process_->snapshot();
-        md.systemInfo = sysInfo_.snapshot();
-
-        alerts_.evaluate(md);
-
-        float t = elapsedTime_;
-
-        {
-            std::lock_guard<std::recursive_mutex> lk(dataMtx_);
-            latest_ = md;
-            elapsedTime_ += 1.0f;
-
-            hCpu_.AddPoint(t, md.cpu.totalUsage);
-            hMem_.AddPoint(t, md.memory.usagePercent);
-            hSwap_.AddPoint(t, md.memory.swapPercent);
-            hNetUp_.AddPoint(t, md.network.totalUploadRate);
-            hNetDown_.AddPoint(t, md.network.totalDownloadRate);
-            hDiskRead_.AddPoint(t, md.disk.totalReadRate);
-            hDiskWrite_.AddPoint(t, md.disk.totalWriteRate);
-
-            if (!md.gpu.gpus.empty()) {
-                hGpuUtil_.AddPoint(t, md.gpu.gpus[0].utilization);
-                hGpuTemp_.AddPoint(t, md.gpu.gpus[0].temperature);
-                hGpuMem_.AddPoint(t, md.gpu.gpus[0].memoryPercent);
-            }
 
-            int nc = static_cast<int>(md.cpu.cores.size());
-            if (static_cast<int>(hCores_.size()) < nc)
-                hCores_.resize(nc, ScrollingBuffer(3600));
-            for (int i = 0; i < nc; ++i)
-                hCores_[i].AddPoint(t, md.cpu.cores[i].usage);
-        }
-
-        ++tickCounter_;
-        if (dbEnabled_ && tickCounter_ >= dbIntervalTicks_) {
+/**
+ * Everything that consumes a sample runs on its own pipeline stage, so a
+ * slow database write never delays the next collect().
+ */
+inline void App::setupPipeline() {
+    pipeline_.setBeforeCollect([this] { syncConsumerInterest(); });
+    pipeline_.addStage("alerts",  [this](MetricData& md) { alerts_.evaluate(md); });
+    pipeline_.addStage("history", [this](MetricData& md) { appendHistory(md); wakeRenderer(); });
+    pipeline_.addStage("persist", [this](MetricData& md) {
+        if (dbEnabled_ && ++tickCounter_ >= dbIntervalTicks_) {
             tickCounter_ = 0;
             db_.insertSnapshot(md);
         }
+    });
+}
+
+/// Start a trace, or stop one and save it for chrome://tracing / Perfetto.
+inline void App::setTracing(bool on) {
+    tracing_ = on;
+    if (on) {
+        Tracer::start();
+        Logger::log("Tracing started");
+        return;
+    }
+    Tracer::stop();
+    const char* path = "resource_monitor_trace.json";
+    if (Tracer::writeChromeJson(path))
+        Logger::log("Trace written to " + std::string(path) + " ("
+                    + std::to_string(Tracer::spanCount()) + " spans, "
+                    + std::to_string(Tracer::dropped()) + " dropped)");
+    else
+        Logger::error("Could not write trace to " + std::string(path));
+}
+
+inline void App::appendHistory(const MetricData& md) {
+    // Ticks can come early (a new subscriber) or be skipped (a stall),
+    // so the x axis uses each sample's own timestamp.
+    float t = static_cast<float>(md.elapsedSec);
+
+    std::lock_guard<std::recursive_mutex> lk(dataMtx_);
+    hCpu_.AddPoint(t, md.cpu.totalUsage);
+    hMem_.AddPoint(t, md.memory.usagePercent);
+    hSwap_.AddPoint(t, md.memory.swapPercent);
+    hNetUp_.AddPoint(t, md.network.totalUploadRate);
+    hNetDown_.AddPoint(t, md.network.totalDownloadRate);
+    hDiskRead_.AddPoint(t, md.disk.totalReadRate);
+    hDiskWrite_.AddPoint(t, md.disk.totalWriteRate);
+
+    if (!md.gpu.gpus.empty()) {
+        hGpuUtil_.AddPoint(t, md.gpu.gpus[0].utilization);
+        hGpuTemp_.AddPoint(t, md.gpu.gpus[0].temperature);
+        hGpuMem_.AddPoint(t, md.gpu.gpus[0].memoryPercent);
+    }
 
-        auto dt = clock::now() - t0;
-        auto remaining = std::chrono::seconds(1) - dt;
-        if (remaining.count() > 0)
-            std::this_thread::sleep_for(remaining);
+    int nc = static_cast<int>(md.cpu.cores.size());
+    if (static_cast<int>(hCores_.size()) < nc) {
+        hCores_.resize(nc, HistoryRing(3600));
+        coresResized_ = true;
+    }
+    for (int i = 0; i < nc; ++i)
+        hCores_[i].AddPoint(t, md.cpu.cores[i].usage);
+}
+
+/**
+ * Subscriptions held on behalf of the database writer and the alert
+ * rules. GUI tabs manage their own in render().
+ */
+inline void App::syncConsumerInterest() {
+    auto& reg = collector_.interests();
+
+    // The DB stores CPU temperature and the top memory process.
+    reg.hold(dbSensors_,  DataCategory::CpuSensors,   dbEnabled_);
+    reg.hold(dbTopProcs_, DataCategory::TopProcesses, dbEnabled_);
+
+    std::array<bool, kDataCategoryCount> needed{};
+    for (const auto& rule : alerts_.getRules()) {
+        DataCategory c;
+        if (rule.enabled && categoryForMetric(rule.metric, c))
+            needed[static_cast<size_t>(c)] = true;
     }
+    for (size_t i = 0; i < kDataCategoryCount; ++i)
+        reg.hold(alertSubs_[i], static_cast<DataCategory>(i), needed[i]);
 }
 
 // ---------------------------------------------------------------------------
 //  Tiny helpers
 // ---------------------------------------------------------------------------
 
-inline void App::plotLine(const char* label, ScrollingBuffer& buf,
-                          float tNow, float histSec, const ImVec4& col) {
-    if (buf.Size() == 0) return;
-    ImPlot::SetNextLineStyle(col, 2.0f);
-    ImPlot::PlotLine(label, buf.DataX.data(), buf.DataY.data(),
-                     buf.Size(), ImPlotLineFlags_None, buf.Offset, sizeof(float));
+/// History spans offered under View > History span, in seconds.
+inline constexpr float kHistorySpans[] = {120, 600, 3600, 6 * 3600, 24 * 3600, 7 * 24 * 3600};
+inline constexpr const char* kHistorySpanNames[] = {"2 min", "10 min", "1 hour",
+                                                    "6 hours", "24 hours", "7 days"};
+
+inline float App::historySpan() const { return kHistorySpans[historySpanIdx_]; }
+
+/**
+ * The points of @p buf (its raw samples, or tier @p tier; for a @p band
+ * the tier's min..max) inside the current plot's x range, plus one either
+ * side, found by binary search.  Up to four points per pixel column are
+ * handed over as they are: in place when they are contiguous in the ring,
+ * otherwise copied.  Longer runs are decimated to the first, min, max and
+ * last point of each column (two for a band).  Copies are cached per
+ * series.
+ */
+inline App::PlotSlice App::visiblePoints(
+        std::unordered_map<const HistoryRing*, PlotCache>& cache,
+        const HistoryRing& buf, int tier, bool band) {
+    const ScrollingBuffer& raw = buf.Raw();
+    const float* xs;
+    const float* ys;
+    const float* ys2 = nullptr;
+    int size, offset;
+    if (tier < 0) {
+        xs = raw.DataX.data();
+        ys = raw.DataY.data();
+        size = raw.Size();
+        offset = raw.Offset;
+    } else {
+        const HistoryTier& tr = buf.Tier(tier);
+        xs = tr.DataX.data();
+        ys = band ? tr.DataMin.data() : tr.DataAvg.data();
+        if (band) ys2 = tr.DataMax.data();
+        size = tr.Size();
+        offset = tr.Offset;
+    }
+
+    const ImPlotRect lim = ImPlot::GetPlotLimits();
+    const auto xMin = static_cast<float>(lim.X.Min);
+    const auto xMax = static_cast<float>(lim.X.Max);
+    const int columns = static_cast<int>(ImPlot::GetPlotSize().x);
+    const int first = std::max(0, ringLowerBound(xs, size, offset, xMin) - 1);
+    const int last  = std::min(size, ringUpperBound(xs, size, offset, xMax) + 1);
+    const int count = std::max(0, last - first);
+    const bool decimate = columns > 0 && count > 4 * columns;
+    int start = offset + first;
+    if (start >= size) start -= size;
+    if (!decimate && start + count <= size)
+        return {xs + start, ys + start, ys2 ? ys2 + start : nullptr, count};
+
+    PlotCache& c = cache[&buf];
+    if (c.source != xs || c.rawSize != raw.Size() || c.rawOffset != raw.Offset
+        || c.columns != columns || c.xMin != lim.X.Min || c.xMax != lim.X.Max) {
+        c.source    = xs;
+        c.rawSize   = raw.Size();
+        c.rawOffset = raw.Offset;
+        c.columns   = columns;
+        c.xMin      = lim.X.Min;
+        c.xMax      = lim.X.Max;
+        if (decimate && ys2) {
+            decimateBand(xs, ys, ys2, size, offset, xMin, xMax, columns, c.x, c.y, c.y2);
+        } else if (decimate) {
+            decimateMinMax(xs, ys, size, offset, xMin, xMax, columns, c.x, c.y);
+        } else {
+            c.x.clear();
+            c.y.clear();
+            c.y2.clear();
+            for (int k = first; k < last; ++k) {
+                const int idx = offset + k < size ? offset + k : offset + k - size;
+                c.x.push_back(xs[idx]);
+                c.y.push_back(ys[idx]);
+                if (ys2) c.y2.push_back(ys2[idx]);
+            }
+        }
+    }
+    return {c.x.data(), c.y.data(), ys2 ? c.y2.data() : nullptr, static_cast<int>(c.x.size())};
+}
+
+/// The last @p histSec seconds of @p buf: raw samples, or a tier's averages.
+inline void App::plotLine(const char* label, HistoryRing& buf,
+                          float tNow, float histSec, const ImVec4& col, float weight) {
+    if (buf.Empty()) return;
+    ImPlot::SetNextLineStyle(col, weight);
+    PlotSlice p = visiblePoints(lineCache_, buf, buf.PickTier(tNow - histSec), false);
+    ImPlot::PlotLine(label, p.x, p.y, p.count);
 }
 
-inline void App::plotShaded(const char* label, ScrollingBuffer& buf,
+/// As plotLine(), filled to zero; from a tier, the fill is the min..max band.
+inline void App::plotShaded(const char* label, HistoryRing& buf,
                             float tNow, float histSec, const ImVec4& col) {
-    if (buf.Size() == 0) return;
+    if (buf.Empty()) return;
     ImPlot::SetNextFillStyle(col, 0.15f);
-    ImPlot::PlotShaded(label, buf.DataX.data(), buf.DataY.data(),
-                       buf.Size(), 0, ImPlotShadedFlags_None, buf.Offset, sizeof(float));
+    int tier = buf.PickTier(tNow - histSec);
+    PlotSlice p = visiblePoints(fillCache_, buf, tier, tier >= 0);
+    if (p.y2)
+        ImPlot::PlotShaded(label, p.x, p.y, p.y2, p.count);
+    else
+        ImPlot::PlotShaded(label, p.x, p.y, p.count, 0);
     plotLine(label, buf, tNow, histSec, col);
 }
 
+/// Draw a placeholder and return false while @p id is still starting up.
+inline bool App::moduleReady(const MetricData& d, ModuleId id) {
+    auto i = static_cast<size_t>(id);
+    if (i < d.collector.modules.size() && d.collector.modules[i].ready) return true;
+    ImGui::TextColored(Theme::TextSecondary, "Starting %s monitor...", moduleName(id));
+    return false;
+}
+
 inline void App::bigNumber(const char* label, float value, const char* fmt) {
     ImGui::PushFont(nullptr);
     char valBuf[64];
@@ -267,15 +436,14 @@ inline void App::bigNumber(const char* label, float value, const char* fmt) {
 //  RENDER
 // ---------------------------------------------------------------------------
 
-inline void App::render() {
-    MetricData data;
-    float tNow;
-    {
-        std::lock_guard<std::recursive_mutex> lk(dataMtx_);
-        data  = latest_;
-        tNow  = elapsedTime_;
-    }
+/// Pick up the collector's latest sample if its version moved on.
+inline void App::refreshView() {
+    if (collector_.version() == viewVersion_) return;
+    if (auto latest = collector_.snapshots().latest(&viewVersion_)) view_ = std::move(latest);
+}
 
+inline void App::render() {
+    refreshView();
     renderMenuBar();
 
     ImGui::SetNextWindowPos(ImVec2(0, ImGui::GetFrameHeight()));
@@ -286,20 +454,30 @@ inline void App::render() {
                  ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse |
                  ImGuiWindowFlags_NoBringToFrontOnFocus);
 
+    // Only the visible tab's expensive data is collected.
+    bool cpuTab = false, memTab = false, netTab = false, procTab = false;
     if (ImGui::BeginTabBar("##tabs", ImGuiTabBarFlags_Reorderable)) {
         if (ImGui::BeginTabItem("Overview"))   { renderOverview();    ImGui::EndTabItem(); }
-        if (ImGui::BeginTabItem("CPU"))        { renderCpuTab();      ImGui::EndTabItem(); }
-        if (ImGui::BeginTabItem("Memory"))     { renderMemoryTab();   ImGui::EndTabItem(); }
-        if (ImGui::BeginTabItem("Network"))    { renderNetworkTab();  ImGui::EndTabItem(); }
+        if (ImGui::BeginTabItem("CPU"))        { cpuTab = true;  renderCpuTab();     ImGui::EndTabItem(); }
+        if (ImGui::BeginTabItem("Memory"))     { memTab = true;  renderMemoryTab();  ImGui::EndTabItem(); }
+        if (ImGui::BeginTabItem("Network"))    { netTab = true;  renderNetworkTab(); ImGui::EndTabItem(); }
         if (ImGui::BeginTabItem("Disk"))       { renderDiskTab();     ImGui::EndTabItem(); }
         if (ImGui::BeginTabItem("GPU"))        { renderGpuTab();      ImGui::EndTabItem(); }
-        if (ImGui::BeginTabItem("Processes"))  { renderProcessTab();  ImGui::EndTabItem(); }
+        if (ImGui::BeginTabItem("Processes"))  { procTab = true; renderProcessTab(); ImGui::EndTabItem(); }
         if (ImGui::BeginTabItem("Alerts"))     { renderAlertTab();    ImGui::EndTabItem(); }
         if (ImGui::BeginTabItem("System"))     { renderSystemTab();   ImGui::EndTabItem(); }
         ImGui::EndTabBar();
     }
 
+    auto& reg = collector_.interests();
+    reg.hold(tabCpuSensors_,  DataCategory::CpuSensors,     cpuTab);
+    reg.hold(tabTopProcs_,    DataCategory::TopProcesses,   memTab);
+    reg.hold(tabConnections_, DataCategory::Connections,    netTab);
+    reg.hold(tabProcesses_,   DataCategory::Processes,      procTab);
+    reg.hold(tabProcDetails_, DataCategory::ProcessDetails, procTab);
+
     ImGui::End();
+    if (showDiagnostics_) renderDiagnostics();
     if (showDemoWindow_) ImGui::ShowDemoWindow(&showDemoWindow_);
 }
 
@@ -308,34 +486,80 @@ inline void App::render() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderMenuBar() {
+    const MetricData& snap = *view_;
     if (ImGui::BeginMainMenuBar()) {
         if (ImGui::BeginMenu("File")) {
             if (ImGui::MenuItem("Export CSV"))      db_.exportToCSV();
             if (ImGui::MenuItem("Prune (7 days)"))  db_.pruneOlderThan(7);
+            bool tracing = tracing_;
+            if (ImGui::MenuItem("Record trace", nullptr, &tracing)) setTracing(tracing);
             ImGui::Separator();
             if (ImGui::MenuItem("Exit"))            running_ = false;
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("View")) {
+            ImGui::MenuItem("Collector diagnostics", nullptr, &showDiagnostics_);
+            ImGui::Combo("History span", &historySpanIdx_, kHistorySpanNames,
+                         static_cast<int>(std::size(kHistorySpanNames)));
             ImGui::MenuItem("ImGui Demo", nullptr, &showDemoWindow_);
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("Settings")) {
             ImGui::Checkbox("Database logging", &dbEnabled_);
             ImGui::SliderInt("DB write interval (ticks)", &dbIntervalTicks_, 1, 60);
+            if (ImGui::Checkbox("Store collector diagnostics", &dbCollectorStats_))
+                db_.setRecordCollectorStats(dbCollectorStats_);
+            ImGui::Separator();
+            const char* profiles[] = {"Minimal", "Standard", "Full", "Diagnostics"};
+            if (ImGui::Combo("Collection profile", &profileIdx_, profiles, 4)) {
+                collector_.setProfile(static_cast<ProfileKind>(profileIdx_));
+                Logger::log(std::string("Collection profile: ")
+                            + profileName(static_cast<ProfileKind>(profileIdx_)));
+                budgetPct_ = collector_.profile().cpuBudgetPercent;
+            }
+            if (ImGui::SliderFloat("CPU budget (% of one core)", &budgetPct_, 0.0f, 10.0f, "%.1f"))
+                collector_.setBudgetPercent(budgetPct_);
+            const char* policies[] = {"Skip", "Burst", "Re-anchor"};
+            if (ImGui::Combo("Missed ticks", &catchUpIdx_, policies, 3))
+                collector_.setCatchUpPolicy(static_cast<CatchUpPolicy>(catchUpIdx_));
+            const auto& tk = snap.collector.ticks;
+            ImGui::TextColored(Theme::TextSecondary,
+                               "Tick jitter p99 %.2f ms, %llu missed, %llu overruns",
+                               tk.jitterUs.percentile(0.99) / 1000.0,
+                               static_cast<unsigned long long>(tk.missedTicks),
+                               static_cast<unsigned long long>(tk.overruns));
+            if (snap.collector.firstCompleteMs > 0.0f)
+                ImGui::TextColored(Theme::TextSecondary, "First complete sample %.0f ms after start",
+                                   snap.collector.firstCompleteMs);
+            for (const auto& m : snap.collector.modules) {
+                if (m.degraded)
+                    ImGui::TextColored(Theme::AccentYellow, "%s slowed to %.0f ms",
+                                       m.name.c_str(), m.periodMs);
+                if (m.stale)
+                    ImGui::TextColored(Theme::AccentRed, "%s stale (%llu deadlines missed)",
+                                       m.name.c_str(),
+                                       static_cast<unsigned long long>(m.deadlineMisses));
+            }
+            ImGui::Separator();
+            for (const auto& st : pipeline_.stats()) {
+                ImGui::TextColored(st.dropped ? Theme::AccentYellow : Theme::TextSecondary,
+                                   "%-8s p99 %.2f ms  queue %zu/%zu (max %zu)  dropped %llu",
+                                   st.name.c_str(), st.latencyUs.percentile(0.99) / 1000.0,
+                                   st.queueDepth, st.capacity, st.maxQueueDepth,
+                                   static_cast<unsigned long long>(st.dropped));
+            }
             ImGui::EndMenu();
         }
 
         // Right-align status info — compute width dynamically
-        MetricData snap;
-        { std::lock_guard<std::recursive_mutex> lk(dataMtx_); snap = latest_; }
         char statusBuf[256];
         char ub[32], db2[32];
         Theme::FormatRate(snap.network.totalUploadRate, ub, 32);
         Theme::FormatRate(snap.network.totalDownloadRate, db2, 32);
         snprintf(statusBuf, sizeof(statusBuf),
-            "CPU %.0f%%  |  Mem %.0f%%  |  Up %s  |  Down %s",
-            snap.cpu.totalUsage, snap.memory.usagePercent, ub, db2);
+            "CPU %.0f%%  |  Mem %.0f%%  |  Up %s  |  Down %s  |  Self %.1f%%",
+            snap.cpu.totalUsage, snap.memory.usagePercent, ub, db2,
+            snap.collector.overheadPercent);
         float textW = ImGui::CalcTextSize(statusBuf).x;
         ImGui::SameLine(ImGui::GetWindowWidth() - textW - 16.0f);
         ImGui::TextColored(Theme::TextSecondary, "%s", statusBuf);
@@ -349,14 +573,13 @@ inline void App::renderMenuBar() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderOverview() {
-    MetricData d;
-    float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    float t = static_cast<float>(d.elapsedSec);
 
     float cardW = (ImGui::GetContentRegionAvail().x - 20) / 3.0f;
     float cardH = (ImGui::GetContentRegionAvail().y - ImGui::GetStyle().ItemSpacing.y) / 2.0f;
 
-    auto card = [&](const char* title, float pct, ScrollingBuffer& buf,
+    auto card = [&](const char* title, float pct, HistoryRing& buf,
                     const char* detail, const ImVec4& col) {
         Theme::BeginCard(title, cardW, cardH);
         ImGui::TextColored(Theme::TextPrimary, "%s", title);
@@ -487,8 +710,9 @@ inline void App::renderOverview() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderCpuTab() {
-    MetricData d; float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Cpu)) return;
+    float t = static_cast<float>(d.elapsedSec);
 
     // Summary panel
     ImGui::TextColored(Theme::TextPrimary,
@@ -528,7 +752,8 @@ inline void App::renderCpuTab() {
 
     ImGui::Separator();
 
-    float xMin = t - 120; if (xMin < 0) xMin = 0;
+    float span = historySpan();
+    float xMin = t - span; if (xMin < 0) xMin = 0;
     float avail = ImGui::GetContentRegionAvail().y;
     int nc = static_cast<int>(d.cpu.cores.size());
 
@@ -539,7 +764,7 @@ inline void App::renderCpuTab() {
         ImPlot::SetupAxes("Time (s)", "%", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_LockMin);
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 100, ImGuiCond_Always);
-        plotShaded("Usage", hCpu_, t, 120, Theme::AccentBlue);
+        plotShaded("Usage", hCpu_, t, span, Theme::AccentBlue);
         ImPlot::EndPlot();
     }
 
@@ -553,12 +778,15 @@ inline void App::renderCpuTab() {
         ImPlot::SetupLegend(ImPlotLocation_East, ImPlotLegendFlags_Outside);
 
         std::lock_guard<std::recursive_mutex> lk(dataMtx_);
+        if (coresResized_) {
+            // The plot caches are keyed by ring address, and the rings moved.
+            lineCache_.clear();
+            fillCache_.clear();
+            coresResized_ = false;
+        }
         for (int i = 0; i < nc && i < static_cast<int>(hCores_.size()); ++i) {
             char lbl[16]; snprintf(lbl, 16, "Core %d", i);
-            ImPlot::SetNextLineStyle(Theme::CoreColor(i), 1.5f);
-            ImPlot::PlotLine(lbl, hCores_[i].DataX.data(), hCores_[i].DataY.data(),
-                             hCores_[i].Size(), ImPlotLineFlags_None,
-                             hCores_[i].Offset, sizeof(float));
+            plotLine(lbl, hCores_[i], t, span, Theme::CoreColor(i), 1.5f);
         }
         ImPlot::EndPlot();
     }
@@ -581,8 +809,9 @@ inline void App::renderCpuTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderMemoryTab() {
-    MetricData d; float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Memory)) return;
+    float t = static_cast<float>(d.elapsedSec);
 
     char u[32], a[32], tot[32], c[32], b[32];
     Theme::FormatBytes(d.memory.usedBytes, u, 32);
@@ -618,7 +847,8 @@ inline void App::renderMemoryTab() {
 
     ImGui::Separator();
 
-    float xMin = t - 120; if (xMin < 0) xMin = 0;
+    float span = historySpan();
+    float xMin = t - span; if (xMin < 0) xMin = 0;
     float avail = ImGui::GetContentRegionAvail().y;
 
     // RAM usage graph
@@ -628,7 +858,7 @@ inline void App::renderMemoryTab() {
         ImPlot::SetupAxes("Time (s)", "%");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 100, ImGuiCond_Always);
-        plotShaded("RAM", hMem_, t, 120, Theme::AccentCyan);
+        plotShaded("RAM", hMem_, t, span, Theme::AccentCyan);
         ImPlot::EndPlot();
     }
 
@@ -646,7 +876,7 @@ inline void App::renderMemoryTab() {
         ImPlot::SetupAxes("Time (s)", "%");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 100, ImGuiCond_Always);
-        plotShaded("Swap", hSwap_, t, 120, Theme::AccentOrange);
+        plotShaded("Swap", hSwap_, t, span, Theme::AccentOrange);
         ImPlot::EndPlot();
     }
 
@@ -692,8 +922,9 @@ inline void App::renderMemoryTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderNetworkTab() {
-    MetricData d; float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Network)) return;
+    float t = static_cast<float>(d.elapsedSec);
 
     char up[32], dn[32], ts[32], tr[32];
     Theme::FormatRate(d.network.totalUploadRate, up, 32);
@@ -707,7 +938,8 @@ inline void App::renderNetworkTab() {
 
     ImGui::Separator();
 
-    float xMin = t - 120; if (xMin < 0) xMin = 0;
+    float span = historySpan();
+    float xMin = t - span; if (xMin < 0) xMin = 0;
     float avail = ImGui::GetContentRegionAvail().y;
 
     // Upload graph
@@ -718,7 +950,7 @@ inline void App::renderNetworkTab() {
         ImPlot::SetupAxes("Time (s)", "Rate");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisFormat(ImAxis_Y1, RateFormatter, nullptr);
-        plotShaded("Upload", hNetUp_, t, 120, Theme::AccentGreen);
+        plotShaded("Upload", hNetUp_, t, span, Theme::AccentGreen);
         ImPlot::EndPlot();
     }
 
@@ -727,7 +959,7 @@ inline void App::renderNetworkTab() {
         ImPlot::SetupAxes("Time (s)", "Rate");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisFormat(ImAxis_Y1, RateFormatter, nullptr);
-        plotShaded("Download", hNetDown_, t, 120, Theme::AccentPurple);
+        plotShaded("Download", hNetDown_, t, span, Theme::AccentPurple);
         ImPlot::EndPlot();
     }
 
@@ -799,8 +1031,9 @@ inline void App::renderNetworkTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderDiskTab() {
-    MetricData d; float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Disk)) return;
+    float t = static_cast<float>(d.elapsedSec);
 
     char r[32], w[32];
     Theme::FormatRate(d.disk.totalReadRate, r, 32);
@@ -809,7 +1042,8 @@ inline void App::renderDiskTab() {
 
     ImGui::Separator();
 
-    float xMin = t - 120; if (xMin < 0) xMin = 0;
+    float span = historySpan();
+    float xMin = t - span; if (xMin < 0) xMin = 0;
     float avail = ImGui::GetContentRegionAvail().y;
 
     // Read rate graph
@@ -820,7 +1054,7 @@ inline void App::renderDiskTab() {
         ImPlot::SetupAxes("Time (s)", "Rate");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisFormat(ImAxis_Y1, RateFormatter, nullptr);
-        plotShaded("Read", hDiskRead_, t, 120, Theme::AccentGreen);
+        plotShaded("Read", hDiskRead_, t, span, Theme::AccentGreen);
         ImPlot::EndPlot();
     }
 
@@ -829,7 +1063,7 @@ inline void App::renderDiskTab() {
         ImPlot::SetupAxes("Time (s)", "Rate");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisFormat(ImAxis_Y1, RateFormatter, nullptr);
-        plotShaded("Write", hDiskWrite_, t, 120, Theme::AccentOrange);
+        plotShaded("Write", hDiskWrite_, t, span, Theme::AccentOrange);
         ImPlot::EndPlot();
     }
 
@@ -878,8 +1112,9 @@ inline void App::renderDiskTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderGpuTab() {
-    MetricData d; float t;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; t = elapsedTime_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Gpu)) return;
+    float t = static_cast<float>(d.elapsedSec);
 
     if (d.gpu.gpus.empty()) {
         ImGui::TextColored(Theme::TextSecondary, "No GPU detected.");
@@ -916,7 +1151,8 @@ inline void App::renderGpuTab() {
 
     ImGui::Separator();
 
-    float xMin = t - 120; if (xMin < 0) xMin = 0;
+    float span = historySpan();
+    float xMin = t - span; if (xMin < 0) xMin = 0;
     float avail = ImGui::GetContentRegionAvail().y;
 
     // Utilization graph
@@ -926,7 +1162,7 @@ inline void App::renderGpuTab() {
         ImPlot::SetupAxes("Time (s)", "%");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 100, ImGuiCond_Always);
-        plotShaded("Utilization", hGpuUtil_, t, 120, Theme::AccentRed);
+        plotShaded("Utilization", hGpuUtil_, t, span, Theme::AccentRed);
         ImPlot::EndPlot();
     }
 
@@ -937,7 +1173,7 @@ inline void App::renderGpuTab() {
         ImPlot::SetupAxes("Time (s)", "%");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 100, ImGuiCond_Always);
-        plotShaded("VRAM", hGpuMem_, t, 120, Theme::AccentCyan);
+        plotShaded("VRAM", hGpuMem_, t, span, Theme::AccentCyan);
         ImPlot::EndPlot();
     }
 
@@ -947,7 +1183,7 @@ inline void App::renderGpuTab() {
     if (ImPlot::BeginPlot("GPU Temperature", ImVec2(-1, h3))) {
         ImPlot::SetupAxes("Time (s)", "C");
         ImPlot::SetupAxisLimits(ImAxis_X1, xMin, t, ImGuiCond_Always);
-        plotLine("Temp", hGpuTemp_, t, 120, Theme::AccentOrange);
+        plotLine("Temp", hGpuTemp_, t, span, Theme::AccentOrange);
         ImPlot::EndPlot();
     }
 }
@@ -957,8 +1193,8 @@ inline void App::renderGpuTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderProcessTab() {
-    MetricData d;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; }
+    const MetricData& d = *view_;
+    if (!moduleReady(d, ModuleId::Process)) return;
 
     ImGui::TextColored(Theme::TextPrimary,
         "Processes: %d  |  Threads: %d  |  Running: %d",
@@ -969,13 +1205,13 @@ inline void App::renderProcessTab() {
                              processFilter_, sizeof(processFilter_));
     ImGui::SameLine();
     if (ImGui::Button("Kill Selected") && selectedPid_ > 0) {
-        if (process_) process_->killProcess(selectedPid_);
+        if (auto* pm = collector_.processManager()) pm->killProcess(selectedPid_);
     }
 
     std::vector<const ProcessInfo*> filtered;
     for (auto& p : d.process.processes) {
         if (processFilter_[0] &&
-            p.name.find(processFilter_) == std::string::npos)
+            p.name.str().find(processFilter_) == std::string::npos)
             continue;
         filtered.push_back(&p);
     }
@@ -990,12 +1226,14 @@ inline void App::renderProcessTab() {
             case 3: return a->memoryBytes < b->memoryBytes;
             case 4: return a->cpuPercent < b->cpuPercent;
             case 5: return a->threads < b->threads;
+            case 8: return a->gpuPercent < b->gpuPercent;
+            case 9: return a->gpuMemoryBytes < b->gpuMemoryBytes;
             default: return a->pid < b->pid;
         }
     };
     std::sort(filtered.begin(), filtered.end(), cmp);
 
-    if (ImGui::BeginTable("##procs", 8,
+    if (ImGui::BeginTable("##procs", 10,
             ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
             ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable |
             ImGuiTableFlags_ScrollY,
@@ -1005,6 +1243,8 @@ inline void App::renderProcessTab() {
         ImGui::TableSetupColumn("State",    0, 0, 2);
         ImGui::TableSetupColumn("Memory",   0, 0, 3);
         ImGui::TableSetupColumn("CPU%",     ImGuiTableColumnFlags_DefaultSort, 0, 4);
+        ImGui::TableSetupColumn("GPU%",     0, 0, 8);
+        ImGui::TableSetupColumn("VRAM",     0, 0, 9);
         ImGui::TableSetupColumn("Threads",  0, 0, 5);
         ImGui::TableSetupColumn("Priority", 0, 0, 6);
         ImGui::TableSetupColumn("User",     0, 0, 7);
@@ -1040,6 +1280,17 @@ inline void App::renderProcessTab() {
                 ImGui::TableNextColumn();
                 ImGui::TextColored(Theme::SeverityColor(p->cpuPercent),
                                    "%.1f", p->cpuPercent);
+                ImGui::TableNextColumn();
+                if (p->gpuPercent >= 0.0f)
+                    ImGui::TextColored(Theme::SeverityColor(p->gpuPercent),
+                                       "%.1f", p->gpuPercent);
+                else
+                    ImGui::TextColored(Theme::TextSecondary, "-");
+                ImGui::TableNextColumn();
+                if (p->gpuMemoryBytes > 0)
+                    ImGui::Text("%s", Theme::FormatBytes(p->gpuMemoryBytes, mb, 32));
+                else
+                    ImGui::TextColored(Theme::TextSecondary, "-");
                 ImGui::TableNextColumn(); ImGui::Text("%d", p->threads);
                 ImGui::TableNextColumn(); ImGui::Text("%d", p->priority);
                 ImGui::TableNextColumn(); ImGui::Text("%s", p->user.c_str());
@@ -1137,8 +1388,7 @@ inline void App::renderAlertTab() {
 // ---------------------------------------------------------------------------
 
 inline void App::renderSystemTab() {
-    MetricData d;
-    { std::lock_guard<std::recursive_mutex> lk(dataMtx_); d = latest_; }
+    const MetricData& d = *view_;
     auto& s = d.systemInfo;
 
     auto row = [](const char* label, const char* value) {
@@ -1147,7 +1397,7 @@ inline void App::renderSystemTab() {
         ImGui::TableNextColumn(); ImGui::TextColored(Theme::TextPrimary, "%s", value);
     };
 
-    if (ImGui::BeginTable("##sysinfo", 2,
+    if (moduleReady(d, ModuleId::SystemInfo) && ImGui::BeginTable("##sysinfo", 2,
             ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg, ImVec2(600, 0))) {
         ImGui::TableSetupColumn("Property", ImGuiTableColumnFlags_WidthFixed, 200);
         ImGui::TableSetupColumn("Value");
@@ -1223,3 +1473,88 @@ inline void App::renderSystemTab() {
         ImGui::TextColored(Theme::AccentGreen, "%s", exportStatus_);
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Collector diagnostics — per-module update cost and pipeline stages
+// ---------------------------------------------------------------------------
+
+inline void App::renderDiagnostics() {
+    const CollectorStats& c = view_->collector;
+    ImGui::SetNextWindowSize(ImVec2(760, 420), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Collector diagnostics", &showDiagnostics_)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::TextColored(Theme::TextSecondary, "Profile %s  |  Self %.2f%% of one core",
+                       c.profile.c_str(), c.overheadPercent);
+
+    ImGui::TextColored(Theme::TextPrimary, "Module updates");
+    if (ImGui::BeginTable("##diagModules", 9,
+            ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupColumn("Module");
+        ImGui::TableSetupColumn("Runs");
+        ImGui::TableSetupColumn("p50 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("CPU ms/run");
+        ImGui::TableSetupColumn("Syscalls/run");
+        ImGui::TableSetupColumn("Opens/run");
+        ImGui::TableSetupColumn("Parsed/run");
+        ImGui::TableHeadersRow();
+
+        for (const auto& m : c.modules) {
+            if (!m.enabled) continue;
+            double runs = m.updates ? static_cast<double>(m.updates) : 1.0;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextColored(m.stale ? Theme::AccentRed : Theme::TextPrimary, "%s", m.name.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(m.updates));
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", m.updateUs.percentile(0.5) / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", m.updateUs.percentile(0.99) / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", m.updateUs.max() / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", m.cpuMsPerRun);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", m.syscalls / runs);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", m.fileOpens / runs);
+            char parsed[32];
+            Theme::FormatBytes(static_cast<uint64_t>(m.bytesRead / runs), parsed, 32);
+            ImGui::TableNextColumn(); ImGui::Text("%s", parsed);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Spacing();
+    ImGui::TextColored(Theme::TextPrimary, "Pipeline stages");
+    if (c.stages.empty()) {
+        ImGui::TextColored(Theme::TextSecondary, "Not running");
+    } else if (ImGui::BeginTable("##diagStages", 8,
+            ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Processed");
+        ImGui::TableSetupColumn("p50 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("Wait p99 ms");
+        ImGui::TableSetupColumn("CPU ms/run");
+        ImGui::TableSetupColumn("Queue");
+        ImGui::TableSetupColumn("Dropped");
+        ImGui::TableHeadersRow();
+
+        for (const auto& st : c.stages) {
+            double runs = st.processed ? static_cast<double>(st.processed) : 1.0;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%s", st.name.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(st.processed));
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", st.latencyUs.percentile(0.5) / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", st.latencyUs.percentile(0.99) / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", st.waitUs.percentile(0.99) / 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", st.cpuSeconds * 1000.0 / runs);
+            ImGui::TableNextColumn(); ImGui::Text("%zu/%zu (max %zu)",
+                                                  st.queueDepth, st.capacity, st.maxQueueDepth);
+            ImGui::TableNextColumn();
+            ImGui::TextColored(st.dropped ? Theme::AccentYellow : Theme::TextPrimary,
+                               "%llu", static_cast<unsigned long long>(st.dropped));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
@@ -95,13 +95,6 @@ bool App::init() {
     Logger::initialize("resource_monitor.log");
     Logger::setConsoleOutput(false);
 
-    cpu_     = createCPU();
-    memory_  = createMemory();
-    network_ = createNetwork();
-    disk_    = createDisk();
-    gpu_     = createGPU();
-    process_ = createProcessManager();
-
     db_.initialize();
 
     Logger::log("GUI initialised");
@@ -113,11 +106,23 @@ bool App::init() {
 // ---------------------------------------------------------------------------
 void App::run() {
     running_ = true;
-    collectorThread_ = std::thread(&App::collectorLoop, this);
+    pipeline_.start();
 
-    while (!glfwWindowShouldClose(window_) && running_) {
-        glfwPollEvents();
+    // Draw a few frames after every wake-up so ImGui can settle hover and
+    // animation state, then sleep until input or a new sample arrives.
+    constexpr int    kFramesPerWake = 3;
+    constexpr double kIdleWakeSec   = 1.0;
 
+    while (!glfwWindowShouldClose(window_) && running_) {
+        if (pendingFrames_ > 0) {
+            glfwPollEvents();
+            --pendingFrames_;
+        } else {
+            glfwWaitEventsTimeout(kIdleWakeSec);
+            pendingFrames_ = kFramesPerWake;
+        }
+
+        TraceSpan frame("gui", "frame");
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
@@ -133,9 +138,23 @@ void App::run() {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         glfwSwapBuffers(window_);
+
+        if (!firstFrameShown_) {
+            firstFrameShown_ = true;
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - launched_).count();
+            Logger::log("First frame " + std::to_string(ms) + " ms after start");
+        }
     }
 
-    running_ = false;  // signal collector to stop
+    running_ = false;
+}
+
+// ---------------------------------------------------------------------------
+//  App::wakeRenderer — called by the history stage after each sample
+// ---------------------------------------------------------------------------
+void App::wakeRenderer() {
+    glfwPostEmptyEvent();
 }
 
 // ---------------------------------------------------------------------------
@@ -143,7 +162,8 @@ void App::run() {
 // ---------------------------------------------------------------------------
 void App::shutdown() {
     running_ = false;
-    if (collectorThread_.joinable()) collectorThread_.join();
+    pipeline_.stop();
+    if (tracing_) setTracing(false);
 
     if (window_) {
         ImGui_ImplOpenGL3_Shutdown();
@@ -0,0 +1,414 @@
+/**
+ * @file load_generator.cpp
+ * @brief Linux implementation of LoadGenerator.
+ */
+
+#include "load_generator.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+extern char** environ;
+
+namespace {
+
+constexpr std::size_t kDiskChunk  = 1 << 20;  ///< Bytes per disk write
+constexpr int         kDiskChunks = 64;       ///< Scratch file size, in chunks
+constexpr int         kDiskBatch  = 8;        ///< Chunks written before syncing and reading back
+constexpr std::size_t kThreadStack = 64 * 1024;  ///< Stack of each extra child thread
+
+/// Called first in every child: die with the parent, even if it already has.
+void dieWithParent(pid_t parent) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != parent) _exit(0);
+}
+
+[[noreturn]] void sleepForever() {
+    for (;;) pause();
+}
+
+/// Body of the extra child threads. They share the child's TLS, so they make
+/// bare system calls only: libc's pause() would touch the cancellation state.
+int blockedThread(void*) {
+    for (;;) syscall(SYS_ppoll, nullptr, 0, nullptr, nullptr, 0);
+}
+
+/// Write all of @p len bytes, retrying on EINTR.
+bool writeAll(int fd, const void* data, std::size_t len) {
+    auto* p = static_cast<const char*>(data);
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, std::size_t len) {
+    auto* p = static_cast<char*>(data);
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/// Run `ip` with @p args, output discarded. @return true if it exited with 0.
+bool runIp(std::vector<std::string> args) {
+    args.insert(args.begin(), "ip");
+    std::vector<char*> argv;
+    for (auto& a : args) argv.push_back(a.data());
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    pid_t pid = 0;
+    int rc = posix_spawnp(&pid, "ip", &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) return false;
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/// Raise the soft fd limit to the hard one.
+void raiseFdLimit() {
+    rlimit lim{};
+    if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+        lim.rlim_cur = lim.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+}
+
+sockaddr_in loopback(uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = htons(port);
+    return addr;
+}
+
+} // namespace
+
+LoadSpec LoadSpec::scaled(double factor) const {
+    auto scale = [factor](int n) { return static_cast<int>(n * factor); };
+    LoadSpec s = *this;
+    s.processes      = scale(processes);
+    s.tcpConnections = scale(tcpConnections);
+    s.udpSockets     = scale(udpSockets);
+    s.namespaces     = scale(namespaces);
+    s.diskMBps       = scale(diskMBps);
+    return s;
+}
+
+LoadGenerator::LoadGenerator(LoadSpec spec) : spec_(std::move(spec)) {}
+
+LoadGenerator::~LoadGenerator() { stop(); }
+
+bool LoadGenerator::start() {
+    if (running_) return report_.warnings.empty();
+    running_ = true;
+    report_  = {};
+
+    raiseFdLimit();  // past the hard limit, openTcp() and openUdp() report the shortfall
+
+    spawnProcesses();
+    openTcp();
+    openUdp();
+    createNamespaces();
+    startDiskWorker();
+    return report_.warnings.empty();
+}
+
+void LoadGenerator::stop() {
+    if (!running_) return;
+    for (pid_t pid : children_) kill(pid, SIGKILL);
+    for (pid_t pid : children_)
+        while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
+    children_.clear();
+    for (int fd : fds_) close(fd);
+    fds_.clear();
+    running_ = false;
+}
+
+void LoadGenerator::warn(std::string message) {
+    report_.warnings.push_back(std::move(message));
+}
+
+// ---------------------------------------------------------------------------
+// Processes and threads
+// ---------------------------------------------------------------------------
+
+void LoadGenerator::spawnProcesses() {
+    if (spec_.processes <= 0) return;
+
+    // Each child reports how many threads it managed to start.
+    int ready[2];
+    if (pipe2(ready, O_CLOEXEC) != 0) {
+        warn(std::string("pipe: ") + std::strerror(errno));
+        return;
+    }
+    const pid_t parent  = getpid();
+    const int   threads = std::max(spec_.threadsPerProcess, 0);
+
+    // This process may already run threads (the log writer, a Collector's
+    // workers), so a child may only make async-signal-safe calls: no
+    // pthread_create() or malloc(). Its threads are raw clone()s on stacks
+    // mapped here; each child gets a private copy of the mapping.
+    const std::size_t stackBytes = static_cast<std::size_t>(threads) * kThreadStack;
+    char* stacks = nullptr;
+    if (stackBytes > 0) {
+        void* m = mmap(nullptr, stackBytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (m == MAP_FAILED) warn(std::string("thread stacks: ") + std::strerror(errno));
+        else stacks = static_cast<char*>(m);
+    }
+
+    int spawned = 0;
+    for (; spawned < spec_.processes; ++spawned) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            dieWithParent(parent);
+            close(ready[0]);
+            constexpr int kFlags = CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND
+                                 | CLONE_THREAD | CLONE_SYSVSEM;
+            int started = 0;
+            for (; stacks && started < threads; ++started) {
+                char* top = stacks + static_cast<std::size_t>(started + 1) * kThreadStack;
+                if (clone(blockedThread, top, kFlags, nullptr) < 0) break;
+            }
+            writeAll(ready[1], &started, sizeof started);
+            close(ready[1]);
+            sleepForever();
+        }
+        if (pid < 0) {
+            warn("forked " + std::to_string(spawned) + " of " + std::to_string(spec_.processes)
+                 + " processes: " + std::strerror(errno));
+            break;
+        }
+        children_.push_back(pid);
+    }
+    close(ready[1]);
+    if (stacks) munmap(stacks, stackBytes);
+
+    for (int i = 0; i < spawned; ++i) {
+        int started = 0;
+        if (!readAll(ready[0], &started, sizeof started)) break;
+        ++report_.processes;
+        report_.threads += started;
+    }
+    close(ready[0]);
+    if (report_.threads < spawned * threads)
+        warn("started " + std::to_string(report_.threads) + " of "
+             + std::to_string(spawned * threads) + " threads");
+}
+
+// ---------------------------------------------------------------------------
+// Sockets
+// ---------------------------------------------------------------------------
+
+void LoadGenerator::openTcp() {
+    if (spec_.tcpConnections <= 0) return;
+
+    int listener = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr = loopback(0);
+    socklen_t len = sizeof addr;
+    if (listener < 0
+        || bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0
+        || listen(listener, SOMAXCONN) != 0
+        || getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        warn(std::string("TCP listener: ") + std::strerror(errno));
+        if (listener >= 0) close(listener);
+        return;
+    }
+    fds_.push_back(listener);
+    report_.tcpSockets = 1;
+
+    int made = 0;
+    for (; made < spec_.tcpConnections; ++made) {
+        int client = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (client < 0) break;
+        if (connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            close(client);
+            break;
+        }
+        int server = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (server < 0) {
+            close(client);
+            break;
+        }
+        fds_.push_back(client);
+        fds_.push_back(server);
+        report_.tcpSockets += 2;
+    }
+    if (made < spec_.tcpConnections)
+        warn("opened " + std::to_string(made) + " of " + std::to_string(spec_.tcpConnections)
+             + " TCP connections: " + std::strerror(errno));
+}
+
+void LoadGenerator::openUdp() {
+    int made = 0;
+    for (; made < spec_.udpSockets; ++made) {
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) break;
+        sockaddr_in addr = loopback(0);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            close(fd);
+            break;
+        }
+        fds_.push_back(fd);
+        ++report_.udpSockets;
+    }
+    if (made < spec_.udpSockets)
+        warn("opened " + std::to_string(made) + " of " + std::to_string(spec_.udpSockets)
+             + " UDP sockets: " + std::strerror(errno));
+}
+
+// ---------------------------------------------------------------------------
+// Network namespaces
+// ---------------------------------------------------------------------------
+
+void LoadGenerator::createNamespaces() {
+    if (spec_.namespaces <= 0) return;
+
+    const pid_t parent = getpid();
+    // veth pairs need CAP_NET_ADMIN on the host side; try until the first refusal.
+    bool vethAllowed = geteuid() == 0;
+    if (!vethAllowed) warn("not root: namespaces get no veth pair");
+
+    for (int i = 0; i < spec_.namespaces; ++i) {
+        int ready[2];
+        if (pipe2(ready, O_CLOEXEC) != 0) return;
+        pid_t pid = fork();
+        if (pid == 0) {
+            dieWithParent(parent);
+            close(ready[0]);
+            // Unprivileged users may still own a namespace inside their own user namespace.
+            char ok = unshare(CLONE_NEWNET) == 0 || unshare(CLONE_NEWUSER | CLONE_NEWNET) == 0;
+            writeAll(ready[1], &ok, 1);
+            close(ready[1]);
+            sleepForever();
+        }
+        close(ready[1]);
+        char ok = 0;
+        if (pid > 0) readAll(ready[0], &ok, 1);
+        close(ready[0]);
+        if (pid < 0 || !ok) {
+            if (pid > 0) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+            warn("created " + std::to_string(i) + " of " + std::to_string(spec_.namespaces)
+                 + " network namespaces (not permitted)");
+            return;
+        }
+        children_.push_back(pid);
+        ++report_.namespaces;
+
+        if (!vethAllowed) continue;
+        // The peer lives in the namespace, so the pair goes away with the child.
+        char name[32];
+        int len = std::snprintf(name, sizeof name, "rl%dv%d", static_cast<int>(parent % 100000), i);
+        if (len < 0 || len > IFNAMSIZ - 1) {
+            // A cut-down name would collide with another pair's.
+            warn("stopped creating veth pairs at " + std::to_string(i)
+                 + ": interface name would exceed " + std::to_string(IFNAMSIZ - 1) + " characters");
+            vethAllowed = false;
+            continue;
+        }
+        if (runIp({"link", "add", name, "type", "veth", "peer", "name", "eth0",
+                   "netns", std::to_string(pid)})
+            && runIp({"link", "set", name, "up"})) {
+            ++report_.vethPairs;
+        } else {
+            warn("could not create veth pairs with `ip link add`");
+            vethAllowed = false;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Disk I/O
+// ---------------------------------------------------------------------------
+
+void LoadGenerator::startDiskWorker() {
+    if (spec_.diskMBps <= 0) return;
+
+    std::error_code ec;
+    std::filesystem::path dir = spec_.diskDir.empty()
+        ? std::filesystem::temp_directory_path(ec) : std::filesystem::path(spec_.diskDir);
+    std::string path = (dir / ("rm_loadgen_" + std::to_string(getpid()) + ".tmp")).string();
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        warn("disk worker: " + path + ": " + std::strerror(errno));
+        return;
+    }
+    unlink(path.c_str());  // the space is freed when the worker dies
+
+    // Allocated before fork(): the child only makes syscalls.
+    std::vector<char> chunk(kDiskChunk, 'r');
+    const long intervalNs = 1000000000L / spec_.diskMBps;
+    const pid_t parent = getpid();
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        dieWithParent(parent);
+        timespec next{};
+        clock_gettime(CLOCK_MONOTONIC, &next);
+        int slot = 0;
+        for (;;) {
+            // Write a batch, push it to the device, drop it from the page
+            // cache and read it back, so both directions reach the disk.
+            for (int i = 0; i < kDiskBatch; ++i) {
+                off_t off = static_cast<off_t>((slot + i) % kDiskChunks) * kDiskChunk;
+                if (pwrite(fd, chunk.data(), kDiskChunk, off) < 0) _exit(1);
+                next.tv_nsec += intervalNs;
+                while (next.tv_nsec >= 1000000000L) {
+                    next.tv_nsec -= 1000000000L;
+                    ++next.tv_sec;
+                }
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+            }
+            off_t begin = static_cast<off_t>(slot % kDiskChunks) * kDiskChunk;
+            fdatasync(fd);
+            posix_fadvise(fd, begin, kDiskBatch * kDiskChunk, POSIX_FADV_DONTNEED);
+            for (int i = 0; i < kDiskBatch; ++i)
+                if (pread(fd, chunk.data(), kDiskChunk, begin + i * kDiskChunk) < 0) _exit(1);
+            slot = (slot + kDiskBatch) % kDiskChunks;
+        }
+    }
+    close(fd);
+    if (pid < 0) {
+        warn(std::string("disk worker: ") + std::strerror(errno));
+        return;
+    }
+    children_.push_back(pid);
+    report_.diskWorker = true;
+}
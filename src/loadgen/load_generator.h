@@ -0,0 +1,95 @@
+/**
+ * @file load_generator.h
+ * @brief Synthetic machine load for measuring the monitor's own scaling.
+ *
+ * A LoadGenerator populates the local machine with the things the
+ * collectors walk every tick: processes and threads (/proc/<pid>), TCP
+ * and UDP sockets (/proc/net/tcp, /proc/net/udp and every process's fd
+ * table), network interfaces (/proc/net/dev) and disk traffic
+ * (/proc/diskstats). Everything is on loopback or in private network
+ * namespaces, so it runs on one box with no network.
+ *
+ * Processes, namespaces and the disk worker are forked children that die
+ * with the generator (PR_SET_PDEATHSIG), so the generating process itself
+ * stays idle apart from holding the sockets, and its CPU time can be
+ * charged to a Collector running in it. The generating process may
+ * already run threads of its own, so the children make only
+ * async-signal-safe calls; their extra threads are bare clone()s that
+ * block in a system call. Anything the host does not allow
+ * (too many processes, no CAP_NET_ADMIN for veth pairs, a low fd limit) is
+ * created as far as possible and reported in achieved().
+ *
+ * Linux only.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+/// @brief How much of each kind of load to create.
+struct LoadSpec {
+    int processes         = 0;  ///< Idle child processes.
+    int threadsPerProcess = 0;  ///< Extra blocked threads in each child.
+    int tcpConnections    = 0;  ///< Established loopback TCP connections (two sockets each).
+    int udpSockets        = 0;  ///< UDP sockets bound to 127.0.0.1.
+    int namespaces        = 0;  ///< Network namespaces, each with a veth pair to the host if permitted.
+    int diskMBps          = 0;  ///< Write-then-read rate of the disk worker in MB/s (0 = none).
+    std::string diskDir;        ///< Directory for the disk worker's scratch file (empty = temp dir).
+
+    /// @brief This load with every count multiplied by @p factor (rounded down).
+    LoadSpec scaled(double factor) const;
+};
+
+/// @brief What start() actually created.
+struct LoadReport {
+    int processes  = 0;
+    int threads    = 0;  ///< Extra threads across all child processes.
+    int tcpSockets = 0;  ///< Both ends of every connection, plus the listener.
+    int udpSockets = 0;
+    int namespaces = 0;
+    int vethPairs  = 0;
+    bool diskWorker = false;
+    std::vector<std::string> warnings;  ///< One line per shortfall.
+};
+
+/**
+ * @class LoadGenerator
+ * @brief Creates a LoadSpec's worth of load on start() and removes it on stop().
+ */
+class LoadGenerator {
+public:
+    explicit LoadGenerator(LoadSpec spec);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    /**
+     * @brief Create the load. Idempotent while running.
+     * @return false if any part fell short; see achieved().
+     */
+    bool start();
+
+    /// @brief Kill the children, close the sockets, remove the interfaces.
+    void stop();
+
+    const LoadSpec& spec() const { return spec_; }
+    const LoadReport& achieved() const { return report_; }
+
+private:
+    void spawnProcesses();
+    void openTcp();
+    void openUdp();
+    void createNamespaces();
+    void startDiskWorker();
+    void warn(std::string message);
+
+    LoadSpec   spec_;
+    LoadReport report_;
+    bool       running_ = false;
+    std::vector<pid_t> children_;  ///< Every forked child, whatever its role.
+    std::vector<int>   fds_;       ///< Sockets held open.
+};
@@ -0,0 +1,212 @@
+/**
+ * @file main.cpp
+ * @brief Load generator that measures the collector's cost as load grows.
+ *
+ * Usage: ResourceMonitorLoadGen [--processes N] [--threads N per process]
+ *                               [--tcp N connections] [--udp N sockets]
+ *                               [--netns N] [--disk-mbps N] [--disk-dir <dir>]
+ *                               [--profile minimal|standard|full|diagnostics]
+ *                               [--duration <seconds per step>] [--steps N]
+ *                               [--csv] [--hold]
+ *
+ * The requested load is applied in --steps equal increments, starting
+ * from none (so --steps 4 measures 0%, 25%, 50%, 75% and 100%). At each
+ * step a fresh Collector runs the chosen profile for --duration seconds
+ * with every data category subscribed, and one row is printed: what was
+ * created, the collect() latency percentiles and the CPU time this
+ * process used, as a percentage of one core. The load lives in child
+ * processes, so that CPU time is the collector's own.
+ *
+ * With --hold the full load is created and kept until Ctrl+C, with no
+ * measuring, for watching with the GUI or CLI.
+ */
+
+#include "load_generator.h"
+#include "core/collector/collector.h"
+#include "utils/histogram.h"
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> running{true};
+
+static void signalHandler(int) { running = false; }
+
+static void printUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--processes N] [--threads N] [--tcp N] [--udp N] [--netns N]"
+                 " [--disk-mbps N] [--disk-dir <dir>]"
+                 " [--profile minimal|standard|full|diagnostics]"
+                 " [--duration <seconds>] [--steps N] [--csv] [--hold]\n";
+}
+
+/// Accept both "--name value" and "--name=value".
+static bool optionValue(const std::string& name, int argc, char* argv[],
+                        int& i, std::string& value) {
+    std::string arg = argv[i];
+    if (arg == name && i + 1 < argc) {
+        value = argv[++i];
+        return true;
+    }
+    if (arg.rfind(name + "=", 0) == 0) {
+        value = arg.substr(name.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+/// User + system CPU time of this process, all threads.
+static double processCpuSeconds() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec)
+         + static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1.0e6;
+}
+
+/// One measured step.
+struct StepResult {
+    LoadReport load;
+    Histogram  tickUs;      ///< collect() latency
+    double     cpuPercent = 0.0;
+    float      overheadPercent = 0.0f;  ///< The collector's own smoothed estimate
+};
+
+/// Create @p spec, run a Collector under @p kind for @p seconds and time every tick.
+static StepResult measure(const LoadSpec& spec, ProfileKind kind, double seconds) {
+    using Clock = std::chrono::steady_clock;
+    StepResult r;
+    LoadGenerator load(spec);
+    load.start();
+    r.load = load.achieved();
+
+    Collector collector(kind);
+    collector.waitForModules(std::chrono::seconds(30));
+    std::vector<InterestRegistry::Subscription> subs;
+    for (std::size_t c = 0; c < kDataCategoryCount; ++c)
+        subs.push_back(collector.interests().subscribe(static_cast<DataCategory>(c)));
+    collector.collect();  // first tick: everything is due and the caches are cold
+
+    const auto   start = Clock::now();
+    const double cpu0  = processCpuSeconds();
+    MetricData   md;
+    while (running && Clock::now() - start < std::chrono::duration<double>(seconds)) {
+        collector.waitNextTick();
+        auto t0 = Clock::now();
+        md = collector.collect();
+        r.tickUs.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count()));
+    }
+    const double wall = std::chrono::duration<double>(Clock::now() - start).count();
+    r.cpuPercent      = wall > 0.0 ? (processCpuSeconds() - cpu0) / wall * 100.0 : 0.0;
+    r.overheadPercent = md.collector.overheadPercent;
+    return r;
+}
+
+static int hold(const LoadSpec& spec) {
+    LoadGenerator load(spec);
+    load.start();
+    const LoadReport& a = load.achieved();
+    for (const auto& w : a.warnings) std::cerr << "warning: " << w << '\n';
+    std::printf("Holding %d processes, %d threads, %d TCP and %d UDP sockets, %d namespaces"
+                " (%d veth), disk worker %s. Ctrl+C to stop.\n",
+                a.processes, a.threads, a.tcpSockets, a.udpSockets, a.namespaces, a.vethPairs,
+                a.diskWorker ? "on" : "off");
+    while (running) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[]) {
+    LoadSpec spec;
+    ProfileKind profile = ProfileKind::Full;
+    double duration = 10.0;
+    int steps = 1;
+    bool csv = false;
+    bool holdOnly = false;
+
+    auto intOption = [&](const char* name, int& i, int& out) {
+        std::string value;
+        if (!optionValue(name, argc, argv, i, value)) return false;
+        out = std::atoi(value.c_str());
+        return true;
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        std::string arg = argv[i];
+        if (intOption("--processes", i, spec.processes)
+            || intOption("--threads", i, spec.threadsPerProcess)
+            || intOption("--tcp", i, spec.tcpConnections)
+            || intOption("--udp", i, spec.udpSockets)
+            || intOption("--netns", i, spec.namespaces)
+            || intOption("--disk-mbps", i, spec.diskMBps)
+            || intOption("--steps", i, steps)) {
+            continue;
+        } else if (optionValue("--disk-dir", argc, argv, i, value)) {
+            spec.diskDir = value;
+        } else if (optionValue("--duration", argc, argv, i, value)) {
+            duration = std::atof(value.c_str());
+        } else if (optionValue("--profile", argc, argv, i, value)) {
+            if (!profileFromName(value, profile)) {
+                std::cerr << "Unknown profile: " << value << '\n';
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--csv") {
+            csv = true;
+        } else if (arg == "--hold") {
+            holdOnly = true;
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (steps < 1 || duration <= 0.0) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+    if (holdOnly) return hold(spec);
+
+    if (csv)
+        std::printf("step,processes,threads,tcp_sockets,udp_sockets,namespaces,veth,disk,"
+                    "ticks,p50_us,p99_us,max_us,cpu_percent,overhead_percent\n");
+    else
+        std::printf("Profile '%s', %.0f s per step\n"
+                    "%5s %9s %9s %8s %8s %6s %5s %7s %9s %9s %9s %7s\n",
+                    profileName(profile), duration, "step", "procs", "threads", "tcp", "udp",
+                    "netns", "veth", "ticks", "p50 ms", "p99 ms", "max ms", "cpu %");
+
+    for (int step = 0; step <= steps && running; ++step) {
+        StepResult r = measure(spec.scaled(static_cast<double>(step) / steps), profile, duration);
+        const LoadReport& a = r.load;
+        for (const auto& w : a.warnings) std::cerr << "warning: " << w << '\n';
+        auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+        if (csv)
+            std::printf("%d,%d,%d,%d,%d,%d,%d,%d,%llu,%llu,%llu,%llu,%.3f,%.3f\n", step,
+                        a.processes, a.threads, a.tcpSockets, a.udpSockets, a.namespaces,
+                        a.vethPairs, a.diskWorker ? 1 : 0,
+                        static_cast<unsigned long long>(r.tickUs.count()),
+                        static_cast<unsigned long long>(r.tickUs.percentile(0.50)),
+                        static_cast<unsigned long long>(r.tickUs.percentile(0.99)),
+                        static_cast<unsigned long long>(r.tickUs.max()),
+                        r.cpuPercent, r.overheadPercent);
+        else
+            std::printf("%5d %9d %9d %8d %8d %6d %5d %7llu %9.2f %9.2f %9.2f %7.2f\n", step,
+                        a.processes, a.threads, a.tcpSockets, a.udpSockets, a.namespaces,
+                        a.vethPairs, static_cast<unsigned long long>(r.tickUs.count()),
+                        ms(r.tickUs.percentile(0.50)), ms(r.tickUs.percentile(0.99)),
+                        ms(r.tickUs.max()), r.cpuPercent);
+        std::fflush(stdout);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file alloc_counter.cpp
+ * @brief Counting replacement for the global operator new.
+ *
+ * Only the scalar allocating forms are replaced; the array and nothrow
+ * forms forward to them in every standard library this project builds
+ * with, so they are counted too.
+ */
+
+#include "alloc_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local uint64_t tAllocations = 0;
+}
+
+uint64_t threadAllocations() { return tAllocations; }
+
+void* operator new(std::size_t n) {
+    ++tAllocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
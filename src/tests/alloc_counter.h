@@ -0,0 +1,25 @@
+/**
+ * @file alloc_counter.h
+ * @brief Count heap allocations made by the calling thread.
+ *
+ * alloc_counter.cpp replaces the global operator new for the whole test
+ * binary. Counts are per thread, so background threads (collector
+ * workers, the logger) do not disturb a measurement on the test thread.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief operator new calls made by this thread since it started.
+uint64_t threadAllocations();
+
+/// @brief Allocations made by this thread while the scope is alive.
+class AllocScope {
+public:
+    AllocScope() : start_(threadAllocations()) {}
+    uint64_t count() const { return threadAllocations() - start_; }
+
+private:
+    uint64_t start_;
+};
@@ -0,0 +1,130 @@
+/**
+ * @file batch_reader_tests.cpp
+ * @brief Tests for the batched procfs reader backends and the I/O counters they feed.
+ */
+
+#include <gtest/gtest.h>
+#include "core/io/batch_reader.h"
+#include "utils/io_counters.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string tempFile(const std::string& contents) {
+    std::string path = ::testing::TempDir() + "batch_reader_test.txt";
+    std::ofstream(path, std::ios::binary) << contents;
+    return path;
+}
+
+std::vector<FileRead> requests(const std::vector<std::string>& paths, std::size_t maxBytes) {
+    std::vector<FileRead> reqs(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        reqs[i].path     = paths[i];
+        reqs[i].maxBytes = maxBytes;
+    }
+    return reqs;
+}
+
+} // namespace
+
+TEST(BatchReaderTest, SyncReadsFileContents) {
+    std::string path = tempFile("hello batch\n");
+    auto reqs = requests({path}, 4096);
+    SyncBatchReader reader;
+    reader.readAll(reqs);
+    EXPECT_EQ(reqs[0].error, 0);
+    EXPECT_EQ(reqs[0].data, "hello batch\n");
+    EXPECT_EQ(reader.syscalls(), 4u);  // open, read, read (EOF), close
+    std::remove(path.c_str());
+}
+
+TEST(BatchReaderTest, MissingFileReportsErrno) {
+    auto reader = createBatchReader();
+    auto reqs = requests({"/nonexistent/batch_reader_test"}, 64);
+    reader->readAll(reqs);
+    EXPECT_EQ(reqs[0].error, ENOENT);
+    EXPECT_TRUE(reqs[0].data.empty());
+}
+
+TEST(BatchReaderTest, TruncatesToMaxBytes) {
+    std::string path = tempFile(std::string(100, 'x'));
+    for (auto backend : {BatchBackend::Sync, BatchBackend::IoUring}) {
+        auto reader = createBatchReader(backend);
+        auto reqs = requests({path}, 10);
+        reader->readAll(reqs);
+        EXPECT_EQ(reqs[0].error, 0) << reader->name();
+        EXPECT_EQ(reqs[0].data, std::string(10, 'x')) << reader->name();
+    }
+    std::remove(path.c_str());
+}
+
+TEST(IoCountersTest, ReadersReportOpensAndBytes) {
+    std::string path = tempFile(std::string(1000, 'x'));
+    std::string out;
+
+    IoUsage before = threadIoUsage();
+    ASSERT_TRUE(readFileInto(path.c_str(), out));
+    SyncBatchReader reader;
+    auto reqs = requests({path, "/nonexistent/io_counters_test"}, 4096);
+    reader.readAll(reqs);
+    IoUsage used = threadIoUsage() - before;
+
+    EXPECT_EQ(used.fileOpens, 2u);  // the missing file is not an open
+    EXPECT_GE(used.syscalls, 5u);   // three opens and two closes at least
+#ifdef __linux__
+    EXPECT_GE(used.bytesRead, 2000u);
+    EXPECT_GE(used.syscalls, 9u);   // plus two reads per file from the kernel counters
+#endif
+    std::remove(path.c_str());
+}
+
+TEST(IoCountersTest, MeasuringCostsNothing) {
+    IoUsage a = threadIoUsage();
+    IoUsage b = threadIoUsage();
+    EXPECT_EQ(b.syscalls,  a.syscalls);
+    EXPECT_EQ(b.fileOpens, a.fileOpens);
+    EXPECT_EQ(b.bytesRead, a.bytesRead);
+}
+
+#ifdef __linux__
+TEST(BatchReaderTest, BackendsAgreeOnProcFiles) {
+    // Files whose contents do not change between two back-to-back reads.
+    std::vector<std::string> paths = {
+        "/proc/self/cmdline", "/proc/1/comm", "/proc/version",
+        "/nonexistent/file", "/proc/self/limits",
+    };
+    // More requests than fit in one submission, to exercise chunking.
+    std::vector<std::string> many;
+    for (int i = 0; i < 300; ++i) many.insert(many.end(), paths.begin(), paths.end());
+
+    auto sync  = createBatchReader(BatchBackend::Sync);
+    auto uring = createBatchReader(BatchBackend::IoUring);
+    auto a = requests(many, 4096);
+    auto b = requests(many, 4096);
+    sync->readAll(a);
+    uring->readAll(b);
+
+    for (std::size_t i = 0; i < many.size(); ++i) {
+        EXPECT_EQ(a[i].error, b[i].error) << many[i];
+        EXPECT_EQ(a[i].data,  b[i].data)  << many[i];
+    }
+}
+
+TEST(BatchReaderTest, UringUsesFewerSyscalls) {
+    auto uring = createBatchReader(BatchBackend::IoUring);
+    if (std::string(uring->name()) != "io_uring")
+        GTEST_SKIP() << "io_uring unavailable";
+
+    std::vector<std::string> paths(200, "/proc/self/stat");
+    auto reqs = requests(paths, 1024);
+    uring->readAll(reqs);
+    for (const auto& r : reqs) ASSERT_EQ(r.error, 0);
+    // Three syscalls per file synchronously; a few ring entries here.
+    EXPECT_LT(uring->syscalls(), paths.size() / 10);
+}
+#endif
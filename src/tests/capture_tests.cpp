@@ -0,0 +1,301 @@
+/**
+ * @file capture_tests.cpp
+ * @brief Tests for recording reads to a capture file and replaying them.
+ */
+
+#include <gtest/gtest.h>
+#include "core/io/capture.h"
+#include "fixture_tree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> listing(const FileReader& files, const char* path) {
+    std::vector<std::string> names;
+    files.forEachEntry(path, [&](const char* name) {
+        names.emplace_back(name);
+        return true;
+    });
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+} // namespace
+
+TEST(CaptureTest, ReplayServesWhatWasRecorded) {
+    FixtureTree tree("capture");
+    const std::string capture = tree.sibling(".rmcap");
+    tree.write("/proc/version", "v1\n");
+    tree.write("/proc/loadavg", "1\n");
+    tree.write("/proc/7/stat", "7\n");
+    tree.link("/proc/7/exe", "/usr/bin/seven");
+
+    FsUsage recordedFs;
+    {
+        auto rec = createRecordingFileReader(createFileReader(tree.root()), capture);
+        ASSERT_NE(rec, nullptr);
+        std::string text;
+        rec->read("/proc/version", text);  // before the first tick, like a constructor
+
+        rec->markTick();
+        rec->read("/proc/loadavg", text);
+        listing(*rec, "/proc");
+        rec->readLink("/proc/7/exe", text);
+        EXPECT_FALSE(rec->read("/proc/missing", text));
+        ASSERT_TRUE(rec->statFs("/", recordedFs));
+
+        tree.write("/proc/loadavg", "2\n");
+        tree.remove("/proc/7");
+        rec->markTick();
+        rec->read("/proc/loadavg", text);
+        listing(*rec, "/proc");
+        EXPECT_FALSE(rec->readLink("/proc/7/exe", text));
+        EXPECT_EQ(rec->ticks(), 2u);
+    }
+
+    auto replay = loadCapture(capture);
+    std::remove(capture.c_str());
+    ASSERT_NE(replay, nullptr);
+    EXPECT_FALSE(replay->isHost());
+    EXPECT_EQ(replay->tickCount(), 2u);
+
+    std::string text;
+    ASSERT_TRUE(replay->read("/proc/version", text));
+    EXPECT_EQ(text, "v1\n");
+    EXPECT_FALSE(replay->read("/proc/loadavg", text));  // first read in tick 1
+
+    ASSERT_TRUE(replay->nextTick());
+    auto firstTick = replay->now();
+    ASSERT_TRUE(replay->read("/proc/loadavg", text));
+    EXPECT_EQ(text, "1\n");
+    EXPECT_EQ(listing(*replay, "/proc"), (std::vector<std::string>{"7", "loadavg", "version"}));
+    ASSERT_TRUE(replay->readLink("/proc/7/exe", text));
+    EXPECT_EQ(text, "/usr/bin/seven");
+    EXPECT_FALSE(replay->read("/proc/missing", text));
+    EXPECT_FALSE(replay->read("/proc/never-read", text));
+    EXPECT_FALSE(replay->read("/proc", text));  // recorded as a directory, not a file
+    FsUsage fs;
+    ASSERT_TRUE(replay->statFs("/", fs));
+    EXPECT_EQ(fs.totalBytes, recordedFs.totalBytes);
+    EXPECT_EQ(fs.freeBytes, recordedFs.freeBytes);
+
+    ASSERT_TRUE(replay->nextTick());
+    EXPECT_GE(replay->now(), firstTick);
+    ASSERT_TRUE(replay->read("/proc/loadavg", text));
+    EXPECT_EQ(text, "2\n");
+    EXPECT_EQ(listing(*replay, "/proc"), (std::vector<std::string>{"loadavg", "version"}));
+    EXPECT_FALSE(replay->readLink("/proc/7/exe", text));
+    EXPECT_FALSE(replay->nextTick());
+
+    replay->rewind();
+    EXPECT_EQ(replay->position(), 0u);
+    ASSERT_TRUE(replay->nextTick());
+    EXPECT_EQ(replay->now(), firstTick);
+}
+
+TEST(CaptureTest, UnchangedReadsAreStoredOnce) {
+    FixtureTree tree("capture_repeat");
+    const std::string capture = tree.sibling(".rmcap");
+    const std::string big(64 * 1024, 'x');
+    tree.write("/proc/big", big);
+
+    uint64_t written = 0;
+    {
+        auto rec = createRecordingFileReader(createFileReader(tree.root()), capture);
+        ASSERT_NE(rec, nullptr);
+        std::string text;
+        for (int i = 0; i < 100; ++i) {
+            rec->markTick();
+            rec->read("/proc/big", text);
+        }
+        written = rec->bytesWritten();
+    }
+    EXPECT_LT(written, big.size() + 100 * 32);
+
+    auto replay = loadCapture(capture);
+    std::remove(capture.c_str());
+    ASSERT_NE(replay, nullptr);
+    std::string text;
+    while (replay->nextTick()) {
+        ASSERT_TRUE(replay->read("/proc/big", text));
+        ASSERT_EQ(text.size(), big.size());
+        EXPECT_EQ(replay->tickBytes(), big.size());
+    }
+    EXPECT_EQ(replay->position(), 100u);
+}
+
+TEST(CaptureTest, InvalidCapturesAreRejected) {
+    EXPECT_EQ(loadCapture("/nonexistent/capture.rmcap"), nullptr);
+
+    ReplayFileReader replay("memory");
+    EXPECT_FALSE(replay.load("not a capture"));
+    EXPECT_EQ(replay.tickCount(), 0u);
+
+    FixtureTree tree("capture_truncated");
+    const std::string capture = tree.sibling(".rmcap");
+    tree.write("/proc/loadavg", "1\n");
+    {
+        auto rec = createRecordingFileReader(createFileReader(tree.root()), capture);
+        ASSERT_NE(rec, nullptr);
+        std::string text;
+        rec->markTick();
+        rec->read("/proc/loadavg", text);
+    }
+    auto size = std::filesystem::file_size(capture);
+    std::filesystem::resize_file(capture, size - 1);
+    EXPECT_EQ(loadCapture(capture), nullptr);
+    std::remove(capture.c_str());
+}
+
+#ifdef __linux__
+#include "core/cpu/cpu_linux.h"
+#include "core/memory/memory_linux.h"
+#include "core/process/process_linux.h"
+
+namespace {
+
+/// Write tick @p t of a small machine whose counters advance every tick.
+void writeTick(const FixtureTree& tree, int t) {
+    auto n = [t](int base, int step) { return std::to_string(base + step * t); };
+    tree.write("/proc/stat",
+               "cpu  " + n(800, 70) + " 0 " + n(400, 20) + " " + n(8000, 110) + " 0 0 0 0 0 0\n"
+               "cpu0 " + n(400, 50) + " 0 " + n(200, 10) + " " + n(4000, 40) + " 0 0 0 0 0 0\n"
+               "cpu1 " + n(400, 20) + " 0 " + n(200, 10) + " " + n(4000, 70) + " 0 0 0 0 0 0\n"
+               "intr " + n(5000, 300) + "\nctxt " + n(9000, 900) + "\nprocesses 42\n");
+    tree.write("/proc/loadavg", "1.00 0.50 0.25 3/150 999\n");
+    tree.write("/proc/meminfo",
+               "MemTotal:       16000000 kB\nMemFree:         2000000 kB\n"
+               "MemAvailable:    " + n(8000000, -100000) + " kB\n");
+    tree.write("/proc/vmstat", "pgfault " + n(1000, 250) + "\n");
+    for (int pid : {1, 200}) {
+        std::string dir = "/proc/" + std::to_string(pid);
+        tree.write(dir + "/stat", std::to_string(pid) + " (fixture) S 1 1 1 0 -1 4194560 100 0 0 0 "
+                   + n(25, 7 * pid % 13) + " 5 0 0 20 0 3 0 100 1000000 200\n");
+        tree.write(dir + "/status", "Name:\tfixture\nUid:\t0\t0\t0\t0\nVmRSS:\t1600 kB\n");
+    }
+}
+
+} // namespace
+
+TEST(CaptureTest, ReplayedCollectorsMatchTheRecording) {
+    FixtureTree tree("capture_collectors");
+    const std::string capture = tree.sibling(".rmcap");
+    writeTick(tree, 0);
+
+    struct Sample {
+        float cpu, ctxt, memory, faults;
+        std::vector<float> procs;
+    };
+    auto sample = [](LinuxCPU& cpu, LinuxMemory& memory, LinuxProcessManager& pm) {
+        cpu.update();
+        memory.update();
+        pm.update();
+        Sample s{cpu.snapshot().totalUsage, cpu.snapshot().contextSwitchesPerSec,
+                 memory.snapshot().usagePercent, memory.snapshot().pageFaultsPerSec, {}};
+        auto p = pm.snapshot();
+        std::sort(p.processes.begin(), p.processes.end(),
+                  [](const ProcessInfo& a, const ProcessInfo& b) { return a.pid < b.pid; });
+        for (const auto& info : p.processes) s.procs.push_back(info.cpuPercent);
+        return s;
+    };
+
+    std::vector<Sample> live;
+    {
+        auto rec = createRecordingFileReader(createFileReader(tree.root()), capture);
+        ASSERT_NE(rec, nullptr);
+        LinuxCPU cpu(rec);
+        LinuxMemory memory(rec);
+        LinuxProcessManager pm(BatchBackend::Sync, rec);
+        for (int t = 1; t <= 3; ++t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            writeTick(tree, t);
+            rec->markTick();
+            live.push_back(sample(cpu, memory, pm));
+        }
+    }
+    ASSERT_GT(live.back().ctxt, 0.0f);
+    ASSERT_EQ(live.back().procs.size(), 2u);
+
+    auto replay = loadCapture(capture);
+    std::remove(capture.c_str());
+    ASSERT_NE(replay, nullptr);
+    LinuxCPU cpu(replay);
+    LinuxMemory memory(replay);
+    LinuxProcessManager pm(BatchBackend::Sync, replay);
+    for (const auto& expected : live) {
+        ASSERT_TRUE(replay->nextTick());
+        Sample s = sample(cpu, memory, pm);
+        EXPECT_FLOAT_EQ(s.cpu, expected.cpu);
+        EXPECT_FLOAT_EQ(s.ctxt, expected.ctxt);
+        EXPECT_FLOAT_EQ(s.memory, expected.memory);
+        EXPECT_FLOAT_EQ(s.faults, expected.faults);
+        EXPECT_EQ(s.procs, expected.procs);
+    }
+}
+
+TEST(CaptureTest, ModulesReplayOnlyOnTheTicksTheyRan) {
+    FixtureTree tree("capture_periods");
+    const std::string capture = tree.sibling(".rmcap");
+    writeTick(tree, 0);
+
+    // CPU runs every tick and processes every second tick, as under the
+    // standard profile; the capture notes which ran.
+    constexpr unsigned kCpu = 0, kProcess = 1;
+    std::vector<float> liveCpu;
+    std::vector<std::vector<float>> liveProcs;
+    auto procPercents = [](const LinuxProcessManager& pm) {
+        auto p = pm.snapshot();
+        std::sort(p.processes.begin(), p.processes.end(),
+                  [](const ProcessInfo& a, const ProcessInfo& b) { return a.pid < b.pid; });
+        std::vector<float> out;
+        for (const auto& info : p.processes) out.push_back(info.cpuPercent);
+        return out;
+    };
+    {
+        auto rec = createRecordingFileReader(createFileReader(tree.root()), capture);
+        ASSERT_NE(rec, nullptr);
+        LinuxCPU cpu(rec);
+        LinuxProcessManager pm(BatchBackend::Sync, rec);
+        for (int t = 1; t <= 6; ++t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            writeTick(tree, t);
+            rec->markTick();
+            rec->markUpdate(kCpu);
+            cpu.update();
+            liveCpu.push_back(cpu.snapshot().totalUsage);
+            if (t % 2 == 0) {
+                rec->markUpdate(kProcess);
+                pm.update();
+                liveProcs.push_back(procPercents(pm));
+            }
+        }
+    }
+    ASSERT_EQ(liveProcs.size(), 3u);
+    ASSERT_GT(liveProcs.back().size(), 0u);
+
+    auto replay = loadCapture(capture);
+    std::remove(capture.c_str());
+    ASSERT_NE(replay, nullptr);
+    LinuxCPU cpu(replay);
+    LinuxProcessManager pm(BatchBackend::Sync, replay);
+    std::size_t cpuTicks = 0, procTicks = 0;
+    while (replay->nextTick()) {
+        ASSERT_TRUE(replay->updated(kCpu));
+        cpu.update();
+        EXPECT_FLOAT_EQ(cpu.snapshot().totalUsage, liveCpu[cpuTicks++]);
+        if (!replay->updated(kProcess)) continue;
+        pm.update();
+        EXPECT_EQ(procPercents(pm), liveProcs[procTicks++]) << "tick " << replay->position();
+    }
+    EXPECT_EQ(cpuTicks, 6u);
+    EXPECT_EQ(procTicks, 3u);
+    EXPECT_FALSE(replay->updated(7));
+}
+#endif
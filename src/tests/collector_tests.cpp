@@ -0,0 +1,578 @@
+/**
+ * @file collector_tests.cpp
+ * @brief Tests for collection profiles, demand-driven interest, tick scheduling, snapshot publishing and the Collector.
+ */
+
+#include <gtest/gtest.h>
+#include "core/collector/collector.h"
+#include "core/io/batch_reader.h"
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <string>
+
+TEST(CollectionProfileTest, NamesRoundTrip) {
+    for (auto k : {ProfileKind::Minimal, ProfileKind::Standard,
+                   ProfileKind::Full, ProfileKind::Diagnostics}) {
+        ProfileKind parsed = ProfileKind::Standard;
+        ASSERT_TRUE(profileFromName(profileName(k), parsed));
+        EXPECT_EQ(parsed, k);
+    }
+    ProfileKind parsed;
+    EXPECT_TRUE(profileFromName("MINIMAL", parsed));
+    EXPECT_EQ(parsed, ProfileKind::Minimal);
+    EXPECT_FALSE(profileFromName("turbo", parsed));
+}
+
+TEST(CollectionProfileTest, MinimalSkipsExpensiveCollectors) {
+    auto p = makeProfile(ProfileKind::Minimal);
+    EXPECT_TRUE(p.schedule(ModuleId::Cpu).enabled);
+    EXPECT_TRUE(p.schedule(ModuleId::Memory).enabled);
+    EXPECT_FALSE(p.schedule(ModuleId::Process).enabled);
+    EXPECT_FALSE(p.schedule(ModuleId::Gpu).enabled);
+    EXPECT_FALSE(p.networkConnections);
+    EXPECT_FALSE(p.memoryTopProcesses);
+    EXPECT_GT(p.cpuBudgetPercent, 0.0f);
+}
+
+TEST(CollectionProfileTest, FullRunsEverything) {
+    auto p = makeProfile(ProfileKind::Full);
+    for (const auto& m : p.modules) {
+        EXPECT_TRUE(m.enabled);
+        EXPECT_EQ(m.period.count(), 1000);
+    }
+    EXPECT_TRUE(p.networkConnections);
+    EXPECT_TRUE(p.processDetails);
+}
+
+TEST(CollectorTest, MinimalOmitsDisabledModules) {
+    Collector c(ProfileKind::Minimal);
+    ASSERT_TRUE(c.waitForModules(std::chrono::seconds(30)));
+    auto md = c.collect();
+    EXPECT_TRUE(md.process.processes.empty());
+    EXPECT_TRUE(md.network.connections.empty());
+    EXPECT_GT(md.cpu.logicalCores, 0);
+    EXPECT_GT(md.memory.totalBytes, 0u);
+}
+
+TEST(CollectorTest, RuntimeProfileSwitch) {
+    Collector c(ProfileKind::Minimal);
+    ASSERT_TRUE(c.waitForModules(std::chrono::seconds(30)));
+    auto sub = c.interests().subscribe(DataCategory::Processes);
+    c.collect();
+    c.setProfile(ProfileKind::Full);
+    EXPECT_EQ(c.profile().kind, ProfileKind::Full);
+    auto md = c.collect();
+    EXPECT_FALSE(md.process.processes.empty());
+    EXPECT_EQ(c.tickInterval().count(), 1000);
+}
+
+TEST(CollectorTest, BudgetStretchesMostExpensiveModule) {
+    // A budget no real collector can meet must make the Collector back off.
+    auto p = makeProfile(ProfileKind::Diagnostics);
+    for (auto& m : p.modules) m.period = std::chrono::milliseconds(1);
+    p.cpuBudgetPercent = 1e-6f;
+
+    Collector c;
+    c.setProfile(p);
+    MetricData md;
+    for (int i = 0; i < 5; ++i) {
+        md = c.collect();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GT(c.overheadPercent(), 0.0f);
+
+    // Exactly one module (the costliest) is stretched per adjustment.
+    int degraded = 0;
+    float worstCost = 0.0f;
+    for (const auto& m : md.collector.modules) worstCost = std::max(worstCost, m.cpuMsPerRun);
+    for (const auto& m : md.collector.modules) {
+        if (!m.degraded) continue;
+        ++degraded;
+        EXPECT_GT(m.periodMs, m.basePeriodMs);
+    }
+    EXPECT_EQ(degraded, 1);
+    EXPECT_GT(worstCost, 0.0f);
+    EXPECT_FLOAT_EQ(md.collector.budgetPercent, 1e-6f);
+    EXPECT_EQ(md.collector.modules.size(), kModuleCount);
+
+    // Removing the budget restores the configured periods.
+    p.cpuBudgetPercent = 0.0f;
+    c.setProfile(p);
+    for (std::size_t i = 0; i < kModuleCount; ++i)
+        EXPECT_FLOAT_EQ(c.periodScale(static_cast<ModuleId>(i)), 1.0f);
+}
+
+TEST(CollectorTest, StatsReportProfileAndCost) {
+    Collector c(ProfileKind::Minimal);
+    c.collect();
+    auto md = c.collect();
+    EXPECT_EQ(md.collector.profile, "minimal");
+    EXPECT_GE(md.collector.overheadPercent, 0.0f);
+    const auto& cpu = md.collector.modules[static_cast<std::size_t>(ModuleId::Cpu)];
+    EXPECT_EQ(cpu.name, "CPU");
+    EXPECT_TRUE(cpu.enabled);
+    EXPECT_GE(cpu.cpuMsPerRun, 0.0f);
+    EXPECT_FALSE(md.collector.modules[static_cast<std::size_t>(ModuleId::Gpu)].enabled);
+}
+
+TEST(CollectorTest, UpdatesAreTimedPerModule) {
+    Collector c(ProfileKind::Minimal, Collector::platformModules());
+    c.collect();
+    auto md = c.collect();
+    const auto& cpu = md.collector.modules[static_cast<std::size_t>(ModuleId::Cpu)];
+    EXPECT_GE(cpu.updates, 1u);
+    EXPECT_EQ(cpu.updateUs.count(), cpu.updates);
+#ifdef __linux__
+    EXPECT_GT(cpu.syscalls, 0u);    // /proc/stat at least
+    EXPECT_GT(cpu.bytesRead, 0u);
+#endif
+    const auto& gpu = md.collector.modules[static_cast<std::size_t>(ModuleId::Gpu)];
+    EXPECT_EQ(gpu.updates, 0u);     // disabled under Minimal
+    EXPECT_TRUE(md.collector.stages.empty());  // no pipeline
+}
+
+TEST(CollectorTest, UpdateObserverSeesTheModulesEachTickRuns) {
+    Collector c(ProfileKind::Minimal, Collector::platformModules());
+    std::vector<ModuleId> ran;
+    c.setUpdateObserver([&](ModuleId id) { ran.push_back(id); });
+
+    c.collect();
+    std::sort(ran.begin(), ran.end());
+    EXPECT_EQ(ran, (std::vector<ModuleId>{ModuleId::Cpu, ModuleId::Memory, ModuleId::Network,
+                                          ModuleId::Disk, ModuleId::SystemInfo}));
+
+    // Nothing is due again for another two seconds.
+    ran.clear();
+    c.collect();
+    EXPECT_TRUE(ran.empty());
+}
+
+TEST(InterestRegistryTest, SubscriptionIsRaii) {
+    InterestRegistry reg;
+    EXPECT_FALSE(reg.wanted(DataCategory::Connections));
+    {
+        auto a = reg.subscribe(DataCategory::Connections);
+        auto b = reg.subscribe(DataCategory::Connections);
+        EXPECT_EQ(reg.subscribers(DataCategory::Connections), 2);
+        auto moved = std::move(a);
+        EXPECT_FALSE(a.active());
+        EXPECT_EQ(reg.subscribers(DataCategory::Connections), 2);
+        b.reset();
+        EXPECT_EQ(reg.subscribers(DataCategory::Connections), 1);
+    }
+    EXPECT_FALSE(reg.wanted(DataCategory::Connections));
+}
+
+TEST(InterestRegistryTest, HoldFollowsVisibility) {
+    InterestRegistry reg;
+    InterestRegistry::Subscription sub;
+    reg.hold(sub, DataCategory::Processes, true);
+    reg.hold(sub, DataCategory::Processes, true);
+    EXPECT_EQ(reg.subscribers(DataCategory::Processes), 1);
+    reg.hold(sub, DataCategory::Processes, false);
+    EXPECT_EQ(reg.subscribers(DataCategory::Processes), 0);
+}
+
+TEST(InterestRegistryTest, AlertMetricCategories) {
+    DataCategory c;
+    EXPECT_TRUE(categoryForMetric(AlertMetric::CpuTemp, c));
+    EXPECT_EQ(c, DataCategory::CpuSensors);
+    EXPECT_FALSE(categoryForMetric(AlertMetric::CpuUsage, c));
+}
+
+TEST(CollectorTest, UnobservedCategoriesAreSkipped) {
+    Collector c(ProfileKind::Full);
+    ASSERT_TRUE(c.waitForModules(std::chrono::seconds(30)));
+    auto md = c.collect();
+    EXPECT_TRUE(md.process.processes.empty());
+    EXPECT_TRUE(md.network.connections.empty());
+
+    {
+        auto sub = c.interests().subscribe(DataCategory::Processes);
+        md = c.collect();
+        EXPECT_FALSE(md.process.processes.empty());
+        for (const auto& p : md.process.processes) {
+            EXPECT_TRUE(p.cmdline.empty());  // details not subscribed
+        }
+    }
+
+    md = c.collect();
+    EXPECT_TRUE(md.process.processes.empty());
+}
+
+TEST(CollectorTest, DiagnosticsIgnoresInterest) {
+    Collector c(ProfileKind::Diagnostics);
+    ASSERT_TRUE(c.waitForModules(std::chrono::seconds(30)));
+    auto md = c.collect();
+    EXPECT_FALSE(md.process.processes.empty());
+}
+
+TEST(CollectorTest, NewSubscriberWakesWait) {
+    Collector c(ProfileKind::Full);
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread waiter([&] { c.waitFor(std::chrono::seconds(10)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto sub = c.interests().subscribe(DataCategory::Connections);
+    waiter.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(5));
+}
+
+TEST(ModuleWorkerTest, DeadlineDoesNotWaitForSlowJob) {
+    ModuleWorker w("test");
+    std::atomic<bool> release{false};
+    ASSERT_TRUE(w.submit([&] {
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }));
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(w.waitUntil(t0 + std::chrono::milliseconds(20)));
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(1));
+    EXPECT_FALSE(w.submit([] {}));  // still busy
+    EXPECT_EQ(w.completed(), 0u);
+
+    release = true;
+    EXPECT_TRUE(w.waitUntil(std::chrono::steady_clock::now() + std::chrono::seconds(5)));
+    EXPECT_EQ(w.completed(), 1u);
+    EXPECT_TRUE(w.submit([] {}));
+    EXPECT_TRUE(w.shutdown(std::chrono::seconds(5)));
+}
+
+TEST(ModuleWorkerTest, JobsAreTimedAndIoCounted) {
+    ModuleWorker w("test");
+    auto wait = [&] { return w.waitUntil(std::chrono::steady_clock::now() + std::chrono::seconds(5)); };
+    ASSERT_TRUE(w.submit([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        std::string s;
+        readFileInto("/proc/self/stat", s);
+    }));
+    ASSERT_TRUE(wait());
+    ASSERT_TRUE(w.submit([] {}));
+    ASSERT_TRUE(wait());
+
+    Histogram h = w.latency();
+    EXPECT_EQ(h.count(), 2u);
+    EXPECT_GE(h.max(), 3000u);
+#ifdef __linux__
+    EXPECT_EQ(w.io().fileOpens, 1u);
+    EXPECT_GT(w.io().bytesRead, 0u);
+#endif
+
+    w.resetUsage();
+    EXPECT_EQ(w.latency().count(), 0u);
+    EXPECT_EQ(w.io().fileOpens, 0u);
+}
+
+namespace {
+
+/// Disk module whose update() blocks like statvfs on a dead NFS mount.
+class BlockingDisk : public Disk {
+public:
+    explicit BlockingDisk(std::atomic<bool>& blocked) : blocked_(blocked) {}
+    void update() override {
+        while (blocked_) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++updates_;
+    }
+    DiskSnapshot snapshot() const override {
+        DiskSnapshot s;
+        s.disks.resize(updates_);
+        return s;
+    }
+private:
+    std::atomic<bool>& blocked_;
+    std::atomic<int>   updates_{0};
+};
+
+} // namespace
+
+TEST(CollectorTest, SlowModuleMissesDeadlineWithoutStallingTick) {
+    std::atomic<bool> blocked{false};
+    auto mods = Collector::platformModules();
+    mods.disk = std::make_unique<BlockingDisk>(blocked);
+
+    auto p = makeProfile(ProfileKind::Minimal);
+    p.cpuBudgetPercent = 0.0f;
+    for (auto& m : p.modules) m.period = std::chrono::milliseconds(1);
+    p.schedule(ModuleId::Disk).deadline = std::chrono::milliseconds(50);
+
+    Collector c(ProfileKind::Minimal, std::move(mods));
+    c.setProfile(p);
+    auto md = c.collect();
+    ASSERT_EQ(md.disk.disks.size(), 1u);
+    const auto disk = static_cast<std::size_t>(ModuleId::Disk);
+    EXPECT_FALSE(md.collector.modules[disk].stale);
+
+    blocked = true;
+    auto t0 = std::chrono::steady_clock::now();
+    md = c.collect();
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(2));
+    EXPECT_TRUE(md.collector.modules[disk].stale);
+    EXPECT_EQ(md.collector.modules[disk].deadlineMisses, 1u);
+    EXPECT_EQ(md.disk.disks.size(), 1u);  // previous snapshot kept
+    EXPECT_GT(md.cpu.logicalCores, 0);    // other modules unaffected
+    EXPECT_FALSE(md.collector.modules[static_cast<std::size_t>(ModuleId::Cpu)].stale);
+
+    // Still stuck: not dispatched again, but the miss is counted.
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    md = c.collect();
+    EXPECT_EQ(md.collector.modules[disk].deadlineMisses, 2u);
+
+    blocked = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    md = c.collect();
+    EXPECT_FALSE(md.collector.modules[disk].stale);
+    EXPECT_GE(md.disk.disks.size(), 2u);
+}
+
+TEST(TickSchedulerTest, DeadlinesFollowAbsoluteGrid) {
+    using namespace std::chrono;
+    TickScheduler s(milliseconds(100));
+    TickScheduler::Clock::time_point t0{seconds(10)};
+    s.tick(t0);
+    EXPECT_EQ(s.deadline(), t0 + milliseconds(100));
+
+    // Waking 7 ms late does not shift later deadlines.
+    EXPECT_TRUE(s.beforeWait(t0 + milliseconds(20)));
+    s.tick(t0 + milliseconds(107));
+    EXPECT_EQ(s.deadline(), t0 + milliseconds(200));
+    EXPECT_EQ(s.stats().jitterUs.count(), 1u);
+    EXPECT_EQ(s.stats().jitterUs.max(), 7000u);
+    EXPECT_EQ(s.stats().missedTicks, 0u);
+}
+
+TEST(TickSchedulerTest, OverrunAndSkipPolicy) {
+    using namespace std::chrono;
+    TickScheduler s(milliseconds(100), CatchUpPolicy::Skip);
+    TickScheduler::Clock::time_point t0{seconds(10)};
+    s.tick(t0);
+
+    // The tick's work took 350 ms: deadlines at 100, 200 and 300 passed.
+    EXPECT_FALSE(s.beforeWait(t0 + milliseconds(350)));
+    EXPECT_EQ(s.stats().overruns, 1u);
+    s.tick(t0 + milliseconds(350));
+    EXPECT_EQ(s.stats().missedTicks, 2u);
+    EXPECT_EQ(s.deadline(), t0 + milliseconds(400));
+    EXPECT_EQ(s.stats().jitterUs.count(), 0u);  // lateness came from the overrun
+}
+
+TEST(TickSchedulerTest, BurstCatchesUpThenReanchorRestarts) {
+    using namespace std::chrono;
+    TickScheduler::Clock::time_point t0{seconds(10)};
+
+    TickScheduler burst(milliseconds(100), CatchUpPolicy::Burst);
+    burst.tick(t0);
+    burst.tick(t0 + milliseconds(350));      // serves the 100 ms tick
+    EXPECT_EQ(burst.deadline(), t0 + milliseconds(200));
+    EXPECT_FALSE(burst.beforeWait(t0 + milliseconds(351)));
+    EXPECT_EQ(burst.stats().overruns, 0u);   // catching up is not an overrun
+    burst.tick(t0 + milliseconds(351));
+    burst.tick(t0 + milliseconds(352));
+    EXPECT_EQ(burst.deadline(), t0 + milliseconds(400));
+    EXPECT_EQ(burst.stats().missedTicks, 0u);
+    EXPECT_EQ(burst.stats().ticks, 4u);
+
+    TickScheduler re(milliseconds(100), CatchUpPolicy::Reanchor);
+    re.tick(t0);
+    re.tick(t0 + milliseconds(350));
+    EXPECT_EQ(re.stats().missedTicks, 2u);
+    EXPECT_EQ(re.deadline(), t0 + milliseconds(450));
+}
+
+TEST(TickSchedulerTest, EarlyWakeDoesNotAdvance) {
+    using namespace std::chrono;
+    TickScheduler s(milliseconds(100));
+    TickScheduler::Clock::time_point t0{seconds(10)};
+    s.tick(t0);
+    s.tick(t0 + milliseconds(30));
+    EXPECT_EQ(s.stats().earlyTicks, 1u);
+    EXPECT_EQ(s.deadline(), t0 + milliseconds(100));
+}
+
+TEST(TickSchedulerTest, PolicyNamesRoundTrip) {
+    for (auto k : {CatchUpPolicy::Skip, CatchUpPolicy::Burst, CatchUpPolicy::Reanchor}) {
+        CatchUpPolicy parsed = CatchUpPolicy::Skip;
+        ASSERT_TRUE(catchUpFromName(catchUpName(k), parsed));
+        EXPECT_EQ(parsed, k);
+    }
+    CatchUpPolicy parsed;
+    EXPECT_FALSE(catchUpFromName("later", parsed));
+}
+
+TEST(CollectorTest, SamplesCarryTimestamps) {
+    Collector c(ProfileKind::Minimal);
+    auto before = std::chrono::system_clock::now();
+    auto a = c.collect();
+    c.waitNextTick();
+    auto b = c.collect();
+    EXPECT_GE(a.timestamp, before);
+    EXPECT_GT(b.elapsedSec, a.elapsedSec);
+    const auto& tk = b.collector.ticks;
+    // A kernel event (e.g. PSI) may legitimately cut the wait short.
+    EXPECT_EQ(tk.ticks + tk.earlyTicks, 2u);
+    if (tk.earlyTicks == 0) {
+        EXPECT_GE(b.elapsedSec - a.elapsedSec, 1.9);  // minimal ticks every 2 s
+    }
+    EXPECT_EQ(tk.catchUp, "skip");
+}
+
+TEST(EventLoopTest, WakeEndsWaitAndIsRemembered) {
+    auto loop = createEventLoop();
+    auto t0 = std::chrono::steady_clock::now();
+    loop->wake();  // before anyone waits
+    loop->runUntil(t0 + std::chrono::seconds(10));
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(5));
+
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop->wake();
+    });
+    loop->runUntil(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    waker.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(5));
+}
+
+TEST(EventLoopTest, DeadlineIsAccurate) {
+    auto loop = createEventLoop();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(30);
+    loop->runUntil(deadline);
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_GE(now, deadline);
+    EXPECT_LT(now - deadline, std::chrono::milliseconds(500));
+}
+
+#ifdef __linux__
+#include <unistd.h>
+
+TEST(EventLoopTest, DispatchesReadyDescriptors) {
+    auto loop = createEventLoop();
+    ASSERT_TRUE(loop->supportsFds());
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    int calls = 0;
+    ASSERT_TRUE(loop->addFd(fds[0], EventLoop::Readable, [&](uint32_t ev) {
+        EXPECT_TRUE(ev & EventLoop::Readable);
+        char c;
+        EXPECT_EQ(read(fds[0], &c, 1), 1);
+        ++calls;
+        loop->wake();
+    }));
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+    loop->runUntil(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    EXPECT_EQ(calls, 1);
+
+    loop->removeFd(fds[0]);
+    ASSERT_EQ(write(fds[1], "y", 1), 1);
+    loop->runUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+    EXPECT_EQ(calls, 1);
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+TEST(SnapshotChannelTest, PublishBumpsVersionAndShares) {
+    SnapshotChannel<std::vector<int>> ch;
+    EXPECT_EQ(ch.version(), 0u);
+    EXPECT_EQ(ch.latest(), nullptr);
+
+    EXPECT_EQ(ch.publish({1, 2, 3}), 1u);
+    uint64_t v = 0;
+    auto a = ch.latest(&v);
+    auto b = ch.latest();
+    EXPECT_EQ(v, 1u);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a.get(), b.get());  // readers share one copy
+    EXPECT_EQ(a->size(), 3u);
+
+    ch.publish({4});
+    EXPECT_EQ(ch.version(), 2u);
+    EXPECT_EQ(a->size(), 3u);     // a held value is never modified
+}
+
+TEST(SnapshotChannelTest, WaitForVersionWakesOnPublish) {
+    using namespace std::chrono;
+    SnapshotChannel<int> ch;
+    auto t0 = steady_clock::now();
+    EXPECT_EQ(ch.waitForVersion(0, milliseconds(20)), 0u);  // times out
+    EXPECT_GE(steady_clock::now() - t0, milliseconds(15));
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        ch.publish(7);
+    });
+    t0 = steady_clock::now();
+    EXPECT_EQ(ch.waitForVersion(0, seconds(10)), 1u);
+    EXPECT_LT(steady_clock::now() - t0, seconds(5));
+    producer.join();
+
+    // Already newer: no wait at all.
+    EXPECT_EQ(ch.waitForVersion(0, seconds(10)), 1u);
+}
+
+TEST(SnapshotChannelTest, CloseReleasesWaiters) {
+    using namespace std::chrono;
+    SnapshotChannel<int> ch;
+    std::thread closer([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        ch.close();
+    });
+    auto t0 = steady_clock::now();
+    EXPECT_EQ(ch.waitForVersion(0, seconds(10)), 0u);
+    EXPECT_LT(steady_clock::now() - t0, seconds(5));
+    closer.join();
+}
+
+TEST(CollectorTest, CollectPublishesVersionedSamples) {
+    Collector c(ProfileKind::Minimal);
+    EXPECT_EQ(c.version(), 0u);
+    auto a = c.collect();
+    auto b = c.collect();
+    EXPECT_EQ(a.version, 1u);
+    EXPECT_EQ(b.version, 2u);
+    EXPECT_EQ(c.version(), 2u);
+
+    uint64_t v = 0;
+    auto latest = c.snapshots().latest(&v);
+    ASSERT_NE(latest, nullptr);
+    EXPECT_EQ(v, 2u);
+    EXPECT_EQ(latest->version, 2u);
+    EXPECT_EQ(latest->elapsedSec, b.elapsedSec);
+}
+
+TEST(CollectorTest, ModulesStartInBackground) {
+    Collector c(ProfileKind::Full);
+    // Whatever is not constructed yet is reported, not waited for.
+    auto md = c.collect();
+    ASSERT_EQ(md.collector.modules.size(), kModuleCount);
+    for (const auto& m : md.collector.modules) {
+        if (!m.ready) {
+            EXPECT_EQ(m.readyMs, 0.0f);
+        }
+    }
+
+    ASSERT_TRUE(c.waitForModules(std::chrono::seconds(30)));
+    md = c.collect();
+    for (std::size_t i = 0; i < kModuleCount; ++i) {
+        EXPECT_TRUE(md.collector.modules[i].ready) << md.collector.modules[i].name;
+        EXPECT_TRUE(c.ready(static_cast<ModuleId>(i)));
+    }
+    EXPECT_GT(md.cpu.logicalCores, 0);
+    EXPECT_NE(c.processManager(), nullptr);
+
+    // Complete once every enabled module has finished an update().
+    for (int i = 0; i < 20 && md.collector.firstCompleteMs == 0.0f; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        md = c.collect();
+    }
+    EXPECT_GT(md.collector.firstCompleteMs, 0.0f);
+}
+
+TEST(CollectorTest, SuppliedModulesAreReadyAtOnce) {
+    Collector c(ProfileKind::Minimal, Collector::Modules{});
+    for (std::size_t i = 0; i < kModuleCount; ++i)
+        EXPECT_TRUE(c.ready(static_cast<ModuleId>(i)));
+    EXPECT_TRUE(c.waitForModules(std::chrono::seconds(0)));
+    auto md = c.collect();
+    EXPECT_GT(md.collector.firstCompleteMs, 0.0f);  // nothing to wait for
+}
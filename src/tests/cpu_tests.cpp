@@ -55,3 +55,30 @@ TEST_F(CpuTest, AverageAndHighest) {
     EXPECT_LE(s.averageUsage, 100.0f);
     EXPECT_GE(s.highestUsage, 0.0f);
 }
+
+#ifdef __linux__
+#include "core/cpu/cpu_linux.h"
+#include "alloc_counter.h"
+#include "syscall_counter.h"
+
+TEST(CpuBudgetTest, SteadyStateTickDoesNotAllocate) {
+    for (bool sensors : {false, true}) {
+        LinuxCPU cpu;
+        cpu.setSensorDetail(sensors);
+        for (int i = 0; i < 3; ++i) cpu.update();  // grow buffers, find the temperature input
+
+        AllocScope allocs;
+        SyscallScope io;
+        cpu.update();
+        EXPECT_EQ(allocs.count(), 0u) << "sensors=" << sensors;
+
+        // /proc/stat, /proc/loadavg, /proc/self/task and the first core's
+        // cpufreq (or /proc/cpuinfo without cpufreq); with sensors, every
+        // core's cpufreq and the temperature input instead.
+        const auto cores = static_cast<uint64_t>(cpu.snapshot().logicalCores);
+        EXPECT_LE(io.opens(), sensors ? 5u + cores : 5u) << "sensors=" << sensors;
+        // Per file: open, close, one read per chunk and the empty read at EOF.
+        EXPECT_LE(io.syscalls(), 4 * io.opens() + io.bytesRead() / 2048) << "sensors=" << sensors;
+    }
+}
+#endif
@@ -7,6 +7,8 @@
 #include "core/database/database.h"
 #include <sqlite3.h>
 #include <filesystem>
+#include <string>
+#include <vector>
 
 class DatabaseTest : public ::testing::Test {
 protected:
@@ -41,9 +43,11 @@ TEST_F(DatabaseTest, InitCreatesTables) {
     EXPECT_TRUE(tableExists("cpu_metrics"));
     EXPECT_TRUE(tableExists("memory_metrics"));
     EXPECT_TRUE(tableExists("network_metrics"));
-    EXPECT_TRUE(tableExists("disk_metrics"));
+    EXPECT_TRUE(tableExists("disk_samples"));
+    EXPECT_TRUE(tableExists("labels"));
     EXPECT_TRUE(tableExists("gpu_metrics"));
     EXPECT_TRUE(tableExists("alert_events"));
+    EXPECT_TRUE(tableExists("collector_stats"));
 
     sqlite3_close(raw);
 }
@@ -75,3 +79,105 @@ TEST_F(DatabaseTest, InsertAndRetrieveCpu) {
     sqlite3_finalize(stmt);
     sqlite3_close(raw);
 }
+
+namespace {
+
+/// Rows of "SELECT device, mount_point, fs_type FROM disk_metrics".
+std::vector<std::string> diskRows(const std::string& path) {
+    std::vector<std::string> rows;
+    sqlite3* raw = nullptr;
+    sqlite3_open(path.c_str(), &raw);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(raw, "SELECT device, mount_point, fs_type FROM disk_metrics ORDER BY id;",
+                       -1, &stmt, nullptr);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::string row;
+        for (int i = 0; i < 3; ++i) {
+            auto* t = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+            row += (i ? "|" : "") + std::string(t ? t : "NULL");
+        }
+        rows.push_back(row);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(raw);
+    return rows;
+}
+
+int64_t scalar(const std::string& path, const char* sql) {
+    sqlite3* raw = nullptr;
+    sqlite3_open(path.c_str(), &raw);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(raw, sql, -1, &stmt, nullptr);
+    int64_t v = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : -1;
+    sqlite3_finalize(stmt);
+    sqlite3_close(raw);
+    return v;
+}
+
+} // namespace
+
+TEST_F(DatabaseTest, DiskStringsAreDictionaryEncoded) {
+    MetricData md{};
+    DiskInfo a, b;
+    a.device = "/dev/sda1"; a.mountPoint = "/";     a.fsType = "ext4";
+    b.device = "/dev/sdb1"; b.mountPoint = "/home"; b.fsType = "ext4";
+    md.disk.disks = {a, b};
+    db->insertSnapshot(md);
+    db->insertSnapshot(md);
+
+    auto rows = diskRows(dbPath);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0], "/dev/sda1|/|ext4");
+    EXPECT_EQ(rows[3], "/dev/sdb1|/home|ext4");
+    // Five distinct strings, each stored once however many rows use it.
+    EXPECT_EQ(scalar(dbPath, "SELECT COUNT(*) FROM labels;"), 5);
+}
+
+TEST_F(DatabaseTest, CollectorStatsAreOptional) {
+    MetricData md{};
+    CollectorModuleStats m;
+    m.name = "CPU"; m.enabled = true; m.updates = 3; m.fileOpens = 6;
+    for (uint64_t us : {100, 200, 5000}) m.updateUs.record(us);
+    PipelineStageStats st;
+    st.name = "persist"; st.processed = 4; st.dropped = 1;
+    md.collector.modules = {m};
+    md.collector.stages  = {st};
+
+    db->insertSnapshot(md);
+    EXPECT_EQ(scalar(dbPath, "SELECT COUNT(*) FROM collector_stats;"), 0);
+
+    db->setRecordCollectorStats(true);
+    db->insertSnapshot(md);
+    EXPECT_EQ(scalar(dbPath, "SELECT COUNT(*) FROM collector_stats;"), 2);
+    EXPECT_EQ(scalar(dbPath, "SELECT max_us FROM collector_stats WHERE component='CPU';"), 5000);
+    EXPECT_EQ(scalar(dbPath, "SELECT file_opens FROM collector_stats WHERE kind='module';"), 6);
+    EXPECT_EQ(scalar(dbPath, "SELECT dropped FROM collector_stats WHERE kind='stage';"), 1);
+}
+
+TEST(DatabaseMigrationTest, LegacyDiskTableIsMigrated) {
+    std::string path = "test_legacy_disk.db";
+    std::filesystem::remove(path);
+    {
+        sqlite3* raw = nullptr;
+        ASSERT_EQ(sqlite3_open(path.c_str(), &raw), SQLITE_OK);
+        sqlite3_exec(raw,
+            "CREATE TABLE disk_metrics ("
+            "  id INTEGER PRIMARY KEY AUTOINCREMENT, timestamp TEXT NOT NULL,"
+            "  device TEXT, mount_point TEXT, fs_type TEXT,"
+            "  usage_pct REAL, total_bytes INTEGER, used_bytes INTEGER,"
+            "  read_rate REAL, write_rate REAL);"
+            "INSERT INTO disk_metrics(timestamp,device,mount_point,fs_type,usage_pct)"
+            "  VALUES('2024-01-01 00:00:00.000','/dev/old','/mnt','xfs',12.5);",
+            nullptr, nullptr, nullptr);
+        sqlite3_close(raw);
+    }
+    {
+        Database db(path);
+        ASSERT_TRUE(db.initialize());
+    }
+    auto rows = diskRows(path);
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0], "/dev/old|/mnt|xfs");
+    EXPECT_EQ(scalar(path, "SELECT COUNT(*) FROM sqlite_master WHERE name='disk_metrics' AND type='view';"), 1);
+    std::filesystem::remove(path);
+}
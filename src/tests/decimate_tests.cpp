@@ -0,0 +1,113 @@
+/**
+ * @file decimate_tests.cpp
+ * @brief Tests for render-time min/max decimation.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/decimate.h"
+#include "utils/scrolling_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/// A wrapped buffer of @p n 1 Hz samples of a noisy sine with one spike.
+ScrollingBuffer noisySeries(int n, int spikeAt) {
+    ScrollingBuffer buf(n);
+    for (int i = 0; i < n + n / 3; ++i) {
+        float y = 50.0f + 20.0f * std::sin(i * 0.01f) + static_cast<float>((i * 7919) % 13);
+        buf.AddPoint(static_cast<float>(i), i == spikeAt ? 400.0f : y);
+    }
+    return buf;
+}
+
+struct ColumnRange {
+    float lo = INFINITY;
+    float hi = -INFINITY;
+};
+
+/// Per-column y range of the points in [xMin, xMax].
+std::vector<ColumnRange> columnRanges(const std::vector<float>& xs, const std::vector<float>& ys,
+                                      float xMin, float xMax, int columns) {
+    std::vector<ColumnRange> out(columns);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (xs[i] < xMin || xs[i] > xMax) continue;
+        int c = std::min(static_cast<int>((xs[i] - xMin) * columns / (xMax - xMin)), columns - 1);
+        out[c].lo = std::min(out[c].lo, ys[i]);
+        out[c].hi = std::max(out[c].hi, ys[i]);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(DecimateTest, KeepsEveryColumnsExtremes) {
+    const ScrollingBuffer buf = noisySeries(20000, 21000);
+    std::vector<float> allX, allY;
+    for (int k = 0; k < buf.Size(); ++k) {
+        int idx = (buf.Offset + k) % buf.Size();
+        allX.push_back(buf.DataX[idx]);
+        allY.push_back(buf.DataY[idx]);
+    }
+
+    const float xMin = 8000.0f, xMax = 26000.0f;
+    const int columns = 300;
+    std::vector<float> x, y;
+    decimateMinMax(buf.DataX.data(), buf.DataY.data(), buf.Size(), buf.Offset,
+                   xMin, xMax, columns, x, y);
+
+    EXPECT_LE(x.size(), static_cast<std::size_t>(4 * columns + 2));
+    EXPECT_LT(x.size() * 10, allX.size());
+    EXPECT_TRUE(std::is_sorted(x.begin(), x.end()));
+    EXPECT_FLOAT_EQ(*std::max_element(y.begin(), y.end()), 400.0f);
+
+    auto want = columnRanges(allX, allY, xMin, xMax, columns);
+    auto got  = columnRanges(x, y, xMin, xMax, columns);
+    for (int c = 0; c < columns; ++c) {
+        EXPECT_FLOAT_EQ(got[c].lo, want[c].lo) << "column " << c;
+        EXPECT_FLOAT_EQ(got[c].hi, want[c].hi) << "column " << c;
+    }
+}
+
+TEST(DecimateTest, KeepsThePointsEitherSideOfTheWindow) {
+    ScrollingBuffer buf(100);
+    for (int i = 0; i < 100; ++i) buf.AddPoint(static_cast<float>(i), static_cast<float>(i));
+    std::vector<float> x, y;
+    decimateMinMax(buf.DataX.data(), buf.DataY.data(), buf.Size(), buf.Offset,
+                   10.5f, 20.5f, 50, x, y);
+    ASSERT_FALSE(x.empty());
+    EXPECT_FLOAT_EQ(x.front(), 10.0f);
+    EXPECT_FLOAT_EQ(x.back(), 21.0f);
+    EXPECT_EQ(x.size(), 12u);  // fewer points than columns: all kept
+}
+
+TEST(DecimateTest, EmptyInputsWriteNothing) {
+    ScrollingBuffer buf(10);
+    std::vector<float> x{1.0f}, y{1.0f};
+    decimateMinMax(buf.DataX.data(), buf.DataY.data(), 0, 0, 0.0f, 10.0f, 100, x, y);
+    EXPECT_TRUE(x.empty());
+    buf.AddPoint(1.0f, 1.0f);
+    decimateMinMax(buf.DataX.data(), buf.DataY.data(), buf.Size(), 0, 5.0f, 5.0f, 100, x, y);
+    EXPECT_TRUE(x.empty());
+}
+
+TEST(DecimateTest, BandCoversEachColumnsLowAndHigh) {
+    std::vector<float> xs, lo, hi;
+    for (int i = 0; i < 1000; ++i) {
+        xs.push_back(static_cast<float>(i));
+        lo.push_back(static_cast<float>(i % 10));
+        hi.push_back(static_cast<float>(100 + i % 10));
+    }
+    hi[505] = 900.0f;
+    std::vector<float> x, bandLo, bandHi;
+    decimateBand(xs.data(), lo.data(), hi.data(), 1000, 0, 0.0f, 999.0f, 20, x, bandLo, bandHi);
+
+    EXPECT_LE(x.size(), 42u);
+    EXPECT_FLOAT_EQ(x.front(), 0.0f);
+    EXPECT_FLOAT_EQ(x.back(), 999.0f);
+    EXPECT_FLOAT_EQ(*std::min_element(bandLo.begin(), bandLo.end()), 0.0f);
+    EXPECT_FLOAT_EQ(*std::max_element(bandHi.begin(), bandHi.end()), 900.0f);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_FLOAT_EQ(bandLo[i], 0.0f);
+}
@@ -30,3 +30,22 @@ TEST_F(DiskTest, DiskSpacePositive) {
         EXPECT_LE(d.usagePercent, 100.0f);
     }
 }
+
+#ifdef __linux__
+#include "core/disk/disk_linux.h"
+#include "alloc_counter.h"
+#include "syscall_counter.h"
+
+TEST(DiskBudgetTest, SteadyStateTickDoesNotAllocate) {
+    LinuxDisk d;
+    for (int i = 0; i < 3; ++i) d.update();  // grow buffers, intern the names
+
+    AllocScope allocs;
+    SyscallScope io;
+    d.update();
+    EXPECT_EQ(allocs.count(), 0u);
+    // /proc/mounts and /proc/diskstats; each mount's statvfs opens nothing.
+    EXPECT_LE(io.opens(), 2u);
+    EXPECT_LE(io.syscalls(), 4 * io.opens() + io.bytesRead() / 2048);
+}
+#endif
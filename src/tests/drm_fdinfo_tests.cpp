@@ -0,0 +1,104 @@
+/**
+ * @file drm_fdinfo_tests.cpp
+ * @brief Tests for the DRM fdinfo parser against recorded amdgpu/i915/xe fixtures.
+ */
+
+#include <gtest/gtest.h>
+#include "core/gpu/drm_fdinfo.h"
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+std::string readFixture(const std::string& name) {
+    std::ifstream f(std::string(DRM_FIXTURE_DIR) + "/" + name);
+    return std::string((std::istreambuf_iterator<char>(f)),
+                        std::istreambuf_iterator<char>());
+}
+
+const DrmEngineUsage* findEngine(const DrmClientUsage& c, const std::string& name) {
+    for (const auto& e : c.engines) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(DrmFdinfoTest, ParsesAmdgpu) {
+    DrmClientUsage c;
+    ASSERT_TRUE(parseDrmFdinfo(readFixture("amdgpu.fdinfo"), c));
+    EXPECT_EQ(c.driver, "amdgpu");
+    EXPECT_EQ(c.clientId, 42u);
+    EXPECT_EQ(c.pdev, "0000:03:00.0");
+    // Legacy drm-memory-vram key; GTT is system memory and not counted.
+    EXPECT_EQ(c.vramBytes, 262144ull * 1024ull);
+    auto* gfx = findEngine(c, "gfx");
+    ASSERT_NE(gfx, nullptr);
+    EXPECT_EQ(gfx->busyNs, 2500000000ull);
+    EXPECT_EQ(gfx->capacity, 1u);
+}
+
+TEST(DrmFdinfoTest, ParsesI915) {
+    DrmClientUsage c;
+    ASSERT_TRUE(parseDrmFdinfo(readFixture("i915.fdinfo"), c));
+    EXPECT_EQ(c.driver, "i915");
+    // Resident local memory is preferred over the total.
+    EXPECT_EQ(c.vramBytes, 512ull * 1024ull * 1024ull);
+    auto* video = findEngine(c, "video");
+    ASSERT_NE(video, nullptr);
+    EXPECT_EQ(video->busyNs, 400000000ull);
+    EXPECT_EQ(video->capacity, 2u);
+    // "video-enhance" must not be confused with "video".
+    EXPECT_NE(findEngine(c, "video-enhance"), nullptr);
+}
+
+TEST(DrmFdinfoTest, ParsesXeCycles) {
+    DrmClientUsage c;
+    ASSERT_TRUE(parseDrmFdinfo(readFixture("xe.fdinfo"), c));
+    EXPECT_EQ(c.driver, "xe");
+    EXPECT_EQ(c.vramBytes, 4096ull * 1024ull);
+    auto* rcs = findEngine(c, "rcs");
+    ASSERT_NE(rcs, nullptr);
+    EXPECT_EQ(rcs->cycles, 28257900ull);
+    EXPECT_EQ(rcs->totalCycles, 7655183225ull);
+    auto* vcs = findEngine(c, "vcs");
+    ASSERT_NE(vcs, nullptr);
+    EXPECT_EQ(vcs->capacity, 2u);
+}
+
+TEST(DrmFdinfoTest, RejectsNonDrmFdinfo) {
+    DrmClientUsage c;
+    EXPECT_FALSE(parseDrmFdinfo("pos:\t0\nflags:\t02\nmnt_id:\t24\nino:\t99\n", c));
+}
+
+TEST(DrmFdinfoTest, BusyPercentFromNanoseconds) {
+    DrmEngineUsage prev, cur;
+    prev.busyNs = 1000000000ull;
+    cur.busyNs  = 1250000000ull;
+    // 250 ms busy over a 1 s window.
+    EXPECT_NEAR(drmEngineBusyPercent(prev, cur, 1e9), 25.0f, 0.01f);
+
+    // Two-instance class: the same busy time is half the capacity.
+    cur.capacity = 2;
+    EXPECT_NEAR(drmEngineBusyPercent(prev, cur, 1e9), 12.5f, 0.01f);
+}
+
+TEST(DrmFdinfoTest, BusyPercentFromCycles) {
+    DrmEngineUsage prev, cur;
+    prev.cycles = 100;  prev.totalCycles = 1000;
+    cur.cycles  = 400;  cur.totalCycles  = 2000;
+    // Wall time is ignored when cycle counters are available.
+    EXPECT_NEAR(drmEngineBusyPercent(prev, cur, 0.0), 30.0f, 0.01f);
+}
+
+TEST(DrmFdinfoTest, BusyPercentClampedAndCounterReset) {
+    DrmEngineUsage prev, cur;
+    prev.busyNs = 0;
+    cur.busyNs  = 5000000000ull;
+    EXPECT_FLOAT_EQ(drmEngineBusyPercent(prev, cur, 1e9), 100.0f);
+
+    // A counter going backwards (client re-created) reports idle.
+    EXPECT_FLOAT_EQ(drmEngineBusyPercent(cur, prev, 1e9), 0.0f);
+}
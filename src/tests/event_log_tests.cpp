@@ -0,0 +1,142 @@
+/**
+ * @file event_log_tests.cpp
+ * @brief Tests for the binary event log and its decoder.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/event_log.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string kPath = "test_events.rmev";
+
+std::string decode(const std::string& path, EventDumpFormat format) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    std::string error;
+    EXPECT_TRUE(decodeEventLog(in, out, format, error)) << error;
+    return out.str();
+}
+
+std::size_t lineCount(const std::string& text) {
+    return static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+class EventLogTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        EventLog::close();
+        std::filesystem::remove(kPath);
+        std::filesystem::remove(kPath + ".1");
+    }
+};
+
+} // namespace
+
+TEST_F(EventLogTest, ClosedLogRecordsNothing) {
+    static const EventType kEvent("never {}");
+    ASSERT_FALSE(EventLog::enabled());
+    EventLog::emit(kEvent, 1);
+    ASSERT_TRUE(EventLog::open(kPath));
+    EventLog::close();
+    EXPECT_EQ(decode(kPath, EventDumpFormat::Text), "");
+}
+
+TEST_F(EventLogTest, DecodesEveryArgumentType) {
+    static const EventType kEvent("{} {} took {} us ({} ok={})");
+    ASSERT_TRUE(EventLog::open(kPath));
+    EventLog::emit(kEvent, Label("cpu"), std::string("update"), uint64_t{85}, -2.5, true);
+    EventLog::close();
+
+    std::string text = decode(kPath, EventDumpFormat::Text);
+    EXPECT_NE(text.find("] cpu update took 85 us (-2.5 ok=1)\n"), std::string::npos) << text;
+
+    std::string json = decode(kPath, EventDumpFormat::Json);
+    EXPECT_NE(json.find("\"event\":\"{} {} took {} us ({} ok={})\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"args\":[\"cpu\",\"update\",85,-2.5,1]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"text\":\"cpu update took 85 us (-2.5 ok=1)\""), std::string::npos);
+}
+
+TEST_F(EventLogTest, EventsFromManyThreadsAreAllWritten) {
+    static const EventType kEvent("worker {} event {}");
+    constexpr int kThreads = 4;
+    constexpr int kEach    = 500;
+    ASSERT_TRUE(EventLog::open(kPath));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+        threads.emplace_back([t] {
+            for (int i = 0; i < kEach; ++i) {
+                EventLog::emit(kEvent, t, i);
+                // Stay under the ring's capacity so the count is exact.
+                if (i % 100 == 99) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+    for (auto& t : threads) t.join();
+    EventLog::close();
+
+    std::string text = decode(kPath, EventDumpFormat::Text);
+    EXPECT_EQ(lineCount(text), static_cast<std::size_t>(kThreads * kEach));
+    EXPECT_NE(text.find("worker 3 event 499"), std::string::npos);
+}
+
+TEST_F(EventLogTest, RotatedFilesDecodeOnTheirOwn) {
+    static const EventType kEvent("rotation {} of {}");
+    ASSERT_TRUE(EventLog::open(kPath, 256));
+    for (int i = 0; i < 20; ++i) {
+        EventLog::emit(kEvent, i, Label("rotation-test"));
+        if (i % 5 == 4) Logger::flush();  // several writer passes, so the file rotates
+    }
+    EventLog::close();
+
+    // The rotated file carries its own string table.
+    ASSERT_TRUE(std::filesystem::exists(kPath + ".1"));
+    std::string older = decode(kPath + ".1", EventDumpFormat::Text);
+    EXPECT_GT(lineCount(older), 0u);
+    EXPECT_NE(older.find(" of rotation-test\n"), std::string::npos) << older;
+    EXPECT_EQ(older.find("<string"), std::string::npos) << older;
+}
+
+TEST_F(EventLogTest, EventsFromDifferentThreadsAreInTimeOrder) {
+    static const EventType kEvent("order {} from {}");
+    ASSERT_TRUE(EventLog::open(kPath));
+    // This thread's ring holds events from both sides of each other
+    // thread's, so draining ring by ring would interleave them wrongly.
+    for (int i = 0; i < 50; ++i) {
+        EventLog::emit(kEvent, i, "main");
+        std::thread([i] { EventLog::emit(kEvent, i, "helper"); }).join();
+        EventLog::emit(kEvent, i, "main");
+    }
+    EventLog::close();
+
+    std::istringstream json(decode(kPath, EventDumpFormat::Json));
+    std::string line;
+    int64_t last = 0;
+    std::size_t events = 0;
+    while (std::getline(json, line)) {
+        const auto at = line.find("\"ts_ns\":");
+        ASSERT_NE(at, std::string::npos) << line;
+        const int64_t ts = std::stoll(line.substr(at + 8));
+        EXPECT_GE(ts, last) << line;
+        last = ts;
+        ++events;
+    }
+    EXPECT_EQ(events, 150u);
+}
+
+TEST(EventLogDecodeTest, RejectsForeignFiles) {
+    std::istringstream in("not an event log");
+    std::ostringstream out;
+    std::string error;
+    EXPECT_FALSE(decodeEventLog(in, out, EventDumpFormat::Text, error));
+    EXPECT_FALSE(error.empty());
+}
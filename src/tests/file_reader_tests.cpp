@@ -0,0 +1,138 @@
+/**
+ * @file file_reader_tests.cpp
+ * @brief Tests for FileReader and the Linux collectors run against a synthetic tree.
+ */
+
+#include <gtest/gtest.h>
+#include "core/io/file_reader.h"
+#include "fixture_tree.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST(FileReaderTest, PathsArePrefixedWithTheRoot) {
+    auto files = createFileReader("/srv/fixture/");
+    EXPECT_EQ(files->root(), "/srv/fixture");
+    EXPECT_EQ(files->path("/proc/stat"), "/srv/fixture/proc/stat");
+    EXPECT_FALSE(files->isHost());
+
+    EXPECT_EQ(createFileReader(""), hostFileReader());
+    EXPECT_EQ(createFileReader("/"), hostFileReader());
+    EXPECT_EQ(hostFileReader()->path("/proc/stat"), "/proc/stat");
+}
+
+TEST(FileReaderTest, ReadsListsAndFollowsLinksUnderTheRoot) {
+    FixtureTree tree("reader");
+    tree.write("/proc/loadavg", "0.50 0.25 0.10 1/99 1234\n");
+    tree.write("/proc/7/stat", "");
+    tree.write("/proc/12/stat", "");
+    tree.link("/proc/7/exe", "/usr/bin/seven");
+
+    auto files = createFileReader(tree.root());
+    std::string text;
+    ASSERT_TRUE(files->read("/proc/loadavg", text));
+    EXPECT_EQ(text, "0.50 0.25 0.10 1/99 1234\n");
+    EXPECT_FALSE(files->read("/proc/missing", text));
+    EXPECT_TRUE(text.empty());
+
+    std::vector<std::string> names;
+    ASSERT_TRUE(files->forEachEntry("/proc", [&](const char* name) {
+        names.emplace_back(name);
+        return true;
+    }));
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, (std::vector<std::string>{"12", "7", "loadavg"}));
+
+    ASSERT_TRUE(files->readLink("/proc/7/exe", text));
+    EXPECT_EQ(text, "/usr/bin/seven");
+    EXPECT_FALSE(files->forEachEntry("/proc/none", [](const char*) { return true; }));
+}
+
+#ifdef __linux__
+#include "core/cpu/cpu_linux.h"
+#include "core/disk/disk_linux.h"
+#include "core/memory/memory_linux.h"
+#include "core/network/network_linux.h"
+#include "core/process/process_linux.h"
+
+namespace {
+
+/// /proc/stat for @p cores CPUs.
+std::string procStat(int cores) {
+    std::string text = "cpu  800 0 400 8000 0 0 0 0 0 0\n";
+    for (int i = 0; i < cores; ++i)
+        text += "cpu" + std::to_string(i) + " 100 0 50 1000 0 0 0 0 0 0\n";
+    return text + "intr 5000\nctxt 9000\nbtime 1700000000\nprocesses 42\n";
+}
+
+/// /proc/<pid>/stat with the fields the process parser reads.
+std::string pidStat(int pid, const char* comm, char state) {
+    return std::to_string(pid) + " (" + comm + ") " + state +
+           " 1 1 1 0 -1 4194560 100 0 0 0 25 5 0 0 20 0 3 0 100 1000000 200\n";
+}
+
+} // namespace
+
+TEST(FileReaderTest, CollectorsReadTheSyntheticTree) {
+    FixtureTree tree("collectors");
+    tree.write("/proc/stat", procStat(64));
+    tree.write("/proc/loadavg", "1.00 0.50 0.25 3/150 999\n");
+    tree.write("/proc/meminfo",
+               "MemTotal:       16000000 kB\nMemFree:         2000000 kB\n"
+               "MemAvailable:    8000000 kB\nSwapTotal:             0 kB\nSwapFree: 0 kB\n");
+    tree.write("/proc/diskstats", "   8       0 sda 10 0 80 5 20 0 160 9 0 12 14\n");
+    tree.write("/proc/mounts", "/dev/sda1 / ext4 rw 0 0\n");
+    for (int pid : {1, 200, 3000}) {
+        tree.write("/proc/" + std::to_string(pid) + "/stat", pidStat(pid, "fixture proc", 'S'));
+        tree.write("/proc/" + std::to_string(pid) + "/status",
+                   "Name:\tfixture\nUid:\t0\t0\t0\t0\nVmRSS:\t1600 kB\n");
+    }
+    tree.write("/proc/net/tcp",
+               "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n"
+               "   0: 0100007F:0277 00000000:0000 0A 00000000:00000000 00:00000000 00000000     0        0 111 1\n"
+               "   1: 0100007F:1F90 0100007F:C350 01 00000000:00000000 00:00000000 00000000  1000        0 222 1\n");
+    tree.write("/proc/net/dev",
+               "Inter-|   Receive                            |  Transmit\n"
+               " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets\n"
+               "fx0: 5000 10 0 0 0 0 0 0 7000 12 0 0 0 0 0 0\n");
+    auto files = createFileReader(tree.root());
+
+    LinuxCPU cpu(files);
+    cpu.update();
+    auto c = cpu.snapshot();
+    EXPECT_EQ(c.logicalCores, 64);
+    EXPECT_EQ(c.cores.size(), 64u);
+    EXPECT_FLOAT_EQ(c.loadAvg1, 1.0f);
+    EXPECT_EQ(c.totalThreads, 150);
+
+    LinuxMemory memory(files);
+    memory.update();
+    EXPECT_EQ(memory.snapshot().totalBytes, 16000000ULL * 1024);
+    EXPECT_NEAR(memory.snapshot().usagePercent, 50.0f, 0.01f);
+
+    LinuxProcessManager pm(BatchBackend::Sync, files);
+    pm.update();
+    auto p = pm.snapshot();
+    ASSERT_EQ(p.totalProcesses, 3);
+    EXPECT_EQ(p.totalThreads, 9);
+    for (const auto& info : p.processes) {
+        EXPECT_EQ(info.name, "fixture proc");
+        EXPECT_NEAR(info.memoryPercent, 0.01f, 0.001f);  // 1600 kB of 16 GB
+    }
+
+    LinuxNetwork net(files);
+    net.setConnectionTracking(true);
+    net.update();
+    auto n = net.snapshot();
+    EXPECT_EQ(n.connections.size(), 2u);
+    ASSERT_EQ(n.interfaces.size(), 1u);
+    EXPECT_EQ(n.interfaces[0].totalRecv, 5000u);
+
+    LinuxDisk disk(files);
+    disk.update();
+    auto d = disk.snapshot();
+    ASSERT_EQ(d.disks.size(), 1u);
+    EXPECT_EQ(d.disks[0].mountPoint, "/");
+}
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file fixture_tree.h
+ * @brief A throwaway directory laid out like "/", for running FileReader users against.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/// @brief A directory under the temp dir, removed on construction and destruction.
+class FixtureTree {
+public:
+    explicit FixtureTree(const std::string& name)
+        : root_(std::filesystem::temp_directory_path() / ("rm_fixture_" + name)) {
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(root_);
+    }
+    ~FixtureTree() { std::filesystem::remove_all(root_); }
+
+    FixtureTree(const FixtureTree&) = delete;
+    FixtureTree& operator=(const FixtureTree&) = delete;
+
+    /// Write @p text to host path @p path inside the tree.
+    void write(const std::string& path, const std::string& text) const {
+        std::filesystem::path full = root_ / path.substr(1);
+        std::filesystem::create_directories(full.parent_path());
+        std::ofstream(full, std::ios::binary) << text;
+    }
+
+    /// Make host path @p path inside the tree a symbolic link to @p target.
+    void link(const std::string& path, const std::string& target) const {
+        std::filesystem::path full = root_ / path.substr(1);
+        std::filesystem::create_directories(full.parent_path());
+        std::filesystem::create_symlink(target, full);
+    }
+
+    /// Delete host path @p path inside the tree.
+    void remove(const std::string& path) const {
+        std::filesystem::remove_all(root_ / path.substr(1));
+    }
+
+    /// A file next to the tree (not inside it), e.g. for a capture.
+    std::string sibling(const std::string& suffix) const { return root_.string() + suffix; }
+
+    std::string root() const { return root_.string(); }
+
+private:
+    std::filesystem::path root_;
+};
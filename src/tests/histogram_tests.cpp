@@ -0,0 +1,56 @@
+/**
+ * @file histogram_tests.cpp
+ * @brief Tests for the log2 latency histogram.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/histogram.h"
+
+TEST(HistogramTest, EmptyIsZero) {
+    Histogram h;
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.percentile(0.99), 0u);
+    EXPECT_DOUBLE_EQ(h.mean(), 0.0);
+}
+
+TEST(HistogramTest, BucketsArePowersOfTwo) {
+    Histogram h;
+    h.record(0);
+    h.record(1);
+    h.record(3);
+    h.record(4);
+    h.record(7);
+    EXPECT_EQ(h.bucketCount(0), 1u);  // 0
+    EXPECT_EQ(h.bucketCount(1), 1u);  // [1, 2)
+    EXPECT_EQ(h.bucketCount(2), 1u);  // [2, 4)
+    EXPECT_EQ(h.bucketCount(3), 2u);  // [4, 8)
+    EXPECT_EQ(Histogram::bucketUpper(3), 7u);
+    EXPECT_EQ(h.max(), 7u);
+    EXPECT_EQ(h.sum(), 15u);
+}
+
+TEST(HistogramTest, PercentilesAreBucketBounds) {
+    Histogram h;
+    for (int i = 0; i < 99; ++i) h.record(100);   // bucket [64, 128)
+    h.record(5000);                               // bucket [4096, 8192)
+    EXPECT_EQ(h.percentile(0.5), 127u);
+    EXPECT_EQ(h.percentile(1.0), 5000u);  // capped at the observed max
+    EXPECT_LE(h.percentile(0.9), 127u);
+}
+
+TEST(HistogramTest, HugeValuesLandInLastBucket) {
+    Histogram h;
+    h.record(UINT64_MAX);
+    EXPECT_EQ(h.bucketCount(Histogram::kBuckets - 1), 1u);
+}
+
+TEST(HistogramTest, MergeAddsCounts) {
+    Histogram a, b;
+    a.record(10);
+    b.record(20);
+    b.record(30);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 3u);
+    EXPECT_EQ(a.max(), 30u);
+    EXPECT_EQ(a.sum(), 60u);
+}
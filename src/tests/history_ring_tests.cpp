@@ -0,0 +1,92 @@
+/**
+ * @file history_ring_tests.cpp
+ * @brief Tests for the multi-resolution chart history.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/history_ring.h"
+
+namespace {
+
+constexpr float kHour = 3600.0f;
+constexpr float kDay  = 24 * kHour;
+
+/// @p seconds of 1 Hz samples with y = t mod 100.
+void fill(HistoryRing& ring, float seconds, float from = 0.0f) {
+    for (float t = from; t < from + seconds; t += 1.0f)
+        ring.AddPoint(t, static_cast<float>(static_cast<int>(t) % 100));
+}
+
+} // namespace
+
+TEST(HistoryRingTest, TiersConsolidateMinMaxAvg) {
+    HistoryRing ring(60, {{10.0f, 8}});
+    for (int t = 0; t < 25; ++t) ring.AddPoint(static_cast<float>(t), static_cast<float>(t));
+
+    const HistoryTier& tier = ring.Tier(0);
+    ASSERT_EQ(tier.Size(), 3);  // [0,10), [10,20) and the bucket being filled
+    EXPECT_FLOAT_EQ(tier.DataX[1], 10.0f);
+    EXPECT_FLOAT_EQ(tier.DataMin[1], 10.0f);
+    EXPECT_FLOAT_EQ(tier.DataMax[1], 19.0f);
+    EXPECT_FLOAT_EQ(tier.DataAvg[1], 14.5f);
+    EXPECT_FLOAT_EQ(tier.DataAvg[2], 22.0f);  // 20..24 so far
+    EXPECT_FLOAT_EQ(tier.DataMax[2], 24.0f);
+}
+
+TEST(HistoryRingTest, MemoryIsFixedAtConstruction) {
+    HistoryRing ring(3600, {{10.0f, 100}, {60.0f, 50}});
+    const std::size_t bytes = ring.MemoryBytes();
+    fill(ring, 10 * kHour);
+
+    EXPECT_EQ(ring.MemoryBytes(), bytes);
+    EXPECT_EQ(ring.Raw().DataX.capacity(), 3600u);
+    EXPECT_EQ(ring.Tier(0).DataX.capacity(), 100u);
+    EXPECT_EQ(ring.Tier(0).Size(), 100);
+    EXPECT_EQ(ring.Tier(1).Size(), 50);
+    // The 60 s tier holds the last 50 minutes, the newest bucket still filling.
+    EXPECT_FLOAT_EQ(ring.Tier(1).OldestX(), 10 * kHour - 50 * 60.0f);
+}
+
+TEST(HistoryRingTest, PickTierFollowsTheVisibleSpan) {
+    HistoryRing ring;  // raw 1 h, 10 s for 24 h, 1 min for 7 days
+    fill(ring, 8 * 24 * kHour);
+    const float now = 8 * kDay - 1.0f;
+
+    EXPECT_EQ(ring.PickTier(now - 120.0f), -1);   // raw still holds it
+    EXPECT_EQ(ring.PickTier(now - kHour + 10.0f), -1);
+    EXPECT_EQ(ring.PickTier(now - 6 * kHour), 0);  // past raw: 10 s buckets
+    EXPECT_EQ(ring.PickTier(now - 20 * kHour), 1);  // 7200 buckets is over budget
+    EXPECT_EQ(ring.PickTier(now - 20 * kHour, 10000), 0);
+    EXPECT_EQ(ring.PickTier(now - 7 * kDay), 1);
+    // Older than anything held: the coarsest tier is the best there is.
+    EXPECT_EQ(ring.PickTier(0.0f), 1);
+}
+
+TEST(HistoryRingTest, YoungSeriesUsesRawUntilItWraps) {
+    HistoryRing ring;
+    fill(ring, 600.0f);
+    // Everything since the start is still raw, however wide the window.
+    EXPECT_EQ(ring.PickTier(-7 * kDay), -1);
+}
+
+TEST(HistoryRingTest, MaxYInWindowReadsThePickedTier) {
+    HistoryRing ring(60, {{10.0f, 1000}});
+    fill(ring, 2 * kHour);  // y is t mod 100, so every 100 s window peaks at 99
+    ring.AddPoint(2 * kHour, 500.0f);
+
+    EXPECT_FLOAT_EQ(ring.MaxYInWindow(2 * kHour - 30.0f), 500.0f);   // raw
+    EXPECT_EQ(ring.PickTier(kHour), 0);
+    EXPECT_FLOAT_EQ(ring.MaxYInWindow(kHour), 500.0f);
+    ring.AddPoint(2 * kHour + 20.0f, 1.0f);
+    EXPECT_FLOAT_EQ(ring.Tier(0).MaxYInWindow(kHour), 500.0f);
+}
+
+TEST(HistoryRingTest, EraseEmptiesEveryTier) {
+    HistoryRing ring;
+    fill(ring, 100.0f);
+    ring.Erase();
+    EXPECT_TRUE(ring.Empty());
+    for (int i = 0; i < ring.TierCount(); ++i) EXPECT_TRUE(ring.Tier(i).Empty());
+    ring.AddPoint(1000.0f, 7.0f);
+    EXPECT_FLOAT_EQ(ring.Tier(0).DataAvg[0], 7.0f);
+}
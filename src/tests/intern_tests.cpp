@@ -0,0 +1,78 @@
+/**
+ * @file intern_tests.cpp
+ * @brief Tests for the string intern pool and Label.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/intern.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(InternTest, SameTextSameId) {
+    Label a = "eth0";
+    Label b = std::string("eth0");
+    Label c = "eth1";
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_NE(a.id(), c.id());
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.str(), "eth0");
+    EXPECT_STREQ(c.c_str(), "eth1");
+}
+
+TEST(InternTest, EmptyIsIdZero) {
+    Label e;
+    EXPECT_EQ(e.id(), 0u);
+    EXPECT_TRUE(e.empty());
+    EXPECT_EQ(Label("").id(), 0u);
+    EXPECT_EQ(e.size(), 0u);
+}
+
+TEST(InternTest, ComparesLikeStrings) {
+    Label a = "apache", z = "zsh";
+    EXPECT_TRUE(a < z);
+    EXPECT_FALSE(z < a);
+    EXPECT_FALSE(a < a);
+    EXPECT_TRUE(a == "apache");
+    EXPECT_TRUE(a != std::string("nginx"));
+}
+
+TEST(InternTest, ConcurrentInternAgrees) {
+    // Enough distinct strings to span several pool chunks.
+    constexpr int kStrings = 3000;
+    std::vector<std::vector<uint32_t>> ids(4, std::vector<uint32_t>(kStrings));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kStrings; ++i)
+                ids[t][i] = Label("intern-test-" + std::to_string(i)).id();
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int i = 0; i < kStrings; ++i) {
+        for (int t = 1; t < 4; ++t) ASSERT_EQ(ids[t][i], ids[0][i]);
+        EXPECT_EQ(InternPool::global().lookup(ids[0][i]), "intern-test-" + std::to_string(i));
+    }
+}
+
+TEST(InternTest, FullPoolAnswersWithTheOverflowId) {
+    InternPool pool(6);  // "", the overflow text and four more
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 4; ++i) ids.push_back(pool.intern("mount-" + std::to_string(i)));
+    EXPECT_EQ(pool.overflows(), 0u);
+
+    EXPECT_EQ(pool.intern("/var/lib/kubelet/pods/new"), InternPool::kOverflowId);
+    EXPECT_EQ(pool.intern("/var/lib/kubelet/pods/newer"), InternPool::kOverflowId);
+    EXPECT_EQ(pool.overflows(), 2u);
+    EXPECT_EQ(pool.lookup(InternPool::kOverflowId), "<intern pool full>");
+    EXPECT_EQ(pool.size(), 6u);
+
+    // What was already interned keeps resolving.
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(pool.intern("mount-" + std::to_string(i)), ids[i]);
+        EXPECT_EQ(pool.lookup(ids[i]), "mount-" + std::to_string(i));
+    }
+    EXPECT_EQ(pool.intern(""), 0u);
+}
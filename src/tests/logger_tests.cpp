@@ -1,14 +1,17 @@
 /**
  * @file logger_tests.cpp
- * @brief Tests for the Logger utility (severity levels, thread safety).
+ * @brief Tests for the Logger utility (severity levels, thread safety, rotation).
  */
 
 #include <gtest/gtest.h>
 #include "utils/logger.h"
+#include <csignal>
+#include <cstdlib>
 #include <fstream>
 #include <filesystem>
 #include <thread>
 #include <string>
+#include <vector>
 
 class LoggerTest : public ::testing::Test {
 protected:
@@ -25,6 +28,7 @@ protected:
 
 TEST_F(LoggerTest, WritesToFile) {
     Logger::log("hello world");
+    Logger::flush();
     std::ifstream f(logPath);
     std::string line;
     ASSERT_TRUE(std::getline(f, line));
@@ -36,6 +40,7 @@ TEST_F(LoggerTest, SeverityTags) {
     Logger::debug("dbg");
     Logger::warn("wrn");
     Logger::error("err");
+    Logger::flush();
 
     std::ifstream f(logPath);
     std::string lines, line;
@@ -51,6 +56,7 @@ TEST_F(LoggerTest, LevelFiltering) {
     Logger::debug("should not appear");
     Logger::log("should not appear either");
     Logger::warn("should appear");
+    Logger::flush();
 
     std::ifstream f(logPath);
     std::string lines, line;
@@ -71,6 +77,7 @@ TEST_F(LoggerTest, ThreadSafety) {
                 Logger::log("thread " + std::to_string(t) + " msg " + std::to_string(i));
         });
     for (auto& t : threads) t.join();
+    Logger::flush();
 
     std::ifstream f(logPath);
     int count = 0;
@@ -78,3 +85,73 @@ TEST_F(LoggerTest, ThreadSafety) {
     while (std::getline(f, line)) count++;
     EXPECT_EQ(count, N * M);
 }
+
+TEST_F(LoggerTest, EachThreadsLinesKeepTheirOrder) {
+    constexpr int N = 4;
+    constexpr int M = 50;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < N; ++t)
+        threads.emplace_back([t]() {
+            for (int i = 0; i < M; ++i)
+                Logger::log("t" + std::to_string(t) + " seq " + std::to_string(i));
+        });
+    for (auto& t : threads) t.join();
+    Logger::flush();
+
+    std::ifstream f(logPath);
+    std::vector<int> next(N, 0);
+    std::string line;
+    while (std::getline(f, line)) {
+        auto at = line.find("[INF] t");
+        ASSERT_NE(at, std::string::npos);
+        int t   = std::stoi(line.substr(at + 7));
+        int seq = std::stoi(line.substr(line.find(" seq ") + 5));
+        EXPECT_EQ(seq, next[t]++);
+    }
+    for (int t = 0; t < N; ++t) EXPECT_EQ(next[t], M);
+}
+
+TEST_F(LoggerTest, LongMessagesAreTruncated) {
+    Logger::log(std::string(Logger::kMaxMessage + 100, 'x'));
+    Logger::flush();
+
+    std::ifstream f(logPath);
+    std::string line;
+    ASSERT_TRUE(std::getline(f, line));
+    EXPECT_EQ(line.size() - line.find('x'), Logger::kMaxMessage);
+}
+
+TEST_F(LoggerTest, RotatesBySize) {
+    Logger::setRotation(1024, 2);
+    for (int pass = 0; pass < 5; ++pass) {
+        for (int i = 0; i < 20; ++i) Logger::log("rotation test line " + std::to_string(i));
+        Logger::flush();
+    }
+    Logger::setRotation(uint64_t{10} << 20, 3);  // reset
+
+    namespace fs = std::filesystem;
+    EXPECT_TRUE(fs::exists(logPath + ".1"));
+    EXPECT_TRUE(fs::exists(logPath + ".2"));
+    EXPECT_FALSE(fs::exists(logPath + ".3"));
+    for (const char* suffix : {".1", ".2"}) {
+        EXPECT_GE(fs::file_size(logPath + suffix), 1024u);
+        fs::remove(logPath + suffix);
+    }
+}
+
+#ifndef _WIN32
+TEST_F(LoggerTest, FatalSignalWritesQueuedMessages) {
+    // Re-run the test body in a fresh process rather than fork this one,
+    // which may be mid-pass in the writer.
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT({
+        Logger::error("last words before the crash");
+        std::abort();
+    }, ::testing::KilledBySignal(SIGABRT), "");
+
+    std::ifstream f(logPath);
+    std::string lines, line;
+    while (std::getline(f, line)) lines += line + "\n";
+    EXPECT_NE(lines.find("[ERR] last words before the crash"), std::string::npos) << lines;
+}
+#endif
@@ -49,3 +49,25 @@ TEST_F(MemoryTest, TopProcessNotEmpty) {
     // May be empty on some systems — just don't crash
     SUCCEED();
 }
+
+#ifdef __linux__
+#include "core/memory/memory_linux.h"
+#include "alloc_counter.h"
+#include "syscall_counter.h"
+
+TEST(MemoryBudgetTest, SteadyStateTickDoesNotAllocate) {
+    for (bool top : {false, true}) {
+        LinuxMemory memory;
+        memory.setTopProcessScan(top);
+        for (int i = 0; i < 3; ++i) memory.update();  // the first one scans for top processes
+
+        // Between the top-process scans (every few seconds) a tick is two files.
+        AllocScope allocs;
+        SyscallScope io;
+        memory.update();
+        EXPECT_EQ(allocs.count(), 0u) << "top=" << top;
+        EXPECT_LE(io.opens(), 2u) << "top=" << top;
+        EXPECT_LE(io.syscalls(), 4 * io.opens() + io.bytesRead() / 2048) << "top=" << top;
+    }
+}
+#endif
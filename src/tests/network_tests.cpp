@@ -37,3 +37,61 @@ TEST_F(NetworkTest, ByteCountsNonNegative) {
     EXPECT_GE(s.totalBytesSent, 0ULL);
     EXPECT_GE(s.totalBytesRecv, 0ULL);
 }
+
+#ifdef __linux__
+#include "core/network/network_linux.h"
+#include "utils/intern.h"
+#include "alloc_counter.h"
+#include "fixture_tree.h"
+#include "syscall_counter.h"
+
+TEST(NetworkAllocTest, SteadyStateTickBarelyAllocates) {
+    LinuxNetwork n;
+    for (int i = 0; i < 3; ++i) n.update();  // grow buffers and tables
+
+    AllocScope scope;
+    SyscallScope io;
+    n.update();
+    // Only connections or interfaces that appeared since the last tick
+    // (and a first-seen PID's name lookup) should cost anything.
+    EXPECT_LT(scope.count(), 16u);
+
+    // /proc/net/dev, operstate and speed per interface, the four socket
+    // tables and the top process's comm.
+    const auto ifaces = static_cast<uint64_t>(n.snapshot().interfaces.size());
+    EXPECT_LE(io.opens(), 6 + 2 * ifaces);
+}
+
+TEST(NetworkOverflowTest, OverflowedInterfacesKeepSeparateRates) {
+    FixtureTree tree("net_overflow");
+    auto netDev = [&tree](uint64_t a, uint64_t b) {
+        tree.write("/proc/net/dev",
+                   "Inter-|   Receive\n"
+                   " face |bytes packets errs drop fifo frame compressed multicast|bytes\n"
+                   "ovfa0: " + std::to_string(a) + " 0 0 0 0 0 0 0 " + std::to_string(a) + " 0 0 0 0 0 0 0\n"
+                   "ovfb0: " + std::to_string(b) + " 0 0 0 0 0 0 0 " + std::to_string(b) + " 0 0 0 0 0 0 0\n");
+    };
+
+    // Fill the global pool so both names come back as kOverflowId.
+    InternPool& pool = InternPool::global();
+    pool.setMaxStrings(pool.size());
+    LinuxNetwork n(createFileReader(tree.root()));
+    netDev(1000, 1000000);
+    n.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    netDev(2000, 1100000);
+    n.update();
+    pool.setMaxStrings(std::size_t{1} << 22);  // back to the default cap
+
+    auto s = n.snapshot();
+    ASSERT_EQ(s.interfaces.size(), 2u);
+    const auto& a = s.interfaces[0];
+    const auto& b = s.interfaces[1];
+    EXPECT_EQ(a.name.id(), InternPool::kOverflowId);
+    EXPECT_EQ(b.name.id(), InternPool::kOverflowId);
+    EXPECT_GT(a.downloadRate, 0.0f);
+    // b moved 100x the bytes of a in the same interval.
+    EXPECT_NEAR(b.downloadRate / a.downloadRate, 100.0f, 1.0f);
+    EXPECT_NEAR(b.uploadRate / a.uploadRate, 100.0f, 1.0f);
+}
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file pipeline_tests.cpp
+ * @brief Tests for the SPSC queue and the staged collection pipeline.
+ */
+
+#include <gtest/gtest.h>
+#include "core/pipeline/pipeline.h"
+#include "core/collector/collector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueueTest, FifoAndFull) {
+    SpscQueue<int> q(3);  // rounded up to 4
+    EXPECT_EQ(q.capacity(), 4u);
+    for (int i = 1; i <= 4; ++i) {
+        int v = i;
+        ASSERT_TRUE(q.tryPush(v));
+    }
+    int extra = 5;
+    EXPECT_FALSE(q.tryPush(extra));
+    EXPECT_EQ(extra, 5);
+    EXPECT_EQ(q.size(), 4u);
+
+    // Wrap around the ring a few times.
+    for (int i = 1; i <= 20; ++i) {
+        int out = 0;
+        ASSERT_TRUE(q.tryPop(out));
+        EXPECT_EQ(out, i);
+        int v = i + 4;
+        ASSERT_TRUE(q.tryPush(v));
+    }
+    int out = 0;
+    while (q.tryPop(out)) {}
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(out, 24);
+}
+
+TEST(SpscQueueTest, SwapRecyclesStorage) {
+    SpscQueue<std::vector<int>> q(2);
+    std::vector<int> in(100, 1);
+    const int* data = in.data();
+    ASSERT_TRUE(q.tryPush(in));
+    std::vector<int> out;
+    ASSERT_TRUE(q.tryPop(out));
+    EXPECT_EQ(out.data(), data);  // moved through, not copied
+}
+
+TEST(SpscQueueTest, ConcurrentProducerConsumerKeepsOrder) {
+    constexpr int kItems = 200000;
+    SpscQueue<int> q(64);
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            int v = i;
+            while (!q.tryPush(v)) std::this_thread::yield();
+        }
+    });
+    int expected = 0;
+    while (expected < kItems) {
+        int v;
+        if (q.tryPop(v)) {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(SpscQueueTest, SizeFromAThirdThreadStaysInRange) {
+    constexpr int kItems = 20000;
+    SpscQueue<int> q(8);
+    std::atomic<bool> done{false};
+    std::size_t worst = 0;
+    std::thread observer([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            worst = std::max(worst, q.size());
+            std::this_thread::yield();
+        }
+    });
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            int v = i;
+            while (!q.tryPush(v)) std::this_thread::yield();
+        }
+    });
+    for (int popped = 0; popped < kItems;) {
+        int v;
+        if (q.tryPop(v)) ++popped;
+        else             std::this_thread::yield();
+    }
+    producer.join();
+    done = true;
+    observer.join();
+    EXPECT_LE(worst, q.capacity());
+}
+
+namespace {
+
+/// Tick every 10 ms.
+void makeFast(Collector& c) {
+    auto p = makeProfile(ProfileKind::Diagnostics);
+    for (auto& m : p.modules) m.period = std::chrono::milliseconds(10);
+    c.setProfile(p);
+}
+
+} // namespace
+
+TEST(PipelineTest, StagesRunInOrderOnEverySample) {
+    Collector c(ProfileKind::Diagnostics, Collector::Modules{});
+    makeFast(c);
+
+    std::atomic<int> seen{0};
+    std::atomic<bool> ordered{true};
+    std::atomic<std::size_t> reported{0};
+    Pipeline p(c);
+    p.addStage("first",  [](MetricData& md) { md.elapsedSec = -1.0; });
+    p.addStage("second", [&](MetricData& md) {
+        if (md.elapsedSec != -1.0) ordered = false;
+        reported = md.collector.stages.size();
+        ++seen;
+    });
+    p.start();
+    auto t0 = std::chrono::steady_clock::now();
+    while (seen < 5 && std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    p.stop();
+
+    EXPECT_GE(seen.load(), 5);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(reported.load(), 3u);  // samples carry the stage counters
+    EXPECT_TRUE(c.collect().collector.stages.empty());  // detached on stop()
+    auto st = p.stats();
+    ASSERT_EQ(st.size(), 3u);
+    EXPECT_EQ(st[0].name, "collect");
+    EXPECT_EQ(st[1].name, "first");
+    EXPECT_EQ(st[2].processed, static_cast<uint64_t>(seen.load()));
+    EXPECT_EQ(st[0].processed, st[1].processed + st[1].dropped);  // nothing lost in flight
+}
+
+TEST(PipelineTest, SlowStageDoesNotDelayCollection) {
+    Collector c(ProfileKind::Diagnostics, Collector::Modules{});
+    makeFast(c);
+
+    Pipeline p(c, 2);
+    p.addStage("slow", [](MetricData&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+    p.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    p.stop();
+
+    auto st = p.stats();
+    ASSERT_EQ(st.size(), 2u);
+    // About 50 ticks at 10 ms against at most ~6 slow runs; allow for a
+    // loaded machine but require collection to outpace the slow stage.
+    EXPECT_GT(st[0].processed, st[1].processed * 2);
+    EXPECT_GT(st[1].dropped, 0u);
+    EXPECT_LE(st[1].maxQueueDepth, st[1].capacity);
+    EXPECT_GE(st[1].latencyUs.percentile(0.5), 90000u);
+    EXPECT_GT(st[1].waitUs.count(), 0u);
+}
@@ -35,3 +35,65 @@ TEST_F(ProcessTest, CpuPercentNonNegative) {
         EXPECT_GE(p.cpuPercent, 0.0f);
     }
 }
+
+TEST_F(ProcessTest, GpuPercentUnknownOrInRange) {
+    auto s = proc->snapshot();
+    for (auto& p : s.processes) {
+        // -1 means the process holds no DRM client.
+        if (p.gpuPercent < 0.0f) {
+            EXPECT_FLOAT_EQ(p.gpuPercent, -1.0f);
+        } else {
+            EXPECT_LE(p.gpuPercent, 100.0f);
+        }
+    }
+}
+
+#ifdef __linux__
+#include "core/process/process_linux.h"
+#include "alloc_counter.h"
+#include "syscall_counter.h"
+
+TEST(ProcessBackendTest, ReadsSynchronouslyUntilAskedForIoUring) {
+    LinuxProcessManager pm;
+    pm.update();
+    EXPECT_STREQ(pm.ioBackend(), "sync");
+
+    // Where io_uring is unavailable the reader still falls back to sync.
+    const std::string uring = createBatchReader(BatchBackend::IoUring)->name();
+    pm.setIoUring(true);
+    pm.update();
+    EXPECT_EQ(pm.ioBackend(), uring);
+    EXPECT_GT(pm.snapshot().totalProcesses, 0);
+
+    pm.setIoUring(false);
+    pm.update();
+    EXPECT_STREQ(pm.ioBackend(), "sync");
+}
+
+TEST(ProcessAllocTest, SteadyStateTickBarelyAllocates) {
+    for (bool details : {false, true}) {
+        LinuxProcessManager pm(BatchBackend::Sync);
+        pm.setDetailedInfo(details);
+        for (int i = 0; i < 3; ++i) pm.update();  // grow buffers and tables
+
+        AllocScope scope;
+        SyscallScope io;
+        pm.update();
+        uint64_t allocs = scope.count();
+        uint64_t opens  = io.opens();
+
+        // Before the arena rewrite this was several allocations per
+        // process; now only PIDs that appeared since the last tick cost
+        // anything (a new snapshot slot, a new UID name).
+        int procs = pm.snapshot().totalProcesses;
+        EXPECT_LT(allocs, 8u + static_cast<uint64_t>(procs) / 10)
+            << "details=" << details << " processes=" << procs;
+
+        // /proc itself, then stat and status per PID; details add cmdline
+        // and io. Executable paths and fd tables are cached between ticks.
+        const uint64_t perPid = details ? 4 : 2;
+        EXPECT_LE(opens, 8 + perPid * static_cast<uint64_t>(procs))
+            << "details=" << details << " processes=" << procs;
+    }
+}
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file scrolling_buffer_tests.cpp
+ * @brief Tests for the plot ring buffer's time search and range min/max.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/scrolling_buffer.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/// Y for sample @p i: bounded noise with no simple period.
+float noise(int i) {
+    return static_cast<float>((i * 7919 + (i >> 3) * 104729) % 1000) - 300.0f;
+}
+
+/// Brute-force max over positions [first, last).
+float slowMax(const ScrollingBuffer& buf, int first, int last) {
+    float m = std::numeric_limits<float>::lowest();
+    for (int k = first; k < last; ++k) m = std::max(m, buf.DataY[buf.Index(k)]);
+    return m;
+}
+
+float slowMin(const ScrollingBuffer& buf, int first, int last) {
+    float m = std::numeric_limits<float>::max();
+    for (int k = first; k < last; ++k) m = std::min(m, buf.DataY[buf.Index(k)]);
+    return m;
+}
+
+} // namespace
+
+TEST(ScrollingBufferTest, BoundsFindTheWindowAcrossTheWrap) {
+    ScrollingBuffer buf(100);
+    for (int i = 0; i < 250; ++i) buf.AddPoint(static_cast<float>(i) * 0.5f, 1.0f);
+    // Holds x = 75.0 .. 124.5, with the oldest in the middle of the arrays.
+    ASSERT_NE(buf.Offset, 0);
+
+    EXPECT_EQ(buf.LowerBound(0.0f), 0);
+    EXPECT_EQ(buf.LowerBound(75.0f), 0);
+    EXPECT_EQ(buf.LowerBound(75.1f), 1);
+    EXPECT_EQ(buf.UpperBound(75.0f), 1);
+    EXPECT_EQ(buf.LowerBound(110.0f), 70);
+    EXPECT_FLOAT_EQ(buf.DataX[buf.Index(70)], 110.0f);
+    EXPECT_EQ(buf.UpperBound(124.5f), 100);
+    EXPECT_EQ(buf.LowerBound(200.0f), 100);
+}
+
+TEST(ScrollingBufferTest, RangeMinMaxMatchesAScan) {
+    // 200 is not a multiple of the index's block size; the loop stops at
+    // many write positions, including mid-block ones.
+    ScrollingBuffer buf(200);
+    for (int i = 0; i < 1000; ++i) {
+        buf.AddPoint(static_cast<float>(i), noise(i));
+        if (i % 37 != 0) continue;
+        for (int first = 0; first < buf.Size(); first += 13) {
+            for (int last = first; last <= buf.Size(); last += 29) {
+                ASSERT_EQ(buf.MaxY(first, last), slowMax(buf, first, last))
+                    << "i=" << i << " [" << first << ", " << last << ")";
+                ASSERT_EQ(buf.MinY(first, last), slowMin(buf, first, last))
+                    << "i=" << i << " [" << first << ", " << last << ")";
+            }
+            ASSERT_EQ(buf.MaxY(first, buf.Size()), slowMax(buf, first, buf.Size()));
+        }
+    }
+}
+
+TEST(ScrollingBufferTest, MaxYInWindowKeepsItsZeroFloor) {
+    ScrollingBuffer buf(10);
+    EXPECT_FLOAT_EQ(buf.MaxYInWindow(0.0f), 0.0f);
+    for (int i = 0; i < 15; ++i) buf.AddPoint(static_cast<float>(i), -1.0f - i);
+    EXPECT_FLOAT_EQ(buf.MaxYInWindow(0.0f), 0.0f);
+    buf.AddPoint(15.0f, 42.0f);
+    EXPECT_FLOAT_EQ(buf.MaxYInWindow(15.0f), 42.0f);
+    EXPECT_FLOAT_EQ(buf.MaxYInWindow(16.0f), 0.0f);
+}
+
+TEST(ScrollingBufferTest, IndexIsRebuiltAfterErase) {
+    ScrollingBuffer buf(128);
+    for (int i = 0; i < 300; ++i) buf.AddPoint(static_cast<float>(i), 1000.0f);
+    buf.Erase();
+    for (int i = 0; i < 100; ++i) buf.AddPoint(static_cast<float>(i), static_cast<float>(i % 10));
+    EXPECT_FLOAT_EQ(buf.MaxY(0, buf.Size()), 9.0f);
+    EXPECT_FLOAT_EQ(buf.MinY(0, 64), 0.0f);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file syscall_counter.cpp
+ * @brief Counting replacements for the libc functions that open files.
+ *
+ * Each replacement bumps the calling thread's counter and forwards to the
+ * next definition (libc's) found with dlsym(RTLD_NEXT). Definitions in
+ * the executable take precedence over libc for the core libraries and
+ * for libstdc++, so std::ifstream (fopen) and std::filesystem (opendir)
+ * are counted too.
+ */
+
+#include "syscall_counter.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+
+#include <cstdarg>
+#include <cstdio>
+#endif
+
+namespace {
+thread_local uint64_t tOpens = 0;
+
+#ifdef __linux__
+/// libc's definition of @p name.
+template <typename Fn>
+Fn next(const char* name) {
+    return reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+}
+
+/// The mode argument, present only when the flags create a file.
+mode_t modeArg(int flags, va_list ap) {
+    return (flags & O_CREAT) || (flags & O_TMPFILE) == O_TMPFILE ? va_arg(ap, mode_t) : 0;
+}
+#endif
+} // namespace
+
+uint64_t threadFileOpens() { return tOpens; }
+
+#ifdef __linux__
+extern "C" {
+
+int open(const char* path, int flags, ...) {
+    static const auto real = next<int (*)(const char*, int, ...)>("open");
+    va_list ap;
+    va_start(ap, flags);
+    mode_t mode = modeArg(flags, ap);
+    va_end(ap);
+    ++tOpens;
+    return real(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...) {
+    static const auto real = next<int (*)(const char*, int, ...)>("open64");
+    va_list ap;
+    va_start(ap, flags);
+    mode_t mode = modeArg(flags, ap);
+    va_end(ap);
+    ++tOpens;
+    return real(path, flags, mode);
+}
+
+int openat(int dirfd, const char* path, int flags, ...) {
+    static const auto real = next<int (*)(int, const char*, int, ...)>("openat");
+    va_list ap;
+    va_start(ap, flags);
+    mode_t mode = modeArg(flags, ap);
+    va_end(ap);
+    ++tOpens;
+    return real(dirfd, path, flags, mode);
+}
+
+int openat64(int dirfd, const char* path, int flags, ...) {
+    static const auto real = next<int (*)(int, const char*, int, ...)>("openat64");
+    va_list ap;
+    va_start(ap, flags);
+    mode_t mode = modeArg(flags, ap);
+    va_end(ap);
+    ++tOpens;
+    return real(dirfd, path, flags, mode);
+}
+
+// What open() and openat() compile to under _FORTIFY_SOURCE.
+int __open_2(const char* path, int flags) {
+    static const auto real = next<int (*)(const char*, int)>("__open_2");
+    ++tOpens;
+    return real(path, flags);
+}
+
+int __open64_2(const char* path, int flags) {
+    static const auto real = next<int (*)(const char*, int)>("__open64_2");
+    ++tOpens;
+    return real(path, flags);
+}
+
+int __openat_2(int dirfd, const char* path, int flags) {
+    static const auto real = next<int (*)(int, const char*, int)>("__openat_2");
+    ++tOpens;
+    return real(dirfd, path, flags);
+}
+
+FILE* fopen(const char* path, const char* mode) {
+    static const auto real = next<FILE* (*)(const char*, const char*)>("fopen");
+    ++tOpens;
+    return real(path, mode);
+}
+
+FILE* fopen64(const char* path, const char* mode) {
+    static const auto real = next<FILE* (*)(const char*, const char*)>("fopen64");
+    ++tOpens;
+    return real(path, mode);
+}
+
+DIR* opendir(const char* path) {
+    static const auto real = next<DIR* (*)(const char*)>("opendir");
+    ++tOpens;
+    return real(path);
+}
+
+} // extern "C"
+#endif
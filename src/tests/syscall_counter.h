@@ -0,0 +1,41 @@
+/**
+ * @file syscall_counter.h
+ * @brief Count the files opened and the I/O syscalls made by the calling thread.
+ *
+ * syscall_counter.cpp interposes the libc open functions (open, openat,
+ * fopen, opendir and their 64-bit and fortified forms) for the whole
+ * test binary, so every file a module opens is counted, whichever path
+ * it takes: FileReader, BatchReader, std::ifstream or std::filesystem.
+ * Read and write syscalls come from the kernel's per-thread counters
+ * (threadIoUsage()), plus the io_uring submissions the readers report.
+ * Like AllocScope, counts are per thread.
+ *
+ * Linux only; elsewhere the counts stay zero.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "utils/io_counters.h"
+
+/// @brief Files opened by this thread since it started.
+uint64_t threadFileOpens();
+
+/// @brief Files opened and I/O syscalls made by this thread while the scope is alive.
+class SyscallScope {
+public:
+    SyscallScope() : io_(threadIoUsage()), opens_(threadFileOpens()) {}
+
+    uint64_t opens() const { return threadFileOpens() - opens_; }
+
+    /// @brief read/write syscalls and io_uring submissions.
+    uint64_t syscalls() const { return (threadIoUsage() - io_).syscalls; }
+
+    /// @brief Bytes those reads returned.
+    uint64_t bytesRead() const { return (threadIoUsage() - io_).bytesRead; }
+
+private:
+    IoUsage  io_;
+    uint64_t opens_;
+};
@@ -0,0 +1,66 @@
+/**
+ * @file tick_arena_tests.cpp
+ * @brief Tests for the per-tick arena and the PID-keyed table.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/pid_table.h"
+#include "utils/tick_arena.h"
+#include "alloc_counter.h"
+
+#include <vector>
+
+TEST(PidTableTest, InsertFindAndGrow) {
+    PidTable<int> t;
+    EXPECT_EQ(t.find(42), nullptr);
+    for (int pid = 1; pid <= 5000; ++pid) t[pid] = pid * 2;
+    EXPECT_EQ(t.size(), 5000u);
+    for (int pid = 1; pid <= 5000; ++pid) {
+        const int* v = t.find(pid);
+        ASSERT_NE(v, nullptr);
+        EXPECT_EQ(*v, pid * 2);
+    }
+    EXPECT_EQ(t.find(5001), nullptr);
+    EXPECT_EQ(t.find(0), nullptr);
+}
+
+TEST(PidTableTest, ClearKeepsCapacityAndDoesNotAllocate) {
+    PidTable<int> t;
+    t.reserve(1000);
+    std::size_t cap = t.capacity();
+
+    AllocScope scope;
+    for (int round = 0; round < 3; ++round) {
+        t.clear();
+        for (int pid = 100; pid < 1100; ++pid) t[pid] = round;
+    }
+    EXPECT_EQ(scope.count(), 0u);
+    EXPECT_EQ(t.capacity(), cap);
+    EXPECT_EQ(*t.find(500), 2);
+}
+
+TEST(PidTableTest, ForEachVisitsEveryKey) {
+    PidTable<int> t;
+    t[7] = 1; t[9] = 2; t[123456] = 3;
+    int sum = 0, keys = 0;
+    t.forEach([&](int pid, int v) { sum += v; keys += pid; });
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(keys, 7 + 9 + 123456);
+}
+
+TEST(TickArenaTest, SteadyTicksStopAllocating) {
+    TickArena arena(256);
+    auto tick = [&] {
+        arena.reset();
+        std::pmr::vector<int> v(arena.resource());
+        for (int i = 0; i < 2000; ++i) v.push_back(i);
+        return v.size();
+    };
+    tick();  // overflows to the heap
+    tick();  // arena grows to the high-water mark at this reset
+    EXPECT_GT(arena.capacity(), 256u);
+
+    AllocScope scope;
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(tick(), 2000u);
+    EXPECT_EQ(scope.count(), 0u);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file tracer_tests.cpp
+ * @brief Tests for the span tracer and its Chrome trace-event output.
+ */
+
+#include <gtest/gtest.h>
+#include "utils/tracer.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string dump() {
+    std::ostringstream out;
+    Tracer::writeChromeJson(out);
+    return out.str();
+}
+
+std::size_t occurrences(const std::string& text, const std::string& needle) {
+    std::size_t n = 0;
+    for (auto pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++n;
+    return n;
+}
+
+} // namespace
+
+TEST(TracerTest, DisabledRecordsNothing) {
+    Tracer::start();
+    Tracer::stop();
+    { TraceSpan span("test", "ignored"); }
+    EXPECT_EQ(Tracer::spanCount(), 0u);
+    EXPECT_EQ(dump().find("ignored"), std::string::npos);
+}
+
+TEST(TracerTest, SpansFromEveryThreadAreWritten) {
+    Tracer::start();
+    { TraceSpan span("test", "main-span"); }
+    std::thread worker([] {
+        for (int i = 0; i < 3; ++i) TraceSpan span("test", "worker-span");
+    });
+    worker.join();  // the buffer outlives the thread
+    Tracer::stop();
+
+    EXPECT_EQ(Tracer::spanCount(), 4u);
+    std::string json = dump();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"main-span\""), 1u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"worker-span\""), 3u);
+    EXPECT_EQ(occurrences(json, "\"ph\":\"X\""), 4u);
+    EXPECT_EQ(occurrences(json, "\"ph\":\"M\""), 2u);  // one thread_name per thread
+}
+
+TEST(TracerTest, ExitedThreadsBuffersArePrunedByTheNextSession) {
+    constexpr std::size_t kThreads = 8;
+    Tracer::start();
+    for (std::size_t i = 0; i < kThreads; ++i) {
+        std::thread([] { TraceSpan span("test", "short-lived"); }).join();
+    }
+    Tracer::stop();
+    const std::size_t held = Tracer::threadBuffers();
+    EXPECT_GE(held, kThreads);
+    EXPECT_EQ(occurrences(dump(), "\"name\":\"short-lived\""), kThreads);  // still this session's
+
+    Tracer::start();
+    Tracer::stop();
+    EXPECT_LE(Tracer::threadBuffers(), held - kThreads);
+}
+
+TEST(TracerTest, StartDiscardsThePreviousSession) {
+    Tracer::start();
+    { TraceSpan span("test", "old-session"); }
+    Tracer::start();
+    { TraceSpan span("test", "new-session"); }
+    Tracer::stop();
+
+    std::string json = dump();
+    EXPECT_EQ(json.find("old-session"), std::string::npos);
+    EXPECT_NE(json.find("new-session"), std::string::npos);
+    EXPECT_EQ(Tracer::spanCount(), 1u);
+}
+
+TEST(TracerTest, SpanDurationCoversTheScope) {
+    Tracer::start();
+    {
+        TraceSpan span("test", "sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    Tracer::stop();
+
+    std::string json = dump();
+    auto pos = json.find("\"dur\":", json.find("\"name\":\"sleep\""));
+    ASSERT_NE(pos, std::string::npos);
+    EXPECT_GE(std::stod(json.substr(pos + 6)), 5000.0);  // microseconds
+}
+
+TEST(TracerTest, NamesAreEscapedAndInterned) {
+    std::string dynamic = "stage \"q\"";
+    const char* name = Tracer::intern(dynamic);
+    EXPECT_EQ(name, Tracer::intern("stage \"q\""));  // same storage every time
+    dynamic.clear();
+
+    Tracer::start();
+    { TraceSpan span("test", name); }
+    Tracer::stop();
+    EXPECT_NE(dump().find("\"name\":\"stage \\\"q\\\"\""), std::string::npos);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file cpu_time.h
+ * @brief CPU time consumed by the calling thread, for self-overhead accounting.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+/**
+ * @brief User + system CPU time of the calling thread.
+ * @return Seconds of CPU time, or 0 if the platform cannot report it.
+ */
+inline double threadCpuSeconds() {
+#ifdef _WIN32
+    FILETIME create{}, exitT{}, kernel{}, user{};
+    if (!GetThreadTimes(GetCurrentThread(), &create, &exitT, &kernel, &user))
+        return 0.0;
+    auto toU64 = [](const FILETIME& ft) {
+        return (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    // FILETIME units are 100-nanosecond intervals.
+    return static_cast<double>(toU64(kernel) + toU64(user)) / 1.0e7;
+#else
+    struct timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.0;
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1.0e9;
+#endif
+}
@@ -0,0 +1,160 @@
+/**
+ * @file decimate.h
+ * @brief Peak-preserving render-time decimation of ring-buffered series.
+ *
+ * A plot a few hundred pixels wide cannot show more than a handful of
+ * vertices per pixel column, yet a long history holds thousands of
+ * samples per column. decimateMinMax() reduces the part of a ring that
+ * lies in [xMin, xMax] to at most four points per column: the first,
+ * minimum, maximum and last sample of the column, in time order (M4).
+ * A line through those points rasterises to the same pixels as the line
+ * through every sample, so spikes survive however far the plot is
+ * zoomed out. decimateBand() does the same for a min..max band.
+ *
+ * The last point before xMin and the first after xMax are kept so the
+ * line still enters and leaves the plot at the right height.
+ *
+ * Inputs use ScrollingBuffer's layout (arrays of @p size entries, the
+ * oldest at @p offset); outputs are plain arrays in time order.
+ */
+
+#pragma once
+
+#include "scrolling_buffer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace decimate_detail {
+
+/**
+ * Calls @p visit(k, column) for the ring entries in time order, where k
+ * is the position from the oldest entry and column is in [0, columns).
+ * The last entry before xMin is visited with column -1 and the first
+ * after xMax with column @p columns, after which the walk stops. Entries
+ * older than that are skipped by binary search, so the cost follows the
+ * number of visible points rather than the size of the ring.
+ */
+template <class Visit>
+void walkColumns(const float* xs, int size, int offset, float xMin, float xMax,
+                 int columns, Visit&& visit) {
+    const double scale = columns / (static_cast<double>(xMax) - xMin);
+    int before = -1;
+    for (int k = std::max(0, ringLowerBound(xs, size, offset, xMin) - 1); k < size; ++k) {
+        int idx = offset + k;
+        if (idx >= size) idx -= size;
+        const float x = xs[idx];
+        if (x < xMin) {
+            before = k;
+            continue;
+        }
+        if (before >= 0) {
+            visit(before, -1);
+            before = -1;
+        }
+        if (x > xMax) {
+            visit(k, columns);
+            return;
+        }
+        int col = static_cast<int>((x - xMin) * scale);
+        visit(k, std::min(col, columns - 1));
+    }
+    if (before >= 0) visit(before, -1);
+}
+
+} // namespace decimate_detail
+
+/**
+ * @brief M4 decimation of a line to @p columns pixel columns.
+ *
+ * Replaces the contents of @p outX / @p outY with at most
+ * 4 * columns + 2 points. Nothing is written when the ring is empty,
+ * @p columns is not positive or the window is empty.
+ */
+inline void decimateMinMax(const float* xs, const float* ys, int size, int offset,
+                           float xMin, float xMax, int columns,
+                           std::vector<float>& outX, std::vector<float>& outY) {
+    outX.clear();
+    outY.clear();
+    if (size <= 0 || columns <= 0 || !(xMax > xMin)) return;
+
+    auto at = [&](int k) { return offset + k < size ? offset + k : offset + k - size; };
+    auto emit = [&](int k) {
+        outX.push_back(xs[at(k)]);
+        outY.push_back(ys[at(k)]);
+    };
+
+    int cur = -2;                      // column being gathered; -2 for none
+    int first = 0, lo = 0, hi = 0, last = 0;
+    auto flush = [&] {
+        if (cur == -2) return;
+        int pts[4] = {first, lo, hi, last};
+        std::sort(pts, pts + 4);
+        for (int i = 0; i < 4; ++i)
+            if (i == 0 || pts[i] != pts[i - 1]) emit(pts[i]);
+    };
+
+    decimate_detail::walkColumns(xs, size, offset, xMin, xMax, columns, [&](int k, int col) {
+        if (col != cur) {
+            flush();
+            cur = col;
+            first = lo = hi = last = k;
+            return;
+        }
+        const float y = ys[at(k)];
+        if (y < ys[at(lo)]) lo = k;
+        if (y > ys[at(hi)]) hi = k;
+        last = k;
+    });
+    flush();
+}
+
+/**
+ * @brief Decimation of a min..max band to @p columns pixel columns.
+ *
+ * Each column becomes its first and last time, both spanning the lowest
+ * @p lo and highest @p hi in the column, so the filled area covers the
+ * same pixels. Replaces the output arrays with at most 2 * columns + 2
+ * points; empty inputs write nothing, as for decimateMinMax().
+ */
+inline void decimateBand(const float* xs, const float* lo, const float* hi, int size,
+                         int offset, float xMin, float xMax, int columns,
+                         std::vector<float>& outX, std::vector<float>& outLo,
+                         std::vector<float>& outHi) {
+    outX.clear();
+    outLo.clear();
+    outHi.clear();
+    if (size <= 0 || columns <= 0 || !(xMax > xMin)) return;
+
+    auto at = [&](int k) { return offset + k < size ? offset + k : offset + k - size; };
+
+    int cur = -2;
+    float x0 = 0.0f, x1 = 0.0f, bandLo = 0.0f, bandHi = 0.0f;
+    auto flush = [&] {
+        if (cur == -2) return;
+        outX.push_back(x0);
+        outLo.push_back(bandLo);
+        outHi.push_back(bandHi);
+        if (x1 != x0) {
+            outX.push_back(x1);
+            outLo.push_back(bandLo);
+            outHi.push_back(bandHi);
+        }
+    };
+
+    decimate_detail::walkColumns(xs, size, offset, xMin, xMax, columns, [&](int k, int col) {
+        const int idx = at(k);
+        if (col != cur) {
+            flush();
+            cur    = col;
+            x0     = x1 = xs[idx];
+            bandLo = lo[idx];
+            bandHi = hi[idx];
+            return;
+        }
+        x1     = xs[idx];
+        bandLo = std::min(bandLo, lo[idx]);
+        bandHi = std::max(bandHi, hi[idx]);
+    });
+    flush();
+}
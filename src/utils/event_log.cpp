@@ -0,0 +1,361 @@
+/**
+ * @file event_log.cpp
+ * @brief Event file writer (fed by the Logger's writer) and decoder.
+ */
+
+#include "event_log.h"
+#include "logger.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+std::atomic<bool> EventLog::enabled_{false};
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'M', 'E', 'V', 'L', 'O', 'G', '1'};
+
+/// Size of an argument's value after its type byte, or 0 for an unknown type.
+std::size_t fixedArgSize(char type) {
+    switch (type) {
+    case 'i': case 'u': case 'd': return 8;
+    case 'l':                     return 4;
+    default:                      return 0;
+    }
+}
+
+template <class T>
+T readAt(const char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// The open event file. Written only from the Logger's drain, under mtx.
+struct EventFile {
+    std::mutex        mtx;
+    std::FILE*        file = nullptr;
+    std::string       path;
+    uint64_t          bytes    = 0;
+    uint64_t          maxBytes = 0;
+    std::vector<bool> defined;  ///< String ids already written to this file
+    std::string       out;
+};
+
+EventFile& eventFile() {
+    static EventFile* f = new EventFile;  // outlives the Logger's atexit flush
+    return *f;
+}
+
+bool startFile(EventFile& f) {
+    f.file = std::fopen(f.path.c_str(), "wb");
+    if (!f.file) return false;
+    std::setvbuf(f.file, nullptr, _IONBF, 0);
+    std::fwrite(kMagic, 1, sizeof(kMagic), f.file);
+    f.bytes = sizeof(kMagic);
+    f.defined.clear();
+    return true;
+}
+
+void defineString(EventFile& f, uint32_t id) {
+    if (id < f.defined.size() && f.defined[id]) return;
+    if (id >= f.defined.size()) f.defined.resize(id + 1 + id / 2, false);
+    f.defined[id] = true;
+    const std::string& text = InternPool::global().lookup(id);
+    auto len = static_cast<uint16_t>(std::min<std::size_t>(text.size(), UINT16_MAX));
+    f.out.push_back('S');
+    f.out.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    f.out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    f.out.append(text.data(), len);
+}
+
+/**
+ * Logger::EventSink. @p records holds, per event, the wall-clock
+ * nanoseconds, a u16 length and the bytes EventLog::emit() encoded.
+ */
+void writeEvents(const char* records, std::size_t size) {
+    EventFile& f = eventFile();
+    std::lock_guard<std::mutex> lock(f.mtx);
+    if (!f.file) return;
+    f.out.clear();
+    std::size_t pos = 0;
+    while (pos + 10 <= size) {
+        const int64_t  wallNs = readAt<int64_t>(records + pos);
+        const uint16_t len    = readAt<uint16_t>(records + pos + 8);
+        const char*    rec    = records + pos + 10;
+        pos += 10 + len;
+        if (len < 8 || pos > size) break;
+
+        // Define the format and any Label arguments before the event.
+        defineString(f, readAt<uint32_t>(rec));
+        for (std::size_t a = 8; a < len;) {
+            char type = rec[a++];
+            if (type == 's') {
+                a += 2 + readAt<uint16_t>(rec + a);
+                continue;
+            }
+            if (type == 'l') defineString(f, readAt<uint32_t>(rec + a));
+            std::size_t n = fixedArgSize(type);
+            if (n == 0) break;
+            a += n;
+        }
+
+        const uint16_t argBytes = static_cast<uint16_t>(len - 8);
+        f.out.push_back('E');
+        f.out.append(reinterpret_cast<const char*>(&wallNs), sizeof(wallNs));
+        f.out.append(rec + 4, 4);   // thread
+        f.out.append(rec, 4);       // format id
+        f.out.append(reinterpret_cast<const char*>(&argBytes), sizeof(argBytes));
+        f.out.append(rec + 8, argBytes);
+    }
+    std::fwrite(f.out.data(), 1, f.out.size(), f.file);
+    f.bytes += f.out.size();
+
+    if (f.maxBytes && f.bytes >= f.maxBytes) {
+        std::fclose(f.file);
+        f.file = nullptr;
+        std::error_code ec;
+        std::filesystem::rename(f.path, f.path + ".1", ec);
+        startFile(f);
+    }
+}
+
+// ---- decoding --------------------------------------------------------------
+
+void appendJsonString(std::string& out, std::string_view s) {
+    out.push_back('"');
+    for (char ch : s) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(ch);
+        } else if (c < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        } else {
+            out.push_back(ch);
+        }
+    }
+    out.push_back('"');
+}
+
+struct DecodedArg {
+    char        type;
+    std::string text;  ///< Rendered value
+};
+
+std::string formatTimestamp(int64_t wallNs) {
+    int64_t sec = wallNs / 1000000000;
+    int64_t us  = (wallNs / 1000) % 1000000;
+    if (us < 0) {
+        --sec;
+        us += 1000000;
+    }
+    std::time_t tt = static_cast<std::time_t>(sec);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm);
+#endif
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%s.%06d", date, static_cast<int>(us));
+    return buf;
+}
+
+/// @p format with each "{}" replaced by the next argument; extra arguments are appended.
+std::string fillFormat(std::string_view format, const std::vector<DecodedArg>& args) {
+    std::string out;
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '{' && i + 1 < format.size() && format[i + 1] == '}') {
+            out += next < args.size() ? args[next++].text : std::string("{}");
+            ++i;
+        } else {
+            out.push_back(format[i]);
+        }
+    }
+    for (; next < args.size(); ++next) out += " " + args[next].text;
+    return out;
+}
+
+} // namespace
+
+// ---- EventLog --------------------------------------------------------------
+
+bool EventLog::open(const std::string& path, uint64_t maxBytes) {
+    close();
+    EventFile& f = eventFile();
+    {
+        std::lock_guard<std::mutex> lock(f.mtx);
+        f.path     = path;
+        f.maxBytes = maxBytes;
+        if (!startFile(f)) return false;
+    }
+    Logger::setEventSink(&writeEvents);
+    enabled_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void EventLog::close() {
+    enabled_.store(false, std::memory_order_relaxed);
+    Logger::flush();
+    EventFile& f = eventFile();
+    std::lock_guard<std::mutex> lock(f.mtx);
+    if (f.file) std::fclose(f.file);
+    f.file = nullptr;
+}
+
+uint32_t EventLog::threadId() {
+    thread_local uint32_t id = [] {
+#if defined(_WIN32)
+        return static_cast<uint32_t>(GetCurrentThreadId());
+#elif defined(__linux__)
+        return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+        static std::atomic<uint32_t> next{1};
+        return next++;
+#endif
+    }();
+    return id;
+}
+
+void EventLog::submit(const char* record, std::size_t bytes) {
+    Logger::logEvent(std::string_view(record, bytes));
+}
+
+bool decodeEventLog(std::istream& in, std::ostream& out, EventDumpFormat format,
+                    std::string& error) {
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "not an event log (bad magic)";
+        return false;
+    }
+
+    std::unordered_map<uint32_t, std::string> strings;
+    auto stringFor = [&](uint32_t id) {
+        auto it = strings.find(id);
+        return it != strings.end() ? it->second : "<string " + std::to_string(id) + ">";
+    };
+
+    std::vector<char>       args;
+    std::vector<DecodedArg> decoded;
+    std::string             line;
+    bool truncated = false;
+    char kind;
+    while (!truncated && in.get(kind)) {
+        if (kind == 'S') {
+            char head[6];
+            if (!in.read(head, sizeof(head))) {
+                truncated = true;
+                break;
+            }
+            std::string text(readAt<uint16_t>(head + 4), '\0');
+            if (!in.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+                truncated = true;
+                break;
+            }
+            strings[readAt<uint32_t>(head)] = std::move(text);
+            continue;
+        }
+        if (kind != 'E') {
+            error = "unknown record type at offset " + std::to_string(static_cast<long long>(in.tellg()) - 1);
+            return false;
+        }
+        char head[18];
+        if (!in.read(head, sizeof(head))) {
+            truncated = true;
+            break;
+        }
+        const int64_t  wallNs = readAt<int64_t>(head);
+        const uint32_t tid    = readAt<uint32_t>(head + 8);
+        const uint32_t fmtId  = readAt<uint32_t>(head + 12);
+        args.resize(readAt<uint16_t>(head + 16));
+        if (!in.read(args.data(), static_cast<std::streamsize>(args.size()))) {
+            truncated = true;
+            break;
+        }
+
+        decoded.clear();
+        for (std::size_t a = 0; a < args.size();) {
+            char type = args[a++];
+            DecodedArg d{type, {}};
+            if (type == 's' && a + 2 <= args.size()) {
+                uint16_t n = readAt<uint16_t>(args.data() + a);
+                a += 2;
+                d.text.assign(args.data() + a, std::min<std::size_t>(n, args.size() - a));
+                a += n;
+            } else if (std::size_t n = fixedArgSize(type); n && a + n <= args.size()) {
+                const char* p = args.data() + a;
+                if (type == 'i')      d.text = std::to_string(readAt<int64_t>(p));
+                else if (type == 'u') d.text = std::to_string(readAt<uint64_t>(p));
+                else if (type == 'l') d.text = stringFor(readAt<uint32_t>(p));
+                else {
+                    char buf[32];
+                    std::snprintf(buf, sizeof(buf), "%g", readAt<double>(p));
+                    d.text = buf;
+                }
+                a += n;
+            } else {
+                break;  // malformed argument list: keep what was read
+            }
+            decoded.push_back(std::move(d));
+        }
+
+        const std::string fmt  = stringFor(fmtId);
+        const std::string text = fillFormat(fmt, decoded);
+        line.clear();
+        if (format == EventDumpFormat::Json) {
+            line += "{\"ts_ns\":" + std::to_string(wallNs) + ",\"tid\":" + std::to_string(tid)
+                  + ",\"event\":";
+            appendJsonString(line, fmt);
+            line += ",\"args\":[";
+            for (std::size_t i = 0; i < decoded.size(); ++i) {
+                if (i) line.push_back(',');
+                char t = decoded[i].type;
+                if (t == 's' || t == 'l')
+                    appendJsonString(line, decoded[i].text);
+                else if (t == 'd' && !std::isfinite(std::strtod(decoded[i].text.c_str(), nullptr)))
+                    line += "null";
+                else
+                    line += decoded[i].text;
+            }
+            line += "],\"text\":";
+            appendJsonString(line, text);
+            line += "}\n";
+        } else {
+            line = formatTimestamp(wallNs) + " [" + std::to_string(tid) + "] " + text + "\n";
+        }
+        out << line;
+    }
+    if (truncated) {
+        error = "last record is truncated";
+        return false;
+    }
+    if (in.bad()) {
+        error = "read error";
+        return false;
+    }
+    return true;
+}
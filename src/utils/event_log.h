@@ -0,0 +1,152 @@
+/**
+ * @file event_log.h
+ * @brief Compact binary log for high-rate internal events.
+ *
+ * Module timings, dropped pipeline samples, alert transitions and stale
+ * modules happen too often to be worth a formatted text line each. An
+ * EventType names the event with a format string whose "{}" placeholders
+ * are filled by the arguments, and is interned once:
+ *
+ *     static const EventType kUpdate("module {} update took {} us");
+ *     EventLog::emit(kUpdate, name, us);
+ *
+ * emit() encodes the format id, the thread id and the typed arguments
+ * (integers, doubles, strings, Labels) into a small record and queues it
+ * on the async Logger's per-thread ring; the Logger's writer appends the
+ * records to the event file, merged across threads in timestamp order
+ * within each pass. A record stamped just before a pass can still be
+ * published after it and land in the next one, a few milliseconds out
+ * of place, so a reader that needs strict order should sort by time. While the event log is closed, emit() costs
+ * one relaxed load and a branch.
+ *
+ * File layout (host byte order), starting with the magic "RMEVLOG1":
+ *   'S' u32 id, u16 length, bytes        a string: format or Label text
+ *   'E' i64 wall ns, u32 thread, u32 format id, u16 arg bytes, args
+ * Each argument is a type byte ('i' i64, 'u' u64, 'd' f64, 'l' u32 string
+ * id, 's' u16 length + bytes) followed by its value. A string is defined
+ * before the first event that refers to it, in every file, so a rotated
+ * file decodes on its own. decodeEventLog() (and ResourceMonitorEventDump)
+ * turns a file back into text or JSON lines.
+ */
+
+#pragma once
+
+#include "intern.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// @brief An interned event format. Construct once (e.g. as a static) per event kind.
+class EventType {
+public:
+    explicit EventType(std::string_view format) : id_(InternPool::global().intern(format)) {}
+    uint32_t id() const { return id_; }
+
+private:
+    uint32_t id_;
+};
+
+namespace eventlog_detail {
+
+/// Largest encoded event; strings are cut to fit.
+constexpr std::size_t kMaxEventBytes = 512;
+
+struct Encoder {
+    char        buf[kMaxEventBytes];
+    std::size_t n = 0;
+
+    void put(char tag, const void* value, std::size_t len) {
+        if (n + 1 + len > sizeof(buf)) return;
+        buf[n++] = tag;
+        std::memcpy(buf + n, value, len);
+        n += len;
+    }
+    void putString(std::string_view s) {
+        if (n + 3 > sizeof(buf)) return;
+        auto len = static_cast<uint16_t>(std::min(s.size(), sizeof(buf) - n - 3));
+        buf[n++] = 's';
+        std::memcpy(buf + n, &len, sizeof(len));
+        std::memcpy(buf + n + sizeof(len), s.data(), len);
+        n += sizeof(len) + len;
+    }
+};
+
+template <class T>
+void encode(Encoder& e, const T& v) {
+    if constexpr (std::is_same_v<T, Label>) {
+        uint32_t id = v.id();
+        e.put('l', &id, sizeof(id));
+    } else if constexpr (std::is_same_v<T, bool>) {
+        uint64_t u = v ? 1 : 0;
+        e.put('u', &u, sizeof(u));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        int64_t i = v;
+        e.put('i', &i, sizeof(i));
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        uint64_t u = static_cast<uint64_t>(v);
+        e.put('u', &u, sizeof(u));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double d = v;
+        e.put('d', &d, sizeof(d));
+    } else {
+        e.putString(std::string_view(v));
+    }
+}
+
+} // namespace eventlog_detail
+
+class EventLog {
+public:
+    /// @brief Whether events are being recorded. One relaxed load.
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start recording to @p path, replacing its contents.
+     *
+     * Once the file reaches @p maxBytes it is renamed to "<path>.1"
+     * (replacing the previous one) and a new file is started.
+     * @return false if the file could not be created.
+     */
+    static bool open(const std::string& path, uint64_t maxBytes = uint64_t{64} << 20);
+
+    /// @brief Write the events queued so far and stop recording.
+    static void close();
+
+    /// @brief Record one event of @p type. Arguments fill its "{}" placeholders in order.
+    template <class... Args>
+    static void emit(const EventType& type, const Args&... args) {
+        if (!enabled()) return;
+        eventlog_detail::Encoder e;
+        uint32_t head[2] = {type.id(), threadId()};
+        std::memcpy(e.buf, head, sizeof(head));
+        e.n = sizeof(head);
+        (eventlog_detail::encode(e, args), ...);
+        submit(e.buf, e.n);
+    }
+
+private:
+    static uint32_t threadId();
+    static void submit(const char* record, std::size_t bytes);
+
+    static std::atomic<bool> enabled_;
+};
+
+enum class EventDumpFormat { Text, Json };
+
+/**
+ * @brief Decode an event file written by EventLog.
+ *
+ * Text lines look like "2026-01-31 12:00:00.123456 [1234] module cpu update
+ * took 85 us"; JSON lines carry ts_ns, tid, event (the format), args and
+ * text. @return false (with @p error set) on a bad magic or a truncated
+ * record; what was decoded up to that point has been written.
+ */
+bool decodeEventLog(std::istream& in, std::ostream& out, EventDumpFormat format,
+                    std::string& error);
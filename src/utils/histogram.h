@@ -0,0 +1,85 @@
+/**
+ * @file histogram.h
+ * @brief Fixed-size log2 histogram for latency-style measurements.
+ *
+ * Bucket 0 holds zero; bucket i (i >= 1) holds values in [2^(i-1), 2^i).
+ * With 32 buckets and microsecond units this covers 1 us to ~18 minutes
+ * (larger values land in the last bucket) at a constant 264 bytes and
+ * no allocation, so it can be copied into every MetricData.
+ *
+ * Not thread-safe; the owner serialises access.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Histogram {
+public:
+    static constexpr std::size_t kBuckets = 32;
+
+    /// Add one sample (unit chosen by the caller, e.g. microseconds).
+    void record(uint64_t value) {
+        ++buckets_[bucketFor(value)];
+        ++count_;
+        sum_ += value;
+        max_  = std::max(max_, value);
+    }
+
+    /// Add every sample of @p other.
+    void merge(const Histogram& other) {
+        for (std::size_t i = 0; i < kBuckets; ++i) buckets_[i] += other.buckets_[i];
+        count_ += other.count_;
+        sum_   += other.sum_;
+        max_    = std::max(max_, other.max_);
+    }
+
+    void reset() { *this = Histogram{}; }
+
+    uint64_t count() const { return count_; }
+    uint64_t sum()   const { return sum_; }
+    uint64_t max()   const { return max_; }
+    double   mean()  const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /// Samples in bucket @p i.
+    uint64_t bucketCount(std::size_t i) const { return i < kBuckets ? buckets_[i] : 0; }
+
+    /// Largest value that falls into bucket @p i.
+    static uint64_t bucketUpper(std::size_t i) {
+        if (i == 0) return 0;
+        if (i >= kBuckets - 1) return UINT64_MAX;
+        return (uint64_t{1} << i) - 1;
+    }
+
+    /**
+     * @brief Approximate quantile.
+     * @param q Quantile in [0, 1] (0.5 = median, 0.99 = p99).
+     * @return Upper bound of the bucket holding the quantile, capped at max().
+     */
+    uint64_t percentile(double q) const {
+        if (count_ == 0) return 0;
+        q = std::min(1.0, std::max(0.0, q));
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(count_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) return std::min(bucketUpper(i), max_);
+        }
+        return max_;
+    }
+
+private:
+    static std::size_t bucketFor(uint64_t v) {
+        std::size_t b = 0;
+        while (v != 0 && b < kBuckets - 1) { v >>= 1; ++b; }
+        return b;
+    }
+
+    std::array<uint64_t, kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_   = 0;
+    uint64_t max_   = 0;
+};
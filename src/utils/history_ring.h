@@ -0,0 +1,214 @@
+/**
+ * @file history_ring.h
+ * @brief Multi-resolution chart history: raw samples plus min/max/avg tiers.
+ *
+ * A HistoryRing keeps one series at several resolutions, RRD-style:
+ * the raw samples in a ScrollingBuffer (an hour at 1 Hz by default) and
+ * consolidated tiers of fixed-width buckets, by default 10 s buckets for
+ * 24 hours and 1 min buckets for 7 days. Every tier is a fixed-capacity
+ * ring allocated up front, so a series costs the same memory (about
+ * 385 KB with the defaults) whether it has run for a minute or a month.
+ *
+ * Each AddPoint() folds the sample into the newest bucket of every tier
+ * in O(1); that bucket is the one being filled and is already visible,
+ * so the coarse tiers reach right up to the latest sample. A sample
+ * whose bucket is past the newest one closes it and starts the next.
+ *
+ * The GUI picks a tier per plot with PickTier(): the finest one that
+ * still holds the whole visible window without exceeding a point budget.
+ * Tier rings use the same (DataX, offset) layout as ScrollingBuffer, so
+ * ImPlot reads them in place.
+ */
+
+#pragma once
+
+#include "scrolling_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief One consolidated resolution: a ring of (start, min, max, avg) buckets.
+struct HistoryTier {
+    float              BucketSec;
+    int                MaxSize;
+    int                Offset = 0;
+    std::vector<float> DataX;    ///< Bucket start time
+    std::vector<float> DataMin;
+    std::vector<float> DataMax;
+    std::vector<float> DataAvg;
+
+    HistoryTier(float bucket_sec, int max_size)
+        : BucketSec(bucket_sec), MaxSize(max_size) {
+        DataX.reserve(max_size);
+        DataMin.reserve(max_size);
+        DataMax.reserve(max_size);
+        DataAvg.reserve(max_size);
+    }
+
+    void AddPoint(float x, float y) {
+        auto bucket = static_cast<int64_t>(std::floor(x / BucketSec));
+        if (count_ == 0 || bucket != bucket_) {
+            bucket_ = bucket;
+            count_  = 0;
+            sum_    = 0.0;
+            newest_ = push(static_cast<float>(bucket) * BucketSec, y);
+        }
+        ++count_;
+        sum_ += y;
+        DataMin[newest_] = std::min(DataMin[newest_], y);
+        DataMax[newest_] = std::max(DataMax[newest_], y);
+        DataAvg[newest_] = static_cast<float>(sum_ / count_);
+    }
+
+    int Size() const { return static_cast<int>(DataX.size()); }
+
+    bool Empty() const { return DataX.empty(); }
+
+    /// Start time of the oldest bucket still held.
+    float OldestX() const {
+        if (DataX.empty()) return 0.0f;
+        return Size() < MaxSize ? DataX[0] : DataX[Offset];
+    }
+
+    /// Max of the bucket maxima for buckets ending after @p xMin (or 0).
+    float MaxYInWindow(float xMin) const {
+        float mx = 0.0f;
+        for (int k = ringUpperBound(DataX.data(), Size(), Offset, xMin - BucketSec);
+             k < Size(); ++k) {
+            int idx = Offset + k;
+            if (idx >= Size()) idx -= Size();
+            mx = std::max(mx, DataMax[idx]);
+        }
+        return mx;
+    }
+
+    void Erase() {
+        DataX.clear();
+        DataMin.clear();
+        DataMax.clear();
+        DataAvg.clear();
+        Offset = 0;
+        count_ = 0;
+    }
+
+private:
+    /// Append a bucket (overwriting the oldest once full); returns its index.
+    int push(float x, float y) {
+        int idx;
+        if (Size() < MaxSize) {
+            idx = Size();
+            DataX.push_back(x);
+            DataMin.push_back(y);
+            DataMax.push_back(y);
+            DataAvg.push_back(y);
+        } else {
+            idx = Offset;
+            DataX[idx] = x;
+            DataMin[idx] = DataMax[idx] = DataAvg[idx] = y;
+            Offset = (Offset + 1) % MaxSize;
+        }
+        return idx;
+    }
+
+    int64_t bucket_ = 0;   ///< Bucket number of the newest entry
+    int     newest_ = 0;   ///< Its index in the ring
+    int     count_  = 0;   ///< Samples folded into it
+    double  sum_    = 0.0;
+};
+
+/// @brief One series at raw resolution plus coarser HistoryTiers.
+class HistoryRing {
+public:
+    struct TierSpec {
+        float bucketSec;
+        int   buckets;
+    };
+
+    /// Raw: @p raw_size samples. Tiers: 10 s for 24 h and 1 min for 7 days.
+    explicit HistoryRing(int raw_size = 3600)
+        : HistoryRing(raw_size, {{10.0f, 8640}, {60.0f, 10080}}) {}
+
+    HistoryRing(int raw_size, std::vector<TierSpec> tiers) : raw_(raw_size) {
+        tiers_.reserve(tiers.size());
+        for (const auto& t : tiers) tiers_.emplace_back(t.bucketSec, t.buckets);
+    }
+
+    void AddPoint(float x, float y) {
+        raw_.AddPoint(x, y);
+        for (auto& t : tiers_) t.AddPoint(x, y);
+    }
+
+    const ScrollingBuffer& Raw() const { return raw_; }
+    int TierCount() const { return static_cast<int>(tiers_.size()); }
+    const HistoryTier& Tier(int i) const { return tiers_[i]; }
+
+    int Size() const { return raw_.Size(); }
+    bool Empty() const { return raw_.Empty(); }
+    float Back() const { return raw_.Back(); }
+
+    /**
+     * @brief The tier to draw the window [xMin, latest] from.
+     *
+     * @return -1 for the raw samples, otherwise an index for Tier(): the
+     * finest resolution that holds data back to @p xMin (or everything
+     * since the start) in no more than @p maxPoints points. When no tier
+     * fits the budget, the coarsest one that reaches back far enough, or
+     * failing that the coarsest of all.
+     */
+    int PickTier(float xMin, int maxPoints = 4000) const {
+        if (raw_.Empty()) return -1;
+        const float newest = rawNewestX();
+        // Points drawn from a ring whose oldest entry is at oldest, step apart.
+        auto points = [&](float oldest, float step) {
+            return (newest - std::max(xMin, oldest)) / step;
+        };
+
+        // Raw covers the window if it has not wrapped or its oldest sample is old enough.
+        const bool rawFull = raw_.Size() == raw_.MaxSize;
+        const float rawOldest = rawFull ? raw_.DataX[raw_.Offset] : raw_.DataX[0];
+        if (!rawFull || rawOldest <= xMin) {
+            float step = raw_.Size() > 1 ? (newest - rawOldest) / (raw_.Size() - 1) : 1.0f;
+            if (step <= 0.0f || points(rawOldest, step) <= static_cast<float>(maxPoints)) return -1;
+        }
+
+        int reaching = -1;
+        for (int i = 0; i < TierCount(); ++i) {
+            const HistoryTier& t = tiers_[i];
+            if (t.Size() == t.MaxSize && t.OldestX() > xMin) continue;
+            reaching = i;
+            if (points(t.OldestX(), t.BucketSec) <= static_cast<float>(maxPoints)) return i;
+        }
+        return reaching >= 0 ? reaching : TierCount() - 1;
+    }
+
+    /// Max Y over [xMin, latest], read from the tier PickTier() would draw.
+    float MaxYInWindow(float xMin, int maxPoints = 4000) const {
+        int tier = PickTier(xMin, maxPoints);
+        return tier < 0 ? raw_.MaxYInWindow(xMin) : tiers_[tier].MaxYInWindow(xMin);
+    }
+
+    void Erase() {
+        raw_.Erase();
+        for (auto& t : tiers_) t.Erase();
+    }
+
+    /// Bytes reserved for this series; fixed at construction.
+    std::size_t MemoryBytes() const {
+        // Raw X and Y plus the raw buffer's min and max trees (2 floats per slot each).
+        std::size_t bytes = 6 * sizeof(float) * static_cast<std::size_t>(raw_.MaxSize);
+        for (const auto& t : tiers_) bytes += 4 * sizeof(float) * static_cast<std::size_t>(t.MaxSize);
+        return bytes;
+    }
+
+private:
+    float rawNewestX() const {
+        int idx = raw_.Offset == 0 ? raw_.Size() - 1 : raw_.Offset - 1;
+        return raw_.DataX[idx];
+    }
+
+    ScrollingBuffer          raw_;
+    std::vector<HistoryTier> tiers_;
+};
@@ -0,0 +1,68 @@
+/**
+ * @file intern.cpp
+ * @brief InternPool implementation.
+ */
+
+#include "intern.h"
+
+#include <algorithm>
+
+InternPool& InternPool::global() {
+    // Never destroyed: Labels in static objects may outlive main().
+    static InternPool* pool = new InternPool();
+    return *pool;
+}
+
+InternPool::InternPool(std::size_t maxStrings)
+    : maxStrings_(std::clamp<std::size_t>(maxStrings, 2, std::size_t{kMaxChunks} << kChunkBits))
+    , chunks_(new std::atomic<std::string*>[kMaxChunks])
+{
+    for (uint32_t i = 0; i < kMaxChunks; ++i) chunks_[i].store(nullptr, std::memory_order_relaxed);
+    std::string* first = new std::string[kChunkSize];
+    first[kOverflowId] = "<intern pool full>";
+    chunks_[0].store(first, std::memory_order_release);
+    // The overflow text is not indexed, so interning it yields a real id.
+    index_.emplace(std::string_view(), 0);
+    count_.store(kOverflowId + 1, std::memory_order_release);
+}
+
+InternPool::~InternPool() {
+    for (uint32_t i = 0; i < kMaxChunks; ++i) delete[] chunks_[i].load(std::memory_order_relaxed);
+}
+
+void InternPool::setMaxStrings(std::size_t maxStrings) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    maxStrings_ = std::clamp<std::size_t>(maxStrings, 2, std::size_t{kMaxChunks} << kChunkBits);
+}
+
+uint32_t InternPool::intern(std::string_view s) {
+    if (s.empty()) return 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        auto it = index_.find(s);
+        if (it != index_.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    auto it = index_.find(s);  // another thread may have added it meanwhile
+    if (it != index_.end()) return it->second;
+
+    auto id = static_cast<uint32_t>(count_.load(std::memory_order_relaxed));
+    if (id >= maxStrings_) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        return kOverflowId;
+    }
+    uint32_t chunk = id >> kChunkBits;
+    std::string* slots = chunks_[chunk].load(std::memory_order_relaxed);
+    if (!slots) {
+        slots = new std::string[kChunkSize];
+        chunks_[chunk].store(slots, std::memory_order_release);
+    }
+
+    std::string& stored = slots[id & kChunkMask];
+    stored.assign(s.data(), s.size());
+    index_.emplace(std::string_view(stored), id);
+    bytes_.fetch_add(s.size(), std::memory_order_relaxed);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
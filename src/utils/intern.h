@@ -0,0 +1,132 @@
+/**
+ * @file intern.h
+ * @brief Process-wide string intern pool and the Label handle it hands out.
+ *
+ * Interface names, device paths, mount points, filesystem types, user and
+ * process names, and TCP states repeat in every snapshot of every tick.
+ * Snapshots store them as a Label: a 4-byte id into a global pool that
+ * keeps one copy of each distinct string for the life of the process.
+ * Copying a snapshot (the GUI does it every frame) then copies ids rather
+ * than strings, and equality is an integer compare.
+ *
+ * Ids are only meaningful inside one process run; anything persisted
+ * (see Database) must map them to its own keys.
+ *
+ * Interning is thread-safe. Looking up a Label's text never locks: the
+ * pool stores strings in fixed chunks that are never moved or freed.
+ *
+ * Since nothing is freed, only strings drawn from a bounded set belong in
+ * a Label; paths that churn (mount points of container bind mounts, for
+ * one) stay plain std::string. Should the pool still fill up, intern()
+ * returns kOverflowId, whose text is "<intern pool full>", rather than
+ * failing on a collection thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class InternPool {
+public:
+    /// @brief The process-wide pool used by Label.
+    static InternPool& global();
+
+    /// Id handed out for every new string once the pool is full.
+    static constexpr uint32_t kOverflowId = 1;
+
+    /// @param maxStrings Distinct strings kept, including "" and the overflow text.
+    explicit InternPool(std::size_t maxStrings = std::size_t{kMaxChunks} << kChunkBits);
+    ~InternPool();
+    InternPool(const InternPool&) = delete;
+    InternPool& operator=(const InternPool&) = delete;
+
+    /**
+     * @brief Id for @p s, adding it on first use. The empty string is id 0.
+     *
+     * Never throws for lack of room: once the pool is full, strings not
+     * already in it get kOverflowId (and are counted by overflows()).
+     */
+    uint32_t intern(std::string_view s);
+
+    /// @brief Text for an id returned by intern().
+    const std::string& lookup(uint32_t id) const {
+        return chunks_[id >> kChunkBits].load(std::memory_order_acquire)[id & kChunkMask];
+    }
+
+    /// @brief Number of distinct strings, including the empty string.
+    std::size_t size() const { return count_.load(std::memory_order_acquire); }
+
+    /// @brief Bytes of string data held (excluding bookkeeping).
+    std::size_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+    /// @brief intern() calls answered with kOverflowId because the pool was full.
+    uint64_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Change the cap on distinct strings (clamped as in the constructor).
+     *
+     * Ids already handed out stay valid; a cap below size() just makes every
+     * new string overflow. Lets tests drive the global pool into overflow.
+     */
+    void setMaxStrings(std::size_t maxStrings);
+
+private:
+    static constexpr uint32_t kChunkBits = 10;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+    static constexpr uint32_t kChunkMask = kChunkSize - 1;
+    static constexpr uint32_t kMaxChunks = 4096;  ///< 4M distinct strings.
+
+    std::size_t maxStrings_;  ///< Guarded by mtx_.
+    mutable std::shared_mutex mtx_;
+    std::unordered_map<std::string_view, uint32_t> index_;  ///< Views into chunks_.
+    std::unique_ptr<std::atomic<std::string*>[]> chunks_;
+    std::atomic<std::size_t> count_{0};
+    std::atomic<std::size_t> bytes_{0};
+    std::atomic<uint64_t>    overflows_{0};
+};
+
+/**
+ * @brief Interned string handle.
+ *
+ * Converts implicitly from and to strings so that code written against
+ * std::string fields (assignment, c_str(), empty(), comparisons) keeps
+ * working. Ordering is by text, so sorting by name is unchanged.
+ */
+class Label {
+public:
+    Label() = default;
+    Label(std::string_view s)   : id_(InternPool::global().intern(s)) {}
+    Label(const std::string& s) : Label(std::string_view(s)) {}
+    Label(const char* s)        : Label(std::string_view(s ? s : "")) {}
+
+    /// @brief Pool id; stable for the life of the process.
+    uint32_t id() const { return id_; }
+
+    const std::string& str() const { return InternPool::global().lookup(id_); }
+    operator const std::string&() const { return str(); }
+
+    const char* c_str()  const { return str().c_str(); }
+    std::size_t size()   const { return str().size(); }
+    bool        empty()  const { return id_ == 0; }
+
+    friend bool operator==(Label a, Label b) { return a.id_ == b.id_; }
+    friend bool operator!=(Label a, Label b) { return a.id_ != b.id_; }
+    friend bool operator==(Label a, std::string_view b) { return a.str() == b; }
+    friend bool operator!=(Label a, std::string_view b) { return a.str() != b; }
+    friend bool operator==(Label a, const char* b) { return a.str() == b; }
+    friend bool operator!=(Label a, const char* b) { return a.str() != b; }
+    friend bool operator==(Label a, const std::string& b) { return a.str() == b; }
+    friend bool operator!=(Label a, const std::string& b) { return a.str() != b; }
+    friend bool operator<(Label a, Label b) { return a.id_ != b.id_ && a.str() < b.str(); }
+
+private:
+    uint32_t id_ = 0;
+};
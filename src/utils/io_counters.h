@@ -0,0 +1,48 @@
+/**
+ * @file io_counters.h
+ * @brief Per-thread syscall, file-open and bytes-read counters.
+ *
+ * Used to attribute the I/O cost of a module update to the module: the
+ * worker takes threadIoUsage() before and after the job and keeps the
+ * difference.
+ *
+ * On Linux the kernel already counts read/write syscalls and bytes read
+ * per thread (/proc/thread-self/io); threadIoUsage() starts from those,
+ * so every plain read() is included without any bookkeeping in the
+ * modules. Opens, closes and io_uring submissions are not part of those
+ * kernel counters, so the shared readers (BatchReader, readFileInto)
+ * report them with noteFileOpen() / noteSyscalls() / noteBytesRead().
+ * Elsewhere only the reported figures are available.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief I/O done by one thread. Counters only grow; subtract two readings.
+struct IoUsage {
+    uint64_t syscalls  = 0;  ///< System calls made for I/O.
+    uint64_t fileOpens = 0;  ///< Files opened.
+    uint64_t bytesRead = 0;  ///< Bytes read (and so parsed) from files.
+
+    IoUsage& operator+=(const IoUsage& o) {
+        syscalls += o.syscalls; fileOpens += o.fileOpens; bytesRead += o.bytesRead;
+        return *this;
+    }
+    friend IoUsage operator-(IoUsage a, const IoUsage& b) {
+        a.syscalls -= b.syscalls; a.fileOpens -= b.fileOpens; a.bytesRead -= b.bytesRead;
+        return a;
+    }
+};
+
+/// @brief Count one file open (and its close) made by the calling thread.
+void noteFileOpen();
+
+/// @brief Count @p n syscalls the kernel does not attribute to reads or writes.
+void noteSyscalls(uint64_t n);
+
+/// @brief Count @p n bytes read by a path the kernel does not count (io_uring).
+void noteBytesRead(uint64_t n);
+
+/// @brief Cumulative I/O of the calling thread.
+IoUsage threadIoUsage();
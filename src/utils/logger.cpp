@@ -1,65 +1,593 @@
 /**
  * @file logger.cpp
- * @brief Thread-safe logger implementation.
+ * @brief Per-thread log rings and the background writer.
  */
 
 #include "logger.h"
-#include <fstream>
-#include <iostream>
+
+#include <algorithm>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
-std::mutex  Logger::log_mutex_;
-std::string Logger::log_file_path_ = "ResourceMonitor.log";
-LogLevel    Logger::min_level_     = LogLevel::Info;
-bool        Logger::console_       = false;
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
 
-void Logger::initialize(const std::string& path) {
-    std::lock_guard<std::mutex> lk(log_mutex_);
-    log_file_path_ = path;
+std::atomic<LogLevel> Logger::min_level_{LogLevel::Info};
+
+namespace {
+
+/// Bytes of ring per logging thread. A power of two.
+constexpr std::size_t kRingBytes = std::size_t{1} << 16;
+
+/// Shortest pause between two writer passes, so a busy logger is drained in batches.
+constexpr auto kBatchInterval = std::chrono::milliseconds(5);
+
+/// RecordHeader::level of a binary EventLog record.
+constexpr uint8_t kEventRecord = 0xFF;
+
+/// Precedes each message in a ring. bytes = 0 marks the rest of the ring as skipped.
+struct RecordHeader {
+    int64_t  wallNs;   ///< system_clock nanoseconds since the epoch
+    uint32_t bytes;    ///< Header plus text, rounded up to 8
+    uint16_t textLen;
+    uint8_t  level;    ///< A LogLevel, or kEventRecord
+    uint8_t  pad;
+};
+static_assert(sizeof(RecordHeader) == 16, "records are packed in 8-byte steps");
+
+constexpr std::size_t align8(std::size_t n) { return (n + 7) & ~std::size_t{7}; }
+
+/**
+ * Single producer (its thread), single consumer (whoever holds
+ * LogState::drainMtx). head and tail only grow; the producer publishes a
+ * record by storing head with release after writing it, and the consumer
+ * frees its space by storing tail with release after copying it out.
+ */
+struct Ring {
+    std::unique_ptr<char[]> data{new char[kRingBytes]};
+    std::atomic<uint64_t>   head{0};
+    std::atomic<uint64_t>   tail{0};
+    std::atomic<uint64_t>   dropped{0};
+
+    /// @return false if the ring was full. @p halfFull is set once the ring is over half full.
+    bool push(int64_t wallNs, uint8_t level, std::string_view text, bool& halfFull) {
+        const std::size_t len  = std::min(text.size(), Logger::kMaxMessage);
+        const std::size_t need = align8(sizeof(RecordHeader) + len);
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        const uint64_t freed = tail.load(std::memory_order_acquire);
+        std::size_t off  = static_cast<std::size_t>(pos & (kRingBytes - 1));
+        std::size_t room = kRingBytes - off;
+        // A record never wraps: skip the end of the ring if it does not fit there.
+        const std::size_t skip = room < need ? room : 0;
+        if (pos + skip + need - freed > kRingBytes) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            halfFull = true;
+            return false;
+        }
+        if (skip) {
+            if (room >= sizeof(RecordHeader)) {
+                RecordHeader marker{};
+                std::memcpy(data.get() + off, &marker, sizeof(marker));
+            }
+            pos += skip;
+            off  = 0;
+        }
+        RecordHeader h{wallNs, static_cast<uint32_t>(need), static_cast<uint16_t>(len), level, 0};
+        std::memcpy(data.get() + off, &h, sizeof(h));
+        std::memcpy(data.get() + off + sizeof(h), text.data(), len);
+        head.store(pos + need, std::memory_order_release);
+        halfFull = pos + need - freed > kRingBytes / 2;
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+    }
+};
+
+/// A drained message: its text is in LogState::text at textOff.
+struct Pending {
+    int64_t     wallNs;
+    std::size_t textOff;
+    uint16_t    textLen;
+    uint8_t     level;
+};
+
+enum class WriterState { NotStarted, Running, Stopped };
+
+struct LogState {
+    std::mutex                         registryMtx;  ///< Guards rings.
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::atomic<uint64_t>              retiredDropped{0};  ///< From rings already removed
+
+    // Everything below is guarded by drainMtx.
+    std::mutex    drainMtx;
+    std::string   path = "ResourceMonitor.log";
+    std::FILE*    file = nullptr;
+    int           fd   = -1;   ///< file's descriptor, for the crash flush
+    uint64_t      fileBytes = 0;
+    uint64_t      maxBytes  = uint64_t{10} << 20;
+    int           keepFiles = 3;
+    uint64_t      droppedReported = 0;
+    std::vector<std::shared_ptr<Ring>> draining;
+    std::vector<Pending> pending;
+    std::string   text;
+    std::string   out;
+    std::vector<Pending> eventPending;  ///< This pass's event records; bytes in eventText
+    std::string   eventText;
+    std::string   events;  ///< eventPending in time order: wallNs, length, bytes
+    void (*eventSink)(const char*, std::size_t) = nullptr;  ///< Logger::EventSink
+    int64_t       cachedSec = -1;
+    char          cachedStamp[32] = {};
+
+    std::atomic<bool> console{false};
+
+    // Writer thread. dirty is set by the first message after a pass,
+    // urgent by a message that leaves its ring over half full.
+    std::mutex              wakeMtx;
+    std::condition_variable wakeCv;
+    std::atomic<bool>       dirty{false};
+    std::atomic<bool>       urgent{false};
+    bool                    stop = false;
+    std::atomic<WriterState> writerState{WriterState::NotStarted};
+    std::thread             writer;
+};
+
+/// Never destroyed, so threads and atexit handlers can log during shutdown.
+LogState& state() {
+    static LogState* s = new LogState;
+    return *s;
+}
+
+Ring& localRing() {
+    thread_local std::shared_ptr<Ring> ring;
+    if (!ring) {
+        ring = std::make_shared<Ring>();
+        LogState& s = state();
+        std::lock_guard<std::mutex> lock(s.registryMtx);
+        s.rings.push_back(ring);
+    }
+    return *ring;
 }
 
-void Logger::setLevel(LogLevel level)       { min_level_ = level; }
-void Logger::setConsoleOutput(bool enabled) { console_   = enabled; }
+const char* levelTag(uint8_t level) {
+    static const char* tags[] = {"[DBG]", "[INF]", "[WRN]", "[ERR]"};
+    return tags[level < 4 ? level : 3];
+}
 
-void Logger::log(const std::string& msg) {
-    log(LogLevel::Info, msg);
+// ---- file ------------------------------------------------------------------
+
+bool openFile(LogState& s) {
+    if (s.file) return true;
+    s.file = std::fopen(s.path.c_str(), "ab");
+    if (!s.file) return false;
+    std::setvbuf(s.file, nullptr, _IONBF, 0);  // each pass is already one buffer
+#ifndef _WIN32
+    s.fd = fileno(s.file);
+#endif
+    std::error_code ec;
+    auto size   = std::filesystem::file_size(s.path, ec);
+    s.fileBytes = ec ? 0 : size;
+    return true;
 }
 
-void Logger::debug(const std::string& msg) { log(LogLevel::Debug,   msg); }
-void Logger::warn (const std::string& msg) { log(LogLevel::Warning, msg); }
-void Logger::error(const std::string& msg) { log(LogLevel::Error,   msg); }
+void closeFile(LogState& s) {
+    if (s.file) std::fclose(s.file);
+    s.file = nullptr;
+    s.fd   = -1;
+}
 
-void Logger::log(LogLevel level, const std::string& message) {
-    if (level < min_level_) return;
+/// <path> -> <path>.1 -> ... -> <path>.<keepFiles>, dropping the oldest.
+void rotate(LogState& s) {
+    closeFile(s);
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    auto numbered = [&](int i) { return s.path + "." + std::to_string(i); };
+    if (s.keepFiles <= 0) {
+        fs::remove(s.path, ec);
+        return;
+    }
+    fs::remove(numbered(s.keepFiles), ec);
+    for (int i = s.keepFiles - 1; i >= 1; --i) fs::rename(numbered(i), numbered(i + 1), ec);
+    fs::rename(s.path, numbered(1), ec);
+}
+
+// ---- draining --------------------------------------------------------------
+
+/// Call @p fn(header, text) for every published record of @p ring, then free them.
+template <class Fn>
+void consumeRing(Ring& ring, Fn&& fn) {
+    uint64_t pos = ring.tail.load(std::memory_order_relaxed);
+    const uint64_t end = ring.head.load(std::memory_order_acquire);
+    while (pos < end) {
+        const std::size_t off  = static_cast<std::size_t>(pos & (kRingBytes - 1));
+        const std::size_t room = kRingBytes - off;
+        if (room < sizeof(RecordHeader)) {
+            pos += room;
+            continue;
+        }
+        RecordHeader h;
+        std::memcpy(&h, ring.data.get() + off, sizeof(h));
+        if (h.bytes == 0) {
+            pos += room;
+            continue;
+        }
+        fn(h, ring.data.get() + off + sizeof(h));
+        pos += h.bytes;
+    }
+    ring.tail.store(pos, std::memory_order_release);
+}
 
-    static const char* tags[] = {"[DBG]","[INF]","[WRN]","[ERR]"};
-    const char* tag = tags[static_cast<int>(level)];
+/// Move every published record out of @p ring into s.pending / s.text
+/// (s.eventPending / s.eventText for event records).
+void drainRing(LogState& s, Ring& ring) {
+    consumeRing(ring, [&s](const RecordHeader& h, const char* text) {
+        if (h.level == kEventRecord) {
+            s.eventPending.push_back({h.wallNs, s.eventText.size(), h.textLen, h.level});
+            s.eventText.append(text, h.textLen);
+        } else {
+            s.pending.push_back({h.wallNs, s.text.size(), h.textLen, h.level});
+            s.text.append(text, h.textLen);
+        }
+    });
+}
 
-    auto now   = std::chrono::system_clock::now();
-    auto tt    = std::chrono::system_clock::to_time_t(now);
-    auto ms    = std::chrono::duration_cast<std::chrono::milliseconds>(
-                     now.time_since_epoch()) % 1000;
-    std::tm tm{};
+void appendLine(LogState& s, int64_t wallNs, uint8_t level, std::string_view msg) {
+    int64_t sec = wallNs / 1000000000;
+    int64_t ms  = (wallNs / 1000000) % 1000;
+    if (wallNs < 0 && wallNs % 1000000000) {
+        --sec;
+        ms += 1000;
+    }
+    if (sec != s.cachedSec) {
+        std::time_t tt = static_cast<std::time_t>(sec);
+        std::tm tm{};
 #ifdef _WIN32
-    localtime_s(&tm, &tt);
+        localtime_s(&tm, &tt);
 #else
-    localtime_r(&tt, &tm);
+        localtime_r(&tt, &tm);
 #endif
+        std::strftime(s.cachedStamp, sizeof(s.cachedStamp), "%Y-%m-%d %H:%M:%S", &tm);
+        s.cachedSec = sec;
+    }
+    char prefix[48];
+    int n = std::snprintf(prefix, sizeof(prefix), "%s.%03d %s ", s.cachedStamp,
+                          static_cast<int>(ms), levelTag(level));
+    const std::size_t lineStart = s.out.size();
+    s.out.append(prefix, static_cast<std::size_t>(n));
+    s.out.append(msg);
+    s.out.push_back('\n');
+    if (s.console.load(std::memory_order_relaxed)) {
+        std::string_view line(s.out.data() + lineStart, s.out.size() - lineStart);
+        (level >= static_cast<uint8_t>(LogLevel::Warning) ? std::cerr : std::cout) << line;
+    }
+}
 
-    std::ostringstream ss;
-    ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S")
-       << '.' << std::setfill('0') << std::setw(3) << ms.count()
-       << ' ' << tag << ' ' << message;
-    std::string line = ss.str();
+/// Write out everything published so far, in timestamp order. Caller holds drainMtx.
+void drainLocked(LogState& s) {
+    uint64_t droppedTotal = s.retiredDropped.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(s.registryMtx);
+        s.draining = s.rings;
+    }
+    s.pending.clear();
+    s.text.clear();
+    s.eventPending.clear();
+    s.eventText.clear();
+    for (auto& ring : s.draining) {
+        drainRing(s, *ring);
+        droppedTotal += ring->dropped.load(std::memory_order_relaxed);
+    }
+    {
+        // Forget the rings of exited threads once they are empty.
+        std::lock_guard<std::mutex> lock(s.registryMtx);
+        auto gone = std::remove_if(s.rings.begin(), s.rings.end(), [&](const auto& r) {
+            // Held by rings, draining and nothing else: its thread has exited.
+            if (r.use_count() > 2 || !r->empty()) return false;
+            s.retiredDropped.fetch_add(r->dropped.load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+            return true;
+        });
+        s.rings.erase(gone, s.rings.end());
+    }
+    s.draining.clear();
+    auto byTime = [](const Pending& a, const Pending& b) { return a.wallNs < b.wallNs; };
+    if (!s.eventPending.empty() && s.eventSink) {
+        // Rings are drained one after another; merge their events by time.
+        std::stable_sort(s.eventPending.begin(), s.eventPending.end(), byTime);
+        s.events.clear();
+        for (const Pending& e : s.eventPending) {
+            s.events.append(reinterpret_cast<const char*>(&e.wallNs), sizeof(e.wallNs));
+            s.events.append(reinterpret_cast<const char*>(&e.textLen), sizeof(e.textLen));
+            s.events.append(s.eventText.data() + e.textOff, e.textLen);
+        }
+        s.eventSink(s.events.data(), s.events.size());
+    }
+    if (s.pending.empty() && droppedTotal == s.droppedReported) return;
+
+    std::stable_sort(s.pending.begin(), s.pending.end(), byTime);
+    s.out.clear();
+    for (const Pending& p : s.pending)
+        appendLine(s, p.wallNs, p.level, std::string_view(s.text.data() + p.textOff, p.textLen));
+    if (droppedTotal > s.droppedReported) {
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count();
+        appendLine(s, now, static_cast<uint8_t>(LogLevel::Warning),
+                   std::to_string(droppedTotal - s.droppedReported)
+                       + " log messages dropped (logging thread outran the writer)");
+        s.droppedReported = droppedTotal;
+    }
+
+    if (!openFile(s)) return;
+    std::fwrite(s.out.data(), 1, s.out.size(), s.file);
+    s.fileBytes += s.out.size();
+    if (s.maxBytes && s.fileBytes >= s.maxBytes) rotate(s);
+}
 
-    std::lock_guard<std::mutex> lk(log_mutex_);
+// ---- writer thread ---------------------------------------------------------
 
-    if (console_) {
-        (level >= LogLevel::Warning ? std::cerr : std::cout) << line << '\n';
+void writerLoop() {
+    LogState& s = state();
+    std::unique_lock<std::mutex> lock(s.wakeMtx);
+    while (!s.stop) {
+        s.wakeCv.wait(lock, [&] { return s.stop || s.dirty.load(std::memory_order_acquire); });
+        if (s.stop) break;
+        s.dirty.store(false, std::memory_order_release);
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> drain(s.drainMtx);
+            drainLocked(s);
+        }
+        lock.lock();
+        s.wakeCv.wait_for(lock, kBatchInterval, [&] {
+            return s.stop || s.urgent.load(std::memory_order_acquire);
+        });
+        s.urgent.store(false, std::memory_order_relaxed);
     }
+}
+
+void startWriter(LogState& s) {
+    std::lock_guard<std::mutex> lock(s.wakeMtx);
+    if (s.writerState.load() != WriterState::NotStarted) return;
+    s.writer = std::thread(writerLoop);
+    s.writerState.store(WriterState::Running, std::memory_order_release);
+    std::atexit(&Logger::shutdown);
+}
+
+/// Called after every push: start, wake or (after shutdown) stand in for the writer.
+void afterPush(LogState& s, bool halfFull) {
+    switch (s.writerState.load(std::memory_order_acquire)) {
+    case WriterState::Running:
+        // Only the first message after a pass, and one that fills a ring
+        // past half, pay for the wake-up.
+        if ((!s.dirty.load(std::memory_order_relaxed)
+             && !s.dirty.exchange(true, std::memory_order_acq_rel))
+            || (halfFull && !s.urgent.exchange(true, std::memory_order_acq_rel))) {
+            // Taking the lock orders this with the writer's predicate check.
+            { std::lock_guard<std::mutex> lock(s.wakeMtx); }
+            s.wakeCv.notify_one();
+        }
+        break;
+    case WriterState::NotStarted:
+        s.dirty.store(true, std::memory_order_release);
+        startWriter(s);  // the new thread sees dirty under wakeMtx
+        s.wakeCv.notify_one();
+        break;
+    case WriterState::Stopped:
+        Logger::flush();
+        break;
+    }
+}
+
+#ifndef _WIN32
+constexpr int kFatalSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+struct sigaction previousAction[NSIG];
+
+// The crash flush runs in a signal handler, possibly one raised inside
+// malloc or while a logger lock is held. It therefore only try_locks,
+// never allocates and uses no stdio or locale: lines are formatted by
+// hand (UTC time, marked "Z") into a static buffer and written with
+// write(2). Rings are written one after another, not merged by time, and
+// event records are left for the event file's next reader to miss.
+
+char crashLine[64 + Logger::kMaxMessage];
+
+/// Append @p v in decimal, zero-padded to @p width digits.
+char* putDec(char* p, int64_t v, int width) {
+    char digits[24];
+    int n = 0;
+    uint64_t u = v < 0 ? 0 : static_cast<uint64_t>(v);
+    do {
+        digits[n++] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u);
+    while (n < width) digits[n++] = '0';
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+/// "YYYY-MM-DD HH:MM:SS.mmmZ" in UTC, from days-since-epoch arithmetic.
+char* putUtcStamp(char* p, int64_t wallNs) {
+    int64_t sec  = wallNs / 1000000000;
+    int64_t ms   = (wallNs / 1000000) % 1000;
+    int64_t days = sec / 86400;
+    int64_t tod  = sec % 86400;
+    // Howard Hinnant's civil_from_days.
+    int64_t z   = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp  = (5 * doy + 2) / 153;
+    int64_t d   = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m   = mp < 10 ? mp + 3 : mp - 9;
+    int64_t y   = yoe + era * 400 + (m <= 2);
+    p = putDec(p, y, 4);       *p++ = '-';
+    p = putDec(p, m, 2);       *p++ = '-';
+    p = putDec(p, d, 2);       *p++ = ' ';
+    p = putDec(p, tod / 3600, 2);      *p++ = ':';
+    p = putDec(p, tod / 60 % 60, 2);   *p++ = ':';
+    p = putDec(p, tod % 60, 2);        *p++ = '.';
+    p = putDec(p, ms, 3);      *p++ = 'Z';
+    return p;
+}
+
+void writeAll(int fd, const char* data, std::size_t len) {
+    while (len) {
+        ssize_t n = ::write(fd, data, len);
+        if (n <= 0) return;
+        data += n;
+        len  -= static_cast<std::size_t>(n);
+    }
+}
+
+/// Best effort: write what is queued, or nothing if a logger lock is taken.
+void crashFlush(LogState& s) {
+    if (!s.drainMtx.try_lock()) return;
+    if (!s.registryMtx.try_lock()) {
+        s.drainMtx.unlock();
+        return;
+    }
+    int fd = s.fd >= 0 ? s.fd
+                       : ::open(s.path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+        for (const auto& ring : s.rings) {
+            consumeRing(*ring, [fd](const RecordHeader& h, const char* text) {
+                if (h.level == kEventRecord) return;
+                char* p = putUtcStamp(crashLine, h.wallNs);
+                *p++ = ' ';
+                const char* tag = levelTag(h.level);
+                const std::size_t tagLen = std::strlen(tag);
+                std::memcpy(p, tag, tagLen);
+                p += tagLen;
+                *p++ = ' ';
+                std::memcpy(p, text, h.textLen);
+                p += h.textLen;
+                *p++ = '\n';
+                writeAll(fd, crashLine, static_cast<std::size_t>(p - crashLine));
+            });
+        }
+    }
+    s.registryMtx.unlock();
+    s.drainMtx.unlock();
+}
+
+void onFatalSignal(int sig) {
+    crashFlush(state());
+    // Hand over to the previous handler; the signal is delivered again once this returns.
+    sigaction(sig, &previousAction[sig], nullptr);
+    std::raise(sig);
+}
+
+void installCrashFlush() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        for (int sig : kFatalSignals) {
+            struct sigaction sa{};
+            sa.sa_handler = onFatalSignal;
+            sigemptyset(&sa.sa_mask);
+            sigaction(sig, &sa, &previousAction[sig]);
+        }
+    });
+}
+#else
+void installCrashFlush() {}
+#endif
+
+} // namespace
+
+// ---- Logger ----------------------------------------------------------------
+
+void Logger::initialize(const std::string& path) {
+    LogState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.drainMtx);
+        drainLocked(s);
+        closeFile(s);
+        s.path = path;
+    }
+    installCrashFlush();
+}
+
+void Logger::setLevel(LogLevel level)       { min_level_.store(level, std::memory_order_relaxed); }
+void Logger::setConsoleOutput(bool enabled) { state().console.store(enabled, std::memory_order_relaxed); }
+
+void Logger::setRotation(uint64_t maxBytes, int keepFiles) {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.drainMtx);
+    s.maxBytes  = maxBytes;
+    s.keepFiles = keepFiles;
+}
+
+void Logger::log(std::string_view msg) {
+    log(LogLevel::Info, msg);
+}
+
+void Logger::debug(std::string_view msg) { log(LogLevel::Debug,   msg); }
+void Logger::warn (std::string_view msg) { log(LogLevel::Warning, msg); }
+void Logger::error(std::string_view msg) { log(LogLevel::Error,   msg); }
+
+void Logger::log(LogLevel level, std::string_view message) {
+    if (level < min_level_.load(std::memory_order_relaxed)) return;
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+    bool halfFull = false;
+    localRing().push(now, static_cast<uint8_t>(level), message, halfFull);
+    afterPush(state(), halfFull);
+}
+
+void Logger::logEvent(std::string_view record) {
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+    bool halfFull = false;
+    localRing().push(now, kEventRecord, record, halfFull);
+    afterPush(state(), halfFull);
+}
+
+void Logger::setEventSink(EventSink sink) {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.drainMtx);
+    s.eventSink = sink;
+}
+
+void Logger::flush() {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.drainMtx);
+    drainLocked(s);
+}
+
+void Logger::shutdown() {
+    LogState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.wakeMtx);
+        if (s.writerState.load() == WriterState::Running) s.stop = true;
+        s.writerState.store(WriterState::Stopped, std::memory_order_release);
+    }
+    s.wakeCv.notify_one();
+    if (s.writer.joinable() && s.writer.get_id() != std::this_thread::get_id()) s.writer.join();
+    std::lock_guard<std::mutex> lock(s.drainMtx);
+    drainLocked(s);
+    closeFile(s);
+}
 
-    std::ofstream f(log_file_path_, std::ios_base::app);
-    if (f.is_open()) f << line << '\n';
+uint64_t Logger::dropped() {
+    LogState& s = state();
+    uint64_t total = s.retiredDropped.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(s.registryMtx);
+    for (const auto& r : s.rings) total += r->dropped.load(std::memory_order_relaxed);
+    return total;
 }
@@ -1,30 +1,85 @@
 /**
  * @file logger.h
- * @brief Thread-safe logger with severity levels and optional console output.
+ * @brief Asynchronous logger with severity levels and optional console output.
+ *
+ * A call to log() copies the message into a ring owned by the calling
+ * thread, with its level and a wall-clock timestamp, and returns; no lock,
+ * no formatting and no I/O happen on the caller. One background writer
+ * drains every thread's ring, formats the lines
+ * ("YYYY-MM-DD HH:MM:SS.mmm [TAG] message") in timestamp order and appends
+ * them to the log file with one buffered write per pass. The file stays
+ * open between passes and is rotated by size (see setRotation()).
+ *
+ * The writer wakes on the first message after a pass and then batches for
+ * a few milliseconds, or less when a ring is half full. If a ring fills
+ * anyway the message is dropped and counted, and the writer notes how
+ * many were lost. Messages longer than kMaxMessage bytes are truncated.
+ *
+ * The same rings and writer carry the binary records of the EventLog
+ * (event_log.h), which the writer hands to the event sink instead of
+ * the text file.
+ *
+ * flush() writes everything logged so far before returning. The logger
+ * flushes itself at exit, and after initialize() also on a fatal signal
+ * (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) before the signal's previous
+ * handler runs. That flush is async-signal-safe: it skips itself if a
+ * logger lock is held, writes each thread's queue in order with write(2)
+ * and stamps those lines in UTC ("...mmmZ").
  */
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <mutex>
+#include <string_view>
 
 enum class LogLevel { Debug, Info, Warning, Error };
 
 class Logger {
 public:
+    /// Longest message kept in full; longer ones are cut to this many bytes.
+    static constexpr std::size_t kMaxMessage = 4096;
+
+    /// @brief Log to @p log_file_path from now on. Pending lines go to the previous file first.
     static void initialize(const std::string& log_file_path);
     static void setLevel(LogLevel level);
     static void setConsoleOutput(bool enabled);
 
-    static void log(const std::string& message);                     // Info
-    static void log(LogLevel level, const std::string& message);
-    static void debug(const std::string& message);
-    static void warn(const std::string& message);
-    static void error(const std::string& message);
+    /**
+     * @brief Rotate the log file once it reaches @p maxBytes.
+     *
+     * The full file becomes "<path>.1", the previous "<path>.1" becomes
+     * "<path>.2", and so on; at most @p keepFiles old files are kept.
+     * @p maxBytes = 0 disables rotation. Default: 10 MiB, 3 old files.
+     */
+    static void setRotation(std::uint64_t maxBytes, int keepFiles);
+
+    static void log(std::string_view message);                     // Info
+    static void log(LogLevel level, std::string_view message);
+    static void debug(std::string_view message);
+    static void warn(std::string_view message);
+    static void error(std::string_view message);
+
+    /// @brief Write every message logged before this call, then return.
+    static void flush();
+
+    /// @brief Flush, stop the writer thread and close the file. Later messages are written synchronously.
+    static void shutdown();
+
+    /// @brief Messages lost so far because their thread's ring was full.
+    static std::uint64_t dropped();
 
 private:
-    static std::mutex  log_mutex_;
-    static std::string log_file_path_;
-    static LogLevel    min_level_;
-    static bool        console_;
+    friend class EventLog;
+
+    /// Receives the binary event records of one writer pass (see event_log.h).
+    using EventSink = void (*)(const char* records, std::size_t bytes);
+
+    /// @brief Queue one encoded event for the event sink. Not filtered by level.
+    static void logEvent(std::string_view record);
+    static void setEventSink(EventSink sink);
+
+    static std::atomic<LogLevel> min_level_;
 };
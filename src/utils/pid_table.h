@@ -0,0 +1,109 @@
+/**
+ * @file pid_table.h
+ * @brief Open-addressing hash table keyed by PID, reused across ticks.
+ *
+ * Replaces the per-tick std::unordered_map<int, T> that modules rebuild
+ * and move-assign every update: clear() keeps the slot array, so once
+ * the table has grown to the steady-state process count an update does
+ * not allocate. Linear probing over a power-of-two array; key 0 marks an
+ * empty slot (PID 0 is never a real /proc entry). There is no erase --
+ * callers double-buffer two tables and clear the older one each tick.
+ *
+ * Not thread-safe; the owner serialises access.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename V>
+class PidTable {
+public:
+    /// @brief Number of stored keys.
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /// @brief Number of slots (for tests; grows, never shrinks).
+    std::size_t capacity() const { return slots_.size(); }
+
+    /// @brief Remove every key but keep the slot array.
+    void clear() {
+        if (size_ == 0) return;
+        for (auto& s : slots_) s.key = 0;
+        size_ = 0;
+    }
+
+    /// @brief Make room for @p n keys without rehashing.
+    void reserve(std::size_t n) {
+        std::size_t want = kMinSlots;
+        while (want < n * 2) want *= 2;  // keep the load factor <= 1/2
+        if (want > slots_.size()) rehash(want);
+    }
+
+    /// @brief Value for @p pid, or nullptr.
+    V* find(int pid) {
+        if (slots_.empty() || pid == 0) return nullptr;
+        for (std::size_t i = home(pid);; i = (i + 1) & mask()) {
+            if (slots_[i].key == pid) return &slots_[i].value;
+            if (slots_[i].key == 0)   return nullptr;
+        }
+    }
+    const V* find(int pid) const { return const_cast<PidTable*>(this)->find(pid); }
+
+    /// @brief Value for @p pid, default-constructed if absent.
+    V& operator[](int pid) {
+        if ((size_ + 1) * 2 > slots_.size())
+            rehash(slots_.empty() ? kMinSlots : slots_.size() * 2);
+        for (std::size_t i = home(pid);; i = (i + 1) & mask()) {
+            if (slots_[i].key == pid) return slots_[i].value;
+            if (slots_[i].key == 0) {
+                slots_[i].key   = pid;
+                slots_[i].value = V{};
+                ++size_;
+                return slots_[i].value;
+            }
+        }
+    }
+
+    /// @brief Call @p fn(pid, value) for every key.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& s : slots_)
+            if (s.key != 0) fn(s.key, s.value);
+    }
+
+    void swap(PidTable& other) noexcept {
+        slots_.swap(other.slots_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    static constexpr std::size_t kMinSlots = 64;
+
+    struct Slot {
+        int key = 0;
+        V   value{};
+    };
+
+    std::size_t mask() const { return slots_.size() - 1; }
+
+    /// Fibonacci hashing: consecutive PIDs spread across the array.
+    std::size_t home(int pid) const {
+        uint64_t h = static_cast<uint32_t>(pid) * UINT64_C(0x9E3779B97F4A7C15);
+        return static_cast<std::size_t>(h >> 32) & mask();
+    }
+
+    void rehash(std::size_t n) {
+        std::vector<Slot> old(n);
+        old.swap(slots_);
+        size_ = 0;
+        for (auto& s : old)
+            if (s.key != 0) (*this)[s.key] = std::move(s.value);
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t       size_ = 0;
+};
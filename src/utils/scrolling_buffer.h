@@ -9,12 +9,51 @@
  * Usage with ImPlot:
  *   ImPlot::PlotLine("label", buf.DataX.data(), buf.DataY.data(),
  *                    buf.Size(), 0, 0, buf.Offset, sizeof(float));
+ *
+ * X values are expected to increase from one AddPoint() to the next
+ * (they are sample times), so a time window is found by binary search:
+ * LowerBound() / UpperBound() return positions counted from the oldest
+ * point. Range min/max over such positions use a min/max segment tree
+ * over the slots, updated by AddPoint() in O(log n), so a query costs
+ * O(log n) however wide the range is (two trees' worth when it crosses
+ * the wrap).
  */
 
 #pragma once
 
-#include <vector>
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Position (0 = oldest) of the first of @p size ring entries whose
+ * X is >= @p x, or @p size if none; the oldest entry is at @p offset.
+ */
+inline int ringLowerBound(const float* xs, int size, int offset, float x) {
+    int lo = 0, hi = size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int idx = offset + mid;
+        if (idx >= size) idx -= size;
+        if (xs[idx] < x) lo = mid + 1;
+        else             hi = mid;
+    }
+    return lo;
+}
+
+/// @brief As ringLowerBound(), for the first X that is > @p x.
+inline int ringUpperBound(const float* xs, int size, int offset, float x) {
+    int lo = 0, hi = size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int idx = offset + mid;
+        if (idx >= size) idx -= size;
+        if (xs[idx] <= x) lo = mid + 1;
+        else              hi = mid;
+    }
+    return lo;
+}
 
 struct ScrollingBuffer {
     int                MaxSize;
@@ -26,17 +65,31 @@ struct ScrollingBuffer {
         : MaxSize(max_size), Offset(0) {
         DataX.reserve(max_size);
         DataY.reserve(max_size);
+        treeMin_.resize(2 * static_cast<std::size_t>(max_size));
+        treeMax_.resize(2 * static_cast<std::size_t>(max_size));
     }
 
     void AddPoint(float x, float y) {
+        int idx;
         if (static_cast<int>(DataX.size()) < MaxSize) {
+            idx = Size();
             DataX.push_back(x);
             DataY.push_back(y);
         } else {
+            idx = Offset;
             DataX[Offset] = x;
             DataY[Offset] = y;
             Offset = (Offset + 1) % MaxSize;
         }
+        // Leaf, then every node above it. A node is only read by a query
+        // whose range covers all its slots, and each of those was written
+        // (refreshing the node) since the last Erase().
+        int i = idx + MaxSize;
+        treeMin_[i] = treeMax_[i] = y;
+        for (; i > 1; i >>= 1) {
+            treeMin_[i >> 1] = std::min(treeMin_[i], treeMin_[i ^ 1]);
+            treeMax_[i >> 1] = std::max(treeMax_[i], treeMax_[i ^ 1]);
+        }
     }
 
     int Size() const { return static_cast<int>(DataX.size()); }
@@ -57,13 +110,63 @@ struct ScrollingBuffer {
         return DataY[idx];
     }
 
-    /// Return the max Y value for points with X >= xMin.
+    /// Index into DataX/DataY of the point at position @p k (0 = oldest).
+    int Index(int k) const {
+        int idx = Offset + k;
+        return idx >= Size() ? idx - Size() : idx;
+    }
+
+    /// Position of the first point with X >= @p x, or Size() if none.
+    int LowerBound(float x) const { return ringLowerBound(DataX.data(), Size(), Offset, x); }
+
+    /// Position of the first point with X > @p x, or Size() if none.
+    int UpperBound(float x) const { return ringUpperBound(DataX.data(), Size(), Offset, x); }
+
+    /// Max Y over positions [first, last); the lowest float if the range is empty.
+    float MaxY(int first, int last) const {
+        return reduce(first, last, std::numeric_limits<float>::lowest(), treeMax_,
+                      [](float a, float b) { return std::max(a, b); });
+    }
+
+    /// Min Y over positions [first, last); the largest float if the range is empty.
+    float MinY(int first, int last) const {
+        return reduce(first, last, std::numeric_limits<float>::max(), treeMin_,
+                      [](float a, float b) { return std::min(a, b); });
+    }
+
+    /// Return the max Y value for points with X >= xMin (or 0 if none is above 0).
     float MaxYInWindow(float xMin) const {
-        float mx = 0.0f;
-        for (int i = 0; i < Size(); ++i) {
-            if (DataX[i] >= xMin && DataY[i] > mx)
-                mx = DataY[i];
+        return std::max(0.0f, MaxY(LowerBound(xMin), Size()));
+    }
+
+private:
+    template <class Pick>
+    float reduce(int first, int last, float init, const std::vector<float>& tree,
+                 Pick pick) const {
+        float m = init;
+        if (first >= last) return m;
+        const int start = Index(first);
+        const int count = last - first;
+        if (start + count <= Size()) {
+            m = reduceRun(start, start + count, m, tree, pick);
+        } else {
+            m = reduceRun(start, Size(), m, tree, pick);
+            m = reduceRun(0, start + count - Size(), m, tree, pick);
+        }
+        return m;
+    }
+
+    /// Reduce slots [a, b) bottom-up through the tree.
+    template <class Pick>
+    float reduceRun(int a, int b, float m, const std::vector<float>& tree, Pick pick) const {
+        for (a += MaxSize, b += MaxSize; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) m = pick(m, tree[a++]);
+            if (b & 1) m = pick(m, tree[--b]);
         }
-        return mx;
+        return m;
     }
+
+    /// Min / max segment trees: slot i is leaf MaxSize + i, node n covers 2n and 2n + 1.
+    std::vector<float> treeMin_;
+    std::vector<float> treeMax_;
 };
@@ -0,0 +1,75 @@
+/**
+ * @file tick_arena.h
+ * @brief Monotonic std::pmr arena for per-tick scratch data.
+ *
+ * A module calls reset() at the start of update() and allocates its
+ * temporary containers (PID lists, lookup maps) from resource(). Those
+ * allocations are pointer bumps into one buffer and are all dropped by
+ * the next reset(). When a tick outgrows the buffer, the overflow is
+ * served from the heap and the buffer is resized to the high-water mark
+ * at the next reset(), so a steady workload stops touching the heap
+ * after its first few ticks.
+ *
+ * Not thread-safe; each module owns its own arena.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+class TickArena {
+public:
+    explicit TickArena(std::size_t initialBytes = 16 * 1024)
+        : size_(initialBytes),
+          buffer_(new std::byte[initialBytes]),
+          mono_(buffer_.get(), size_, &overflow_) {}
+
+    TickArena(const TickArena&) = delete;
+    TickArena& operator=(const TickArena&) = delete;
+
+    /// @brief Resource to hand to std::pmr containers for this tick.
+    std::pmr::memory_resource* resource() { return &mono_; }
+
+    /// @brief Drop everything allocated since the last reset().
+    void reset() {
+        std::size_t used = overflow_.bytes;
+        mono_.release();
+        overflow_.bytes = 0;
+        if (used > 0) {
+            // Grow once to cover the last tick; the monotonic resource
+            // needs the whole buffer, so reconstruct it in place.
+            size_ += used + used / 2;
+            buffer_.reset(new std::byte[size_]);
+            mono_.~monotonic_buffer_resource();
+            new (&mono_) std::pmr::monotonic_buffer_resource(buffer_.get(), size_, &overflow_);
+        }
+    }
+
+    /// @brief Size of the arena's own buffer in bytes.
+    std::size_t capacity() const { return size_; }
+
+private:
+    /// Upstream that records how much the arena had to borrow from the heap.
+    struct Overflow : std::pmr::memory_resource {
+        std::size_t bytes = 0;
+
+        void* do_allocate(std::size_t n, std::size_t align) override {
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+        void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+        bool do_is_equal(const memory_resource& o) const noexcept override {
+            return this == &o;
+        }
+    };
+
+    std::size_t                         size_;
+    std::unique_ptr<std::byte[]>        buffer_;
+    Overflow                            overflow_;
+    std::pmr::monotonic_buffer_resource mono_;
+};
@@ -0,0 +1,278 @@
+/**
+ * @file tracer.cpp
+ * @brief Per-thread span buffers and the Chrome trace-event writer.
+ */
+
+#include "tracer.h"
+#include "intern.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#  ifdef __linux__
+#    include <sys/syscall.h>
+#  endif
+#endif
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+/// Spans one thread can hold per session (32 bytes each).
+constexpr std::size_t kSpansPerThread = std::size_t{1} << 15;
+
+struct Span {
+    const char* category;
+    const char* name;
+    uint64_t    startNs;
+    uint64_t    durNs;
+};
+
+/**
+ * Written only by its thread. count is published with release after the
+ * span it covers, so a reader that loads it with acquire sees complete
+ * spans. A buffer whose generation is behind the tracer's belongs to an
+ * earlier session; its thread clears it on its next span. Once the thread
+ * has exited, such a buffer holds nothing anyone will read, and
+ * pruneExited() drops it.
+ */
+struct ThreadBuffer {
+    uint64_t                 tid = 0;
+    std::string              threadName;
+    std::unique_ptr<Span[]>  spans{new Span[kSpansPerThread]};
+    std::atomic<std::size_t> count{0};
+    std::atomic<uint64_t>    dropped{0};
+    std::atomic<uint64_t>    generation{0};
+    std::atomic<bool>        exited{false};
+};
+
+struct Registry {
+    std::mutex                                 mtx;   ///< Guards buffers.
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<uint64_t>                      generation{0};
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+uint64_t currentTid() {
+#if defined(_WIN32)
+    return GetCurrentThreadId();
+#elif defined(__linux__)
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    static std::atomic<uint64_t> next{1};
+    thread_local uint64_t id = next++;
+    return id;
+#endif
+}
+
+std::string currentThreadName() {
+#if defined(__linux__)
+    char buf[16] = {};
+    if (pthread_getname_np(pthread_self(), buf, sizeof(buf)) == 0 && buf[0]) return buf;
+#endif
+    return "thread " + std::to_string(currentTid());
+}
+
+uint64_t processId() {
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+/// The calling thread's handle on its buffer; marks it exited when the thread ends.
+struct LocalBuffer {
+    std::shared_ptr<ThreadBuffer> buf;
+    ~LocalBuffer() {
+        if (buf) buf->exited.store(true, std::memory_order_release);
+    }
+};
+
+ThreadBuffer& localBuffer() {
+    thread_local LocalBuffer local;
+    std::shared_ptr<ThreadBuffer>& buf = local.buf;
+    if (!buf) {
+        buf = std::make_shared<ThreadBuffer>();
+        buf->tid        = currentTid();
+        buf->threadName = currentThreadName();
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        buf->generation.store(r.generation.load());
+        r.buffers.push_back(buf);
+    }
+    return *buf;
+}
+
+/// Drop buffers of exited threads from earlier sessions. Caller holds r.mtx.
+void pruneExited(Registry& r) {
+    const uint64_t gen = r.generation.load();
+    auto dead = [gen](const std::shared_ptr<ThreadBuffer>& b) {
+        return b->exited.load(std::memory_order_acquire)
+            && b->generation.load(std::memory_order_acquire) != gen;
+    };
+    r.buffers.erase(std::remove_if(r.buffers.begin(), r.buffers.end(), dead), r.buffers.end());
+}
+
+void writeString(std::ostream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            out << '\\' << *s;
+        } else if (c < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out << esc;
+        } else {
+            out << *s;
+        }
+    }
+    out << '"';
+}
+
+/// Chrome timestamps are microseconds; keep nanosecond precision as decimals.
+void writeMicros(std::ostream& out, uint64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03u",
+                  static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+    out << buf;
+}
+
+} // namespace
+
+void Tracer::start() {
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.generation.fetch_add(1, std::memory_order_acq_rel);
+        pruneExited(r);
+    }
+    nowNs();  // fix the time origin before the first span
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* category, const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& b = localBuffer();
+    uint64_t gen = registry().generation.load(std::memory_order_acquire);
+    if (b.generation.load(std::memory_order_relaxed) != gen) {
+        b.count.store(0, std::memory_order_relaxed);
+        b.dropped.store(0, std::memory_order_relaxed);
+        b.generation.store(gen, std::memory_order_release);
+    }
+
+    std::size_t n = b.count.load(std::memory_order_relaxed);
+    if (n >= kSpansPerThread) {
+        b.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    b.spans[n] = Span{category, name, startNs, endNs > startNs ? endNs - startNs : 0};
+    b.count.store(n + 1, std::memory_order_release);
+}
+
+uint64_t Tracer::spanCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    uint64_t gen = r.generation.load();
+    uint64_t total = 0;
+    for (const auto& b : r.buffers)
+        if (b->generation.load(std::memory_order_acquire) == gen)
+            total += b->count.load(std::memory_order_acquire);
+    return total;
+}
+
+std::size_t Tracer::threadBuffers() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    return r.buffers.size();
+}
+
+uint64_t Tracer::dropped() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    uint64_t gen = r.generation.load();
+    uint64_t total = 0;
+    for (const auto& b : r.buffers)
+        if (b->generation.load(std::memory_order_acquire) == gen)
+            total += b->dropped.load(std::memory_order_relaxed);
+    return total;
+}
+
+void Tracer::writeChromeJson(std::ostream& out) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    pruneExited(r);
+    const uint64_t gen = r.generation.load();
+    const uint64_t pid = processId();
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto next = [&] { out << (first ? "\n" : ",\n"); first = false; };
+
+    for (const auto& b : r.buffers) {
+        if (b->generation.load(std::memory_order_acquire) != gen) continue;
+        std::size_t n = b->count.load(std::memory_order_acquire);
+        if (n == 0) continue;
+
+        next();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << b->tid << ",\"args\":{\"name\":";
+        writeString(out, b->threadName.c_str());
+        out << "}}";
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const Span& s = b->spans[i];
+            next();
+            out << "{\"name\":";
+            writeString(out, s.name);
+            out << ",\"cat\":";
+            writeString(out, s.category);
+            out << ",\"ph\":\"X\",\"ts\":";
+            writeMicros(out, s.startNs);
+            out << ",\"dur\":";
+            writeMicros(out, s.durNs);
+            out << ",\"pid\":" << pid << ",\"tid\":" << b->tid << '}';
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool Tracer::writeChromeJson(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    writeChromeJson(out);
+    return static_cast<bool>(out);
+}
+
+const char* Tracer::intern(std::string_view name) {
+    InternPool& pool = InternPool::global();
+    return pool.lookup(pool.intern(name)).c_str();
+}
+
+uint64_t Tracer::nowNs() {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point origin = Clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count());
+}
@@ -0,0 +1,95 @@
+/**
+ * @file tracer.h
+ * @brief Optional span tracer with Chrome trace-event JSON output.
+ *
+ * Code marks interesting regions (a module update, a parser, a database
+ * transaction, a render frame) with a TraceSpan. While tracing is off, a
+ * span costs one relaxed atomic load and a branch in its constructor and
+ * does nothing else. While it is on, the span's start time and duration
+ * are appended on destruction to a buffer owned by the calling thread;
+ * the writer never locks, and a full buffer drops spans instead of
+ * growing (see dropped()).
+ *
+ * writeChromeJson() dumps every thread's spans as "X" (complete) events in
+ * the Chrome trace-event format, which chrome://tracing and Perfetto
+ * (ui.perfetto.dev) load directly. Buffers outlive their threads, so
+ * spans from workers that have exited are still included.
+ *
+ * Span names and categories are stored by pointer and must stay valid
+ * for the rest of the process: string literals, moduleName(), or text
+ * held by the InternPool (see Tracer::intern()).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class Tracer {
+public:
+    /// @brief Whether spans are being recorded. One relaxed load.
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /// @brief Discard all recorded spans and start recording.
+    static void start();
+
+    /// @brief Stop recording; what was recorded stays available for writing.
+    static void stop();
+
+    /// @brief Spans recorded since start(), across all threads.
+    static uint64_t spanCount();
+
+    /// @brief Spans lost since start() because a thread's buffer was full.
+    static uint64_t dropped();
+
+    /// @brief Per-thread span buffers held, including exited threads' not yet pruned.
+    static std::size_t threadBuffers();
+
+    /// @brief Write the recorded spans as Chrome trace-event JSON.
+    static void writeChromeJson(std::ostream& out);
+
+    /// @brief As above, to @p path. @return false if the file could not be written.
+    static bool writeChromeJson(const std::string& path);
+
+    /// @brief A permanent copy of @p name suitable as a span name.
+    static const char* intern(std::string_view name);
+
+    /// @brief Monotonic nanoseconds since the first call in this process.
+    static uint64_t nowNs();
+
+    /// @brief Append one finished span for the calling thread.
+    static void record(const char* category, const char* name, uint64_t startNs, uint64_t endNs);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief RAII span: recorded from construction to destruction if tracing was on at construction.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* category, const char* name) {
+        if (Tracer::enabled()) {
+            category_ = category;
+            name_     = name;
+            startNs_  = Tracer::nowNs();
+        }
+    }
+
+    ~TraceSpan() {
+        if (name_) Tracer::record(category_, name_, startNs_, Tracer::nowNs());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* category_ = nullptr;
+    const char* name_     = nullptr;
+    uint64_t    startNs_  = 0;
+};